@@ -33,6 +33,7 @@
 #include "appMain/life_cycle_impl.h"
 #include "application_manager/system_time/system_time_handler_impl.h"
 #include "config_profile/profile.h"
+#include "protocol/frame_pool.h"
 #include "resumption/last_state_impl.h"
 #include "resumption/last_state_wrapper_impl.h"
 #include "utils/signals.h"
@@ -194,6 +195,8 @@ void LifeCycleImpl::LowVoltage() {
       transport_manager::TransportAction::kListeningOff);
   transport_manager_->StopEventsProcessing();
   transport_manager_->Deinit();
+  // No more frames are expected until wake up, so cached blocks are useless
+  protocol_handler::frame_pool::ReleaseCachedMemory();
   app_manager_->OnLowVoltage();
 }
 
@@ -46,6 +46,7 @@
 #include "application_manager/app_service_manager.h"
 #include "application_manager/application_manager.h"
 #include "application_manager/application_manager_settings.h"
+#include "application_manager/application_registry.h"
 #include "application_manager/command_factory.h"
 #include "application_manager/command_holder.h"
 #include "application_manager/event_engine/event_dispatcher_impl.h"
@@ -1276,7 +1277,7 @@ class ApplicationManagerImpl
    * @param connection_key connection key of app, which provided app list to
    * be created
    */
-  void CreateApplications(smart_objects::SmartArray& obj_array,
+  void CreateApplications(const smart_objects::SmartArray& obj_array,
                           const uint32_t connection_key);
 
   /*
@@ -1537,6 +1538,11 @@ class ApplicationManagerImpl
    * @brief List of applications
    */
   ApplicationSet applications_;
+  /**
+   * @brief Indexed snapshots of applications list for lookups which
+   * should not take applications list lock
+   */
+  ApplicationRegistry applications_registry_;
   AppsWaitRegistrationSet apps_to_register_;
   ForbiddenApps forbidden_applications;
   ReregisterWaitList reregister_wait_list_;
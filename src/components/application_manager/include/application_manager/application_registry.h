@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_APPLICATION_REGISTRY_H_
+#define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_APPLICATION_REGISTRY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "application_manager/application_manager.h"
+#include "utils/macro.h"
+
+namespace application_manager {
+
+/**
+ * @brief Read-mostly view of registered applications with hash indexes
+ * by app id, HMI app id, policy app id and device.
+ *
+ * Registry keeps immutable snapshot of the applications list. Writers
+ * publish new snapshot each time the list is changed, readers take
+ * current snapshot and use it without holding applications list lock.
+ * Snapshot is released once the last reader drops it.
+ *
+ * Application ids may be changed after the snapshot has been built
+ * (e.g. HMI app id is assigned on registration), so each index hit is
+ * verified against the application and lookup falls back to the scan
+ * of snapshot applications if the index is stale or has no such key.
+ */
+class ApplicationRegistry {
+ public:
+  /**
+   * @brief Immutable copy of applications list with its indexes
+   */
+  class Snapshot {
+   public:
+    explicit Snapshot(const ApplicationSet& applications);
+
+    /**
+     * @brief Applications in ApplicationSet order
+     */
+    const std::vector<ApplicationSharedPtr>& applications() const {
+      return applications_;
+    }
+
+    ApplicationSharedPtr FindByAppId(const uint32_t app_id) const;
+    ApplicationSharedPtr FindByHmiAppId(const uint32_t hmi_app_id) const;
+    ApplicationSharedPtr FindByPolicyAppId(
+        const std::string& policy_app_id) const;
+    ApplicationSharedPtr FindByDeviceAndPolicyAppId(
+        const connection_handler::DeviceHandle device,
+        const std::string& policy_app_id) const;
+
+   private:
+    typedef std::unordered_map<uint32_t, size_t> IdIndex;
+    typedef std::unordered_map<std::string, size_t> PolicyAppIdIndex;
+    typedef std::unordered_map<connection_handler::DeviceHandle,
+                               std::vector<size_t> >
+        DeviceIndex;
+
+    /**
+     * @brief Gets indexed application if it still matches predicate,
+     * otherwise first application matching predicate
+     */
+    template <typename Index, typename Key, typename Predicate>
+    ApplicationSharedPtr Find(const Index& index,
+                              const Key& key,
+                              Predicate predicate) const;
+
+    std::vector<ApplicationSharedPtr> applications_;
+    IdIndex by_app_id_;
+    IdIndex by_hmi_app_id_;
+    PolicyAppIdIndex by_policy_app_id_;
+    DeviceIndex by_device_;
+
+    DISALLOW_COPY_AND_ASSIGN(Snapshot);
+  };
+
+  typedef std::shared_ptr<const Snapshot> SnapshotPtr;
+
+  ApplicationRegistry();
+
+  /**
+   * @brief Gets current snapshot of applications list.
+   * Thread-safe, does not block writers.
+   */
+  SnapshotPtr snapshot() const;
+
+  /**
+   * @brief Builds and publishes snapshot of applications list.
+   * Should be called with applications list lock acquired after each
+   * change of the list, so snapshots are published in order of changes.
+   */
+  void Publish(const ApplicationSet& applications);
+
+ private:
+  SnapshotPtr snapshot_;
+
+  DISALLOW_COPY_AND_ASSIGN(ApplicationRegistry);
+};
+
+}  // namespace application_manager
+
+#endif  // SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_APPLICATION_REGISTRY_H_
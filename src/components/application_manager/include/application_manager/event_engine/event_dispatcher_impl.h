@@ -33,7 +33,9 @@
 #ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_EVENT_ENGINE_EVENT_DISPATCHER_IMPL_H_
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_EVENT_ENGINE_EVENT_DISPATCHER_IMPL_H_
 
-#include <map>
+#include <stdint.h>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "utils/lock.h"
@@ -50,10 +52,8 @@ class EventDispatcherImpl : public EventDispatcher {
  public:
   // Data types section
   typedef std::vector<EventObserver*> ObserverVector;
-  typedef std::map<int32_t, ObserverVector> ObserversMap;
-  typedef std::map<Event::EventID, ObserversMap> EventObserverMap;
-  typedef std::map<MobileEvent::MobileEventID, ObserversMap>
-      MobileEventObserverMap;
+  typedef std::shared_ptr<const ObserverVector> ObserverVectorPtr;
+
   /*
    * @brief Destructor
    */
@@ -65,14 +65,11 @@ class EventDispatcherImpl : public EventDispatcher {
   EventDispatcherImpl();
 
 #ifdef BUILD_TESTS
-  EventObserverMap get_observers() const {
-    return observers_event_;
-  }
-  MobileEventObserverMap get_mobile_observers() const {
-    return mobile_observers_event_;
+  size_t get_observed_events_count() const {
+    return observers_.size();
   }
-  ObserverVector get_observers_list() const {
-    return observers_;
+  size_t get_observed_mobile_events_count() const {
+    return mobile_observers_.size();
   }
 #endif  // BUILD_TESTS
 
@@ -147,31 +144,80 @@ class EventDispatcherImpl : public EventDispatcher {
 
  private:
   /*
-   * @brief removes observer
-   * when occurs unsubscribe from event
-   * @param observer to be removed
-   */
-  void remove_observer_from_vector(EventObserver& observer);
-
-  /*
-   * @brief removes observer
-   * when occurs unsubscribe from event
-   * @param observer to be removed
+   * @brief Observers subscribed to events, sharded by correlation ID.
+   * Each shard has its own lock and hash table keyed by pair of event ID
+   * and correlation ID. Observers of the key are stored in immutable vector
+   * which is replaced on subscribe/unsubscribe, so event is delivered
+   * without copying observers. Key is erased once it has no observers.
    */
-  void remove_mobile_observer_from_vector(EventObserver& observer);
+  class ObserversRegistry {
+   public:
+    void Add(const int32_t event_id,
+             const int32_t correlation_id,
+             EventObserver* observer);
+
+    /*
+     * @brief Unsubscribes observer from event with any correlation ID
+     */
+    void Remove(const int32_t event_id, EventObserver* observer);
+
+    /*
+     * @brief Unsubscribes observer from all events
+     */
+    void RemoveAll(EventObserver* observer);
+
+    /*
+     * @return observers subscribed to event or shared_ptr with NULL
+     */
+    ObserverVectorPtr Find(const int32_t event_id,
+                           const int32_t correlation_id) const;
+
+    /*
+     * @return amount of event ID and correlation ID pairs having observers
+     */
+    size_t size() const;
+
+   private:
+    enum { kShardsCount = 16 };
+
+    struct Shard {
+      mutable sync_primitives::Lock lock_;
+      std::unordered_map<uint64_t, ObserverVectorPtr> observers_;
+      /*
+       * Keys of this shard every observer is subscribed to
+       */
+      std::unordered_multimap<EventObserver*, uint64_t> subscriptions_;
+    };
+
+    static uint64_t Key(const int32_t event_id, const int32_t correlation_id);
+    static int32_t EventId(const uint64_t key);
+    static size_t ShardIndex(const int32_t correlation_id);
+
+    /*
+     * @brief Removes observer from observers of the key. Not thread-safe
+     */
+    void RemoveFromKey(Shard& shard,
+                       const uint64_t key,
+                       EventObserver* observer);
+
+    /*
+     * @brief Unsubscribes observer from events in shard matching filter.
+     * Not thread-safe
+     */
+    void RemoveFromShard(Shard& shard,
+                         EventObserver* observer,
+                         const bool any_event,
+                         const int32_t event_id);
+
+    Shard shards_[kShardsCount];
+  };
 
   DISALLOW_COPY_AND_ASSIGN(EventDispatcherImpl);
 
  private:
   // Members section
-  sync_primitives::Lock state_lock_;
-  sync_primitives::Lock mobile_state_lock_;
-  sync_primitives::RecursiveLock observer_lock_;
-  sync_primitives::RecursiveLock mobile_observer_lock_;
-  EventObserverMap observers_event_;
-  MobileEventObserverMap mobile_observers_event_;
-  ObserverVector observers_;
-  ObserverVector mobile_observers_;
+  ObserversRegistry observers_;
+  ObserversRegistry mobile_observers_;
 };
 
 }  // namespace event_engine
@@ -33,8 +33,12 @@
 #ifndef SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REQUEST_CONTROLLER_H_
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REQUEST_CONTROLLER_H_
 
+#include <atomic>
 #include <climits>
+#include <deque>
 #include <list>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "utils/lock.h"
@@ -42,7 +46,6 @@
 #include "utils/conditional_variable.h"
 #include "utils/threads/thread.h"
 #include "utils/threads/thread_delegate.h"
-#include "utils/timer.h"
 
 #include "interfaces/HMI_API.h"
 #include "interfaces/MOBILE_API.h"
@@ -217,7 +220,7 @@ class RequestController {
 
  protected:
   /**
-   * @brief Timer callback which handles all request timeouts
+   * @brief Timeout thread loop which handles all request timeouts
    */
   void TimeoutThread();
 
@@ -251,25 +254,145 @@ class RequestController {
  private:
   class Worker : public threads::ThreadDelegate {
    public:
-    explicit Worker(RequestController* requestController);
+    Worker(RequestController* requestController, const size_t shard_index);
     virtual ~Worker();
     virtual void threadMain();
     virtual void exitThreadMain();
 
-   protected:
    private:
     RequestController* request_controller_;
-    sync_primitives::Lock thread_lock_;
-    volatile bool stop_flag_;
+    const size_t shard_index_;
+    std::atomic<bool> stop_flag_;
   };
 
+  /**
+   * @brief Delegate of thread waiting for nearest request deadline
+   */
+  class TimeoutWatcher : public threads::ThreadDelegate {
+   public:
+    explicit TimeoutWatcher(RequestController* request_controller);
+    void threadMain() OVERRIDE;
+    void exitThreadMain() OVERRIDE;
+
+   private:
+    RequestController* request_controller_;
+  };
+
+  /**
+   * @brief Mobile requests of single application waiting for execution.
+   * Requests of the same application are executed one by one in order of
+   * arrival, requests of different applications are executed in parallel.
+   */
+  struct AppRequests {
+    std::deque<RequestPtr> requests_;
+  };
+
+  /**
+   * @brief Part of requests waiting for execution owned by single pool
+   * worker. Applications are distributed between shards by connection key,
+   * so adding or taking a request locks only one shard. Idle workers steal
+   * ready applications from shards of busy ones.
+   */
+  struct Shard {
+    Shard() : ready_count_(0), idle_(false), wakeup_(false) {}
+
+    sync_primitives::Lock lock_;
+    sync_primitives::ConditionalVariable cond_var_;
+
+    /**
+     * @brief Applications which are either ready or being executed,
+     * application is removed once it has no more requests to execute
+     */
+    std::unordered_map<uint32_t, AppRequests> apps_;
+
+    /**
+     * @brief Applications which requests may be taken for execution
+     */
+    std::deque<uint32_t> ready_apps_;
+
+    /**
+     * @brief Size of ready_apps_ which may be checked without lock
+     */
+    std::atomic<size_t> ready_count_;
+
+    /**
+     * @brief Set while owner worker has nothing to execute
+     */
+    std::atomic<bool> idle_;
+
+    /**
+     * @brief Set if owner worker should look for work before falling asleep
+     */
+    bool wakeup_;
+  };
+
+  /**
+   * @brief Gets shard responsible for application requests
+   */
+  size_t ShardIndex(const uint32_t connection_key) const;
+
+  /**
+   * @brief Takes next request for execution, request is taken from own
+   * shard of worker first and stolen from other shards otherwise.
+   * Blocks until request is available or worker has been stopped.
+   * @param shard_index index of worker own shard
+   * @param stop_flag worker stop flag
+   * @param request_shard_index output index of shard request has been
+   * taken from
+   * @return request or empty pointer if worker should be stopped
+   */
+  RequestPtr WaitForRequest(const size_t shard_index,
+                            const std::atomic<bool>& stop_flag,
+                            size_t& request_shard_index);
+
+  /**
+   * @brief Takes request of first ready application of shard.
+   * Not thread-safe, shard lock should be taken
+   */
+  RequestPtr TakeReadyRequest(Shard& shard);
+
+  /**
+   * @brief Tries to take ready request from any shard except own one
+   */
+  RequestPtr StealRequest(const size_t shard_index,
+                          size_t& request_shard_index);
+
+  /**
+   * @brief Returns application to ready list of shard after its request has
+   * been executed or removes it if there are no more requests
+   */
+  void OnRequestExecuted(const size_t shard_index,
+                         const size_t request_shard_index,
+                         const uint32_t connection_key);
+
+  /**
+   * @brief Wakes up any idle worker to steal ready applications
+   */
+  void WakeUpIdleWorker();
+
+  /**
+   * @brief Wakes up all workers waiting for requests
+   */
+  void WakeUpAllWorkers();
+
+  /**
+   * @brief Adds request to waiting for response list and executes it
+   */
+  void ExecuteRequest(RequestPtr request);
+
   std::vector<threads::Thread*> pool_;
-  volatile TPoolState pool_state_;
+  std::atomic<TPoolState> pool_state_;
   uint32_t pool_size_;
-  sync_primitives::ConditionalVariable cond_var_;
 
-  std::list<RequestPtr> mobile_request_list_;
-  sync_primitives::Lock mobile_request_list_lock_;
+  /**
+   * @brief Requests waiting for execution, one shard per pool worker
+   */
+  std::vector<std::unique_ptr<Shard> > shards_;
+
+  /**
+   * @brief Amount of requests waiting for execution in all shards
+   */
+  std::atomic<size_t> pending_requests_count_;
 
   /*
    * Requests, that are waiting for responses
@@ -297,9 +420,10 @@ class RequestController {
   sync_primitives::Lock duplicate_message_count_lock_;
 
   /*
-   * timer for checking requests timeout
+   * Thread checking requests timeout. It blocks while waiting for deadline,
+   * so it is not run from shared timer wheel threads
    */
-  timer::Timer timer_;
+  threads::Thread* timeout_thread_;
 
   /*
    * Timer for lock
@@ -37,7 +37,9 @@
 #define SRC_COMPONENTS_APPLICATION_MANAGER_INCLUDE_APPLICATION_MANAGER_REQUEST_INFO_H_
 
 #include <stdint.h>
-#include <set>
+#include <limits>
+#include <unordered_map>
+#include <vector>
 
 #include "application_manager/commands/command_request_impl.h"
 #include "commands/request_to_hmi.h"
@@ -155,28 +157,10 @@ struct HMIRequestInfo : public RequestInfo {
                  const uint64_t timeout_msec);
 };
 
-// Request info, for searching in request info set by log_n time
-// Returns correct hash by app_id and corr_id
-struct FakeRequestInfo : public RequestInfo {
-  FakeRequestInfo(uint32_t app_id, uint32_t correaltion_id);
-};
-
-struct RequestInfoTimeComparator {
-  bool operator()(const RequestInfoPtr lhs, const RequestInfoPtr rhs) const;
-};
-
-struct RequestInfoHashComparator {
-  bool operator()(const RequestInfoPtr lhs, const RequestInfoPtr rhs) const;
-};
-
-typedef std::set<RequestInfoPtr, RequestInfoTimeComparator>
-    TimeSortedRequestInfoSet;
-typedef std::set<RequestInfoPtr, RequestInfoHashComparator>
-    HashSortedRequestInfoSet;
-
 /*
  * @brief RequestInfoSet provides uniue requests bu corralation_id and app_id
- *
+ * Requests are stored in hash map by app_id and correlation_id, requests
+ * with not null timeout are additionally kept in 4-ary min heap of deadlines.
  */
 class RequestInfoSet {
  public:
@@ -193,7 +177,7 @@ class RequestInfoSet {
   bool Add(RequestInfoPtr request_info);
 
   /*
-   * @brief Find requests int colletion by log(n) time
+   * @brief Find requests int colletion by constant time
    * @param connection_key - connection_key of request
    * @param correlation_id - correlation_id of request
    * @return founded request or shared_ptr with NULL
@@ -202,7 +186,8 @@ class RequestInfoSet {
                       const uint32_t correlation_id);
 
   /*
-   * @brief Get request with smalest end_time_
+   * @brief Get request with smalest end_time_, requests with null timeout
+   * are returned only if there are no other requests
    * @return founded request or shared_ptr with NULL
    */
   RequestInfoPtr Front();
@@ -213,6 +198,19 @@ class RequestInfoSet {
    */
   RequestInfoPtr FrontWithNotNullTimeout();
 
+  /*
+   * @brief Updates timeout of request and restarts counting it from now.
+   * Extending of timeout takes constant time, request is moved in deadlines
+   * heap lazily once its previous deadline is reached.
+   * @param connection_key - connection_key of request
+   * @param correlation_id - correlation_id of request
+   * @param timeout_msec - new timeout in milliseconds, 0 to stop tracking
+   * @return true if request has been found
+   */
+  bool UpdateTimeout(const uint32_t connection_key,
+                     const uint32_t correlation_id,
+                     const uint64_t timeout_msec);
+
   /*
    * @brief Erase request from colletion by log(n) time
    * @param request_info - request to erase
@@ -253,7 +251,31 @@ class RequestInfoSet {
     CompareType compare_type_;
   };
 
-  bool Erase(const RequestInfoPtr request_info);
+  /**
+   * @brief Pending request with its position in deadlines heap
+   */
+  struct Entry {
+    explicit Entry(RequestInfoPtr request_info)
+        : request_info_(request_info)
+        , heap_index_(std::numeric_limits<size_t>::max()) {}
+
+    bool in_heap() const {
+      return std::numeric_limits<size_t>::max() != heap_index_;
+    }
+
+    RequestInfoPtr request_info_;
+
+    /**
+     * @brief Heap key. It is never later than end time of request: when
+     * timeout is extended key stays unchanged until entry reaches the top
+     */
+    date_time::TimeDuration deadline_;
+    size_t heap_index_;
+  };
+
+  typedef std::unordered_map<uint64_t, Entry> RequestsMap;
+
+  bool Erase(RequestsMap::iterator it);
 
   /*
    * @brief Erase requests from collection if filter allows
@@ -262,12 +284,25 @@ class RequestInfoSet {
    */
   uint32_t RemoveRequests(const RequestInfoSet::AppIdCompararator& filter);
 
-  /*
-   * @brief Debug function, will raise assert if set sizes are noit equal
+  /**
+   * @brief Functions maintaining deadlines heap, not thread-safe
    */
-  inline void CheckSetSizes();
-  TimeSortedRequestInfoSet time_sorted_pending_requests_;
-  HashSortedRequestInfoSet hash_sorted_pending_requests_;
+  static bool DeadlineLess(const Entry* lhs, const Entry* rhs);
+  void HeapPush(Entry* entry);
+  void HeapRemove(Entry* entry);
+  void HeapSet(const size_t index, Entry* entry);
+  void SiftUp(size_t index);
+  void SiftDown(size_t index);
+
+  /**
+   * @brief Moves entries with extended timeout from the heap top to their
+   * actual positions, so top entry has the nearest deadline afterwards.
+   * Not thread-safe
+   */
+  Entry* HeapTop();
+
+  RequestsMap pending_requests_;
+  std::vector<Entry*> deadlines_heap_;
 
   sync_primitives::Lock pending_requests_lock_;
 };
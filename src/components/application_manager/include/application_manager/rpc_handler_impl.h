@@ -44,6 +44,7 @@
 #include "hmi_message_handler/hmi_message_sender.h"
 #include "protocol_handler/protocol_observer.h"
 
+#include "formatters/CFormatterBsonSDLRPCv2.h"
 #include "formatters/CFormatterJsonSDLRPCv1.h"
 #include "formatters/CFormatterJsonSDLRPCv2.h"
 #include "formatters/formatter_json_rpc.h"
@@ -83,9 +84,11 @@ struct MessageFromHmi : public std::shared_ptr<Message> {
 };
 
 // Short type names for prioritized message queues
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageFromMobile> >
+typedef threads::MessageLoopThread<
+    utils::FixedPrioritizedQueue<MessageFromMobile> >
     FromMobileQueue;
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageFromHmi> >
+typedef threads::MessageLoopThread<
+    utils::FixedPrioritizedQueue<MessageFromHmi> >
     FromHmiQueue;
 }  // namespace impl
 
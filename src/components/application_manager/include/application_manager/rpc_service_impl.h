@@ -42,6 +42,7 @@
 #include "application_manager/rpc_service.h"
 #include "application_manager/usage_statistics.h"
 
+#include "formatters/CFormatterBsonSDLRPCv2.h"
 #include "formatters/CFormatterJsonSDLRPCv1.h"
 #include "formatters/CFormatterJsonSDLRPCv2.h"
 #include "formatters/formatter_json_rpc.h"
@@ -82,9 +83,11 @@ struct MessageToHmi : public std::shared_ptr<Message> {
   }
 };
 
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageToMobile> >
+typedef threads::MessageLoopThread<
+    utils::FixedPrioritizedQueue<MessageToMobile> >
     ToMobileQueue;
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageToHmi> >
+typedef threads::MessageLoopThread<
+    utils::FixedPrioritizedQueue<MessageToHmi> >
     ToHmiQueue;
 }  // namespace impl
 
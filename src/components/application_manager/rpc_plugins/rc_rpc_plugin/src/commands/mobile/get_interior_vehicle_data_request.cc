@@ -78,9 +78,7 @@ void GetInteriorVehicleDataRequest::FilterDisabledModuleData(
   // message.
   if (module_data.keyExists(message_params::kRadioEnable) &&
       module_data[message_params::kRadioEnable].asBool() == false) {
-    for (auto data = module_data.map_begin(); data != module_data.map_end();) {
-      auto key = data->first;
-      ++data;
+    for (const auto& key : module_data.enumerate()) {
       if (key != message_params::kRadioEnable) {
         module_data.erase(key);
       }
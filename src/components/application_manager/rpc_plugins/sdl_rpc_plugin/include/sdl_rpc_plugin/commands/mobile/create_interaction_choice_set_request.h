@@ -161,32 +161,6 @@ class CreateInteractionChoiceSetRequest
   mobile_apis::Result::eType CheckChoiceSet(
       app_mngr::ApplicationConstSharedPtr app);
 
-  /*
-   * @brief Checks if incoming choice set doesn't has similar VR synonyms.
-   *
-   * @param choice1  Choice to compare
-   * @param choice2  Choice to compare
-   *
-   * return Return TRUE if there are similar VR synonyms in choice set,
-   * otherwise FALSE
-   */
-  bool compareSynonyms(
-      const ns_smart_device_link::ns_smart_objects::SmartObject& choice1,
-      const ns_smart_device_link::ns_smart_objects::SmartObject& choice2);
-
-  /*
-   * @brief Checks VR synonyms ignoring differences in case.
-   *
-   * @param str1 VR synonym to compare
-   * @param str2 VR synonym to compare
-   *
-   * return Return TRUE if there are similar VR synonyms in choice set,
-   * otherwise FALSE
-   */
-  static bool compareStr(
-      const ns_smart_device_link::ns_smart_objects::SmartObject& str1,
-      const ns_smart_device_link::ns_smart_objects::SmartObject& str2);
-
   /**
    * @brief Checks choice set params(menuName, tertiaryText, ...)
    * When type is String there is a check on the contents \t\n \\t \\n
@@ -246,31 +246,38 @@ bool AddCommandRequest::CheckCommandVRSynonym(ApplicationConstSharedPtr app) {
     return false;
   }
 
+  // Synonyms of the new command are indexed once, so each synonym of
+  // existing commands is checked with a single lookup
+  const smart_objects::SmartObject& new_vr_commands =
+      (*message_)[strings::msg_params][strings::vr_commands];
+  custom_str::StringSetIgnoreCase new_synonyms;
+  for (size_t i = 0; i < new_vr_commands.length(); ++i) {
+    new_synonyms.insert(
+        custom_str::StringRefIgnoreCase(new_vr_commands[i].asCharArray()));
+  }
+
   const DataAccessor<CommandsMap> accessor = app->commands_map();
   const CommandsMap& commands = accessor.GetData();
   CommandsMap::const_iterator it = commands.begin();
 
   for (; commands.end() != it; ++it) {
-    if (!(*it->second).keyExists(strings::vr_commands)) {
+    const smart_objects::SmartObject& command = *it->second;
+    if (!command.keyExists(strings::vr_commands)) {
       continue;
     }
 
-    for (size_t i = 0; i < (*it->second)[strings::vr_commands].length(); ++i) {
-      for (size_t j = 0;
-           j < (*message_)[strings::msg_params][strings::vr_commands].length();
-           ++j) {
-        const custom_str::CustomString& vr_cmd_i =
-            (*it->second)[strings::vr_commands][i].asCustomString();
-        const custom_str::CustomString& vr_cmd_j =
-            (*message_)[strings::msg_params][strings::vr_commands][j]
-                .asCustomString();
-
-        if (vr_cmd_i.CompareIgnoreCase(vr_cmd_j)) {
-          SDL_LOG_INFO(
-              "AddCommandRequest::CheckCommandVRSynonym"
-              " received command vr synonym already exist");
-          return false;
-        }
+    const smart_objects::SmartObject& vr_commands =
+        command[strings::vr_commands];
+    for (size_t i = 0; i < vr_commands.length(); ++i) {
+      if (smart_objects::SmartType_String != vr_commands[i].getType()) {
+        continue;
+      }
+      if (new_synonyms.count(
+              custom_str::StringRefIgnoreCase(vr_commands[i].asCharArray()))) {
+        SDL_LOG_INFO(
+            "AddCommandRequest::CheckCommandVRSynonym"
+            " received command vr synonym already exist");
+        return false;
       }
     }
   }
@@ -40,6 +40,7 @@
 #include "application_manager/application_impl.h"
 #include "application_manager/message_helper.h"
 #include "application_manager/resumption/resume_ctrl.h"
+#include "utils/custom_string.h"
 #include "utils/gen_hash.h"
 #include "utils/helpers.h"
 
@@ -171,70 +172,52 @@ mobile_apis::Result::eType CreateInteractionChoiceSetRequest::CheckChoiceSet(
   const SmartArray* choice_set =
       (*message_)[strings::msg_params][strings::choice_set].asArray();
 
-  SmartArray::const_iterator current_choice_set_it = choice_set->begin();
-  SmartArray::const_iterator next_choice_set_it;
+  // Choices are checked in order, so for each choice it is found in advance
+  // whether any of the following choices repeats its VR synonym
+  std::vector<bool> duplicated_synonyms(choice_set->size(), false);
+  custom_str::StringSetIgnoreCase following_synonyms;
+  for (size_t i = choice_set->size(); i > 0; --i) {
+    const SmartObject& choice = (*choice_set)[i - 1];
+    if (!choice.keyExists(strings::vr_commands)) {
+      continue;
+    }
+    const SmartObject& vr_commands = choice[strings::vr_commands];
+    for (size_t j = 0; j < vr_commands.length(); ++j) {
+      if (following_synonyms.count(
+              custom_str::StringRefIgnoreCase(vr_commands[j].asCharArray()))) {
+        SDL_LOG_INFO("Incoming choice set has duplicated VR synonyms "
+                     << vr_commands[j].asString());
+        duplicated_synonyms[i - 1] = true;
+        break;
+      }
+    }
+    for (size_t j = 0; j < vr_commands.length(); ++j) {
+      following_synonyms.insert(
+          custom_str::StringRefIgnoreCase(vr_commands[j].asCharArray()));
+    }
+  }
 
-  for (; choice_set->end() != current_choice_set_it; ++current_choice_set_it) {
+  for (size_t i = 0; i < choice_set->size(); ++i) {
+    const SmartObject& choice = (*choice_set)[i];
     std::pair<std::set<uint32_t>::iterator, bool> ins_res =
-        choice_id_set.insert(
-            (*current_choice_set_it)[strings::choice_id].asInt());
+        choice_id_set.insert(choice[strings::choice_id].asInt());
     if (!ins_res.second) {
-      SDL_LOG_ERROR("Choice with ID "
-                    << (*current_choice_set_it)[strings::choice_id].asInt()
-                    << " already exists");
+      SDL_LOG_ERROR("Choice with ID " << choice[strings::choice_id].asInt()
+                                      << " already exists");
       return mobile_apis::Result::INVALID_ID;
     }
 
-    if (IsWhiteSpaceExist(*current_choice_set_it)) {
+    if (IsWhiteSpaceExist(choice)) {
       SDL_LOG_ERROR("Incoming choice set has contains \t\n \\t \\n");
       return mobile_apis::Result::INVALID_DATA;
     }
-    for (next_choice_set_it = current_choice_set_it + 1;
-         choice_set->end() != next_choice_set_it;
-         ++next_choice_set_it) {
-      if (compareSynonyms(*current_choice_set_it, *next_choice_set_it)) {
-        return mobile_apis::Result::DUPLICATE_NAME;
-      }
+    if (duplicated_synonyms[i]) {
+      return mobile_apis::Result::DUPLICATE_NAME;
     }
   }
   return mobile_apis::Result::SUCCESS;
 }
 
-bool CreateInteractionChoiceSetRequest::compareSynonyms(
-    const ns_smart_device_link::ns_smart_objects::SmartObject& choice1,
-    const ns_smart_device_link::ns_smart_objects::SmartObject& choice2) {
-  // only compare if they both have vr commands
-  if (!(choice1.keyExists(strings::vr_commands) &&
-        choice2.keyExists(strings::vr_commands))) {
-    return false;  // clearly there isn't a duplicate if one of them is null
-  }
-  smart_objects::SmartArray* vr_cmds_1 =
-      choice1[strings::vr_commands].asArray();
-  smart_objects::SmartArray* vr_cmds_2 =
-      choice2[strings::vr_commands].asArray();
-
-  smart_objects::SmartArray::iterator it;
-  it = std::find_first_of(vr_cmds_1->begin(),
-                          vr_cmds_1->end(),
-                          vr_cmds_2->begin(),
-                          vr_cmds_2->end(),
-                          CreateInteractionChoiceSetRequest::compareStr);
-
-  if (it != vr_cmds_1->end()) {
-    SDL_LOG_INFO("Incoming choice set has duplicated VR synonyms "
-                 << it->asString());
-    return true;
-  }
-
-  return false;
-}
-
-bool CreateInteractionChoiceSetRequest::compareStr(
-    const ns_smart_device_link::ns_smart_objects::SmartObject& str1,
-    const ns_smart_device_link::ns_smart_objects::SmartObject& str2) {
-  return 0 == strcasecmp(str1.asCharArray(), str2.asCharArray());
-}
-
 bool CreateInteractionChoiceSetRequest::IsWhiteSpaceExist(
     const smart_objects::SmartObject& choice_set) {
   SDL_LOG_AUTO_TRACE();
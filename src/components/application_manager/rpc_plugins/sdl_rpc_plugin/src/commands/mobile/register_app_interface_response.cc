@@ -68,7 +68,7 @@ void RegisterAppInterfaceResponse::Run() {
       app->is_media_application() &&
       (*message_)[strings::msg_params].keyExists(
           hmi_response::button_capabilities)) {
-    const smart_objects::SmartObject& button_caps =
+    smart_objects::SmartObject& button_caps =
         (*message_)[strings::msg_params][hmi_response::button_capabilities];
     auto it = button_caps.asArray()->begin();
     auto ok_btn_it = it;
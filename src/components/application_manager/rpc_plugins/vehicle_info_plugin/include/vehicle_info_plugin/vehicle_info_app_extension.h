@@ -34,9 +34,15 @@
 #define SRC_COMPONENTS_APPLICATION_MANAGER_RPC_PLUGINS_VEHICLE_INFO_PLUGIN_INCLUDE_VEHICLE_INFO_PLUGIN_VEHICLE_INFO_APP_EXTENSION_H
 
 #include <application_manager/application_manager.h>
+#include <application_manager/commands/command_impl.h>
 
+#include <functional>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace vehicle_info_plugin {
 class VehicleInfoPlugin;
@@ -49,6 +55,20 @@ typedef mobile_apis::VehicleDataType::eType VehicleDataType;
  */
 typedef std::set<std::string> VehicleInfoSubscriptions;
 
+/**
+ * @brief Defines applications subscribed to vehicle info type
+ */
+typedef std::vector<const app_mngr::Application*> VehicleInfoSubscribers;
+
+typedef std::shared_ptr<const app_mngr::CommandParametersPermissions>
+    ParamsPermissionsPtr;
+
+/**
+ * @brief Defines policy request for parameters permissions of application
+ */
+typedef std::function<void(app_mngr::CommandParametersPermissions&)>
+    ParamsPermissionsProvider;
+
 class VehicleInfoAppExtension : public app_mngr::AppExtension {
  public:
   /**
@@ -163,7 +183,48 @@ class VehicleInfoAppExtension : public app_mngr::AppExtension {
   static VehicleInfoAppExtension& ExtractVIExtension(
       application_manager::Application& app);
 
+  /**
+   * @brief SubscribedApps gets all applications which extensions are
+   * subscribed to vehicle data. Reverse index is maintained by extensions on
+   * each subscription change, so there is no need to check every application.
+   * Returned pointers are identities only and must not be dereferenced,
+   * applications should be taken from ApplicationManager::applications()
+   * @param vehicle_data vehicle data to check
+   * @return subscribed applications
+   */
+  static VehicleInfoSubscribers SubscribedApps(const std::string& vehicle_data);
+
+  /**
+   * @brief OnVehicleDataPermissions gets policy permissions of OnVehicleData
+   * parameters for application at specified HMI level. Policy may echo
+   * requested parameters in result, so permissions are requested from
+   * policy once per HMI level and parameters set and cached until next
+   * ResetPermissionsCache call.
+   * @param hmi_level current HMI level of application
+   * @param requested_params parameters requested to be sent to application
+   * @param provider callback requesting permissions from policy on cache miss
+   * @return parameters permissions
+   */
+  ParamsPermissionsPtr OnVehicleDataPermissions(
+      const mobile_apis::HMILevel::eType hmi_level,
+      const app_mngr::RPCParams& requested_params,
+      const ParamsPermissionsProvider& provider);
+
+  /**
+   * @brief ResetPermissionsCache invalidates cached parameters permissions
+   * of all extensions. Should be called on any policy permissions change.
+   */
+  static void ResetPermissionsCache();
+
  private:
+  struct CachedPermissions {
+    uint32_t generation_;
+    ParamsPermissionsPtr permissions_;
+  };
+  typedef std::pair<mobile_apis::HMILevel::eType, app_mngr::RPCParams>
+      PermissionsKey;
+  typedef std::map<PermissionsKey, CachedPermissions> PermissionsCache;
+
   mutable std::shared_ptr<sync_primitives::Lock> subscribed_data_lock_;
   VehicleInfoSubscriptions subscribed_data_;
 
@@ -171,6 +232,9 @@ class VehicleInfoAppExtension : public app_mngr::AppExtension {
   VehicleInfoSubscriptions pending_subscriptions_;
   VehicleInfoPlugin& plugin_;
   app_mngr::Application& app_;
+
+  mutable sync_primitives::Lock permissions_cache_lock_;
+  PermissionsCache permissions_cache_;
 };
 }  // namespace vehicle_info_plugin
 
@@ -34,6 +34,7 @@
 #define SRC_COMPONENTS_APPLICATION_MANAGER_RPC_PLUGINS_VEHICLE_INFO_PLUGIN_INCLUDE_VEHICLE_INFO_PLUGIN_VEHICLE_INFO_PLUGIN_H
 
 #include "application_manager/command_factory.h"
+#include "application_manager/policies/policy_handler_observer.h"
 #include "application_manager/resumption/pending_resumption_handler.h"
 #include "vehicle_info_plugin/custom_vehicle_data_manager.h"
 
@@ -45,9 +46,11 @@ namespace plugins = application_manager::plugin_manager;
 bool IsSubscribedAppExist(const std::string& ivi,
                           const app_mngr::ApplicationManager& app_manager);
 
-class VehicleInfoPlugin : public plugins::RPCPlugin {
+class VehicleInfoPlugin : public plugins::RPCPlugin,
+                          public policy::PolicyHandlerObserver {
  public:
   VehicleInfoPlugin();
+  ~VehicleInfoPlugin();
 
   bool Init(app_mngr::ApplicationManager& application_manager,
             app_mngr::rpc_service::RPCService& rpc_service,
@@ -66,6 +69,13 @@ class VehicleInfoPlugin : public plugins::RPCPlugin {
   void OnApplicationEvent(plugins::ApplicationEvent event,
                           app_mngr::ApplicationSharedPtr application) OVERRIDE;
 
+  /**
+   * @brief OnPermissionsUpdated resets cached OnVehicleData parameters
+   * permissions of applications as they could be changed by user consent
+   * @param policy_app_id policy id of application
+   */
+  void OnPermissionsUpdated(const std::string& policy_app_id) OVERRIDE;
+
   /**
    * @brief ProcessResumptionSubscription send Subscribe vehicle data requests
    * to HMI
@@ -100,6 +110,7 @@ class VehicleInfoPlugin : public plugins::RPCPlugin {
   typedef std::shared_ptr<resumption::PendingResumptionHandler>
       PendingResumptionHandlerSPtr;
   app_mngr::ApplicationManager* application_manager_;
+  policy::PolicyHandlerInterface* policy_handler_;
   std::unique_ptr<CustomVehicleDataManager> custom_vehicle_data_manager_;
   PendingResumptionHandlerSPtr pending_resumption_handler_;
 };
@@ -33,6 +33,10 @@
 
 #include "vehicle_info_plugin/commands/mobile/on_vehicle_data_notification.h"
 
+#include <map>
+#include <utility>
+#include <vector>
+
 #include "application_manager/application_impl.h"
 #include "application_manager/helpers/application_helper.h"
 #include "application_manager/message_helper.h"
@@ -62,88 +66,112 @@ OnVehicleDataNotification::~OnVehicleDataNotification() {}
 void OnVehicleDataNotification::Run() {
   SDL_LOG_AUTO_TRACE();
 
-  std::vector<ApplicationSharedPtr> notify_apps;
-  std::vector<ApplicationSharedPtr>::iterator notified_app_it =
-      notify_apps.begin();
-  std::vector<smart_objects::SmartObject> appSO;
-
   custom_vehicle_data_manager_.CreateMobileMessageParams(
       (*message_)[strings::msg_params]);
 
+  typedef std::map<const Application*, RPCParams> AppsParams;
+  AppsParams subscribed_apps_params;
+
   const auto& param_names = (*message_)[strings::msg_params].enumerate();
   for (const auto& name : param_names) {
     SDL_LOG_DEBUG("vehicle_data name: " << name);
     auto vehicle_data_value = (*message_)[strings::msg_params][name].asInt();
     application_manager_.IviInfoUpdated(name, vehicle_data_value);
 
-    auto subscribed_to_ivi_predicate = [&name](const ApplicationSharedPtr app) {
-      DCHECK_OR_RETURN(app, false);
-      auto& ext = VehicleInfoAppExtension::ExtractVIExtension(*app);
-      return ext.isSubscribedToVehicleInfo(name);
-    };
-
-    const auto& applications = application_manager::FindAllApps(
-        application_manager_.applications(), subscribed_to_ivi_predicate);
-    for (const auto& app : applications) {
-      if (!app) {
-        SDL_LOG_ERROR("NULL pointer");
-        continue;
-      }
-      notified_app_it = find(notify_apps.begin(), notify_apps.end(), app);
-      if (notified_app_it == notify_apps.end()) {
-        notify_apps.push_back(app);
-        smart_objects::SmartObject msg_param =
-            smart_objects::SmartObject(smart_objects::SmartType_Map);
-        msg_param[name] = (*message_)[strings::msg_params][name];
-        appSO.push_back(msg_param);
-      } else {
-        size_t idx = std::distance(notify_apps.begin(), notified_app_it);
-        appSO[idx][name] = (*message_)[strings::msg_params][name];
+    const auto subscribed_apps =
+        VehicleInfoAppExtension::SubscribedApps(name);
+    for (const auto app : subscribed_apps) {
+      subscribed_apps_params[app].insert(name);
+    }
+  }
+
+  if (subscribed_apps_params.empty()) {
+    SDL_LOG_DEBUG("There are no applications subscribed to vehicle data");
+    return;
+  }
+
+  std::vector<std::pair<ApplicationSharedPtr, const RPCParams*> >
+      subscribed_apps;
+  {
+    auto applications = application_manager_.applications();
+    for (const auto& app : applications.GetData()) {
+      auto app_params = subscribed_apps_params.find(app.get());
+      if (subscribed_apps_params.end() != app_params) {
+        subscribed_apps.push_back(std::make_pair(app, &app_params->second));
       }
     }
   }
 
-  for (size_t idx = 0; idx < notify_apps.size(); ++idx) {
-    CommandParametersPermissions params_permissions;
-    application_manager_.CheckPolicyPermissions(
-        notify_apps[idx],
-        window_id(),
-        MessageHelper::StringifiedFunctionID(
-            mobile_api::FunctionID::OnVehicleDataID),
-        appSO[idx].enumerate(),
-        &params_permissions);
-    if (params_permissions.allowed_params.empty() &&
-        params_permissions.disallowed_params.empty() &&
-        params_permissions.undefined_params.empty()) {
+  // Applications allowed to receive the same set of parameters share
+  // the same notification payload
+  typedef std::map<RPCParams, std::vector<ApplicationSharedPtr> > Payloads;
+  Payloads payloads;
+
+  const std::string function_id = MessageHelper::StringifiedFunctionID(
+      mobile_api::FunctionID::OnVehicleDataID);
+  for (const auto& subscribed_app : subscribed_apps) {
+    const ApplicationSharedPtr& app = subscribed_app.first;
+    const RPCParams& requested_params = *subscribed_app.second;
+
+    auto& ext = VehicleInfoAppExtension::ExtractVIExtension(*app);
+    auto permissions_provider =
+        [this, &app, &function_id, &requested_params](
+            CommandParametersPermissions& params_permissions) {
+          application_manager_.CheckPolicyPermissions(app,
+                                                      window_id(),
+                                                      function_id,
+                                                      requested_params,
+                                                      &params_permissions);
+        };
+    const auto params_permissions = ext.OnVehicleDataPermissions(
+        app->hmi_level(window_id()), requested_params, permissions_provider);
+
+    RPCParams allowed_params;
+    if (params_permissions->allowed_params.empty() &&
+        params_permissions->disallowed_params.empty() &&
+        params_permissions->undefined_params.empty()) {
       SDL_LOG_DEBUG(
           "No parameter permissions provided, all params are allowed");
+      allowed_params = requested_params;
     } else {
-      for (const auto& param : appSO[idx].enumerate()) {
-        const auto& allowed_params = params_permissions.allowed_params;
-        auto param_allowed = allowed_params.find(param);
-        if (allowed_params.end() == param_allowed) {
+      const auto& policy_allowed_params = params_permissions->allowed_params;
+      for (const auto& param : requested_params) {
+        if (policy_allowed_params.end() == policy_allowed_params.find(param)) {
           SDL_LOG_DEBUG("Param " << param
                                  << " is not allowed by policy for app "
-                                 << notify_apps[idx]->app_id()
-                                 << ". It will be ignored.");
-          appSO[idx].erase(param);
+                                 << app->app_id() << ". It will be ignored.");
+          continue;
         }
+        allowed_params.insert(param);
       }
     }
 
-    if (appSO[idx].empty()) {
-      SDL_LOG_DEBUG("App " << notify_apps[idx]->app_id()
+    if (allowed_params.empty()) {
+      SDL_LOG_DEBUG("App " << app->app_id()
                            << " will be skipped: there is nothing to notify.");
       continue;
     }
 
-    SDL_LOG_INFO("Send OnVehicleData notification to "
-                 << notify_apps[idx]->name().c_str() << " application id "
-                 << notify_apps[idx]->app_id());
-    (*message_)[strings::params][strings::connection_key] =
-        notify_apps[idx]->app_id();
-    (*message_)[strings::msg_params] = appSO[idx];
-    SendNotification();
+    payloads[allowed_params].push_back(app);
+  }
+
+  const smart_objects::SmartObject vehicle_data(
+      std::move((*message_)[strings::msg_params]));
+  for (const auto& payload : payloads) {
+    smart_objects::SmartObject msg_params =
+        smart_objects::SmartObject(smart_objects::SmartType_Map);
+    for (const auto& param : payload.first) {
+      msg_params[param] = vehicle_data[param];
+    }
+    (*message_)[strings::msg_params] = std::move(msg_params);
+
+    for (const auto& app : payload.second) {
+      SDL_LOG_INFO("Send OnVehicleData notification to "
+                   << app->name().c_str() << " application id "
+                   << app->app_id());
+      (*message_)[strings::params][strings::connection_key] = app->app_id();
+      SendNotification();
+    }
   }
 }
 
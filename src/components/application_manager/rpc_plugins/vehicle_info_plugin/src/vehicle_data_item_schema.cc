@@ -98,10 +98,12 @@ vehicle_info_plugin::VehicleDataItemSchema::validate(
     const utils::SemanticVersion& MessageVersion,
     const bool allow_unknown_enums) {
   if (!so_schema_item_) {
-    std::string validation_info =
-        "Invalid type: " +
-        smart_objects::SmartObject::typeToString(Object.getType());
-    report__->set_validation_info(validation_info);
+    if (report__) {
+      std::string validation_info =
+          "Invalid type: " +
+          smart_objects::SmartObject::typeToString(Object.getType());
+      report__->set_validation_info(validation_info);
+    }
     return smart_objects::errors::eType::ERROR;
   }
 
@@ -31,6 +31,10 @@
  */
 
 #include "vehicle_info_plugin/vehicle_info_app_extension.h"
+
+#include <atomic>
+#include <unordered_map>
+
 #include "vehicle_info_plugin/vehicle_info_plugin.h"
 
 SDL_CREATE_LOG_VARIABLE("VehicleInfoPlugin")
@@ -38,6 +42,55 @@ SDL_CREATE_LOG_VARIABLE("VehicleInfoPlugin")
 namespace vehicle_info_plugin {
 namespace strings = application_manager::strings;
 
+namespace {
+/**
+ * @brief Reverse index of vehicle data subscriptions of all extensions
+ */
+struct SubscribersIndex {
+  sync_primitives::Lock lock_;
+  std::unordered_map<std::string, std::set<const app_mngr::Application*> >
+      apps_;
+};
+
+SubscribersIndex& subscribers_index() {
+  static SubscribersIndex index;
+  return index;
+}
+
+void AddSubscriber(const std::string& vehicle_data,
+                   const app_mngr::Application* app) {
+  auto& index = subscribers_index();
+  sync_primitives::AutoLock lock(index.lock_);
+  index.apps_[vehicle_data].insert(app);
+}
+
+void RemoveSubscriber(const std::string& vehicle_data,
+                      const app_mngr::Application* app) {
+  auto& index = subscribers_index();
+  sync_primitives::AutoLock lock(index.lock_);
+  auto it = index.apps_.find(vehicle_data);
+  if (index.apps_.end() == it) {
+    return;
+  }
+  it->second.erase(app);
+  if (it->second.empty()) {
+    index.apps_.erase(it);
+  }
+}
+
+/**
+ * @brief Incremented on each policy permissions change, cached permissions
+ * of previous generations are considered outdated
+ */
+std::atomic<uint32_t> permissions_generation(0);
+
+/**
+ * @brief Limit of cached permissions per extension. Notifications usually
+ * come with a few parameters combinations, so it is not reached in practice
+ */
+const size_t kMaxCachedPermissions = 32u;
+}  // namespace
+
 unsigned VehicleInfoAppExtension::VehicleInfoAppExtensionUID = 146;
 
 VehicleInfoAppExtension::VehicleInfoAppExtension(
@@ -53,13 +106,18 @@ VehicleInfoAppExtension::VehicleInfoAppExtension(
 
 VehicleInfoAppExtension::~VehicleInfoAppExtension() {
   SDL_LOG_AUTO_TRACE();
+  unsubscribeFromVehicleInfo();
 }
 
 bool VehicleInfoAppExtension::subscribeToVehicleInfo(
     const std::string& vehicle_data) {
   SDL_LOG_DEBUG(vehicle_data);
   sync_primitives::AutoLock lock(*subscribed_data_lock_);
-  return subscribed_data_.insert(vehicle_data).second;
+  if (!subscribed_data_.insert(vehicle_data).second) {
+    return false;
+  }
+  AddSubscriber(vehicle_data, &app_);
+  return true;
 }
 
 bool VehicleInfoAppExtension::unsubscribeFromVehicleInfo(
@@ -69,6 +127,7 @@ bool VehicleInfoAppExtension::unsubscribeFromVehicleInfo(
   auto it = subscribed_data_.find(vehicle_data);
   if (it != subscribed_data_.end()) {
     subscribed_data_.erase(it);
+    RemoveSubscriber(vehicle_data, &app_);
     return true;
   }
   return false;
@@ -77,6 +136,9 @@ bool VehicleInfoAppExtension::unsubscribeFromVehicleInfo(
 void VehicleInfoAppExtension::unsubscribeFromVehicleInfo() {
   SDL_LOG_AUTO_TRACE();
   sync_primitives::AutoLock lock(*subscribed_data_lock_);
+  for (const auto& vehicle_data : subscribed_data_) {
+    RemoveSubscriber(vehicle_data, &app_);
+  }
   subscribed_data_.clear();
 }
 
@@ -209,4 +271,52 @@ VehicleInfoAppExtension& VehicleInfoAppExtension::ExtractVIExtension(
   DCHECK(vi_app_extension);
   return *vi_app_extension;
 }
+
+VehicleInfoSubscribers VehicleInfoAppExtension::SubscribedApps(
+    const std::string& vehicle_data) {
+  auto& index = subscribers_index();
+  sync_primitives::AutoLock lock(index.lock_);
+  auto it = index.apps_.find(vehicle_data);
+  if (index.apps_.end() == it) {
+    return VehicleInfoSubscribers();
+  }
+  return VehicleInfoSubscribers(it->second.begin(), it->second.end());
+}
+
+ParamsPermissionsPtr VehicleInfoAppExtension::OnVehicleDataPermissions(
+    const mobile_apis::HMILevel::eType hmi_level,
+    const app_mngr::RPCParams& requested_params,
+    const ParamsPermissionsProvider& provider) {
+  // Generation is taken before policy request, so permissions change
+  // happened during the request invalidates result right away
+  const uint32_t generation = permissions_generation.load();
+  const PermissionsKey key(hmi_level, requested_params);
+  {
+    sync_primitives::AutoLock lock(permissions_cache_lock_);
+    auto it = permissions_cache_.find(key);
+    if (permissions_cache_.end() != it &&
+        generation == it->second.generation_) {
+      return it->second.permissions_;
+    }
+  }
+
+  auto permissions =
+      std::make_shared<app_mngr::CommandParametersPermissions>();
+  provider(*permissions);
+
+  sync_primitives::AutoLock lock(permissions_cache_lock_);
+  if (permissions_cache_.size() >= kMaxCachedPermissions) {
+    // Too many parameters combinations, start over
+    permissions_cache_.clear();
+  }
+  CachedPermissions& cached = permissions_cache_[key];
+  cached.generation_ = generation;
+  cached.permissions_ = permissions;
+  return permissions;
+}
+
+void VehicleInfoAppExtension::ResetPermissionsCache() {
+  SDL_LOG_AUTO_TRACE();
+  ++permissions_generation;
+}
 }  // namespace vehicle_info_plugin
@@ -64,7 +64,15 @@ bool IsSubscribedAppExist(
 }
 
 VehicleInfoPlugin::VehicleInfoPlugin()
-    : application_manager_(nullptr), pending_resumption_handler_(nullptr) {}
+    : application_manager_(nullptr)
+    , policy_handler_(nullptr)
+    , pending_resumption_handler_(nullptr) {}
+
+VehicleInfoPlugin::~VehicleInfoPlugin() {
+  if (policy_handler_) {
+    policy_handler_->remove_listener(this);
+  }
+}
 
 bool VehicleInfoPlugin::Init(
     application_manager::ApplicationManager& app_manager,
@@ -74,6 +82,11 @@ bool VehicleInfoPlugin::Init(
     resumption::LastStateWrapperPtr last_state) {
   UNUSED(last_state);
   application_manager_ = &app_manager;
+  if (policy_handler_) {
+    policy_handler_->remove_listener(this);
+  }
+  policy_handler_ = &policy_handler;
+  policy_handler_->add_listener(this);
   custom_vehicle_data_manager_.reset(
       new CustomVehicleDataManagerImpl(policy_handler, rpc_service));
   pending_resumption_handler_ =
@@ -102,6 +115,7 @@ app_mngr::CommandFactory& VehicleInfoPlugin::GetCommandFactory() {
 }
 
 void VehicleInfoPlugin::OnPolicyEvent(plugins::PolicyEvent event) {
+  VehicleInfoAppExtension::ResetPermissionsCache();
   UnsubscribeFromRemovedVDItems();
   custom_vehicle_data_manager_->OnPolicyEvent(event);
 }
@@ -119,6 +133,12 @@ void VehicleInfoPlugin::OnApplicationEvent(
   }
 }
 
+void VehicleInfoPlugin::OnPermissionsUpdated(
+    const std::string& policy_app_id) {
+  SDL_LOG_DEBUG("Permissions of " << policy_app_id << " have been updated");
+  VehicleInfoAppExtension::ResetPermissionsCache();
+}
+
 void VehicleInfoPlugin::UnsubscribeFromRemovedVDItems() {
   SDL_LOG_AUTO_TRACE();
   typedef std::vector<std::string> StringsVector;
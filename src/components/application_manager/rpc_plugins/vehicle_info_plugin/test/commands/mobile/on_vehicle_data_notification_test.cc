@@ -31,6 +31,8 @@
  */
 
 #include <strings.h>
+#include <algorithm>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "mobile/on_vehicle_data_notification.h"
@@ -57,6 +59,7 @@ namespace am = ::application_manager;
 
 using ::testing::_;
 using ::testing::ContainerEq;
+using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::ReturnRef;
 using ::testing::SetArgPointee;
@@ -71,6 +74,7 @@ typedef DataAccessor<application_manager::ApplicationSet> ApplicationSetDA;
 
 namespace {
 const uint32_t kAppId = 1u;
+const uint32_t kSecondAppId = 2u;
 const utils::custom_string::CustomString kAppName("test_app");
 }  // namespace
 
@@ -87,7 +91,27 @@ class OnVehicleDataNotificationTest
     ON_CALL(mock_message_helper_, PrintSmartObject(_))
         .WillByDefault(Return(false));
   }
+
+  VehicleInfoAppExtensionPtr CreateExtension(MockAppPtr app) {
+    auto ext_ptr =
+        std::make_shared<vehicle_info_plugin::VehicleInfoAppExtension>(
+            vi_plugin_, *app);
+    ON_CALL(*app,
+            QueryInterface(vehicle_info_plugin::VehicleInfoAppExtension::
+                               VehicleInfoAppExtensionUID))
+        .WillByDefault(Return(ext_ptr));
+    return ext_ptr;
+  }
+
+  MessageSharedPtr CreateSpeedAndRpmMessage() {
+    MessageSharedPtr message(CreateMessage(smart_objects::SmartType_Map));
+    (*message)[am::strings::msg_params][am::strings::speed] = 10;
+    (*message)[am::strings::msg_params][am::strings::rpm] = 1000;
+    return message;
+  }
+
   MockAppPtr mock_app_;
+  vehicle_info_plugin::VehicleInfoPlugin vi_plugin_;
 };
 
 MATCHER_P(SmartObjectCheck, checker, "") {
@@ -145,6 +169,201 @@ TEST_F(OnVehicleDataNotificationTest, OnVehicleDataNotification_SUCCESS) {
   command->Run();
 }
 
+TEST_F(OnVehicleDataNotificationTest,
+       OnVehicleDataNotification_NotSubscribedApp_NotNotified) {
+  application_manager::ApplicationSet apps;
+  apps.insert(mock_app_);
+  std::shared_ptr<sync_primitives::Lock> apps_lock =
+      std::make_shared<sync_primitives::Lock>();
+  ApplicationSetDA apps_da(apps, apps_lock);
+  ON_CALL(app_mngr_, applications()).WillByDefault(Return(apps_da));
+
+  auto ext = CreateExtension(mock_app_);
+  ext->subscribeToVehicleInfo(am::strings::gps);
+  ext->subscribeToVehicleInfo(am::strings::speed);
+  ext->unsubscribeFromVehicleInfo(am::strings::speed);
+
+  EXPECT_CALL(app_mngr_, CheckPolicyPermissions(_, _, _, _, _)).Times(0);
+  EXPECT_CALL(mock_rpc_service_, SendMessageToMobile(_, _)).Times(0);
+
+  MessageSharedPtr message(CreateMessage(smart_objects::SmartType_Map));
+  (*message)[am::strings::msg_params][am::strings::speed] = 0;
+  NotificationPtr command(CreateCommandVI<OnVehicleDataNotification>(message));
+  command->Run();
+}
+
+TEST_F(OnVehicleDataNotificationTest,
+       OnVehicleDataNotification_DisallowedParamIsFilteredOut) {
+  application_manager::ApplicationSet apps;
+  apps.insert(mock_app_);
+  std::shared_ptr<sync_primitives::Lock> apps_lock =
+      std::make_shared<sync_primitives::Lock>();
+  ApplicationSetDA apps_da(apps, apps_lock);
+  ON_CALL(app_mngr_, applications()).WillByDefault(Return(apps_da));
+
+  auto ext = CreateExtension(mock_app_);
+  ext->subscribeToVehicleInfo(am::strings::speed);
+  ext->subscribeToVehicleInfo(am::strings::rpm);
+
+  am::CommandParametersPermissions params_permissions;
+  params_permissions.allowed_params.insert(am::strings::speed);
+  params_permissions.disallowed_params.insert(am::strings::rpm);
+  EXPECT_CALL(app_mngr_, CheckPolicyPermissions(_, _, _, _, _))
+      .WillOnce(DoAll(SetArgPointee<4>(params_permissions),
+                      Return(mobile_apis::Result::SUCCESS)));
+
+  auto only_speed = [](const MessageSharedPtr& msg) {
+    const auto& msg_params = (*msg)[am::strings::msg_params];
+    return msg_params.keyExists(am::strings::speed) &&
+           !msg_params.keyExists(am::strings::rpm);
+  };
+  EXPECT_CALL(mock_rpc_service_,
+              SendMessageToMobile(SmartObjectCheck(only_speed), _));
+
+  MessageSharedPtr message = CreateSpeedAndRpmMessage();
+  NotificationPtr command(CreateCommandVI<OnVehicleDataNotification>(message));
+  command->Run();
+}
+
+TEST_F(OnVehicleDataNotificationTest,
+       OnVehicleDataNotification_PermissionsCachedPerHmiLevel) {
+  application_manager::ApplicationSet apps;
+  apps.insert(mock_app_);
+  std::shared_ptr<sync_primitives::Lock> apps_lock =
+      std::make_shared<sync_primitives::Lock>();
+  ApplicationSetDA apps_da(apps, apps_lock);
+  ON_CALL(app_mngr_, applications()).WillByDefault(Return(apps_da));
+  ON_CALL(*mock_app_, hmi_level(_))
+      .WillByDefault(Return(mobile_apis::HMILevel::HMI_FULL));
+
+  auto ext = CreateExtension(mock_app_);
+  ext->subscribeToVehicleInfo(am::strings::speed);
+
+  EXPECT_CALL(app_mngr_, CheckPolicyPermissions(_, _, _, _, _))
+      .WillOnce(Return(mobile_apis::Result::SUCCESS));
+  EXPECT_CALL(mock_rpc_service_, SendMessageToMobile(_, _)).Times(2);
+  for (int i = 0; i < 2; ++i) {
+    MessageSharedPtr message = CreateSpeedAndRpmMessage();
+    CreateCommandVI<OnVehicleDataNotification>(message)->Run();
+  }
+
+  // Another HMI level requires new policy check
+  ON_CALL(*mock_app_, hmi_level(_))
+      .WillByDefault(Return(mobile_apis::HMILevel::HMI_BACKGROUND));
+  EXPECT_CALL(app_mngr_, CheckPolicyPermissions(_, _, _, _, _))
+      .WillOnce(Return(mobile_apis::Result::SUCCESS));
+  MessageSharedPtr message = CreateSpeedAndRpmMessage();
+  CreateCommandVI<OnVehicleDataNotification>(message)->Run();
+
+  // Policy permissions change invalidates cached permissions
+  vi_plugin_.OnPermissionsUpdated("policy_app_id");
+  EXPECT_CALL(app_mngr_, CheckPolicyPermissions(_, _, _, _, _))
+      .WillOnce(Return(mobile_apis::Result::SUCCESS));
+  message = CreateSpeedAndRpmMessage();
+  CreateCommandVI<OnVehicleDataNotification>(message)->Run();
+}
+
+TEST_F(OnVehicleDataNotificationTest,
+       OnVehicleDataNotification_DifferentParams_PermissionsNotShared) {
+  application_manager::ApplicationSet apps;
+  apps.insert(mock_app_);
+  std::shared_ptr<sync_primitives::Lock> apps_lock =
+      std::make_shared<sync_primitives::Lock>();
+  ApplicationSetDA apps_da(apps, apps_lock);
+  ON_CALL(app_mngr_, applications()).WillByDefault(Return(apps_da));
+  ON_CALL(*mock_app_, hmi_level(_))
+      .WillByDefault(Return(mobile_apis::HMILevel::HMI_FULL));
+
+  auto ext = CreateExtension(mock_app_);
+  ext->subscribeToVehicleInfo(am::strings::speed);
+  ext->subscribeToVehicleInfo(am::strings::rpm);
+
+  // Policy echoes requested parameters when all of them are allowed
+  auto echo_params = [](const am::ApplicationSharedPtr,
+                        const am::WindowID,
+                        const std::string&,
+                        const am::RPCParams& rpc_params,
+                        am::CommandParametersPermissions* permissions) {
+    permissions->allowed_params = rpc_params;
+    return mobile_apis::Result::SUCCESS;
+  };
+  EXPECT_CALL(app_mngr_, CheckPolicyPermissions(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(Invoke(echo_params));
+
+  auto only_speed = [](const MessageSharedPtr& msg) {
+    const auto& msg_params = (*msg)[am::strings::msg_params];
+    return 1u == msg_params.length() &&
+           msg_params.keyExists(am::strings::speed);
+  };
+  auto only_rpm = [](const MessageSharedPtr& msg) {
+    const auto& msg_params = (*msg)[am::strings::msg_params];
+    return 1u == msg_params.length() && msg_params.keyExists(am::strings::rpm);
+  };
+  EXPECT_CALL(mock_rpc_service_,
+              SendMessageToMobile(SmartObjectCheck(only_speed), _));
+  EXPECT_CALL(mock_rpc_service_,
+              SendMessageToMobile(SmartObjectCheck(only_rpm), _));
+
+  MessageSharedPtr message(CreateMessage(smart_objects::SmartType_Map));
+  (*message)[am::strings::msg_params][am::strings::speed] = 10;
+  CreateCommandVI<OnVehicleDataNotification>(message)->Run();
+
+  message = CreateMessage(smart_objects::SmartType_Map);
+  (*message)[am::strings::msg_params][am::strings::rpm] = 1000;
+  CreateCommandVI<OnVehicleDataNotification>(message)->Run();
+}
+
+TEST_F(OnVehicleDataNotificationTest,
+       OnVehicleDataNotification_AppsWithSameParams_ShareSamePayload) {
+  MockAppPtr second_app = CreateMockApp();
+  ON_CALL(*second_app, app_id()).WillByDefault(Return(kSecondAppId));
+  ON_CALL(*second_app, name()).WillByDefault(ReturnRef(kAppName));
+
+  application_manager::ApplicationSet apps;
+  apps.insert(mock_app_);
+  apps.insert(second_app);
+  std::shared_ptr<sync_primitives::Lock> apps_lock =
+      std::make_shared<sync_primitives::Lock>();
+  ApplicationSetDA apps_da(apps, apps_lock);
+  ON_CALL(app_mngr_, applications()).WillByDefault(Return(apps_da));
+
+  auto first_ext = CreateExtension(mock_app_);
+  first_ext->subscribeToVehicleInfo(am::strings::speed);
+  first_ext->subscribeToVehicleInfo(am::strings::rpm);
+  auto second_ext = CreateExtension(second_app);
+  second_ext->subscribeToVehicleInfo(am::strings::speed);
+
+  am::CommandParametersPermissions params_permissions;
+  params_permissions.allowed_params.insert(am::strings::speed);
+  EXPECT_CALL(app_mngr_, CheckPolicyPermissions(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(DoAll(SetArgPointee<4>(params_permissions),
+                            Return(mobile_apis::Result::SUCCESS)));
+
+  auto only_speed = [](const MessageSharedPtr& msg) {
+    const auto& msg_params = (*msg)[am::strings::msg_params];
+    return 1u == msg_params.length() &&
+           msg_params.keyExists(am::strings::speed);
+  };
+  std::vector<uint32_t> notified_apps;
+  auto save_app_id = [&notified_apps](const MessageSharedPtr msg, bool) {
+    notified_apps.push_back(
+        (*msg)[am::strings::params][am::strings::connection_key].asUInt());
+  };
+  EXPECT_CALL(mock_rpc_service_,
+              SendMessageToMobile(SmartObjectCheck(only_speed), _))
+      .Times(2)
+      .WillRepeatedly(Invoke(save_app_id));
+
+  MessageSharedPtr message = CreateSpeedAndRpmMessage();
+  NotificationPtr command(CreateCommandVI<OnVehicleDataNotification>(message));
+  command->Run();
+
+  std::sort(notified_apps.begin(), notified_apps.end());
+  EXPECT_EQ(std::vector<uint32_t>({kAppId, kSecondAppId}), notified_apps);
+}
+
 }  // namespace on_vehicle_data_notification
 }  // namespace mobile_commands_test
 }  // namespace commands_test
@@ -278,23 +278,17 @@ ApplicationManagerImpl::reregister_applications() const {
 
 ApplicationSharedPtr ApplicationManagerImpl::application(
     uint32_t app_id) const {
-  AppIdPredicate finder(app_id);
-  DataAccessor<ApplicationSet> accessor = applications();
-  return FindApp(accessor, finder);
+  return applications_registry_.snapshot()->FindByAppId(app_id);
 }
 
 ApplicationSharedPtr ApplicationManagerImpl::application_by_hmi_app(
     uint32_t hmi_app_id) const {
-  HmiAppIdPredicate finder(hmi_app_id);
-  DataAccessor<ApplicationSet> accessor = applications();
-  return FindApp(accessor, finder);
+  return applications_registry_.snapshot()->FindByHmiAppId(hmi_app_id);
 }
 
 ApplicationSharedPtr ApplicationManagerImpl::application_by_policy_id(
     const std::string& policy_app_id) const {
-  PolicyAppIdPredicate finder(policy_app_id);
-  DataAccessor<ApplicationSet> accessor = applications();
-  return FindApp(accessor, finder);
+  return applications_registry_.snapshot()->FindByPolicyAppId(policy_app_id);
 }
 
 ApplicationSharedPtr ApplicationManagerImpl::pending_application_by_policy_id(
@@ -423,19 +417,6 @@ std::vector<ApplicationSharedPtr> ApplicationManagerImpl::applications_by_name(
   return FindAllApps(accessor, finder);
 }
 
-struct IsApplication {
-  IsApplication(connection_handler::DeviceHandle device_handle,
-                const std::string& policy_app_id)
-      : device_handle_(device_handle), policy_app_id_(policy_app_id) {}
-  bool operator()(const ApplicationSharedPtr app) const {
-    return app && app->device() == device_handle_ &&
-           app->policy_app_id() == policy_app_id_;
-  }
-
- private:
-  connection_handler::DeviceHandle device_handle_;
-  const std::string& policy_app_id_;
-};
 void ApplicationManagerImpl::IviInfoUpdated(const std::string& vehicle_info,
                                             int value) {
   // Notify Policy Manager if available about info it's interested in,
@@ -1772,6 +1753,7 @@ void ApplicationManagerImpl::SwitchApplication(ApplicationSharedPtr app,
   // Application need to be re-inserted in order to keep sorting in applications
   // container. Otherwise data loss on erasing is possible.
   applications_.insert(app);
+  applications_registry_.Publish(applications_);
 }
 
 mobile_apis::HMILevel::eType ApplicationManagerImpl::GetDefaultHmiLevel(
@@ -2789,8 +2771,8 @@ void ApplicationManagerImpl::PullLanguagesInfo(const SmartObject& app_data,
   }
 }
 
-void ApplicationManagerImpl::CreateApplications(SmartArray& obj_array,
-                                                const uint32_t connection_key) {
+void ApplicationManagerImpl::CreateApplications(
+    const SmartArray& obj_array, const uint32_t connection_key) {
   SDL_LOG_AUTO_TRACE();
   using namespace policy;
 
@@ -2900,7 +2882,7 @@ void ApplicationManagerImpl::ProcessQueryApp(
     return;
   }
 
-  SmartArray* obj_array = sm_object[json::response].asArray();
+  const SmartArray* obj_array = sm_object[json::response].asArray();
   if (NULL != obj_array) {
     CreateApplications(*obj_array, connection_key);
     SendUpdateAppList();
@@ -3267,6 +3249,7 @@ void ApplicationManagerImpl::UnregisterApplication(
       if (app_id == (*it_app)->app_id()) {
         app_to_remove = *it_app;
         applications_.erase(it_app++);
+        applications_registry_.Publish(applications_);
         break;
       } else {
         ++it_app;
@@ -4612,6 +4595,7 @@ void ApplicationManagerImpl::AddAppToRegisteredAppList(
   // Add application to registered app list and set appropriate mark.
   application->MarkRegistered();
   applications_.insert(application);
+  applications_registry_.Publish(applications_);
   SDL_LOG_DEBUG("App with app_id: "
                 << application->app_id()
                 << " has been added to registered applications list");
@@ -4924,6 +4908,7 @@ bool ApplicationManagerImpl::UnsubscribeAppFromSoftButtons(
 void ApplicationManagerImpl::AddMockApplication(ApplicationSharedPtr mock_app) {
   applications_list_lock_ptr_->Acquire();
   applications_.insert(mock_app);
+  applications_registry_.Publish(applications_);
   apps_size_ = applications_.size();
   applications_list_lock_ptr_->Release();
 }
@@ -4971,9 +4956,9 @@ ApplicationSharedPtr ApplicationManagerImpl::application(
     return ApplicationSharedPtr();
   }
 
-  DataAccessor<ApplicationSet> accessor = applications();
   ApplicationSharedPtr app =
-      FindApp(accessor, IsApplication(device_handle, policy_app_id));
+      applications_registry_.snapshot()->FindByDeviceAndPolicyAppId(
+          device_handle, policy_app_id);
 
   SDL_LOG_DEBUG(" policy_app_id << " << policy_app_id << "Found = " << app);
   return app;
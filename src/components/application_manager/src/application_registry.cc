@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "application_manager/application_registry.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace application_manager {
+
+ApplicationRegistry::Snapshot::Snapshot(const ApplicationSet& applications)
+    : applications_(applications.begin(), applications.end()) {
+  by_app_id_.reserve(applications_.size());
+  by_hmi_app_id_.reserve(applications_.size());
+  by_policy_app_id_.reserve(applications_.size());
+  for (size_t i = 0; i < applications_.size(); ++i) {
+    const ApplicationSharedPtr& app = applications_[i];
+    if (!app) {
+      continue;
+    }
+    // Only first application with the key is indexed, same one
+    // the scan of applications would find
+    by_app_id_.insert(std::make_pair(app->app_id(), i));
+    by_hmi_app_id_.insert(std::make_pair(app->hmi_app_id(), i));
+    by_policy_app_id_.insert(std::make_pair(app->policy_app_id(), i));
+    by_device_[app->device()].push_back(i);
+  }
+}
+
+template <typename Index, typename Key, typename Predicate>
+ApplicationSharedPtr ApplicationRegistry::Snapshot::Find(
+    const Index& index, const Key& key, Predicate predicate) const {
+  const typename Index::const_iterator it = index.find(key);
+  if (index.end() != it && predicate(applications_[it->second])) {
+    return applications_[it->second];
+  }
+  const std::vector<ApplicationSharedPtr>::const_iterator found =
+      std::find_if(applications_.begin(), applications_.end(), predicate);
+  return applications_.end() == found ? ApplicationSharedPtr() : *found;
+}
+
+ApplicationSharedPtr ApplicationRegistry::Snapshot::FindByAppId(
+    const uint32_t app_id) const {
+  return Find(by_app_id_, app_id, [app_id](const ApplicationSharedPtr& app) {
+    return app && app_id == app->app_id();
+  });
+}
+
+ApplicationSharedPtr ApplicationRegistry::Snapshot::FindByHmiAppId(
+    const uint32_t hmi_app_id) const {
+  return Find(by_hmi_app_id_,
+              hmi_app_id,
+              [hmi_app_id](const ApplicationSharedPtr& app) {
+                return app && hmi_app_id == app->hmi_app_id();
+              });
+}
+
+ApplicationSharedPtr ApplicationRegistry::Snapshot::FindByPolicyAppId(
+    const std::string& policy_app_id) const {
+  return Find(by_policy_app_id_,
+              policy_app_id,
+              [&policy_app_id](const ApplicationSharedPtr& app) {
+                return app && policy_app_id == app->policy_app_id();
+              });
+}
+
+ApplicationSharedPtr ApplicationRegistry::Snapshot::FindByDeviceAndPolicyAppId(
+    const connection_handler::DeviceHandle device,
+    const std::string& policy_app_id) const {
+  auto predicate = [device, &policy_app_id](const ApplicationSharedPtr& app) {
+    return app && app->device() == device &&
+           app->policy_app_id() == policy_app_id;
+  };
+  const DeviceIndex::const_iterator device_apps = by_device_.find(device);
+  if (by_device_.end() != device_apps) {
+    for (std::vector<size_t>::const_iterator it = device_apps->second.begin();
+         it != device_apps->second.end();
+         ++it) {
+      if (predicate(applications_[*it])) {
+        return applications_[*it];
+      }
+    }
+  }
+  const std::vector<ApplicationSharedPtr>::const_iterator found =
+      std::find_if(applications_.begin(), applications_.end(), predicate);
+  return applications_.end() == found ? ApplicationSharedPtr() : *found;
+}
+
+ApplicationRegistry::ApplicationRegistry()
+    : snapshot_(std::make_shared<Snapshot>(ApplicationSet())) {}
+
+ApplicationRegistry::SnapshotPtr ApplicationRegistry::snapshot() const {
+  return std::atomic_load(&snapshot_);
+}
+
+void ApplicationRegistry::Publish(const ApplicationSet& applications) {
+  const SnapshotPtr snapshot = std::make_shared<Snapshot>(applications);
+  std::atomic_store(&snapshot_, snapshot);
+}
+
+}  // namespace application_manager
@@ -39,116 +39,71 @@ namespace application_manager {
 namespace event_engine {
 using namespace sync_primitives;
 
-EventDispatcherImpl::EventDispatcherImpl() : observers_event_() {}
+EventDispatcherImpl::EventDispatcherImpl() {}
 
 EventDispatcherImpl::~EventDispatcherImpl() {}
 
 void EventDispatcherImpl::raise_event(const Event& event) {
-  ObserverVector observers;
-  AutoLock observer_lock(observer_lock_);
-  {
-    AutoLock state_lock(state_lock_);
-
-    // check if event is notification
-    if (hmi_apis::messageType::notification == event.smart_object_type()) {
-      const uint32_t notification_correlation_id = 0;
-      observers = observers_event_[event.id()][notification_correlation_id];
-    }
+  ObserverVectorPtr observers;
 
-    if (hmi_apis::messageType::response == event.smart_object_type() ||
-        hmi_apis::messageType::error_response == event.smart_object_type()) {
-      observers =
-          observers_event_[event.id()][event.smart_object_correlation_id()];
-    }
+  // check if event is notification
+  if (hmi_apis::messageType::notification == event.smart_object_type()) {
+    const uint32_t notification_correlation_id = 0;
+    observers = observers_.Find(event.id(), notification_correlation_id);
+  }
+
+  if (hmi_apis::messageType::response == event.smart_object_type() ||
+      hmi_apis::messageType::error_response == event.smart_object_type()) {
+    observers =
+        observers_.Find(event.id(), event.smart_object_correlation_id());
   }
 
-  while (!observers.empty()) {
-    EventObserver* temp = *observers.begin();
-    observers.erase(observers.begin());
-    AutoUnlock unlock_observer(observer_lock);
-    temp->on_event(event);
+  if (!observers) {
+    return;
+  }
+  for (EventObserver* observer : *observers) {
+    observer->on_event(event);
   }
 }
 
 void EventDispatcherImpl::add_observer(const Event::EventID& event_id,
                                        int32_t hmi_correlation_id,
                                        EventObserver& observer) {
-  AutoLock auto_lock(state_lock_);
-  observers_event_[event_id][hmi_correlation_id].push_back(&observer);
+  observers_.Add(event_id, hmi_correlation_id, &observer);
 }
 
-struct IdCheckFunctor {
-  explicit IdCheckFunctor(const unsigned long id) : target_id(id) {}
-
-  bool operator()(const EventObserver* obs) const {
-    return (obs->id() == target_id);
-  }
-
- private:
-  const unsigned long target_id;
-};
-
 void EventDispatcherImpl::remove_observer(const Event::EventID& event_id,
                                           EventObserver& observer) {
-  remove_observer_from_vector(observer);
-  AutoLock auto_lock(state_lock_);
-  ObserversMap::iterator it = observers_event_[event_id].begin();
-
-  for (; observers_event_[event_id].end() != it; ++it) {
-    ObserverVector& obs_vec = it->second;
-    const ObserverVector::iterator obs_vec_it = obs_vec.end();
-    obs_vec.erase(
-        std::remove_if(
-            obs_vec.begin(), obs_vec_it, IdCheckFunctor(observer.id())),
-        obs_vec_it);
-  }
+  observers_.Remove(event_id, &observer);
 }
 
 void EventDispatcherImpl::remove_observer(EventObserver& observer) {
-  remove_observer_from_vector(observer);
-  EventObserverMap::iterator event_map = observers_event_.begin();
-
-  for (; observers_event_.end() != event_map; ++event_map) {
-    remove_observer(event_map->first, observer);
-  }
-}
-
-void EventDispatcherImpl::remove_observer_from_vector(EventObserver& observer) {
-  AutoLock auto_lock(observer_lock_);
-
-  observers_.erase(
-      std::remove_if(
-          observers_.begin(), observers_.end(), IdCheckFunctor(observer.id())),
-      observers_.end());
+  observers_.RemoveAll(&observer);
 }
 
 // Mobile Events
 
 void EventDispatcherImpl::raise_mobile_event(const MobileEvent& event) {
-  AutoLock observer_lock(mobile_observer_lock_);
-  {
-    AutoLock state_lock(mobile_state_lock_);
-
-    // check if event is notification
-    if (mobile_apis::messageType::notification == event.smart_object_type()) {
-      const uint32_t notification_correlation_id = 0;
-      mobile_observers_ =
-          mobile_observers_event_[event.id()][notification_correlation_id];
-    }
+  ObserverVectorPtr observers;
 
-    if (mobile_apis::messageType::response == event.smart_object_type()) {
-      mobile_observers_ =
-          mobile_observers_event_[event.id()]
-                                 [event.smart_object_correlation_id()];
-    }
+  // check if event is notification
+  if (mobile_apis::messageType::notification == event.smart_object_type()) {
+    const uint32_t notification_correlation_id = 0;
+    observers =
+        mobile_observers_.Find(event.id(), notification_correlation_id);
   }
 
+  if (mobile_apis::messageType::response == event.smart_object_type()) {
+    observers = mobile_observers_.Find(event.id(),
+                                       event.smart_object_correlation_id());
+  }
+
+  if (!observers) {
+    return;
+  }
   // Call observers
-  while (!mobile_observers_.empty()) {
-    EventObserver* temp = *mobile_observers_.begin();
-    mobile_observers_.erase(mobile_observers_.begin());
-    AutoUnlock unlock_observer(observer_lock);
-    temp->on_event(event);
+  for (EventObserver* observer : *observers) {
+    observer->on_event(event);
   }
 }
 
@@ -156,43 +111,117 @@ void EventDispatcherImpl::add_mobile_observer(
     const MobileEvent::MobileEventID& event_id,
     int32_t mobile_correlation_id,
     EventObserver& observer) {
-  AutoLock auto_lock(mobile_state_lock_);
-  mobile_observers_event_[event_id][mobile_correlation_id].push_back(&observer);
+  mobile_observers_.Add(event_id, mobile_correlation_id, &observer);
 }
 
 void EventDispatcherImpl::remove_mobile_observer(
     const MobileEvent::MobileEventID& event_id, EventObserver& observer) {
-  remove_mobile_observer_from_vector(observer);
-  AutoLock auto_lock(mobile_state_lock_);
-  ObserversMap::iterator it = mobile_observers_event_[event_id].begin();
-
-  for (; mobile_observers_event_[event_id].end() != it; ++it) {
-    ObserverVector& obs_vec = it->second;
-    const ObserverVector::iterator obs_vec_it = obs_vec.end();
-    obs_vec.erase(
-        std::remove_if(
-            obs_vec.begin(), obs_vec_it, IdCheckFunctor(observer.id())),
-        obs_vec_it);
-  }
+  mobile_observers_.Remove(event_id, &observer);
 }
 
 void EventDispatcherImpl::remove_mobile_observer(EventObserver& observer) {
-  remove_mobile_observer_from_vector(observer);
-  MobileEventObserverMap::iterator event_map = mobile_observers_event_.begin();
+  mobile_observers_.RemoveAll(&observer);
+}
 
-  for (; mobile_observers_event_.end() != event_map; ++event_map) {
-    remove_mobile_observer(event_map->first, observer);
+// Observers registry
+
+void EventDispatcherImpl::ObserversRegistry::Add(const int32_t event_id,
+                                                 const int32_t correlation_id,
+                                                 EventObserver* observer) {
+  const uint64_t key = Key(event_id, correlation_id);
+  Shard& shard = shards_[ShardIndex(correlation_id)];
+  AutoLock auto_lock(shard.lock_);
+  ObserverVectorPtr& observers = shard.observers_[key];
+  std::shared_ptr<ObserverVector> updated =
+      observers ? std::make_shared<ObserverVector>(*observers)
+                : std::make_shared<ObserverVector>();
+  updated->push_back(observer);
+  observers = updated;
+  shard.subscriptions_.emplace(observer, key);
+}
+
+void EventDispatcherImpl::ObserversRegistry::Remove(const int32_t event_id,
+                                                    EventObserver* observer) {
+  for (size_t i = 0; i < kShardsCount; ++i) {
+    AutoLock auto_lock(shards_[i].lock_);
+    RemoveFromShard(shards_[i], observer, false, event_id);
   }
 }
 
-void EventDispatcherImpl::remove_mobile_observer_from_vector(
-    EventObserver& observer) {
-  AutoLock auto_lock(mobile_observer_lock_);
+void EventDispatcherImpl::ObserversRegistry::RemoveAll(
+    EventObserver* observer) {
+  for (size_t i = 0; i < kShardsCount; ++i) {
+    AutoLock auto_lock(shards_[i].lock_);
+    RemoveFromShard(shards_[i], observer, true, 0);
+  }
+}
+
+EventDispatcherImpl::ObserverVectorPtr
+EventDispatcherImpl::ObserversRegistry::Find(
+    const int32_t event_id, const int32_t correlation_id) const {
+  const Shard& shard = shards_[ShardIndex(correlation_id)];
+  AutoLock auto_lock(shard.lock_);
+  const auto it = shard.observers_.find(Key(event_id, correlation_id));
+  return shard.observers_.end() != it ? it->second : ObserverVectorPtr();
+}
+
+size_t EventDispatcherImpl::ObserversRegistry::size() const {
+  size_t result = 0;
+  for (size_t i = 0; i < kShardsCount; ++i) {
+    AutoLock auto_lock(shards_[i].lock_);
+    result += shards_[i].observers_.size();
+  }
+  return result;
+}
+
+uint64_t EventDispatcherImpl::ObserversRegistry::Key(
+    const int32_t event_id, const int32_t correlation_id) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(event_id)) << 32) |
+         static_cast<uint32_t>(correlation_id);
+}
+
+int32_t EventDispatcherImpl::ObserversRegistry::EventId(const uint64_t key) {
+  return static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+}
 
-  mobile_observers_.erase(
-      std::remove_if(
-          observers_.begin(), observers_.end(), IdCheckFunctor(observer.id())),
-      observers_.end());
+size_t EventDispatcherImpl::ObserversRegistry::ShardIndex(
+    const int32_t correlation_id) {
+  return static_cast<uint32_t>(correlation_id) % kShardsCount;
+}
+
+void EventDispatcherImpl::ObserversRegistry::RemoveFromKey(
+    Shard& shard, const uint64_t key, EventObserver* observer) {
+  const auto it = shard.observers_.find(key);
+  if (shard.observers_.end() == it) {
+    return;
+  }
+  std::shared_ptr<ObserverVector> updated =
+      std::make_shared<ObserverVector>(*it->second);
+  updated->erase(std::remove(updated->begin(), updated->end(), observer),
+                 updated->end());
+  if (updated->empty()) {
+    shard.observers_.erase(it);
+  } else {
+    it->second = updated;
+  }
+}
+
+void EventDispatcherImpl::ObserversRegistry::RemoveFromShard(
+    Shard& shard,
+    EventObserver* observer,
+    const bool any_event,
+    const int32_t event_id) {
+  auto range = shard.subscriptions_.equal_range(observer);
+  auto it = range.first;
+  while (range.second != it) {
+    const uint64_t key = it->second;
+    if (!any_event && EventId(key) != event_id) {
+      ++it;
+      continue;
+    }
+    RemoveFromKey(shard, key, observer);
+    it = shard.subscriptions_.erase(it);
+  }
 }
 
 }  // namespace event_engine
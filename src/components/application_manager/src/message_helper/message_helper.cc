@@ -39,6 +39,7 @@
 #include <inttypes.h>
 #undef __STDC_FORMAT_MACROS
 
+#include <string.h>
 #include <strings.h>
 #include <algorithm>
 #include <functional>
@@ -963,11 +964,10 @@ std::string MessageHelper::StringifiedFunctionID(
   const char* str = 0;
   if (EnumConversionHelper<mobile_apis::FunctionID::eType>::EnumToCString(
           function_id, &str)) {
-    const std::string enum_name = str;
+    const size_t length = strlen(str);
     // Strip 'ID' suffix from value name
-    DCHECK(enum_name.length() > 2 &&
-           enum_name.substr(enum_name.length() - 2) == "ID");
-    return enum_name.substr(0, enum_name.length() - 2);
+    DCHECK(length > 2 && strcmp(str + length - 2, "ID") == 0);
+    return std::string(str, length - 2);
   }
   return std::string();
 }
@@ -1646,6 +1646,13 @@ void PolicyHandler::OnPermissionsUpdated(const std::string& device_id,
                                          const std::string& policy_app_id,
                                          const Permissions& permissions) {
   SDL_LOG_AUTO_TRACE();
+  {
+    sync_primitives::AutoLock lock(listeners_lock_);
+    for (auto listener : listeners_) {
+      listener->OnPermissionsUpdated(policy_app_id);
+    }
+  }
+
   const auto policy_manager = LoadPolicyManager();
   POLICY_LIB_CHECK_VOID(policy_manager);
 
@@ -2930,7 +2937,7 @@ void PolicyHandler::SetDefaultHmiTypes(
   POLICY_LIB_CHECK_VOID(policy_manager);
   std::vector<int> hmi_types;
   if (app_types && app_types->asArray()) {
-    smart_objects::SmartArray* hmi_list = app_types->asArray();
+    const smart_objects::SmartArray* hmi_list = app_types->asArray();
     std::transform(hmi_list->begin(),
                    hmi_list->end(),
                    std::back_inserter(hmi_types),
@@ -2950,7 +2957,7 @@ bool PolicyHandler::CheckHMIType(const std::string& application_id,
 
   std::vector<int> additional_hmi_types;
   if (app_types && app_types->asArray()) {
-    smart_objects::SmartArray* hmi_list = app_types->asArray();
+    const smart_objects::SmartArray* hmi_list = app_types->asArray();
     std::transform(hmi_list->begin(),
                    hmi_list->end(),
                    std::back_inserter(additional_hmi_types),
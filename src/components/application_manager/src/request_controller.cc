@@ -30,14 +30,14 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
+
 #include "utils/logger.h"
 
 #include "application_manager/commands/command_request_impl.h"
 #include "application_manager/commands/request_to_hmi.h"
 #include "application_manager/request_controller.h"
 
-#include "utils/timer_task_impl.h"
-
 namespace application_manager {
 
 namespace request_controller {
@@ -49,27 +49,29 @@ SDL_CREATE_LOG_VARIABLE("RequestController")
 RequestController::RequestController(const RequestControlerSettings& settings)
     : pool_state_(UNDEFINED)
     , pool_size_(settings.thread_pool_size())
+    , pending_requests_count_(0)
     , request_tracker_(settings)
     , duplicate_message_count_()
-    , timer_("AM RequestCtrlTimer",
-             new timer::TimerTaskImpl<RequestController>(
-                 this, &RequestController::TimeoutThread))
+    , timeout_thread_(NULL)
     , timer_stop_flag_(false)
     , is_low_voltage_(false)
     , settings_(settings) {
   SDL_LOG_AUTO_TRACE();
+  const size_t shards_count = std::max<size_t>(pool_size_, 1);
+  for (size_t i = 0; i < shards_count; ++i) {
+    shards_.push_back(std::unique_ptr<Shard>(new Shard()));
+  }
   InitializeThreadpool();
-  timer_.Start(0, timer::kSingleShot);
+  timeout_thread_ =
+      threads::CreateThread("AM RequestCtrlTimer", new TimeoutWatcher(this));
+  timeout_thread_->Start();
 }
 
 RequestController::~RequestController() {
   SDL_LOG_AUTO_TRACE();
-  {
-    sync_primitives::AutoLock auto_lock(timer_lock);
-    timer_stop_flag_ = true;
-    timer_condition_.Broadcast();
-  }
-  timer_.Stop();
+  timeout_thread_->Stop(threads::Thread::kThreadSoftStop);
+  delete timeout_thread_->GetDelegate();
+  threads::DeleteThread(timeout_thread_);
   if (pool_state_ != TPoolState::STOPPED) {
     DestroyThreadpool();
   }
@@ -82,7 +84,7 @@ void RequestController::InitializeThreadpool() {
   char name[50];
   for (uint32_t i = 0; i < pool_size_; ++i) {
     snprintf(name, sizeof(name) / sizeof(name[0]), "AM Pool %u", i);
-    pool_.push_back(threads::CreateThread(name, new Worker(this)));
+    pool_.push_back(threads::CreateThread(name, new Worker(this, i)));
     pool_[i]->Start();
     SDL_LOG_DEBUG("Request thread initialized: " << name);
   }
@@ -90,12 +92,9 @@ void RequestController::InitializeThreadpool() {
 
 void RequestController::DestroyThreadpool() {
   SDL_LOG_AUTO_TRACE();
-  {
-    AutoLock auto_lock(mobile_request_list_lock_);
-    pool_state_ = TPoolState::STOPPED;
-    SDL_LOG_DEBUG("Broadcasting STOP signal to all threads...");
-    cond_var_.Broadcast();  // notify all threads we are shutting down
-  }
+  pool_state_ = TPoolState::STOPPED;
+  SDL_LOG_DEBUG("Broadcasting STOP signal to all threads...");
+  WakeUpAllWorkers();
   for (size_t i = 0; i < pool_.size(); ++i) {
     threads::Thread* thread = pool_[i];
     thread->Stop(threads::Thread::kThreadSoftStop);
@@ -138,7 +137,7 @@ bool RequestController::CheckPendingRequestsAmount(
     const uint32_t& pending_requests_amount) {
   SDL_LOG_AUTO_TRACE();
   if (pending_requests_amount > 0) {
-    const size_t pending_requests_size = mobile_request_list_.size();
+    const size_t pending_requests_size = pending_requests_count_;
     const bool available_to_add =
         pending_requests_amount > pending_requests_size;
     if (!available_to_add) {
@@ -157,20 +156,39 @@ RequestController::TResult RequestController::addMobileRequest(
   SDL_LOG_AUTO_TRACE();
   if (!request) {
     SDL_LOG_ERROR("Null Pointer request");
-    cond_var_.NotifyOne();
     return INVALID_DATA;
   }
   SDL_LOG_DEBUG("correlation_id : " << request->correlation_id()
                                     << "connection_key : "
                                     << request->connection_key());
   RequestController::TResult result = CheckPosibilitytoAdd(request, hmi_level);
-  if (SUCCESS == result) {
-    AutoLock auto_lock_list(mobile_request_list_lock_);
-    mobile_request_list_.push_back(request);
-    SDL_LOG_DEBUG("Waiting for execution: " << mobile_request_list_.size());
-    // wake up one thread that is waiting for a task to be available
+  if (SUCCESS != result) {
+    return result;
+  }
+
+  const uint32_t connection_key = request->connection_key();
+  Shard& shard = *shards_[ShardIndex(connection_key)];
+  bool became_ready = false;
+  {
+    AutoLock auto_lock(shard.lock_);
+    auto app = shard.apps_.emplace(connection_key, AppRequests());
+    app.first->second.requests_.push_back(request);
+    ++pending_requests_count_;
+    // Application which is already ready or being executed will be
+    // returned to ready list by worker after current request execution
+    became_ready = app.second;
+    if (became_ready) {
+      shard.ready_apps_.push_back(connection_key);
+      ++shard.ready_count_;
+      // wake up owner worker if it is waiting for a task to be available
+      shard.cond_var_.NotifyOne();
+    }
+    SDL_LOG_DEBUG("Waiting for execution: " << pending_requests_count_);
+  }
+  if (became_ready && !shard.idle_) {
+    // Owner worker is busy, so application may be taken by idle one
+    WakeUpIdleWorker();
   }
-  cond_var_.NotifyOne();
   return result;
 }
 
@@ -292,18 +310,17 @@ void RequestController::terminateWaitingForExecutionAppRequests(
     const uint32_t& app_id) {
   SDL_LOG_AUTO_TRACE();
   SDL_LOG_DEBUG("app_id: " << app_id << "Waiting for execution"
-                           << mobile_request_list_.size());
-  AutoLock auto_lock(mobile_request_list_lock_);
-  std::list<RequestPtr>::iterator request_it = mobile_request_list_.begin();
-  while (mobile_request_list_.end() != request_it) {
-    RequestPtr request = (*request_it);
-    if ((request.use_count() != 0) && (request->connection_key() == app_id)) {
-      mobile_request_list_.erase(request_it++);
-    } else {
-      ++request_it;
-    }
+                           << pending_requests_count_);
+  Shard& shard = *shards_[ShardIndex(app_id)];
+  AutoLock auto_lock(shard.lock_);
+  auto app = shard.apps_.find(app_id);
+  if (shard.apps_.end() != app) {
+    // Application stays in ready list or is being executed, so it will be
+    // removed by worker as soon as worker finds out there are no requests
+    pending_requests_count_ -= app->second.requests_.size();
+    app->second.requests_.clear();
   }
-  SDL_LOG_DEBUG("Waiting for execution " << mobile_request_list_.size());
+  SDL_LOG_DEBUG("Waiting for execution " << pending_requests_count_);
 }
 
 void RequestController::terminateWaitingForResponseAppRequests(
@@ -318,7 +335,7 @@ void RequestController::terminateAppRequests(const uint32_t& app_id) {
   SDL_LOG_AUTO_TRACE();
   SDL_LOG_DEBUG("app_id : " << app_id
                             << "Requests waiting for execution count : "
-                            << mobile_request_list_.size()
+                            << pending_requests_count_
                             << "Requests waiting for response count : "
                             << waiting_for_response_.Size());
 
@@ -336,8 +353,13 @@ void RequestController::terminateAllMobileRequests() {
   SDL_LOG_AUTO_TRACE();
   waiting_for_response_.RemoveMobileRequests();
   SDL_LOG_DEBUG("Mobile Requests waiting for response cleared");
-  AutoLock waiting_execution_auto_lock(mobile_request_list_lock_);
-  mobile_request_list_.clear();
+  for (auto& shard : shards_) {
+    AutoLock auto_lock(shard->lock_);
+    for (auto& app : shard->apps_) {
+      pending_requests_count_ -= app.second.requests_.size();
+      app.second.requests_.clear();
+    }
+  }
   SDL_LOG_DEBUG("Mobile Requests waiting for execution cleared");
   NotifyTimer();
 }
@@ -354,12 +376,8 @@ void RequestController::updateRequestTimeout(const uint32_t& app_id,
       "New_timeout is NULL. RequestCtrl will "
       "not manage this request any more");
 
-  RequestInfoPtr request_info =
-      waiting_for_response_.Find(app_id, correlation_id);
-  if (request_info) {
-    waiting_for_response_.RemoveRequest(request_info);
-    request_info->updateTimeOut(new_timeout);
-    waiting_for_response_.Add(request_info);
+  if (waiting_for_response_.UpdateTimeout(
+          app_id, correlation_id, new_timeout)) {
     NotifyTimer();
     SDL_LOG_INFO("Timeout updated for "
                  << " app_id: " << app_id << " correlation_id: "
@@ -448,93 +466,232 @@ void RequestController::TimeoutThread() {
       "EXIT Waiting for response count : " << waiting_for_response_.Size());
 }
 
-RequestController::Worker::Worker(RequestController* requestController)
-    : request_controller_(requestController), stop_flag_(false) {}
+size_t RequestController::ShardIndex(const uint32_t connection_key) const {
+  return connection_key % shards_.size();
+}
 
-RequestController::Worker::~Worker() {}
+RequestPtr RequestController::WaitForRequest(
+    const size_t shard_index,
+    const std::atomic<bool>& stop_flag,
+    size_t& request_shard_index) {
+  Shard& shard = *shards_[shard_index];
+  while (!stop_flag && pool_state_ != TPoolState::STOPPED) {
+    RequestPtr request;
+    {
+      AutoLock auto_lock(shard.lock_);
+      request = TakeReadyRequest(shard);
+    }
+    request_shard_index = shard_index;
 
-void RequestController::Worker::threadMain() {
-  SDL_LOG_AUTO_TRACE();
-  AutoLock auto_lock(thread_lock_);
-  while (!stop_flag_) {
-    // Try to pick a request
-    AutoLock auto_lock(request_controller_->mobile_request_list_lock_);
+    if (!request) {
+      // Idle flag has to be set before looking into other shards, so
+      // request added to any of them after the check wakes this worker up
+      shard.idle_ = true;
+      request = StealRequest(shard_index, request_shard_index);
+    }
+
+    if (request) {
+      shard.idle_ = false;
+      // Let idle workers take the rest of ready applications while this
+      // one is busy
+      if (0 != shard.ready_count_ ||
+          0 != shards_[request_shard_index]->ready_count_) {
+        WakeUpIdleWorker();
+      }
+      return request;
+    }
 
-    while ((request_controller_->pool_state_ != TPoolState::STOPPED) &&
-           (request_controller_->mobile_request_list_.empty())) {
-      // Wait until there is a task in the queue
-      // Unlock mutex while wait, then lock it back when signaled
+    AutoLock auto_lock(shard.lock_);
+    if (!shard.wakeup_ && 0 == shard.ready_count_ && !stop_flag &&
+        pool_state_ != TPoolState::STOPPED) {
       SDL_LOG_INFO("Unlocking and waiting");
-      request_controller_->cond_var_.Wait(auto_lock);
+      shard.cond_var_.Wait(auto_lock);
       SDL_LOG_INFO("Signaled and locking");
     }
+    shard.wakeup_ = false;
+  }
+  return RequestPtr();
+}
 
-    // If the thread was shutdown, return from here
-    if (request_controller_->pool_state_ == TPoolState::STOPPED) {
-      break;
+RequestPtr RequestController::TakeReadyRequest(Shard& shard) {
+  while (!shard.ready_apps_.empty()) {
+    const uint32_t connection_key = shard.ready_apps_.front();
+    shard.ready_apps_.pop_front();
+    --shard.ready_count_;
+
+    auto app = shard.apps_.find(connection_key);
+    DCHECK_OR_RETURN(shard.apps_.end() != app, RequestPtr());
+    if (app->second.requests_.empty()) {
+      // All requests of application have been terminated
+      shard.apps_.erase(app);
+      continue;
     }
+    RequestPtr request = app->second.requests_.front();
+    app->second.requests_.pop_front();
+    --pending_requests_count_;
+    return request;
+  }
+  return RequestPtr();
+}
 
-    if (request_controller_->mobile_request_list_.empty()) {
-      SDL_LOG_WARN("Mobile request list is empty");
-      break;
+RequestPtr RequestController::StealRequest(const size_t shard_index,
+                                           size_t& request_shard_index) {
+  const size_t shards_count = shards_.size();
+  for (size_t i = 1; i < shards_count; ++i) {
+    const size_t victim_index = (shard_index + i) % shards_count;
+    Shard& victim = *shards_[victim_index];
+    if (0 == victim.ready_count_) {
+      continue;
+    }
+    RequestPtr request;
+    {
+      AutoLock auto_lock(victim.lock_);
+      request = TakeReadyRequest(victim);
     }
+    if (request) {
+      SDL_LOG_DEBUG("Request of app " << request->connection_key()
+                                      << " is stolen from shard "
+                                      << victim_index);
+      request_shard_index = victim_index;
+      return request;
+    }
+  }
+  return RequestPtr();
+}
 
-    RequestPtr request_ptr(request_controller_->mobile_request_list_.front());
-    request_controller_->mobile_request_list_.pop_front();
-
-    bool init_res = request_ptr->Init();  // to setup specific
-                                          // default timeout
-
-    const uint32_t timeout_in_mseconds = request_ptr->default_timeout();
-    RequestInfoPtr request_info_ptr =
-        std::make_shared<MobileRequestInfo>(request_ptr, timeout_in_mseconds);
-
-    if (!request_controller_->waiting_for_response_.Add(request_info_ptr)) {
-      commands::CommandRequestImpl* cmd_request =
-          dynamic_cast<commands::CommandRequestImpl*>(request_ptr.get());
-      if (cmd_request != NULL) {
-        uint32_t corr_id = cmd_request->correlation_id();
-        request_controller_->duplicate_message_count_lock_.Acquire();
-        auto dup_it =
-            request_controller_->duplicate_message_count_.find(corr_id);
-        if (request_controller_->duplicate_message_count_.end() == dup_it) {
-          request_controller_->duplicate_message_count_[corr_id] = 0;
-        }
-        request_controller_->duplicate_message_count_[corr_id]++;
-        request_controller_->duplicate_message_count_lock_.Release();
-        cmd_request->SendResponse(
-            false, mobile_apis::Result::INVALID_ID, "Duplicate correlation_id");
-      }
-      continue;
+void RequestController::OnRequestExecuted(const size_t shard_index,
+                                          const size_t request_shard_index,
+                                          const uint32_t connection_key) {
+  Shard& shard = *shards_[request_shard_index];
+  {
+    AutoLock auto_lock(shard.lock_);
+    auto app = shard.apps_.find(connection_key);
+    DCHECK_OR_RETURN_VOID(shard.apps_.end() != app);
+    if (app->second.requests_.empty()) {
+      shard.apps_.erase(app);
+      return;
     }
-    SDL_LOG_DEBUG("timeout_in_mseconds " << timeout_in_mseconds);
+    // Application goes to the tail of ready list to let other applications
+    // of the shard be served in between
+    shard.ready_apps_.push_back(connection_key);
+    ++shard.ready_count_;
+    shard.cond_var_.NotifyOne();
+  }
+  if (shard_index != request_shard_index && !shard.idle_) {
+    WakeUpIdleWorker();
+  }
+}
 
-    if (0 != timeout_in_mseconds) {
-      request_controller_->NotifyTimer();
-    } else {
-      SDL_LOG_DEBUG(
-          "Default timeout was set to 0. "
-          "RequestController will not track timeout "
-          "of this request.");
+void RequestController::WakeUpIdleWorker() {
+  for (auto& shard : shards_) {
+    if (shard->idle_) {
+      AutoLock auto_lock(shard->lock_);
+      shard->wakeup_ = true;
+      shard->cond_var_.NotifyOne();
+      return;
+    }
+  }
+}
+
+void RequestController::WakeUpAllWorkers() {
+  for (auto& shard : shards_) {
+    AutoLock auto_lock(shard->lock_);
+    shard->wakeup_ = true;
+    shard->cond_var_.Broadcast();
+  }
+}
+
+void RequestController::ExecuteRequest(RequestPtr request_ptr) {
+  bool init_res = request_ptr->Init();  // to setup specific
+                                        // default timeout
+
+  const uint32_t timeout_in_mseconds = request_ptr->default_timeout();
+  RequestInfoPtr request_info_ptr =
+      std::make_shared<MobileRequestInfo>(request_ptr, timeout_in_mseconds);
+
+  if (!waiting_for_response_.Add(request_info_ptr)) {
+    commands::CommandRequestImpl* cmd_request =
+        dynamic_cast<commands::CommandRequestImpl*>(request_ptr.get());
+    if (cmd_request != NULL) {
+      uint32_t corr_id = cmd_request->correlation_id();
+      duplicate_message_count_lock_.Acquire();
+      auto dup_it = duplicate_message_count_.find(corr_id);
+      if (duplicate_message_count_.end() == dup_it) {
+        duplicate_message_count_[corr_id] = 0;
+      }
+      duplicate_message_count_[corr_id]++;
+      duplicate_message_count_lock_.Release();
+      cmd_request->SendResponse(
+          false, mobile_apis::Result::INVALID_ID, "Duplicate correlation_id");
     }
+    return;
+  }
+  SDL_LOG_DEBUG("timeout_in_mseconds " << timeout_in_mseconds);
 
-    AutoUnlock unlock(auto_lock);
+  if (0 != timeout_in_mseconds) {
+    NotifyTimer();
+  } else {
+    SDL_LOG_DEBUG(
+        "Default timeout was set to 0. "
+        "RequestController will not track timeout "
+        "of this request.");
+  }
+
+  // execute
+  if ((false == IsLowVoltage()) && request_ptr->CheckPermissions() &&
+      init_res) {
+    SDL_LOG_DEBUG("Execute MobileRequest corr_id = "
+                  << request_info_ptr->requestId()
+                  << " with timeout: " << timeout_in_mseconds);
+    request_ptr->Run();
+  }
+}
+
+RequestController::Worker::Worker(RequestController* requestController,
+                                  const size_t shard_index)
+    : request_controller_(requestController)
+    , shard_index_(shard_index)
+    , stop_flag_(false) {}
+
+RequestController::Worker::~Worker() {}
 
-    // execute
-    if ((false == request_controller_->IsLowVoltage()) &&
-        request_ptr->CheckPermissions() && init_res) {
-      SDL_LOG_DEBUG("Execute MobileRequest corr_id = "
-                    << request_info_ptr->requestId()
-                    << " with timeout: " << timeout_in_mseconds);
-      request_ptr->Run();
+void RequestController::Worker::threadMain() {
+  SDL_LOG_AUTO_TRACE();
+  while (!stop_flag_) {
+    size_t request_shard_index = shard_index_;
+    RequestPtr request_ptr = request_controller_->WaitForRequest(
+        shard_index_, stop_flag_, request_shard_index);
+    if (!request_ptr) {
+      break;
     }
+
+    const uint32_t connection_key = request_ptr->connection_key();
+    request_controller_->ExecuteRequest(request_ptr);
+    request_controller_->OnRequestExecuted(
+        shard_index_, request_shard_index, connection_key);
   }
 }
 
 void RequestController::Worker::exitThreadMain() {
   stop_flag_ = true;
-  // setup stop flag and whit while threadMain will be finished correctly
-  // FIXME (dchmerev@luxoft.com): There is no waiting
+  Shard& shard = *request_controller_->shards_[shard_index_];
+  AutoLock auto_lock(shard.lock_);
+  shard.wakeup_ = true;
+  shard.cond_var_.Broadcast();
+}
+
+RequestController::TimeoutWatcher::TimeoutWatcher(
+    RequestController* request_controller)
+    : request_controller_(request_controller) {}
+
+void RequestController::TimeoutWatcher::threadMain() {
+  request_controller_->TimeoutThread();
+}
+
+void RequestController::TimeoutWatcher::exitThreadMain() {
+  sync_primitives::AutoLock auto_lock(request_controller_->timer_lock);
+  request_controller_->timer_stop_flag_ = true;
+  request_controller_->timer_condition_.Broadcast();
 }
 
 void RequestController::NotifyTimer() {
@@ -111,18 +111,10 @@ uint64_t RequestInfo::GenerateHash(uint32_t var1, uint32_t var2) {
   return hash_result;
 }
 
-FakeRequestInfo::FakeRequestInfo(uint32_t app_id, uint32_t correaltion_id) {
-  app_id_ = app_id;
-  correlation_id_ = correaltion_id;
-}
-
 RequestInfoSet::~RequestInfoSet() {
   sync_primitives::AutoLock lock(pending_requests_lock_);
-  auto it = time_sorted_pending_requests_.begin();
-  while (!time_sorted_pending_requests_.empty()) {
-    Erase(*it);
-    it = time_sorted_pending_requests_.begin();
-  }
+  deadlines_heap_.clear();
+  pending_requests_.clear();
 }
 
 bool RequestInfoSet::Add(RequestInfoPtr request_info) {
@@ -131,40 +123,31 @@ bool RequestInfoSet::Add(RequestInfoPtr request_info) {
                                         << "; corr_id = "
                                         << request_info->requestId());
   sync_primitives::AutoLock lock(pending_requests_lock_);
-  CheckSetSizes();
-  const std::pair<HashSortedRequestInfoSet::iterator, bool>& insert_resilt =
-      hash_sorted_pending_requests_.insert(request_info);
-  if (insert_resilt.second == true) {
-    const std::pair<TimeSortedRequestInfoSet::iterator, bool>& insert_resilt =
-        time_sorted_pending_requests_.insert(request_info);
-    DCHECK(insert_resilt.second);
-    if (!insert_resilt.second) {
-      return false;
-    }
-    CheckSetSizes();
-    return true;
-  } else {
+  const std::pair<RequestsMap::iterator, bool> insert_result =
+      pending_requests_.emplace(request_info->hash(), Entry(request_info));
+  if (!insert_result.second) {
     SDL_LOG_ERROR("Request with app_id = "
                   << request_info->app_id() << "; corr_id "
                   << request_info->requestId() << " Already exist ");
+    return false;
   }
-  CheckSetSizes();
-  return false;
+  if (0 != request_info->timeout_msec()) {
+    Entry& entry = insert_result.first->second;
+    entry.deadline_ = request_info->end_time();
+    HeapPush(&entry);
+  }
+  return true;
 }
 
 RequestInfoPtr RequestInfoSet::Find(const uint32_t connection_key,
                                     const uint32_t correlation_id) {
   RequestInfoPtr result;
 
-  // Request info for searching in request info set by log_n time
-  std::shared_ptr<FakeRequestInfo> request_info_for_search(
-      new FakeRequestInfo(connection_key, correlation_id));
-
   sync_primitives::AutoLock lock(pending_requests_lock_);
-  HashSortedRequestInfoSet::iterator it =
-      hash_sorted_pending_requests_.find(request_info_for_search);
-  if (it != hash_sorted_pending_requests_.end()) {
-    result = *it;
+  RequestsMap::const_iterator it = pending_requests_.find(
+      RequestInfo::GenerateHash(connection_key, correlation_id));
+  if (it != pending_requests_.end()) {
+    result = it->second.request_info_;
   }
   return result;
 }
@@ -173,9 +156,11 @@ RequestInfoPtr RequestInfoSet::Front() {
   RequestInfoPtr result;
 
   sync_primitives::AutoLock lock(pending_requests_lock_);
-  TimeSortedRequestInfoSet::iterator it = time_sorted_pending_requests_.begin();
-  if (it != time_sorted_pending_requests_.end()) {
-    result = *it;
+  const Entry* top = HeapTop();
+  if (top) {
+    result = top->request_info_;
+  } else if (!pending_requests_.empty()) {
+    result = pending_requests_.begin()->second.request_info_;
   }
   return result;
 }
@@ -184,50 +169,65 @@ RequestInfoPtr RequestInfoSet::FrontWithNotNullTimeout() {
   SDL_LOG_AUTO_TRACE();
   sync_primitives::AutoLock lock(pending_requests_lock_);
   RequestInfoPtr result;
-  TimeSortedRequestInfoSet::iterator it = time_sorted_pending_requests_.begin();
-  while (it != time_sorted_pending_requests_.end()) {
-    RequestInfoPtr tmp = *it;
-    if (0 == tmp->timeout_msec()) {
-      ++it;
-    } else {
-      result = tmp;
-      it = time_sorted_pending_requests_.end();
-    }
+  const Entry* top = HeapTop();
+  if (top) {
+    result = top->request_info_;
   }
   return result;
 }
 
-bool RequestInfoSet::Erase(const RequestInfoPtr request_info) {
-  DCHECK(request_info);
-  if (!request_info) {
-    SDL_LOG_ERROR("NULL ponter request_info");
+bool RequestInfoSet::UpdateTimeout(const uint32_t connection_key,
+                                   const uint32_t correlation_id,
+                                   const uint64_t timeout_msec) {
+  sync_primitives::AutoLock lock(pending_requests_lock_);
+  RequestsMap::iterator it = pending_requests_.find(
+      RequestInfo::GenerateHash(connection_key, correlation_id));
+  if (it == pending_requests_.end()) {
     return false;
   }
-  CheckSetSizes();
-
-  size_t erased_count = hash_sorted_pending_requests_.erase(request_info);
-  DCHECK((erased_count <= 1));
-  if (1 == erased_count) {
-    TimeSortedRequestInfoSet::iterator it =
-        time_sorted_pending_requests_.find(request_info);
-    DCHECK(it != time_sorted_pending_requests_.end());
-    if (it == time_sorted_pending_requests_.end()) {
-      SDL_LOG_ERROR("Can't find request in time_sorted_requests_");
-      return false;
+
+  Entry& entry = it->second;
+  entry.request_info_->updateTimeOut(timeout_msec);
+  if (0 == timeout_msec) {
+    if (entry.in_heap()) {
+      HeapRemove(&entry);
     }
-    const RequestInfoPtr found = *it;
-    DCHECK(request_info == found);
-    time_sorted_pending_requests_.erase(it);
-    CheckSetSizes();
     return true;
   }
-  CheckSetSizes();
-  return false;
+
+  const date_time::TimeDuration end_time = entry.request_info_->end_time();
+  if (!entry.in_heap()) {
+    entry.deadline_ = end_time;
+    HeapPush(&entry);
+  } else if (end_time < entry.deadline_) {
+    entry.deadline_ = end_time;
+    SiftUp(entry.heap_index_);
+  }
+  // Later end time is taken into account by HeapTop
+  return true;
+}
+
+bool RequestInfoSet::Erase(RequestsMap::iterator it) {
+  DCHECK_OR_RETURN(it != pending_requests_.end(), false);
+  if (it->second.in_heap()) {
+    HeapRemove(&it->second);
+  }
+  pending_requests_.erase(it);
+  return true;
 }
 
 bool RequestInfoSet::RemoveRequest(const RequestInfoPtr request_info) {
+  DCHECK(request_info);
+  if (!request_info) {
+    SDL_LOG_ERROR("NULL ponter request_info");
+    return false;
+  }
   sync_primitives::AutoLock lock(pending_requests_lock_);
-  return Erase(request_info);
+  RequestsMap::iterator it = pending_requests_.find(request_info->hash());
+  if (it == pending_requests_.end()) {
+    return false;
+  }
+  return Erase(it);
 }
 
 uint32_t RequestInfoSet::RemoveRequests(
@@ -236,17 +236,14 @@ uint32_t RequestInfoSet::RemoveRequests(
   uint32_t erased = 0;
 
   sync_primitives::AutoLock lock(pending_requests_lock_);
-  HashSortedRequestInfoSet::iterator it =
-      std::find_if(hash_sorted_pending_requests_.begin(),
-                   hash_sorted_pending_requests_.end(),
-                   filter);
-  while (it != hash_sorted_pending_requests_.end()) {
-    HashSortedRequestInfoSet::iterator to_erase = it++;
-    Erase(*to_erase);
-    it = std::find_if(it, hash_sorted_pending_requests_.end(), filter);
-    ++erased;
+  RequestsMap::iterator it = pending_requests_.begin();
+  while (it != pending_requests_.end()) {
+    RequestsMap::iterator to_erase = it++;
+    if (filter(to_erase->second.request_info_)) {
+      Erase(to_erase);
+      ++erased;
+    }
   }
-  CheckSetSizes();
   return erased;
 }
 
@@ -264,15 +261,7 @@ uint32_t RequestInfoSet::RemoveMobileRequests() {
 
 const size_t RequestInfoSet::Size() {
   sync_primitives::AutoLock lock(pending_requests_lock_);
-  CheckSetSizes();
-  return time_sorted_pending_requests_.size();
-}
-
-void RequestInfoSet::CheckSetSizes() {
-  const ssize_t time_set_size = time_sorted_pending_requests_.size();
-  const ssize_t hash_set_size = hash_sorted_pending_requests_.size();
-  const bool set_sizes_equal = (time_set_size == hash_set_size);
-  DCHECK(set_sizes_equal);
+  return pending_requests_.size();
 }
 
 bool RequestInfoSet::AppIdCompararator::operator()(
@@ -287,23 +276,91 @@ bool RequestInfoSet::AppIdCompararator::operator()(
   }
 }
 
-bool RequestInfoTimeComparator::operator()(const RequestInfoPtr lhs,
-                                           const RequestInfoPtr rhs) const {
-  date_time::TimeCompare compare_result =
-      date_time::compareTime(lhs->end_time(), rhs->end_time());
-  if (compare_result == date_time::LESS) {
-    return true;
-  } else if (compare_result == date_time::GREATER) {
-    return false;
+namespace {
+const size_t kHeapArity = 4;
+}  // namespace
+
+bool RequestInfoSet::DeadlineLess(const Entry* lhs, const Entry* rhs) {
+  if (lhs->deadline_ != rhs->deadline_) {
+    return lhs->deadline_ < rhs->deadline_;
   }
-  // compare_result == date_time::EQUAL
   // If time is equal, sort by hash
-  return lhs->hash() < rhs->hash();
+  return lhs->request_info_->hash() < rhs->request_info_->hash();
+}
+
+void RequestInfoSet::HeapSet(const size_t index, Entry* entry) {
+  deadlines_heap_[index] = entry;
+  entry->heap_index_ = index;
+}
+
+void RequestInfoSet::HeapPush(Entry* entry) {
+  deadlines_heap_.push_back(entry);
+  entry->heap_index_ = deadlines_heap_.size() - 1;
+  SiftUp(entry->heap_index_);
+}
+
+void RequestInfoSet::HeapRemove(Entry* entry) {
+  const size_t index = entry->heap_index_;
+  DCHECK_OR_RETURN_VOID(index < deadlines_heap_.size());
+  Entry* last = deadlines_heap_.back();
+  deadlines_heap_.pop_back();
+  entry->heap_index_ = std::numeric_limits<size_t>::max();
+  if (last == entry) {
+    return;
+  }
+  HeapSet(index, last);
+  SiftUp(index);
+  SiftDown(last->heap_index_);
 }
 
-bool RequestInfoHashComparator::operator()(const RequestInfoPtr lhs,
-                                           const RequestInfoPtr rhs) const {
-  return lhs->hash() < rhs->hash();
+void RequestInfoSet::SiftUp(size_t index) {
+  Entry* entry = deadlines_heap_[index];
+  while (index > 0) {
+    const size_t parent = (index - 1) / kHeapArity;
+    if (!DeadlineLess(entry, deadlines_heap_[parent])) {
+      break;
+    }
+    HeapSet(index, deadlines_heap_[parent]);
+    index = parent;
+  }
+  HeapSet(index, entry);
+}
+
+void RequestInfoSet::SiftDown(size_t index) {
+  Entry* entry = deadlines_heap_[index];
+  const size_t size = deadlines_heap_.size();
+  while (true) {
+    const size_t first_child = index * kHeapArity + 1;
+    if (first_child >= size) {
+      break;
+    }
+    const size_t last_child = std::min(first_child + kHeapArity, size);
+    size_t min_child = first_child;
+    for (size_t child = first_child + 1; child < last_child; ++child) {
+      if (DeadlineLess(deadlines_heap_[child], deadlines_heap_[min_child])) {
+        min_child = child;
+      }
+    }
+    if (!DeadlineLess(deadlines_heap_[min_child], entry)) {
+      break;
+    }
+    HeapSet(index, deadlines_heap_[min_child]);
+    index = min_child;
+  }
+  HeapSet(index, entry);
+}
+
+RequestInfoSet::Entry* RequestInfoSet::HeapTop() {
+  while (!deadlines_heap_.empty()) {
+    Entry* top = deadlines_heap_.front();
+    const date_time::TimeDuration end_time = top->request_info_->end_time();
+    if (!(top->deadline_ < end_time)) {
+      return top;
+    }
+    top->deadline_ = end_time;
+    SiftDown(0);
+  }
+  return NULL;
 }
 
 }  // namespace request_controller
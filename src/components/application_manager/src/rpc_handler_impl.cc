@@ -33,6 +33,7 @@
 #include "application_manager/rpc_handler_impl.h"
 #include "application_manager/app_service_manager.h"
 #include "application_manager/plugin_manager/plugin_keys.h"
+#include "smart_objects/smart_object_arena.h"
 
 namespace application_manager {
 namespace rpc_handler {
@@ -357,18 +358,60 @@ bool RPCHandlerImpl::ConvertMessageToSO(
                 << message.protocol_version() << "; json "
                 << message.json_message());
 
+  // Decoded message and its schema-converted members share lifetime of the
+  // message, so they are taken from per-message arena instead of the heap.
+  // Arena memory is released once the last object using it is destroyed,
+  // parts of the message copied by commands later on are taken from the heap
+  smart_objects::SmartObjectArena message_arena;
+  smart_objects::SmartObjectArena::Scope arena_scope(&message_arena);
+
   switch (message.protocol_version()) {
     case protocol_handler::MajorProtocolVersion::PROTOCOL_VERSION_5:
     case protocol_handler::MajorProtocolVersion::PROTOCOL_VERSION_4:
     case protocol_handler::MajorProtocolVersion::PROTOCOL_VERSION_3:
     case protocol_handler::MajorProtocolVersion::PROTOCOL_VERSION_2: {
+      // Schema is used to convert enums while parsing, it is not attached
+      // when parameters are not going to be validated (e.g. RPC passing),
+      // so message is kept as is in that case
+      smart_objects::CSmartSchema schema;
+      smart_objects::ISchemaItem* msg_params_schema = NULL;
+      if (validate_params &&
+          mobile_so_factory().GetSchema(
+              static_cast<mobile_apis::FunctionID::eType>(
+                  message.function_id()),
+              static_cast<mobile_apis::messageType::eType>(message.type()),
+              schema)) {
+        auto msg_params_member =
+            schema.getSchemaItem()->GetMemberSchemaItem(strings::msg_params);
+        if (msg_params_member) {
+          msg_params_schema = msg_params_member->mSchemaItem;
+        }
+      }
+
+      // Binary payload may be negotiated in StartService ACK since v5 only
+      const bool is_bson_payload =
+          message.protocol_version() >=
+              protocol_handler::MajorProtocolVersion::PROTOCOL_VERSION_5 &&
+          protocol_handler::RPC_PAYLOAD_FORMAT_BSON ==
+              app_manager_.connection_handler().RpcPayloadFormatUsed(
+                  message.connection_key());
+
       const bool conversion_result =
-          formatters::CFormatterJsonSDLRPCv2::fromString(
-              message.json_message(),
-              output,
-              message.function_id(),
-              message.type(),
-              message.correlation_id());
+          is_bson_payload
+              ? formatters::CFormatterBsonSDLRPCv2::fromString(
+                    message.json_message(),
+                    output,
+                    message.function_id(),
+                    message.type(),
+                    message.correlation_id(),
+                    msg_params_schema)
+              : formatters::CFormatterJsonSDLRPCv2::fromString(
+                    message.json_message(),
+                    output,
+                    message.function_id(),
+                    message.type(),
+                    message.correlation_id(),
+                    msg_params_schema);
 
       rpc::ValidationReport report("RPC");
 
@@ -574,8 +574,8 @@ void RPCServiceImpl::SendMessageToMobile(
     const WindowID window_id =
         MessageHelper::ExtractWindowIdFromSmartObject(s_map);
     if (smart_objects::SmartType_Map == s_map.getType()) {
-      smart_objects::SmartMap::iterator iter = s_map.map_begin();
-      smart_objects::SmartMap::iterator iter_end = s_map.map_end();
+      smart_objects::SmartMap::const_iterator iter = s_map.map_begin();
+      smart_objects::SmartMap::const_iterator iter_end = s_map.map_end();
 
       for (; iter != iter_end; ++iter) {
         if (true == iter->second.asBool()) {
@@ -739,8 +739,22 @@ bool RPCServiceImpl::ConvertSOtoMessage(
         output.set_protocol_version(
             protocol_handler::MajorProtocolVersion::PROTOCOL_VERSION_1);
       } else {
-        if (!formatters::CFormatterJsonSDLRPCv2::toString(
-                message, output_string, !allow_unknown_parameters)) {
+        // Binary payload may be negotiated in StartService ACK since v5 only
+        const bool is_bson_payload =
+            protocol_version >=
+                protocol_handler::MajorProtocolVersion::PROTOCOL_VERSION_5 &&
+            protocol_handler::RPC_PAYLOAD_FORMAT_BSON ==
+                app_manager_.connection_handler().RpcPayloadFormatUsed(
+                    message.getElement(jhs::S_PARAMS)
+                        .getElement(strings::connection_key)
+                        .asUInt());
+        const bool serialized =
+            is_bson_payload
+                ? formatters::CFormatterBsonSDLRPCv2::toString(
+                      message, output_string, !allow_unknown_parameters)
+                : formatters::CFormatterJsonSDLRPCv2::toString(
+                      message, output_string, !allow_unknown_parameters);
+        if (!serialized) {
           SDL_LOG_WARN("Failed to serialize smart object");
           return false;
         }
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gmock/gmock.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "application_manager/application_registry.h"
+
+#include "application_manager/mock_application.h"
+
+namespace test {
+namespace components {
+namespace application_manager_test {
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace am = application_manager;
+
+namespace {
+const uint32_t kAppId = 11u;
+const uint32_t kHmiAppId = 101u;
+const std::string kPolicyAppId = "policy_app_id";
+const connection_handler::DeviceHandle kDevice = 1u;
+const connection_handler::DeviceHandle kOtherDevice = 2u;
+}  // namespace
+
+class ApplicationRegistryTest : public testing::Test {
+ protected:
+  std::shared_ptr<NiceMock<MockApplication> > CreateApp(
+      const uint32_t app_id,
+      const uint32_t hmi_app_id,
+      const std::string& policy_app_id,
+      const connection_handler::DeviceHandle device) {
+    std::shared_ptr<NiceMock<MockApplication> > app =
+        std::make_shared<NiceMock<MockApplication> >();
+    ON_CALL(*app, app_id()).WillByDefault(Return(app_id));
+    ON_CALL(*app, hmi_app_id()).WillByDefault(Return(hmi_app_id));
+    ON_CALL(*app, policy_app_id()).WillByDefault(Return(policy_app_id));
+    ON_CALL(*app, device()).WillByDefault(Return(device));
+    return app;
+  }
+
+  am::ApplicationRegistry registry_;
+};
+
+TEST_F(ApplicationRegistryTest, EmptyRegistry_NoApplicationsFound) {
+  const am::ApplicationRegistry::SnapshotPtr snapshot = registry_.snapshot();
+  ASSERT_TRUE(snapshot.get());
+  EXPECT_TRUE(snapshot->applications().empty());
+  EXPECT_FALSE(snapshot->FindByAppId(kAppId));
+  EXPECT_FALSE(snapshot->FindByHmiAppId(kHmiAppId));
+  EXPECT_FALSE(snapshot->FindByPolicyAppId(kPolicyAppId));
+  EXPECT_FALSE(snapshot->FindByDeviceAndPolicyAppId(kDevice, kPolicyAppId));
+}
+
+TEST_F(ApplicationRegistryTest, Publish_ApplicationsFoundByEachKey) {
+  am::ApplicationSet applications;
+  const am::ApplicationSharedPtr app =
+      CreateApp(kAppId, kHmiAppId, kPolicyAppId, kDevice);
+  const am::ApplicationSharedPtr other_app =
+      CreateApp(kAppId + 1, kHmiAppId + 1, kPolicyAppId, kOtherDevice);
+  applications.insert(app);
+  applications.insert(other_app);
+  registry_.Publish(applications);
+
+  const am::ApplicationRegistry::SnapshotPtr snapshot = registry_.snapshot();
+  EXPECT_EQ(2u, snapshot->applications().size());
+  EXPECT_EQ(app, snapshot->FindByAppId(kAppId));
+  EXPECT_EQ(other_app, snapshot->FindByAppId(kAppId + 1));
+  EXPECT_EQ(other_app, snapshot->FindByHmiAppId(kHmiAppId + 1));
+  // First application in applications list order is found
+  EXPECT_EQ(app, snapshot->FindByPolicyAppId(kPolicyAppId));
+  EXPECT_EQ(other_app,
+            snapshot->FindByDeviceAndPolicyAppId(kOtherDevice, kPolicyAppId));
+  EXPECT_FALSE(snapshot->FindByDeviceAndPolicyAppId(kOtherDevice, "unknown"));
+  EXPECT_FALSE(snapshot->FindByAppId(kAppId + 2));
+}
+
+TEST_F(ApplicationRegistryTest, IdChangedAfterPublish_ApplicationFound) {
+  am::ApplicationSet applications;
+  std::shared_ptr<NiceMock<MockApplication> > app =
+      CreateApp(kAppId, 0u, kPolicyAppId, kDevice);
+  applications.insert(app);
+  registry_.Publish(applications);
+
+  // HMI app id is assigned after application has been added to the list
+  ON_CALL(*app, hmi_app_id()).WillByDefault(Return(kHmiAppId));
+  const am::ApplicationRegistry::SnapshotPtr snapshot = registry_.snapshot();
+  EXPECT_EQ(app, snapshot->FindByHmiAppId(kHmiAppId));
+  EXPECT_FALSE(snapshot->FindByHmiAppId(0u));
+}
+
+TEST_F(ApplicationRegistryTest, Publish_TakenSnapshotIsNotChanged) {
+  am::ApplicationSet applications;
+  const am::ApplicationSharedPtr app =
+      CreateApp(kAppId, kHmiAppId, kPolicyAppId, kDevice);
+  applications.insert(app);
+  registry_.Publish(applications);
+  const am::ApplicationRegistry::SnapshotPtr old_snapshot =
+      registry_.snapshot();
+
+  applications.clear();
+  registry_.Publish(applications);
+
+  EXPECT_EQ(app, old_snapshot->FindByAppId(kAppId));
+  EXPECT_FALSE(registry_.snapshot()->FindByAppId(kAppId));
+}
+
+TEST_F(ApplicationRegistryTest, ConcurrentPublishAndLookup_NoDataRace) {
+  const size_t kIterations = 1000;
+  const am::ApplicationSharedPtr app =
+      CreateApp(kAppId, kHmiAppId, kPolicyAppId, kDevice);
+
+  std::thread reader([this, &app, kIterations]() {
+    for (size_t i = 0; i < kIterations; ++i) {
+      const am::ApplicationSharedPtr found =
+          registry_.snapshot()->FindByAppId(kAppId);
+      EXPECT_TRUE(!found || app == found);
+    }
+  });
+  am::ApplicationSet applications;
+  for (size_t i = 0; i < kIterations; ++i) {
+    if (applications.empty()) {
+      applications.insert(app);
+    } else {
+      applications.clear();
+    }
+    registry_.Publish(applications);
+  }
+  reader.join();
+}
+
+}  // namespace application_manager_test
+}  // namespace components
+}  // namespace test
@@ -181,6 +181,49 @@ TEST_F(EventEngineTest, Event_set_smart_object_ExpectObjectSet) {
   EXPECT_EQ(smart_object_with_type_notification, event_->smart_object());
 }
 
+TEST_F(EventEngineTest,
+       EventDispatcherImpl_RaiseEvent_NotSubscribedEvent_NoEntriesCreated) {
+  event_->set_smart_object(smart_object_with_type_response);
+  event_dispatcher_instance_->raise_event(*event_);
+  event_->set_smart_object(smart_object_with_type_notification);
+  event_dispatcher_instance_->raise_event(*event_);
+
+  EXPECT_EQ(0u, event_dispatcher_instance_->get_observed_events_count());
+}
+
+TEST_F(EventEngineTest,
+       EventDispatcherImpl_RemoveObserver_ExpectEmptyEntriesErased) {
+  event_dispatcher_instance_->add_observer(
+      event_id, correlation_id, event_observer_mock_);
+  event_dispatcher_instance_->add_observer(
+      event_id2, correlation_id + 1, event_observer_mock_);
+  event_dispatcher_instance_->add_observer(
+      event_id3, correlation_id, event_observer_mock_);
+  EXPECT_EQ(3u, event_dispatcher_instance_->get_observed_events_count());
+
+  event_dispatcher_instance_->remove_observer(event_id, event_observer_mock_);
+  EXPECT_EQ(2u, event_dispatcher_instance_->get_observed_events_count());
+
+  event_dispatcher_instance_->remove_observer(event_observer_mock_);
+  EXPECT_EQ(0u, event_dispatcher_instance_->get_observed_events_count());
+}
+
+TEST_F(EventEngineTest,
+       EventDispatcherImpl_RemoveObserver_ExpectEventNotRaisedForRemoved) {
+  MockEventObserver another_observer(mock_event_dispatcher_);
+  event_dispatcher_instance_->add_observer(
+      event_id3, correlation_id, event_observer_mock_);
+  event_dispatcher_instance_->add_observer(
+      event_id3, correlation_id, another_observer);
+  event_dispatcher_instance_->remove_observer(event_id3, event_observer_mock_);
+  event_->set_smart_object(smart_object_with_type_response);
+
+  EXPECT_CALL(event_observer_mock_, on_event(An<const Event&>())).Times(0);
+  EXPECT_CALL(another_observer, on_event(An<const Event&>())).Times(1);
+  event_dispatcher_instance_->raise_event(*event_);
+  EXPECT_EQ(1u, event_dispatcher_instance_->get_observed_events_count());
+}
+
 }  // namespace event_engine_test
 }  // namespace components
 }  // namespace test
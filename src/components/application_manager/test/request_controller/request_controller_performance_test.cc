@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "application_manager/mock_request.h"
+#include "application_manager/mock_request_controller_settings.h"
+#include "application_manager/request_controller.h"
+#include "utils/lock.h"
+#include "utils/test_async_waiter.h"
+
+namespace test {
+namespace components {
+namespace request_controller_test {
+
+using ::application_manager::request_controller::RequestController;
+
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+typedef NiceMock<application_manager_test::MockRequest> MRequest;
+typedef std::shared_ptr<MRequest> RequestPtr;
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+const uint32_t kThreadPoolSize = 4u;
+const uint32_t kAppsCount = 16u;
+const uint32_t kRequestsPerApp = 50u;
+// Each kLongRequestPeriod-th request of application is a long one
+const uint32_t kLongRequestPeriod = 5u;
+const uint32_t kLongRequestDurationMs = 2u;
+const uint32_t kWaitTimeoutMs = 10000u;
+const uint32_t kNoLimit = 0u;
+
+uint64_t Percentile(const std::vector<uint64_t>& sorted, const double rank) {
+  const size_t index = static_cast<size_t>(rank * (sorted.size() - 1));
+  return sorted[index];
+}
+}  // namespace
+
+/*
+ * Dispatch latency of mixed short and long requests of several applications.
+ * Latency percentiles are recorded as "p50_us" and "p99_us" test properties,
+ * so they could be compared between builds with --gtest_output=xml.
+ * Disabled by default, run with --gtest_also_run_disabled_tests.
+ */
+TEST(RequestControllerPerformanceTest, DISABLED_MixedRequestsDispatchLatency) {
+  NiceMock<application_manager_test::MockRequestControlerSettings> settings;
+  ON_CALL(settings, thread_pool_size()).WillByDefault(Return(kThreadPoolSize));
+  ON_CALL(settings, app_hmi_level_none_time_scale())
+      .WillByDefault(ReturnRef(kNoLimit));
+  ON_CALL(settings, app_hmi_level_none_time_scale_max_requests())
+      .WillByDefault(ReturnRef(kNoLimit));
+  ON_CALL(settings, app_time_scale()).WillByDefault(ReturnRef(kNoLimit));
+  ON_CALL(settings, app_time_scale_max_requests())
+      .WillByDefault(ReturnRef(kNoLimit));
+  ON_CALL(settings, pending_requests_amount())
+      .WillByDefault(ReturnRef(kNoLimit));
+
+  RequestController request_ctrl(settings);
+
+  const size_t requests_count = kAppsCount * kRequestsPerApp;
+  std::vector<Clock::time_point> added_at(requests_count);
+  std::vector<uint64_t> latencies_us;
+  latencies_us.reserve(requests_count);
+  sync_primitives::Lock latencies_lock;
+  auto waiter = test::TestAsyncWaiter::createInstance();
+
+  std::vector<RequestPtr> requests;
+  requests.reserve(requests_count);
+  for (uint32_t corr_id = 0u; corr_id < kRequestsPerApp; ++corr_id) {
+    for (uint32_t app = 0u; app < kAppsCount; ++app) {
+      const size_t index = requests.size();
+      const bool is_long = 0u == (corr_id + 1u) % kLongRequestPeriod;
+      RequestPtr request = std::make_shared<MRequest>(app + 1u, corr_id);
+      ON_CALL(*request, default_timeout()).WillByDefault(Return(0u));
+      ON_CALL(*request, CheckPermissions()).WillByDefault(Return(true));
+      ON_CALL(*request, Init()).WillByDefault(Return(true));
+      ON_CALL(*request, Run()).WillByDefault(Invoke([&, index, is_long]() {
+        const auto started_at = Clock::now();
+        {
+          sync_primitives::AutoLock auto_lock(latencies_lock);
+          latencies_us.push_back(
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  started_at - added_at[index])
+                  .count());
+        }
+        if (is_long) {
+          std::this_thread::sleep_for(
+              std::chrono::milliseconds(kLongRequestDurationMs));
+        }
+        waiter->Notify();
+      }));
+      requests.push_back(request);
+    }
+  }
+
+  for (size_t i = 0u; i < requests.size(); ++i) {
+    added_at[i] = Clock::now();
+    EXPECT_EQ(RequestController::SUCCESS,
+              request_ctrl.addMobileRequest(
+                  requests[i], mobile_apis::HMILevel::HMI_FULL));
+  }
+
+  ASSERT_TRUE(waiter->WaitFor(requests_count, kWaitTimeoutMs));
+
+  sync_primitives::AutoLock auto_lock(latencies_lock);
+  ASSERT_EQ(requests_count, latencies_us.size());
+  std::sort(latencies_us.begin(), latencies_us.end());
+  RecordProperty("p50_us", static_cast<int>(Percentile(latencies_us, 0.5)));
+  RecordProperty("p99_us", static_cast<int>(Percentile(latencies_us, 0.99)));
+}
+
+}  // namespace request_controller_test
+}  // namespace components
+}  // namespace test
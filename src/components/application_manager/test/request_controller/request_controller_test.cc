@@ -31,6 +31,7 @@
  */
 
 #include <stdint.h>
+#include <vector>
 
 #include "application_manager/mock_request.h"
 #include "application_manager/request_controller.h"
@@ -49,6 +50,7 @@
 #include "application_manager/resumption/resume_ctrl.h"
 #include "application_manager/state_controller.h"
 #include "resumption/last_state.h"
+#include "utils/lock.h"
 #include "utils/test_async_waiter.h"
 
 namespace test {
@@ -59,6 +61,7 @@ using ::application_manager::request_controller::RequestController;
 using ::application_manager::request_controller::RequestInfo;
 
 using ::testing::_;
+using ::testing::Invoke;
 using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::ReturnRef;
@@ -295,6 +298,84 @@ TEST_F(RequestControllerTestClass, OnTimer_SUCCESS) {
   EXPECT_TRUE(waiter->WaitFor(1, kTimeScale));
 }
 
+TEST_F(RequestControllerTestClass,
+       AddMobileRequest_SameApplication_ExecutedInOrder) {
+  const uint32_t kAppConnectionKey = 1u;
+  sync_primitives::Lock run_order_lock;
+  std::vector<uint32_t> run_order;
+  auto waiter = TestAsyncWaiter::createInstance();
+
+  std::vector<RequestPtr> requests;
+  for (uint32_t corr_id = 1u; corr_id <= kNumberOfRequests; ++corr_id) {
+    RequestPtr request = GetMockRequest(corr_id, kAppConnectionKey, 0u);
+    ON_CALL(*request, Init()).WillByDefault(Return(true));
+    EXPECT_CALL(*request, Run())
+        .WillOnce(Invoke([&run_order_lock, &run_order, waiter, corr_id]() {
+          sync_primitives::AutoLock auto_lock(run_order_lock);
+          run_order.push_back(corr_id);
+          waiter->Notify();
+        }));
+    requests.push_back(request);
+  }
+
+  for (auto& request : requests) {
+    EXPECT_EQ(RequestController::SUCCESS,
+              AddRequest(default_settings_,
+                         request,
+                         RequestInfo::RequestType::MobileRequest,
+                         mobile_apis::HMILevel::HMI_FULL));
+  }
+
+  EXPECT_TRUE(waiter->WaitFor(kNumberOfRequests, kTimeScale));
+  sync_primitives::AutoLock auto_lock(run_order_lock);
+  ASSERT_EQ(kNumberOfRequests, run_order.size());
+  for (uint32_t i = 0u; i < run_order.size(); ++i) {
+    EXPECT_EQ(i + 1u, run_order[i]);
+  }
+}
+
+TEST_F(RequestControllerTestClass,
+       AddMobileRequest_DifferentApplications_ExecutedInParallel) {
+  const uint32_t kParallelPoolSize = 2u;
+  ON_CALL(mock_request_controller_settings_, thread_pool_size())
+      .WillByDefault(Return(kParallelPoolSize));
+  request_ctrl_ =
+      std::make_shared<RequestController>(mock_request_controller_settings_);
+
+  RequestPtr blocking_request = GetMockRequest(1u, 1u, 0u);
+  RequestPtr unblocking_request = GetMockRequest(1u, 2u, 0u);
+  ON_CALL(*blocking_request, Init()).WillByDefault(Return(true));
+  ON_CALL(*unblocking_request, Init()).WillByDefault(Return(true));
+
+  auto unblocked = TestAsyncWaiter::createInstance();
+  auto finished = TestAsyncWaiter::createInstance();
+  bool was_unblocked = false;
+
+  // First application request can complete only if request of another
+  // application is executed while it is still running
+  EXPECT_CALL(*blocking_request, Run())
+      .WillOnce(Invoke([unblocked, finished, &was_unblocked]() {
+        was_unblocked = unblocked->WaitFor(1, kTimeScale);
+        finished->Notify();
+      }));
+  EXPECT_CALL(*unblocking_request, Run())
+      .WillOnce(NotifyTestAsyncWaiter(unblocked));
+
+  EXPECT_EQ(RequestController::SUCCESS,
+            AddRequest(default_settings_,
+                       blocking_request,
+                       RequestInfo::RequestType::MobileRequest,
+                       mobile_apis::HMILevel::HMI_FULL));
+  EXPECT_EQ(RequestController::SUCCESS,
+            AddRequest(default_settings_,
+                       unblocking_request,
+                       RequestInfo::RequestType::MobileRequest,
+                       mobile_apis::HMILevel::HMI_FULL));
+
+  EXPECT_TRUE(finished->WaitFor(1, 2 * kTimeScale));
+  EXPECT_TRUE(was_unblocked);
+}
+
 }  // namespace request_controller_test
 }  // namespace components
 }  // namespace test
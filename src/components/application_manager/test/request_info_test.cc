@@ -358,6 +358,60 @@ TEST_F(RequestInfoTest, UpdateTimeOut) {
       date_time::getSecs(time) + 100, date_time::getSecs(last_time), 500);
 }
 
+TEST_F(RequestInfoTest, RequestInfoSetUpdateTimeout_ExtendTimeout) {
+  std::shared_ptr<TestRequestInfo> first_request =
+      CreateTestInfo(mobile_connection_key1_,
+                     mobile_correlation_id,
+                     request_info::RequestInfo::MobileRequest,
+                     date_time::getCurrentTime(),
+                     default_timeout_);
+  std::shared_ptr<TestRequestInfo> second_request =
+      CreateTestInfo(mobile_connection_key2_,
+                     mobile_correlation_id,
+                     request_info::RequestInfo::MobileRequest,
+                     date_time::getCurrentTime(),
+                     10 * default_timeout_);
+  EXPECT_TRUE(request_info_set_.Add(first_request));
+  EXPECT_TRUE(request_info_set_.Add(second_request));
+  EXPECT_EQ(first_request, request_info_set_.FrontWithNotNullTimeout());
+
+  EXPECT_TRUE(request_info_set_.UpdateTimeout(
+      mobile_connection_key1_, mobile_correlation_id, 100 * default_timeout_));
+  EXPECT_EQ(second_request, request_info_set_.FrontWithNotNullTimeout());
+
+  EXPECT_TRUE(request_info_set_.UpdateTimeout(
+      mobile_connection_key1_, mobile_correlation_id, 1));
+  EXPECT_EQ(first_request, request_info_set_.FrontWithNotNullTimeout());
+  EXPECT_EQ(2u, request_info_set_.Size());
+}
+
+TEST_F(RequestInfoTest, RequestInfoSetUpdateTimeout_NullTimeout) {
+  std::shared_ptr<TestRequestInfo> request =
+      CreateTestInfo(mobile_connection_key1_,
+                     mobile_correlation_id,
+                     request_info::RequestInfo::MobileRequest,
+                     date_time::getCurrentTime(),
+                     default_timeout_);
+  EXPECT_TRUE(request_info_set_.Add(request));
+
+  EXPECT_TRUE(request_info_set_.UpdateTimeout(
+      mobile_connection_key1_, mobile_correlation_id, 0));
+  EXPECT_FALSE(request_info_set_.FrontWithNotNullTimeout());
+  EXPECT_EQ(request, request_info_set_.Find(mobile_connection_key1_,
+                                            mobile_correlation_id));
+
+  EXPECT_TRUE(request_info_set_.UpdateTimeout(
+      mobile_connection_key1_, mobile_correlation_id, default_timeout_));
+  EXPECT_EQ(request, request_info_set_.FrontWithNotNullTimeout());
+  EXPECT_TRUE(request_info_set_.RemoveRequest(request));
+  EXPECT_FALSE(request_info_set_.FrontWithNotNullTimeout());
+}
+
+TEST_F(RequestInfoTest, RequestInfoSetUpdateTimeout_UnknownRequest) {
+  EXPECT_FALSE(request_info_set_.UpdateTimeout(
+      mobile_connection_key1_, mobile_correlation_id, default_timeout_));
+}
+
 }  // namespace application_manager_test
 }  // namespace components
 }  // namespace test
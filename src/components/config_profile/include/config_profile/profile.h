@@ -420,6 +420,11 @@ class Profile : public protocol_handler::ProtocolHandlerSettings,
   const std::string& transport_manager_tcp_adapter_network_interface()
       const OVERRIDE;
 
+  /**
+   * @brief Returns number of threads serving socket connections
+   */
+  uint32_t transport_manager_io_reactor_threads() const OVERRIDE;
+
 #ifdef WEBSOCKET_SERVER_TRANSPORT_SUPPORT
   /**
    * @brief Returns websocket server address
@@ -709,6 +714,12 @@ class Profile : public protocol_handler::ProtocolHandlerSettings,
 
   uint32_t multiframe_waiting_timeout() const OVERRIDE;
 
+  size_t frame_pool_thread_cache_size() const OVERRIDE;
+
+  size_t frame_pool_shared_cache_size() const OVERRIDE;
+
+  uint32_t frame_pool_trim_period() const OVERRIDE;
+
   uint32_t heart_beat_timeout() const OVERRIDE;
 
   uint16_t max_supported_protocol_version() const OVERRIDE;
@@ -1044,6 +1055,7 @@ class Profile : public protocol_handler::ProtocolHandlerSettings,
   std::string system_files_path_;
   uint16_t transport_manager_tcp_adapter_port_;
   std::string transport_manager_tcp_adapter_network_interface_;
+  uint32_t transport_manager_io_reactor_threads_;
 #ifdef WEBSOCKET_SERVER_TRANSPORT_SUPPORT
   std::string websocket_server_address_;
   uint16_t websocket_server_port_;
@@ -1128,6 +1140,9 @@ class Profile : public protocol_handler::ProtocolHandlerSettings,
   size_t malformed_frequency_count_;
   size_t malformed_frequency_time_;
   uint32_t multiframe_waiting_timeout_;
+  size_t frame_pool_thread_cache_size_;
+  size_t frame_pool_shared_cache_size_;
+  uint32_t frame_pool_trim_period_;
   uint16_t attempts_to_open_policy_db_;
   uint16_t open_attempt_timeout_ms_;
   uint32_t resumption_delay_before_ign_;
@@ -158,6 +158,7 @@ const char* kMaxSupportedProtocolVersionKey = "MaxSupportedProtocolVersion";
 const char* kUseLastStateKey = "UseLastState";
 const char* kTCPAdapterPortKey = "TCPAdapterPort";
 const char* kTCPAdapterNetworkInterfaceKey = "TCPAdapterNetworkInterface";
+const char* kIOReactorThreadsKey = "IOReactorThreads";
 #ifdef WEBSOCKET_SERVER_TRANSPORT_SUPPORT
 const char* kWebSocketServerAddressKey = "WebSocketServerAddress";
 const char* kWebSocketServerPortKey = "WebSocketServerPort";
@@ -231,6 +232,9 @@ const char* kMalformedFrequencyCount = "MalformedFrequencyCount";
 const char* kMalformedFrequencyTime = "MalformedFrequencyTime";
 const char* kExpectedConsecutiveFramesTimeout =
     "ExpectedConsecutiveFramesTimeout";
+const char* kFramePoolThreadCacheSizeKey = "FramePoolThreadCacheSize";
+const char* kFramePoolSharedCacheSizeKey = "FramePoolSharedCacheSize";
+const char* kFramePoolTrimPeriodKey = "FramePoolTrimPeriod";
 const char* kHashStringSizeKey = "HashStringSize";
 const char* kUseDBForResumptionKey = "UseDBForResumption";
 const char* kAttemptsToOpenResumptionDBKey = "AttemptsToOpenResumptionDB";
@@ -346,6 +350,7 @@ const uint32_t kDefaultHubProtocolIndex = 0;
 const uint32_t kDefaultHeartBeatTimeout = 5000;
 const uint16_t kDefaultMaxSupportedProtocolVersion = 5;
 const uint16_t kDefautTransportManagerTCPPort = 12345;
+const uint32_t kDefaultTransportManagerIOReactorThreads = 2;
 const uint16_t kDefaultWebSocketServerPort = 2020;
 const uint16_t kDefaultCloudAppRetryTimeout = 1000;
 const uint16_t kDefaultCloudAppMaxRetryAttempts = 5;
@@ -391,6 +396,9 @@ const bool kDefaulMalformedMessageFiltering = true;
 const size_t kDefaultMalformedFrequencyCount = 10;
 const size_t kDefaultMalformedFrequencyTime = 1000;
 const uint32_t kDefaultExpectedConsecutiveFramesTimeout = 10000;
+const size_t kDefaultFramePoolThreadCacheSize = 524288;
+const size_t kDefaultFramePoolSharedCacheSize = 2097152;
+const uint32_t kDefaultFramePoolTrimPeriod = 10000;
 const uint16_t kDefaultAttemptsToOpenPolicyDB = 5;
 const uint16_t kDefaultOpenAttemptTimeoutMs = 500;
 const uint32_t kDefaultAppIconsFolderMaxSize = 104857600;
@@ -509,6 +517,8 @@ Profile::Profile()
     , supported_diag_modes_()
     , system_files_path_(kDefaultSystemFilesPath)
     , transport_manager_tcp_adapter_port_(kDefautTransportManagerTCPPort)
+    , transport_manager_io_reactor_threads_(
+          kDefaultTransportManagerIOReactorThreads)
 #ifdef WEBSOCKET_SERVER_TRANSPORT_SUPPORT
     , websocket_server_address_(kDefaultWebsocketServerAddress)
     , websocket_server_port_(kDefaultWebSocketServerPort)
@@ -540,6 +550,9 @@ Profile::Profile()
     , malformed_frequency_count_(kDefaultMalformedFrequencyCount)
     , malformed_frequency_time_(kDefaultMalformedFrequencyTime)
     , multiframe_waiting_timeout_(kDefaultExpectedConsecutiveFramesTimeout)
+    , frame_pool_thread_cache_size_(kDefaultFramePoolThreadCacheSize)
+    , frame_pool_shared_cache_size_(kDefaultFramePoolSharedCacheSize)
+    , frame_pool_trim_period_(kDefaultFramePoolTrimPeriod)
     , attempts_to_open_policy_db_(kDefaultAttemptsToOpenPolicyDB)
     , open_attempt_timeout_ms_(kDefaultAttemptsToOpenPolicyDB)
     , resumption_delay_before_ign_(kDefaultResumptionDelayBeforeIgn)
@@ -857,6 +870,10 @@ const std::string& Profile::transport_manager_tcp_adapter_network_interface()
   return transport_manager_tcp_adapter_network_interface_;
 }
 
+uint32_t Profile::transport_manager_io_reactor_threads() const {
+  return transport_manager_io_reactor_threads_;
+}
+
 #ifdef WEBSOCKET_SERVER_TRANSPORT_SUPPORT
 const std::string& Profile::websocket_server_address() const {
   return websocket_server_address_;
@@ -1024,6 +1041,18 @@ uint32_t Profile::multiframe_waiting_timeout() const {
   return multiframe_waiting_timeout_;
 }
 
+size_t Profile::frame_pool_thread_cache_size() const {
+  return frame_pool_thread_cache_size_;
+}
+
+size_t Profile::frame_pool_shared_cache_size() const {
+  return frame_pool_shared_cache_size_;
+}
+
+uint32_t Profile::frame_pool_trim_period() const {
+  return frame_pool_trim_period_;
+}
+
 uint16_t Profile::attempts_to_open_policy_db() const {
   return attempts_to_open_policy_db_;
 }
@@ -1983,6 +2012,21 @@ void Profile::UpdateValues() {
   LOG_UPDATED_VALUE(transport_manager_tcp_adapter_network_interface_,
                     kTCPAdapterNetworkInterfaceKey,
                     kTransportManagerSection);
+
+  // Transport manager socket I/O threads
+  ReadUIntValue(&transport_manager_io_reactor_threads_,
+                kDefaultTransportManagerIOReactorThreads,
+                kTransportManagerSection,
+                kIOReactorThreadsKey);
+
+  if (0 == transport_manager_io_reactor_threads_) {
+    transport_manager_io_reactor_threads_ =
+        kDefaultTransportManagerIOReactorThreads;
+  }
+
+  LOG_UPDATED_VALUE(transport_manager_io_reactor_threads_,
+                    kIOReactorThreadsKey,
+                    kTransportManagerSection);
 #ifdef WEBSOCKET_SERVER_TRANSPORT_SUPPORT
   // Websocket server address
   ReadStringValue(&websocket_server_address_,
@@ -2243,6 +2287,36 @@ void Profile::UpdateValues() {
                     kExpectedConsecutiveFramesTimeout,
                     kProtocolHandlerSection);
 
+  // Memory cached for frames by each thread
+  ReadUIntValue(&frame_pool_thread_cache_size_,
+                kDefaultFramePoolThreadCacheSize,
+                kProtocolHandlerSection,
+                kFramePoolThreadCacheSizeKey);
+
+  LOG_UPDATED_VALUE(frame_pool_thread_cache_size_,
+                    kFramePoolThreadCacheSizeKey,
+                    kProtocolHandlerSection);
+
+  // Memory cached for frames shared between threads
+  ReadUIntValue(&frame_pool_shared_cache_size_,
+                kDefaultFramePoolSharedCacheSize,
+                kProtocolHandlerSection,
+                kFramePoolSharedCacheSizeKey);
+
+  LOG_UPDATED_VALUE(frame_pool_shared_cache_size_,
+                    kFramePoolSharedCacheSizeKey,
+                    kProtocolHandlerSection);
+
+  // Period of returning unused frame memory to system
+  ReadUIntValue(&frame_pool_trim_period_,
+                kDefaultFramePoolTrimPeriod,
+                kProtocolHandlerSection,
+                kFramePoolTrimPeriodKey);
+
+  LOG_UPDATED_VALUE(frame_pool_trim_period_,
+                    kFramePoolTrimPeriodKey,
+                    kProtocolHandlerSection);
+
   // Attempts number for opening policy DB
   ReadUIntValue(&attempts_to_open_policy_db_,
                 kDefaultAttemptsToOpenPolicyDB,
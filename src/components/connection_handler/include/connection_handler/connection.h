@@ -100,6 +100,7 @@ struct Session {
   ServiceList service_list;
   uint8_t protocol_version;
   utils::SemanticVersion full_protocol_version;
+  ::protocol_handler::RpcPayloadFormat rpc_payload_format;
 #ifdef ENABLE_SECURITY
   security_manager::SSLContext* ssl_context;
 #endif  // ENABLE_SECURITY
@@ -107,6 +108,7 @@ struct Session {
       : service_list()
       , protocol_version(::protocol_handler::PROTOCOL_VERSION_2)
       , full_protocol_version(utils::SemanticVersion(2, 0, 0))
+      , rpc_payload_format(::protocol_handler::RPC_PAYLOAD_FORMAT_JSON)
 #ifdef ENABLE_SECURITY
       , ssl_context(NULL)
 #endif  // ENABLE_SECURITY
@@ -116,6 +118,7 @@ struct Session {
       : service_list(services)
       , protocol_version(protocol_version)
       , full_protocol_version(utils::SemanticVersion(protocol_version, 0, 0))
+      , rpc_payload_format(::protocol_handler::RPC_PAYLOAD_FORMAT_JSON)
 #ifdef ENABLE_SECURITY
       , ssl_context(NULL)
 #endif  // ENABLE_SECURITY
@@ -322,6 +325,15 @@ class Connection {
   void UpdateProtocolVersionSession(
       uint8_t session_id, const utils::SemanticVersion& full_protocol_version);
 
+  /**
+   * @brief changes RPC payload format in session
+   * @param  session_id session id
+   * @param  rpc_payload_format format negotiated for RPC service
+   */
+  void UpdateRpcPayloadFormatSession(
+      uint8_t session_id,
+      const ::protocol_handler::RpcPayloadFormat rpc_payload_format);
+
   /**
    * @brief checks if session supports heartbeat
    * @param  session_id session id
@@ -349,6 +361,17 @@ class Connection {
   bool ProtocolVersion(uint8_t session_id,
                        utils::SemanticVersion& full_protocol_version);
 
+  /**
+   * @brief find RPC payload format for session
+   * @param session_id id of session which is launched on mobile side
+   * @param rpc_payload_format where to write the payload format
+   * @return TRUE if session exists otherwise
+   *   return FALSE
+   */
+  bool RpcPayloadFormat(
+      uint8_t session_id,
+      ::protocol_handler::RpcPayloadFormat& rpc_payload_format);
+
   /**
    * @brief Returns the primary connection handle associated with this
    * connection
@@ -514,6 +514,23 @@ class ConnectionHandlerImpl
       uint32_t connection_key,
       const utils::SemanticVersion& full_protocol_version) OVERRIDE;
 
+  /**
+   * @brief binds RPC payload format negotiated for RPC service with session
+   * @param connection_key pair of connection and session id
+   * @param rpc_payload_format format of RPC payload used by the session
+   */
+  void BindRpcPayloadFormatWithSession(
+      uint32_t connection_key,
+      const protocol_handler::RpcPayloadFormat rpc_payload_format) OVERRIDE;
+
+  /**
+   * @brief returns RPC payload format negotiated for session
+   * @param connection_key pair of connection and session id
+   * @return format bound with session, JSON if session does not exist
+   */
+  protocol_handler::RpcPayloadFormat RpcPayloadFormatUsed(
+      uint32_t connection_key) const OVERRIDE;
+
   /**
    * \brief returns TRUE if session supports sending HEART BEAT ACK to mobile
    * side
@@ -500,6 +500,19 @@ void Connection::UpdateProtocolVersionSession(
   session.full_protocol_version = full_protocol_version;
 }
 
+void Connection::UpdateRpcPayloadFormatSession(
+    uint8_t session_id,
+    const protocol_handler::RpcPayloadFormat rpc_payload_format) {
+  SDL_LOG_AUTO_TRACE();
+  sync_primitives::AutoLock lock(session_map_lock_);
+  SessionMap::iterator session_it = session_map_.find(session_id);
+  if (session_map_.end() == session_it) {
+    SDL_LOG_WARN("Session not found in this connection!");
+    return;
+  }
+  (session_it->second).rpc_payload_format = rpc_payload_format;
+}
+
 bool Connection::SupportHeartBeat(uint8_t session_id) {
   SDL_LOG_AUTO_TRACE();
   sync_primitives::AutoLock lock(session_map_lock_);
@@ -544,6 +557,20 @@ bool Connection::ProtocolVersion(
   return true;
 }
 
+bool Connection::RpcPayloadFormat(
+    uint8_t session_id,
+    protocol_handler::RpcPayloadFormat& rpc_payload_format) {
+  SDL_LOG_AUTO_TRACE();
+  sync_primitives::AutoLock lock(session_map_lock_);
+  SessionMap::iterator session_it = session_map_.find(session_id);
+  if (session_map_.end() == session_it) {
+    SDL_LOG_WARN("Session not found in this connection!");
+    return false;
+  }
+  rpc_payload_format = (session_it->second).rpc_payload_format;
+  return true;
+}
+
 ConnectionHandle Connection::primary_connection_handle() const {
   return primary_connection_handle_;
 }
@@ -1832,6 +1832,38 @@ void ConnectionHandlerImpl::BindProtocolVersionWithSession(
   }
 }
 
+void ConnectionHandlerImpl::BindRpcPayloadFormatWithSession(
+    uint32_t connection_key,
+    const protocol_handler::RpcPayloadFormat rpc_payload_format) {
+  SDL_LOG_AUTO_TRACE();
+  uint32_t connection_handle = 0;
+  uint8_t session_id = 0;
+  PairFromKey(connection_key, &connection_handle, &session_id);
+
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
+  auto connection = GetPrimaryConnection(connection_handle);
+  if (connection) {
+    connection->UpdateRpcPayloadFormatSession(session_id, rpc_payload_format);
+  }
+}
+
+protocol_handler::RpcPayloadFormat ConnectionHandlerImpl::RpcPayloadFormatUsed(
+    uint32_t connection_key) const {
+  SDL_LOG_AUTO_TRACE();
+  uint32_t connection_handle = 0;
+  uint8_t session_id = 0;
+  PairFromKey(connection_key, &connection_handle, &session_id);
+
+  protocol_handler::RpcPayloadFormat rpc_payload_format =
+      protocol_handler::RPC_PAYLOAD_FORMAT_JSON;
+  sync_primitives::AutoReadLock lock(connection_list_lock_);
+  auto connection = GetPrimaryConnection(connection_handle);
+  if (connection) {
+    connection->RpcPayloadFormat(session_id, rpc_payload_format);
+  }
+  return rpc_payload_format;
+}
+
 bool ConnectionHandlerImpl::IsHeartBeatSupported(
     transport_manager::ConnectionUID connection_handle,
     uint8_t session_id) const {
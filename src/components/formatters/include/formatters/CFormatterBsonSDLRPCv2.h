@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_CFORMATTERBSONSDLRPCV2_H_
+#define SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_CFORMATTERBSONSDLRPCV2_H_
+
+#include <string>
+
+#include "smart_objects/smart_object.h"
+
+#include "formatters/CSmartFactory.h"
+#include "formatters/bson_smart_object_reader.h"
+
+namespace ns_smart_device_link {
+namespace ns_json_handler {
+namespace formatters {
+
+/**
+ * @brief Class is used to convert SmartObjects to BSON payload and vice versa.
+ *
+ * Payload is the binary counterpart of SDLRPCv2 JSON payload: msg_params
+ * encoded as BSON document. Payload bytes are kept in std::string, so it
+ * can be carried in the same message field as JSON.
+ */
+class CFormatterBsonSDLRPCv2 {
+ private:
+  /**
+   * @brief Hidden constructor.
+   *
+   * The class contains only static methods. Should not be instantiated.
+   */
+  CFormatterBsonSDLRPCv2();
+
+  /**
+   * @brief Hidden copy constructor.
+   *
+   * The class contains only static methods. Should not be instantiated.
+   */
+  CFormatterBsonSDLRPCv2(const CFormatterBsonSDLRPCv2&);
+
+ public:
+  /**
+   * @brief Creates a BSON payload from a SmartObject.
+   *
+   * @param obj input SmartObject
+   * @param outStr resulting BSON document bytes
+   * @param remove_unknown_parameters contains true if need to remove unknown
+   *parameters
+   * @return true if success, false otherwise
+   */
+  static bool toString(
+      const ns_smart_device_link::ns_smart_objects::SmartObject& obj,
+      std::string& outStr,
+      const bool remove_unknown_parameters = true);
+
+  /**
+   * @brief Creates a SmartObject from a BSON payload in a single pass.
+   *
+   * Payload is decoded directly into the SmartObject, enum values are
+   * converted while decoding if schema of msg_params is provided.
+   *
+   * @param str Input BSON document bytes
+   * @param out Output SmartObject
+   * @param functionId The corresponding field in SmartObject is filled with
+   *this param.
+   * @param messageType The corresponding field in SmartObject is filled with
+   *this param.
+   * @param correlatioId The corresponding field in SmartObject is filled with
+   *this param.
+   * @param msg_params_schema Schema item of msg_params, may be NULL
+   * @return true if success, otherwise - false
+   */
+  template <typename FunctionId, typename MessageType>
+  static bool fromString(
+      const std::string& str,
+      ns_smart_device_link::ns_smart_objects::SmartObject& out,
+      FunctionId functionId,
+      MessageType messageType,
+      int32_t correlationId,
+      ns_smart_device_link::ns_smart_objects::ISchemaItem* msg_params_schema);
+};
+
+template <typename FunctionId, typename MessageType>
+inline bool CFormatterBsonSDLRPCv2::fromString(
+    const std::string& str,
+    ns_smart_device_link::ns_smart_objects::SmartObject& out,
+    FunctionId functionId,
+    MessageType messageType,
+    int32_t correlationId,
+    ns_smart_device_link::ns_smart_objects::ISchemaItem* msg_params_schema) {
+  namespace strings = ns_smart_device_link::ns_json_handler::strings;
+
+  if (!BsonSmartObjectReader::Parse(
+          str, out[strings::S_MSG_PARAMS], msg_params_schema)) {
+    out.erase(strings::S_MSG_PARAMS);
+    return false;
+  }
+
+  out[strings::S_PARAMS][strings::S_MESSAGE_TYPE] = messageType;
+  out[strings::S_PARAMS][strings::S_FUNCTION_ID] = functionId;
+  out[strings::S_PARAMS][strings::S_PROTOCOL_TYPE] = 0;
+  out[strings::S_PARAMS][strings::S_PROTOCOL_VERSION] = 2;
+  out[strings::S_PARAMS][strings::S_CORRELATION_ID] = correlationId;
+
+  return true;
+}
+
+}  // namespace formatters
+}  // namespace ns_json_handler
+}  // namespace ns_smart_device_link
+
+#endif  // SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_CFORMATTERBSONSDLRPCV2_H_
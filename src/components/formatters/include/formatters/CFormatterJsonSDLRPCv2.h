@@ -37,6 +37,7 @@
 
 #include "CFormatterJsonBase.h"
 #include "formatters/CSmartFactory.h"
+#include "formatters/json_smart_object_reader.h"
 
 namespace ns_smart_device_link {
 namespace ns_json_handler {
@@ -124,6 +125,34 @@ class CFormatterJsonSDLRPCv2 : public CFormatterJsonBase {
       MessageType messageType,
       int32_t correlationId);
 
+  /**
+   * @brief Creates a SmartObject from a JSON string in a single pass.
+   *
+   * Version guided by the schema of msg_params. String is parsed directly
+   * into the SmartObject, enum values are converted while parsing.
+   * Falls back to the jsoncpp based fromString if string can not be
+   * handled by JsonSmartObjectReader.
+   *
+   * @param str Input JSON string in SDLRPCv2 format
+   * @param out Output SmartObject
+   * @param functionId The corresponding field in SmartObject is filled with
+   *this param.
+   * @param messageType The corresponding field in SmartObject is filled with
+   *this param.
+   * @param correlatioId The corresponding field in SmartObject is filled with
+   *this param.
+   * @param msg_params_schema Schema item of msg_params, may be NULL
+   * @return true if success, otherwise - false
+   */
+  template <typename FunctionId, typename MessageType>
+  static bool fromString(
+      const std::string& str,
+      ns_smart_device_link::ns_smart_objects::SmartObject& out,
+      FunctionId functionId,
+      MessageType messageType,
+      int32_t correlationId,
+      ns_smart_device_link::ns_smart_objects::ISchemaItem* msg_params_schema);
+
   /**
    * @brief Converts to string the smart object against the given schema
    *
@@ -191,6 +220,31 @@ inline bool CFormatterJsonSDLRPCv2::fromString(
 
   return result;
 }
+
+template <typename FunctionId, typename MessageType>
+inline bool CFormatterJsonSDLRPCv2::fromString(
+    const std::string& str,
+    ns_smart_device_link::ns_smart_objects::SmartObject& out,
+    FunctionId functionId,
+    MessageType messageType,
+    int32_t correlationId,
+    ns_smart_device_link::ns_smart_objects::ISchemaItem* msg_params_schema) {
+  namespace strings = ns_smart_device_link::ns_json_handler::strings;
+
+  if (!JsonSmartObjectReader::Parse(
+          str, out[strings::S_MSG_PARAMS], msg_params_schema)) {
+    out.erase(strings::S_MSG_PARAMS);
+    return fromString(str, out, functionId, messageType, correlationId);
+  }
+
+  out[strings::S_PARAMS][strings::S_MESSAGE_TYPE] = messageType;
+  out[strings::S_PARAMS][strings::S_FUNCTION_ID] = functionId;
+  out[strings::S_PARAMS][strings::S_PROTOCOL_TYPE] = 0;
+  out[strings::S_PARAMS][strings::S_PROTOCOL_VERSION] = 2;
+  out[strings::S_PARAMS][strings::S_CORRELATION_ID] = correlationId;
+
+  return true;
+}
 }  // namespace formatters
 }  // namespace ns_json_handler
 }  // namespace ns_smart_device_link
@@ -37,8 +37,11 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include "smart_objects/smart_object.h"
 #include "smart_objects/smart_schema.h"
+#include "utils/lock.h"
+#include "utils/semantic_version.h"
 
 namespace ns_smart_device_link {
 namespace ns_json_handler {
@@ -238,7 +241,54 @@ class CSmartFactory {
   bool GetSchema(const StructIdEnum struct_id,
                  ns_smart_device_link::ns_smart_objects::CSmartSchema& result);
 
+  /**
+   * @brief Get SmartSchema for specific function resolved for message
+   *        version.
+   *
+   * Schemes are resolved on first request for the version and then are
+   * shared by all messages of this version.
+   *
+   * @param function_id FunctionID of the function.
+   * @param message_type messageType of the function.
+   * @param message_version Version of RPC Spec negotiated with application.
+   * @param[out] result This value will be copy of the resolved function
+   *                    SmartSchema if it found or unmodified otherwise.
+   *
+   * @return True if function schema for specified input parameters
+   *         is found or false otherwise.
+   */
+  bool GetSchema(const FunctionIdEnum function_id,
+                 const MessageTypeEnum message_type,
+                 const utils::SemanticVersion& message_version,
+                 ns_smart_device_link::ns_smart_objects::CSmartSchema& result);
+
  protected:
+  /**
+   * @brief Drops resolved schemes of function for all versions.
+   *
+   * Must be called each time function schema is replaced or modified.
+   *
+   * @param function_id FunctionID of the function.
+   * @param message_type messageType of the function.
+   */
+  void ResetResolvedSchemes(const FunctionIdEnum function_id,
+                            const MessageTypeEnum message_type);
+
+  /**
+   * @brief Gets function schema resolved for message version from cache
+   *        or resolves it if there is no such schema yet.
+   *
+   * @param key Key of the function schema.
+   * @param schema Function schema.
+   * @param message_version Version to resolve schema for.
+   *
+   * @return Resolved schema.
+   */
+  ns_smart_device_link::ns_smart_objects::CSmartSchema GetResolvedSchema(
+      const SmartSchemaKey<FunctionIdEnum, MessageTypeEnum>& key,
+      const ns_smart_device_link::ns_smart_objects::CSmartSchema& schema,
+      const utils::SemanticVersion& message_version);
+
   /**
    * @brief Defines map of SmartSchemaKeys to the SmartSchemes.
    *
@@ -268,6 +318,33 @@ class CSmartFactory {
    * @brief Map of all struct shemes for this factory.
    */
   StructsSchemesMap structs_schemes_;
+
+  /**
+   * @brief Defines map of SmartSchemaKeys and message versions to
+   *        the function SmartSchemes resolved for the version.
+   */
+  typedef std::map<std::pair<SmartSchemaKey<FunctionIdEnum, MessageTypeEnum>,
+                             utils::SemanticVersion>,
+                   ns_smart_device_link::ns_smart_objects::CSmartSchema>
+      ResolvedSchemesMap;
+
+  /**
+   * @brief Function schemes resolved for message versions used so far.
+   */
+  ResolvedSchemesMap resolved_schemes_;
+
+  /**
+   * @brief Average amount of message versions each function scheme is kept
+   *        resolved for. Message versions come from applications, so
+   *        resolved_schemes_ is dropped once it exceeds this limit.
+   */
+  static const size_t kMaxResolvedVersions = 8;
+
+  /**
+   * @brief Protects resolved_schemes_ as messages of different
+   *        applications are attached to schemes from different threads.
+   */
+  sync_primitives::Lock resolved_schemes_lock_;
 };
 
 template <class FunctionIdEnum, class MessageTypeEnum, class StructIdEnum>
@@ -305,9 +382,17 @@ bool CSmartFactory<FunctionIdEnum, MessageTypeEnum, StructIdEnum>::attachSchema(
     return false;
   }
 
-  object.setSchema(schemaIterator->second);
+  if (!MessageVersion.isValid()) {
+    object.setSchema(schemaIterator->second);
+    schemaIterator->second.applySchema(
+        object, remove_unknown_parameters, MessageVersion, report__);
+    return true;
+  }
 
-  schemaIterator->second.applySchema(
+  ns_smart_device_link::ns_smart_objects::CSmartSchema schema =
+      GetResolvedSchema(key, schemaIterator->second, MessageVersion);
+  object.setSchema(schema);
+  schema.applySchema(
       object, remove_unknown_parameters, MessageVersion, report__);
 
   return true;
@@ -398,6 +483,67 @@ bool CSmartFactory<FunctionIdEnum, MessageTypeEnum, StructIdEnum>::GetSchema(
   return false;
 }
 
+template <class FunctionIdEnum, class MessageTypeEnum, class StructIdEnum>
+bool CSmartFactory<FunctionIdEnum, MessageTypeEnum, StructIdEnum>::GetSchema(
+    const FunctionIdEnum function_id,
+    const MessageTypeEnum message_type,
+    const utils::SemanticVersion& message_version,
+    ns_smart_device_link::ns_smart_objects::CSmartSchema& result) {
+  SmartSchemaKey<FunctionIdEnum, MessageTypeEnum> key(function_id,
+                                                      message_type);
+
+  typename FuncionsSchemesMap::iterator schema_iterator =
+      functions_schemes_.find(key);
+
+  if (schema_iterator == functions_schemes_.end()) {
+    return false;
+  }
+
+  result = GetResolvedSchema(key, schema_iterator->second, message_version);
+  return true;
+}
+
+template <class FunctionIdEnum, class MessageTypeEnum, class StructIdEnum>
+void CSmartFactory<FunctionIdEnum, MessageTypeEnum, StructIdEnum>::
+    ResetResolvedSchemes(const FunctionIdEnum function_id,
+                         const MessageTypeEnum message_type) {
+  SmartSchemaKey<FunctionIdEnum, MessageTypeEnum> key(function_id,
+                                                      message_type);
+
+  sync_primitives::AutoLock auto_lock(resolved_schemes_lock_);
+  typename ResolvedSchemesMap::iterator it = resolved_schemes_.lower_bound(
+      std::make_pair(key, utils::SemanticVersion()));
+  while (it != resolved_schemes_.end() &&
+         !(key < it->first.first || it->first.first < key)) {
+    resolved_schemes_.erase(it++);
+  }
+}
+
+template <class FunctionIdEnum, class MessageTypeEnum, class StructIdEnum>
+ns_smart_device_link::ns_smart_objects::CSmartSchema
+CSmartFactory<FunctionIdEnum, MessageTypeEnum, StructIdEnum>::GetResolvedSchema(
+    const SmartSchemaKey<FunctionIdEnum, MessageTypeEnum>& key,
+    const ns_smart_device_link::ns_smart_objects::CSmartSchema& schema,
+    const utils::SemanticVersion& message_version) {
+  const typename ResolvedSchemesMap::key_type resolved_key(key,
+                                                           message_version);
+
+  sync_primitives::AutoLock auto_lock(resolved_schemes_lock_);
+  typename ResolvedSchemesMap::iterator it =
+      resolved_schemes_.find(resolved_key);
+  if (it == resolved_schemes_.end()) {
+    if (resolved_schemes_.size() >=
+        functions_schemes_.size() * kMaxResolvedVersions) {
+      resolved_schemes_.clear();
+    }
+    it = resolved_schemes_
+             .insert(std::make_pair(resolved_key,
+                                    schema.ResolveVersion(message_version)))
+             .first;
+  }
+  return it->second;
+}
+
 template <class FunctionIdEnum, class MessageTypeEnum>
 SmartSchemaKey<FunctionIdEnum, MessageTypeEnum>::SmartSchemaKey(
     FunctionIdEnum functionIdParam, MessageTypeEnum messageTypeParam)
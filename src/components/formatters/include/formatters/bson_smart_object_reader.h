@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_BSON_SMART_OBJECT_READER_H_
+#define SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_BSON_SMART_OBJECT_READER_H_
+
+#include <stdint.h>
+#include <string>
+
+#include "smart_objects/schema_item.h"
+#include "smart_objects/smart_object.h"
+
+namespace ns_smart_device_link {
+namespace ns_json_handler {
+namespace formatters {
+
+/**
+ * @brief Single pass BSON reader which builds SmartObject directly
+ * from the document bytes.
+ *
+ * Element types are mapped back as written by BsonSmartObjectWriter,
+ * int32 and int64 are read as Integer. Null elements
+ * leave the corresponding element as created by container, the same way
+ * JsonSmartObjectReader does for JSON null. If schema item is provided,
+ * reader walks it along with the document and converts enum values to
+ * their numeric representation as soon as they are parsed.
+ *
+ * Any malformed input (wrong lengths, unterminated strings, element types
+ * not listed above, nesting deeper than kMaxDepth etc.) is rejected.
+ */
+class BsonSmartObjectReader {
+ public:
+  /**
+   * @brief Maximal nesting depth of documents and arrays
+   */
+  static const uint32_t kMaxDepth = 1000;
+
+  /**
+   * @brief Parses BSON document into SmartObject
+   * @param str Input document bytes
+   * @param out Output SmartObject, may be partially filled on failure
+   * @param schema_item Schema item describing root document, may be NULL
+   * @return true if the whole input is a single valid document,
+   * otherwise false
+   */
+  static bool Parse(const std::string& str,
+                    ns_smart_objects::SmartObject& out,
+                    ns_smart_objects::ISchemaItem* schema_item);
+
+ private:
+  BsonSmartObjectReader();
+};
+
+}  // namespace formatters
+}  // namespace ns_json_handler
+}  // namespace ns_smart_device_link
+
+#endif  // SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_BSON_SMART_OBJECT_READER_H_
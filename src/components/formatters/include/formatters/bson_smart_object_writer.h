@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_BSON_SMART_OBJECT_WRITER_H_
+#define SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_BSON_SMART_OBJECT_WRITER_H_
+
+#include <stdint.h>
+#include <string>
+
+#include "smart_objects/smart_object.h"
+#include "utils/macro.h"
+
+namespace ns_smart_device_link {
+namespace ns_json_handler {
+namespace formatters {
+
+/**
+ * @brief Serializes SmartObject into BSON document without intermediate
+ * representation.
+ *
+ * Values are mapped to BSON element types as follows:
+ *  - Map - embedded document (0x03)
+ *  - Array - array (0x04)
+ *  - Boolean - boolean (0x08)
+ *  - Integer, UInteger - int32 (0x10) if value fits into 32 bits,
+ *    otherwise int64 (0x12)
+ *  - Double - double (0x01)
+ *  - Null - null (0x0A)
+ *  - Binary - generic binary (0x05, subtype 0x00)
+ *  - Others - UTF-8 string (0x02) with the value of asString()
+ */
+class BsonSmartObjectWriter {
+ public:
+  /**
+   * @brief Constructor
+   * @param out Output string. It is cleared, but its capacity is reused,
+   * so the same string may serve as a buffer for many messages.
+   */
+  explicit BsonSmartObjectWriter(std::string& out);
+
+  /**
+   * @brief Writes map as BSON document.
+   * Objects which are not maps are written as empty document, since
+   * BSON has no representation for scalar root values.
+   */
+  void WriteDocument(const ns_smart_objects::SmartObject& value);
+
+ private:
+  void WriteElement(const char* key,
+                    const ns_smart_objects::SmartObject& value);
+  void WriteMap(const ns_smart_objects::SmartObject& value);
+  void WriteArray(const ns_smart_objects::SmartArray& array);
+
+  /**
+   * @brief Reserves document length field
+   * @return Offset of the document in output
+   */
+  size_t BeginDocument();
+
+  /**
+   * @brief Writes document terminator and patches document length
+   */
+  void EndDocument(const size_t offset);
+
+  void WriteType(const uint8_t type, const char* key);
+  void WriteCString(const char* value);
+  void WriteInt32(const int32_t value);
+  void WriteInt64(const int64_t value);
+  void WriteUInt64(const uint64_t value);
+  void WriteDouble(const double value);
+  void WriteStringValue(const char* value, const size_t length);
+
+  std::string& out_;
+
+  DISALLOW_COPY_AND_ASSIGN(BsonSmartObjectWriter);
+};
+
+}  // namespace formatters
+}  // namespace ns_json_handler
+}  // namespace ns_smart_device_link
+
+#endif  // SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_BSON_SMART_OBJECT_WRITER_H_
@@ -240,7 +240,7 @@ class FormatterJsonRpc : public CFormatterJsonBase {
    *         value of "method" field.
    */
   static bool SetMethod(const ns_smart_objects::SmartObject& params,
-                        Json::Value& method_container);
+                        ns_smart_objects::SmartObject& method_container);
 
   /**
    * @brief Set id.
@@ -255,7 +255,7 @@ class FormatterJsonRpc : public CFormatterJsonBase {
    *         as a value of "id" field.
    */
   static bool SetId(const ns_smart_objects::SmartObject& params,
-                    Json::Value& id_container);
+                    ns_smart_objects::SmartObject& id_container);
 
   /**
    * @brief Set message
@@ -270,7 +270,7 @@ class FormatterJsonRpc : public CFormatterJsonBase {
    *         as a value of "message" field.
    */
   static bool SetMessage(const ns_smart_objects::SmartObject& params,
-                         Json::Value& id_container);
+                         ns_smart_objects::SmartObject& id_container);
 };
 
 template <typename FunctionId, typename MessageType>
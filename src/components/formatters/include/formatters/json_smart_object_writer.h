@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_JSON_SMART_OBJECT_WRITER_H_
+#define SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_JSON_SMART_OBJECT_WRITER_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "smart_objects/smart_object.h"
+#include "utils/macro.h"
+
+namespace ns_smart_device_link {
+namespace ns_json_handler {
+namespace formatters {
+
+/**
+ * @brief Serializes SmartObject into JSON string without intermediate
+ * Json::Value tree.
+ *
+ * Values are converted the same way as CFormatterJsonBase::objToJsonValue
+ * does, output is byte-identical to the one produced by jsoncpp for
+ * the corresponding Json::Value.
+ */
+class JsonSmartObjectWriter {
+ public:
+  enum Style {
+    /**
+     * @brief Single line output, as written by Json::StreamWriterBuilder
+     * with empty indentation
+     */
+    kCompact,
+
+    /**
+     * @brief Multiline output with 3 space indentation, as written by
+     * Json::StyledWriter (toStyledString of jsoncpp prior to 1.8)
+     */
+    kStyled
+  };
+
+  /**
+   * @brief Constructor
+   * @param out Output string. It is cleared, but its capacity is reused,
+   * so the same string may serve as a buffer for many messages.
+   * @param style Output style
+   */
+  JsonSmartObjectWriter(std::string& out, const Style style);
+
+  /**
+   * @brief Writes SmartObject as JSON value
+   */
+  void WriteValue(const ns_smart_objects::SmartObject& value);
+
+  /**
+   * @brief Writes JSON object containing members of both maps.
+   * Members of overlay replace members of base with the same key.
+   * Objects which are not maps are treated as empty ones.
+   */
+  void WriteMerged(const ns_smart_objects::SmartObject& base,
+                   const ns_smart_objects::SmartObject& overlay);
+
+  void WriteNull();
+  void WriteBool(const bool value);
+  void WriteInt(const int64_t value);
+  void WriteUInt(const uint64_t value);
+  void WriteDouble(const double value);
+  void WriteString(const char* value);
+  void WriteString(const std::string& value);
+
+  /**
+   * @brief Starts JSON object. Members are added with Key() followed
+   * by exactly one value, object is completed with EndObject()
+   */
+  void BeginObject();
+  void Key(const char* key);
+  void Key(const std::string& key);
+  void EndObject();
+
+  /**
+   * @brief Completes document, styled output is terminated with line feed
+   */
+  void Finish();
+
+ private:
+  void WriteArray(const ns_smart_objects::SmartArray& array);
+  void WriteQuoted(const char* value);
+  void WriteIndent();
+  void WriteWithIndent(const char* value);
+  void Indent();
+  void Unindent();
+
+  std::string& out_;
+  const Style style_;
+  size_t indent_;
+
+  /**
+   * @brief For each object opened with BeginObject() contains true
+   * if object has at least one member written
+   */
+  std::vector<bool> object_has_members_;
+
+  DISALLOW_COPY_AND_ASSIGN(JsonSmartObjectWriter);
+};
+
+}  // namespace formatters
+}  // namespace ns_json_handler
+}  // namespace ns_smart_device_link
+
+#endif  // SRC_COMPONENTS_FORMATTERS_INCLUDE_FORMATTERS_JSON_SMART_OBJECT_WRITER_H_
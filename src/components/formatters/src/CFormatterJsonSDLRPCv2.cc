@@ -29,6 +29,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include "formatters/CFormatterJsonSDLRPCv2.h"
+#include "formatters/json_smart_object_writer.h"
 #include "formatters/meta_formatter.h"
 
 namespace smart_objects_ns = ns_smart_device_link::ns_smart_objects;
@@ -45,16 +46,14 @@ bool CFormatterJsonSDLRPCv2::toString(const smart_objects_ns::SmartObject& obj,
                                       const bool remove_unknown_parameters) {
   bool result = true;
   try {
-    Json::Value root(Json::objectValue);
-
     smart_objects_ns::SmartObject formattedObj(obj);
     formattedObj.getSchema().unapplySchema(
         formattedObj,
         remove_unknown_parameters);  // converts enums(as int32_t) to strings
 
-    objToJsonValue(formattedObj.getElement(strings::S_MSG_PARAMS), root);
-
-    outStr = root.toStyledString();
+    JsonSmartObjectWriter writer(outStr, JsonSmartObjectWriter::kStyled);
+    writer.WriteValue(formattedObj.getElement(strings::S_MSG_PARAMS));
+    writer.Finish();
 
     result = true;
   } catch (...) {
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "formatters/bson_smart_object_reader.h"
+
+#include <string.h>
+
+#include "smart_objects/object_schema_item.h"
+
+namespace ns_smart_device_link {
+namespace ns_json_handler {
+namespace formatters {
+
+namespace {
+
+using ns_smart_objects::ISchemaItem;
+using ns_smart_objects::SMember;
+using ns_smart_objects::SmartObject;
+
+enum BsonType {
+  kBsonDouble = 0x01,
+  kBsonString = 0x02,
+  kBsonDocument = 0x03,
+  kBsonArray = 0x04,
+  kBsonBinary = 0x05,
+  kBsonBoolean = 0x08,
+  kBsonNull = 0x0A,
+  kBsonInt32 = 0x10,
+  kBsonInt64 = 0x12
+};
+
+/**
+ * @brief Size of document length field and terminator
+ */
+const size_t kMinDocumentSize = 5;
+
+class Parser {
+ public:
+  Parser(const char* begin, const char* end)
+      : cur_(begin), end_(end), depth_(0) {}
+
+  bool ParseRoot(SmartObject& out, ISchemaItem* schema_item) {
+    const char* const input_end = end_;
+    return ParseDocument(out, schema_item, false) && cur_ == input_end;
+  }
+
+ private:
+  size_t BytesLeft() const {
+    return static_cast<size_t>(end_ - cur_);
+  }
+
+  uint64_t ReadLittleEndian(const size_t size) {
+    uint64_t value = 0;
+    for (size_t byte = 0; byte < size; ++byte) {
+      value |= static_cast<uint64_t>(static_cast<uint8_t>(cur_[byte]))
+               << (byte * 8);
+    }
+    cur_ += size;
+    return value;
+  }
+
+  bool ReadInt32(int32_t& value) {
+    if (BytesLeft() < sizeof(value)) {
+      return false;
+    }
+    value = static_cast<int32_t>(
+        static_cast<uint32_t>(ReadLittleEndian(sizeof(value))));
+    return true;
+  }
+
+  bool ReadUInt64(uint64_t& value) {
+    if (BytesLeft() < sizeof(value)) {
+      return false;
+    }
+    value = ReadLittleEndian(sizeof(value));
+    return true;
+  }
+
+  bool ReadCString(const char*& value, size_t& length) {
+    const void* terminator = memchr(cur_, '\0', BytesLeft());
+    if (!terminator) {
+      return false;
+    }
+    value = cur_;
+    length = static_cast<const char*>(terminator) - cur_;
+    cur_ += length + 1;
+    return true;
+  }
+
+  /**
+   * @brief Parses document or array. Nested content is bounded
+   * by the document length, so end_ is narrowed for its elements.
+   */
+  bool ParseDocument(SmartObject& obj,
+                     ISchemaItem* schema_item,
+                     const bool is_array) {
+    if (++depth_ > BsonSmartObjectReader::kMaxDepth) {
+      return false;
+    }
+    const char* const document_begin = cur_;
+    int32_t length = 0;
+    if (!ReadInt32(length) || length < static_cast<int32_t>(kMinDocumentSize) ||
+        static_cast<size_t>(length) > BytesLeft() + sizeof(length)) {
+      return false;
+    }
+    const char* const document_end = document_begin + length;
+    if ('\0' != document_end[-1]) {
+      return false;
+    }
+
+    obj = SmartObject(is_array ? ns_smart_objects::SmartType_Array
+                               : ns_smart_objects::SmartType_Map);
+    ISchemaItem* element_schema_item =
+        (is_array && schema_item) ? schema_item->GetElementSchemaItem() : NULL;
+
+    const char* const outer_end = end_;
+    end_ = document_end - 1;
+    int32_t index = 0;
+    while (cur_ != end_) {
+      const uint8_t type = static_cast<uint8_t>(*cur_++);
+      const char* key = NULL;
+      size_t key_length = 0;
+      if (!ReadCString(key, key_length)) {
+        return false;
+      }
+
+      if (is_array) {
+        // Keys of array elements are ignored, order defines indexes
+        if (!ParseValue(type, obj[index++], element_schema_item)) {
+          return false;
+        }
+        continue;
+      }
+
+      const std::string key_string(key, key_length);
+      ISchemaItem* member_schema_item = NULL;
+      if (schema_item) {
+        boost::optional<SMember&> member =
+            schema_item->GetMemberSchemaItem(key_string);
+        if (member) {
+          member_schema_item = member->mSchemaItem;
+        }
+      }
+      SmartObject* member_value = &obj[key_string];
+      if (ns_smart_objects::SmartType_Null != member_value->getType()) {
+        // Duplicated key, the last value wins as for JSON input
+        obj.erase(key_string);
+        member_value = &obj[key_string];
+      }
+      if (!ParseValue(type, *member_value, member_schema_item)) {
+        return false;
+      }
+    }
+
+    end_ = outer_end;
+    cur_ = document_end;
+    --depth_;
+    return true;
+  }
+
+  bool ParseValue(const uint8_t type,
+                  SmartObject& obj,
+                  ISchemaItem* schema_item) {
+    switch (type) {
+      case kBsonDouble: {
+        uint64_t bits = 0;
+        if (!ReadUInt64(bits)) {
+          return false;
+        }
+        double value = 0.0;
+        memcpy(&value, &bits, sizeof(value));
+        obj = value;
+        return true;
+      }
+      case kBsonString: {
+        int32_t length = 0;
+        if (!ReadInt32(length) || length < 1 ||
+            static_cast<size_t>(length) > BytesLeft() ||
+            '\0' != cur_[length - 1]) {
+          return false;
+        }
+        obj = std::string(cur_, length - 1);
+        cur_ += length;
+        if (schema_item &&
+            ns_smart_objects::TYPE_ENUM == schema_item->GetType()) {
+          schema_item->applySchema(obj, false);
+        }
+        return true;
+      }
+      case kBsonDocument:
+        return ParseDocument(obj, schema_item, false);
+      case kBsonArray:
+        return ParseDocument(obj, schema_item, true);
+      case kBsonBinary: {
+        int32_t length = 0;
+        if (!ReadInt32(length) || length < 0 ||
+            static_cast<size_t>(length) + 1 > BytesLeft()) {
+          return false;
+        }
+        // Subtype is not significant for SmartObject
+        ++cur_;
+        obj = ns_smart_objects::SmartBinary(cur_, cur_ + length);
+        cur_ += length;
+        return true;
+      }
+      case kBsonBoolean:
+        if (BytesLeft() < 1 || static_cast<uint8_t>(*cur_) > 1) {
+          return false;
+        }
+        obj = '\0' != *cur_++;
+        return true;
+      case kBsonNull:
+        // Element stays as created by the container operator[]
+        return true;
+      case kBsonInt32: {
+        int32_t value = 0;
+        if (!ReadInt32(value)) {
+          return false;
+        }
+        obj = static_cast<int64_t>(value);
+        return true;
+      }
+      case kBsonInt64: {
+        uint64_t value = 0;
+        if (!ReadUInt64(value)) {
+          return false;
+        }
+        obj = static_cast<int64_t>(value);
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+  const char* cur_;
+  const char* end_;
+  uint32_t depth_;
+};
+
+}  // namespace
+
+const uint32_t BsonSmartObjectReader::kMaxDepth;
+
+bool BsonSmartObjectReader::Parse(const std::string& str,
+                                  ns_smart_objects::SmartObject& out,
+                                  ns_smart_objects::ISchemaItem* schema_item) {
+  Parser parser(str.data(), str.data() + str.size());
+  return parser.ParseRoot(out, schema_item);
+}
+
+}  // namespace formatters
+}  // namespace ns_json_handler
+}  // namespace ns_smart_device_link
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "formatters/bson_smart_object_writer.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <limits>
+
+namespace ns_smart_device_link {
+namespace ns_json_handler {
+namespace formatters {
+
+namespace {
+
+using ns_smart_objects::SmartArray;
+using ns_smart_objects::SmartMap;
+using ns_smart_objects::SmartObject;
+
+enum BsonType {
+  kBsonDouble = 0x01,
+  kBsonString = 0x02,
+  kBsonDocument = 0x03,
+  kBsonArray = 0x04,
+  kBsonBinary = 0x05,
+  kBsonBoolean = 0x08,
+  kBsonNull = 0x0A,
+  kBsonInt32 = 0x10,
+  kBsonInt64 = 0x12
+};
+
+const uint8_t kBsonBinaryGeneric = 0x00;
+
+}  // namespace
+
+BsonSmartObjectWriter::BsonSmartObjectWriter(std::string& out) : out_(out) {
+  out_.clear();
+}
+
+void BsonSmartObjectWriter::WriteDocument(const SmartObject& value) {
+  if (ns_smart_objects::SmartType_Map == value.getType()) {
+    WriteMap(value);
+    return;
+  }
+  EndDocument(BeginDocument());
+}
+
+void BsonSmartObjectWriter::WriteElement(const char* key,
+                                         const SmartObject& value) {
+  switch (value.getType()) {
+    case ns_smart_objects::SmartType_Map:
+      WriteType(kBsonDocument, key);
+      WriteMap(value);
+      break;
+    case ns_smart_objects::SmartType_Array:
+      WriteType(kBsonArray, key);
+      WriteArray(*value.asArray());
+      break;
+    case ns_smart_objects::SmartType_Boolean:
+      WriteType(kBsonBoolean, key);
+      out_ += static_cast<char>(value.asBool() ? 1 : 0);
+      break;
+    case ns_smart_objects::SmartType_Integer:
+    case ns_smart_objects::SmartType_UInteger: {
+      // SmartObject keeps unsigned values as int64 too, so they always fit
+      // into int64. BSON has no unsigned 64-bit type, 0x11 is Timestamp
+      const int64_t int_value = value.asInt();
+      if (int_value >= std::numeric_limits<int32_t>::min() &&
+          int_value <= std::numeric_limits<int32_t>::max()) {
+        WriteType(kBsonInt32, key);
+        WriteInt32(static_cast<int32_t>(int_value));
+      } else {
+        WriteType(kBsonInt64, key);
+        WriteInt64(int_value);
+      }
+      break;
+    }
+    case ns_smart_objects::SmartType_Double:
+      WriteType(kBsonDouble, key);
+      WriteDouble(value.asDouble());
+      break;
+    case ns_smart_objects::SmartType_Null:
+      WriteType(kBsonNull, key);
+      break;
+    case ns_smart_objects::SmartType_Binary: {
+      const ns_smart_objects::SmartBinary binary = value.asBinary();
+      WriteType(kBsonBinary, key);
+      WriteInt32(static_cast<int32_t>(binary.size()));
+      out_ += static_cast<char>(kBsonBinaryGeneric);
+      if (!binary.empty()) {
+        out_.append(reinterpret_cast<const char*>(&binary[0]), binary.size());
+      }
+      break;
+    }
+    case ns_smart_objects::SmartType_String: {
+      const char* string_value = value.asCharArray();
+      WriteType(kBsonString, key);
+      WriteStringValue(string_value, strlen(string_value));
+      break;
+    }
+    default: {
+      const std::string string_value = value.asString();
+      WriteType(kBsonString, key);
+      WriteStringValue(string_value.c_str(), string_value.length());
+      break;
+    }
+  }
+}
+
+void BsonSmartObjectWriter::WriteMap(const SmartObject& value) {
+  const size_t offset = BeginDocument();
+  for (SmartMap::const_iterator it = value.map_begin(); it != value.map_end();
+       ++it) {
+    WriteElement(it->first.c_str(), it->second);
+  }
+  EndDocument(offset);
+}
+
+void BsonSmartObjectWriter::WriteArray(const SmartArray& array) {
+  const size_t offset = BeginDocument();
+  // Array is stored as document with decimal indexes as keys
+  char key[16];
+  for (size_t index = 0; index < array.size(); ++index) {
+    snprintf(key, sizeof(key), "%u", static_cast<uint32_t>(index));
+    WriteElement(key, array[index]);
+  }
+  EndDocument(offset);
+}
+
+size_t BsonSmartObjectWriter::BeginDocument() {
+  const size_t offset = out_.size();
+  WriteInt32(0);
+  return offset;
+}
+
+void BsonSmartObjectWriter::EndDocument(const size_t offset) {
+  out_ += '\0';
+  const uint32_t length = static_cast<uint32_t>(out_.size() - offset);
+  for (size_t byte = 0; byte < sizeof(length); ++byte) {
+    out_[offset + byte] = static_cast<char>(length >> (byte * 8));
+  }
+}
+
+void BsonSmartObjectWriter::WriteType(const uint8_t type, const char* key) {
+  out_ += static_cast<char>(type);
+  WriteCString(key);
+}
+
+void BsonSmartObjectWriter::WriteCString(const char* value) {
+  // Key can not contain NUL character, so it is written up to the first one
+  out_.append(value, strlen(value) + 1);
+}
+
+void BsonSmartObjectWriter::WriteInt32(const int32_t value) {
+  const uint32_t bits = static_cast<uint32_t>(value);
+  for (size_t byte = 0; byte < sizeof(bits); ++byte) {
+    out_ += static_cast<char>(bits >> (byte * 8));
+  }
+}
+
+void BsonSmartObjectWriter::WriteInt64(const int64_t value) {
+  WriteUInt64(static_cast<uint64_t>(value));
+}
+
+void BsonSmartObjectWriter::WriteUInt64(const uint64_t value) {
+  for (size_t byte = 0; byte < sizeof(value); ++byte) {
+    out_ += static_cast<char>(value >> (byte * 8));
+  }
+}
+
+void BsonSmartObjectWriter::WriteDouble(const double value) {
+  uint64_t bits = 0;
+  memcpy(&bits, &value, sizeof(bits));
+  WriteUInt64(bits);
+}
+
+void BsonSmartObjectWriter::WriteStringValue(const char* value,
+                                             const size_t length) {
+  // Length includes terminating NUL character
+  WriteInt32(static_cast<int32_t>(length + 1));
+  out_.append(value, length);
+  out_ += '\0';
+}
+
+}  // namespace formatters
+}  // namespace ns_json_handler
+}  // namespace ns_smart_device_link
@@ -33,6 +33,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include "formatters/formatter_json_rpc.h"
+#include "formatters/json_smart_object_writer.h"
 #include "utils/convert_utils.h"
 
 namespace ns_smart_device_link {
@@ -61,24 +62,30 @@ bool FormatterJsonRpc::ToString(const ns_smart_objects::SmartObject& obj,
                                 const bool remove_unknown_parameters) {
   bool result = true;
   try {
-    Json::Value root(Json::objectValue);
+    // Root contains all message fields except msg_params, which are
+    // written directly from the formatted object to avoid copying
+    ns_smart_objects::SmartObject root(ns_smart_objects::SmartType_Map);
 
     root[kJsonRpc] = kJsonRpcExpectedValue;
 
     ns_smart_objects::SmartObject formatted_object(obj);
-    Json::Value msg_params_json(Json::objectValue);
+    const ns_smart_objects::SmartObject empty_message_params_json(
+        ns_smart_objects::SmartType_Map);
+    const ns_smart_objects::SmartObject* msg_params_json =
+        &empty_message_params_json;
     formatted_object.getSchema().unapplySchema(formatted_object,
                                                remove_unknown_parameters);
 
     bool is_message_params = formatted_object.keyExists(strings::S_MSG_PARAMS);
     bool empty_message_params = true;
+    bool has_params = false;
     if (true == is_message_params) {
       const ns_smart_objects::SmartObject& msg_params =
           formatted_object.getElement(strings::S_MSG_PARAMS);
 
       result = (ns_smart_objects::SmartType_Map == msg_params.getType());
       if (true == result) {
-        objToJsonValue(msg_params, msg_params_json);
+        msg_params_json = &msg_params;
       }
       if (0 < msg_params.length()) {
         empty_message_params = false;
@@ -104,12 +111,14 @@ bool FormatterJsonRpc::ToString(const ns_smart_objects::SmartObject& obj,
 
           if (kRequest == message_type) {
             if (false == empty_message_params) {
-              root[kParams] = msg_params_json;
+              has_params = true;
             }
             result = result && SetMethod(params, root);
             result = result && SetId(params, root);
           } else if (kResponse == message_type) {
-            root[kResult] = msg_params_json;
+            // Members of root result are written over msg_params
+            root[kResult] =
+                ns_smart_objects::SmartObject(ns_smart_objects::SmartType_Map);
             result = result && SetMethod(params, root[kResult]);
             result = result && SetId(params, root);
 
@@ -126,7 +135,7 @@ bool FormatterJsonRpc::ToString(const ns_smart_objects::SmartObject& obj,
               }
             }
           } else if (kNotification == message_type) {
-            root[kParams] = msg_params_json;
+            has_params = true;
             result = result && SetMethod(params, root);
           } else if (kErrorResponse == message_type) {
             result = result && SetId(params, root);
@@ -144,7 +153,27 @@ bool FormatterJsonRpc::ToString(const ns_smart_objects::SmartObject& obj,
         }
       }
     }
-    out_str = root.toStyledString();
+
+    // "params" and "result" are never set together and follow all other
+    // root members in alphabetical order
+    JsonSmartObjectWriter writer(out_str, JsonSmartObjectWriter::kStyled);
+    writer.BeginObject();
+    for (ns_smart_objects::SmartMap::const_iterator it = root.map_begin();
+         it != root.map_end();
+         ++it) {
+      writer.Key(it->first);
+      if (kResult == it->first) {
+        writer.WriteMerged(*msg_params_json, it->second);
+      } else {
+        writer.WriteValue(it->second);
+      }
+    }
+    if (has_params) {
+      writer.Key(kParams);
+      writer.WriteValue(*msg_params_json);
+    }
+    writer.EndObject();
+    writer.Finish();
   } catch (...) {
     result = false;
   }
@@ -152,8 +181,9 @@ bool FormatterJsonRpc::ToString(const ns_smart_objects::SmartObject& obj,
   return result;
 }
 
-bool FormatterJsonRpc::SetMethod(const ns_smart_objects::SmartObject& params,
-                                 Json::Value& method_container) {
+bool FormatterJsonRpc::SetMethod(
+    const ns_smart_objects::SmartObject& params,
+    ns_smart_objects::SmartObject& method_container) {
   bool result = false;
 
   if (true == params.keyExists(strings::S_FUNCTION_ID)) {
@@ -170,7 +200,7 @@ bool FormatterJsonRpc::SetMethod(const ns_smart_objects::SmartObject& params,
 }
 
 bool FormatterJsonRpc::SetId(const ns_smart_objects::SmartObject& params,
-                             Json::Value& id_container) {
+                             ns_smart_objects::SmartObject& id_container) {
   bool result = false;
 
   if (true == params.keyExists(strings::S_CORRELATION_ID)) {
@@ -186,8 +216,9 @@ bool FormatterJsonRpc::SetId(const ns_smart_objects::SmartObject& params,
   return result;
 }
 
-bool FormatterJsonRpc::SetMessage(const ns_smart_objects::SmartObject& params,
-                                  Json::Value& message_container) {
+bool FormatterJsonRpc::SetMessage(
+    const ns_smart_objects::SmartObject& params,
+    ns_smart_objects::SmartObject& message_container) {
   bool result = false;
 
   if (true == params.keyExists(strings::kMessage)) {
@@ -33,6 +33,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include "formatters/generic_json_formatter.h"
+#include "formatters/json_smart_object_writer.h"
 #include "utils/jsoncpp_reader_wrapper.h"
 
 namespace ns_smart_device_link {
@@ -41,9 +42,9 @@ namespace formatters {
 
 void GenericJsonFormatter::ToString(const ns_smart_objects::SmartObject& obj,
                                     std::string& out_str) {
-  Json::Value json_root;
-  objToJsonValue(obj, json_root);
-  out_str = json_root.toStyledString();
+  JsonSmartObjectWriter writer(out_str, JsonSmartObjectWriter::kStyled);
+  writer.WriteValue(obj);
+  writer.Finish();
 }
 
 bool GenericJsonFormatter::FromString(const std::string& str,
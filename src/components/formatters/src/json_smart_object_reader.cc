@@ -0,0 +1,447 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "formatters/json_smart_object_reader.h"
+
+#include <stdint.h>
+#include <limits>
+#include <locale>
+#include <sstream>
+
+#include "smart_objects/object_schema_item.h"
+
+namespace ns_smart_device_link {
+namespace ns_json_handler {
+namespace formatters {
+
+namespace {
+
+using ns_smart_objects::ISchemaItem;
+using ns_smart_objects::SMember;
+using ns_smart_objects::SmartObject;
+
+bool IsDigit(const char c) {
+  return c >= '0' && c <= '9';
+}
+
+bool HexValue(const char c, uint32_t& value) {
+  if (IsDigit(c)) {
+    value = c - '0';
+  } else if (c >= 'a' && c <= 'f') {
+    value = c - 'a' + 10;
+  } else if (c >= 'A' && c <= 'F') {
+    value = c - 'A' + 10;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void AppendUtf8(const uint32_t code_point, std::string& out) {
+  if (code_point < 0x80) {
+    out += static_cast<char>(code_point);
+  } else if (code_point < 0x800) {
+    out += static_cast<char>(0xC0 | (code_point >> 6));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else if (code_point < 0x10000) {
+    out += static_cast<char>(0xE0 | (code_point >> 12));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (code_point >> 18));
+    out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  }
+}
+
+class Parser {
+ public:
+  Parser(const char* begin, const char* end)
+      : cur_(begin), end_(end), depth_(0) {}
+
+  bool ParseDocument(SmartObject& out, ISchemaItem* schema_item) {
+    SkipWhitespace();
+    if (!ParseValue(out, schema_item)) {
+      return false;
+    }
+    SkipWhitespace();
+    return cur_ == end_;
+  }
+
+ private:
+  void SkipWhitespace() {
+    while (cur_ != end_ && (' ' == *cur_ || '\t' == *cur_ || '\r' == *cur_ ||
+                            '\n' == *cur_)) {
+      ++cur_;
+    }
+  }
+
+  bool Consume(const char c) {
+    if (cur_ == end_ || c != *cur_) {
+      return false;
+    }
+    ++cur_;
+    return true;
+  }
+
+  bool ConsumeLiteral(const char* literal) {
+    for (; '\0' != *literal; ++literal) {
+      if (!Consume(*literal)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool ParseValue(SmartObject& obj, ISchemaItem* schema_item) {
+    if (cur_ == end_) {
+      return false;
+    }
+    switch (*cur_) {
+      case '{':
+        return ParseObject(obj, schema_item);
+      case '[':
+        return ParseArray(obj, schema_item);
+      case '"': {
+        std::string value;
+        if (!ParseString(value)) {
+          return false;
+        }
+        obj = value;
+        if (schema_item &&
+            ns_smart_objects::TYPE_ENUM == schema_item->GetType()) {
+          schema_item->applySchema(obj, false);
+        }
+        return true;
+      }
+      case 't':
+        if (!ConsumeLiteral("true")) {
+          return false;
+        }
+        obj = true;
+        return true;
+      case 'f':
+        if (!ConsumeLiteral("false")) {
+          return false;
+        }
+        obj = false;
+        return true;
+      case 'n':
+        if (!ConsumeLiteral("null")) {
+          return false;
+        }
+        // Null values are skipped by jsonValueToObj, so the element stays
+        // as created by the container operator[]
+        return true;
+      default:
+        return ParseNumber(obj);
+    }
+  }
+
+  bool ParseObject(SmartObject& obj, ISchemaItem* schema_item) {
+    if (++depth_ > JsonSmartObjectReader::kMaxDepth) {
+      return false;
+    }
+    ++cur_;
+    obj = SmartObject(ns_smart_objects::SmartType_Map);
+    SkipWhitespace();
+    if (Consume('}')) {
+      --depth_;
+      return true;
+    }
+
+    std::string key;
+    while (true) {
+      SkipWhitespace();
+      if (cur_ == end_ || '"' != *cur_ || !ParseString(key)) {
+        return false;
+      }
+      SkipWhitespace();
+      if (!Consume(':')) {
+        return false;
+      }
+      SkipWhitespace();
+
+      ISchemaItem* member_schema_item = NULL;
+      if (schema_item) {
+        boost::optional<SMember&> member =
+            schema_item->GetMemberSchemaItem(key);
+        if (member) {
+          member_schema_item = member->mSchemaItem;
+        }
+      }
+      SmartObject* member_value = &obj[key];
+      if (ns_smart_objects::SmartType_Null != member_value->getType()) {
+        // Duplicated key, the last value wins as in jsoncpp
+        obj.erase(key);
+        member_value = &obj[key];
+      }
+      if (!ParseValue(*member_value, member_schema_item)) {
+        return false;
+      }
+
+      SkipWhitespace();
+      if (Consume('}')) {
+        --depth_;
+        return true;
+      }
+      if (!Consume(',')) {
+        return false;
+      }
+    }
+  }
+
+  bool ParseArray(SmartObject& obj, ISchemaItem* schema_item) {
+    if (++depth_ > JsonSmartObjectReader::kMaxDepth) {
+      return false;
+    }
+    ++cur_;
+    obj = SmartObject(ns_smart_objects::SmartType_Array);
+    SkipWhitespace();
+    if (Consume(']')) {
+      --depth_;
+      return true;
+    }
+
+    ISchemaItem* element_schema_item =
+        schema_item ? schema_item->GetElementSchemaItem() : NULL;
+    for (int32_t index = 0;; ++index) {
+      SkipWhitespace();
+      if (!ParseValue(obj[index], element_schema_item)) {
+        return false;
+      }
+      SkipWhitespace();
+      if (Consume(']')) {
+        --depth_;
+        return true;
+      }
+      if (!Consume(',')) {
+        return false;
+      }
+    }
+  }
+
+  bool ParseHexQuad(uint32_t& value) {
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+      uint32_t digit = 0;
+      if (cur_ == end_ || !HexValue(*cur_, digit)) {
+        return false;
+      }
+      value = (value << 4) | digit;
+      ++cur_;
+    }
+    return true;
+  }
+
+  bool ParseCodePoint(uint32_t& code_point) {
+    if (!ParseHexQuad(code_point)) {
+      return false;
+    }
+    if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+      // Lone low surrogate
+      return false;
+    }
+    if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+      uint32_t low = 0;
+      if (!Consume('\\') || !Consume('u') || !ParseHexQuad(low) ||
+          low < 0xDC00 || low > 0xDFFF) {
+        return false;
+      }
+      code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+    }
+    return true;
+  }
+
+  bool ParseString(std::string& out) {
+    ++cur_;
+    out.clear();
+    const char* chunk = cur_;
+    while (cur_ != end_) {
+      const char c = *cur_;
+      if ('"' == c) {
+        out.append(chunk, cur_);
+        ++cur_;
+        return true;
+      }
+      if ('\\' != c) {
+        ++cur_;
+        continue;
+      }
+
+      out.append(chunk, cur_);
+      ++cur_;
+      if (cur_ == end_) {
+        return false;
+      }
+      switch (*cur_++) {
+        case '"':
+          out += '"';
+          break;
+        case '\\':
+          out += '\\';
+          break;
+        case '/':
+          out += '/';
+          break;
+        case 'b':
+          out += '\b';
+          break;
+        case 'f':
+          out += '\f';
+          break;
+        case 'n':
+          out += '\n';
+          break;
+        case 'r':
+          out += '\r';
+          break;
+        case 't':
+          out += '\t';
+          break;
+        case 'u': {
+          uint32_t code_point = 0;
+          if (!ParseCodePoint(code_point)) {
+            return false;
+          }
+          AppendUtf8(code_point, out);
+          break;
+        }
+        default:
+          return false;
+      }
+      chunk = cur_;
+    }
+    return false;
+  }
+
+  bool ParseDigits() {
+    if (cur_ == end_ || !IsDigit(*cur_)) {
+      return false;
+    }
+    while (cur_ != end_ && IsDigit(*cur_)) {
+      ++cur_;
+    }
+    return true;
+  }
+
+  bool ParseNumber(SmartObject& obj) {
+    const char* start = cur_;
+    const bool negative = Consume('-');
+    const char* int_begin = cur_;
+    if (Consume('0')) {
+      if (cur_ != end_ && IsDigit(*cur_)) {
+        return false;
+      }
+    } else if (!ParseDigits()) {
+      return false;
+    }
+    const char* int_end = cur_;
+
+    bool is_real = false;
+    if (Consume('.')) {
+      is_real = true;
+      if (!ParseDigits()) {
+        return false;
+      }
+    }
+    if (Consume('e') || Consume('E')) {
+      is_real = true;
+      if (!Consume('+')) {
+        Consume('-');
+      }
+      if (!ParseDigits()) {
+        return false;
+      }
+    }
+
+    if (!is_real) {
+      const uint64_t max_value = std::numeric_limits<uint64_t>::max();
+      uint64_t value = 0;
+      bool overflow = false;
+      for (const char* digit = int_begin; digit != int_end; ++digit) {
+        const uint64_t digit_value = *digit - '0';
+        if (value > (max_value - digit_value) / 10) {
+          overflow = true;
+          break;
+        }
+        value = value * 10 + digit_value;
+      }
+
+      // Mirrors jsoncpp number decoding: integers which do not fit
+      // into 64 bits are stored as double
+      const uint64_t min_int64_magnitude =
+          static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1;
+      if (!overflow && !negative) {
+        obj = value;
+        return true;
+      }
+      if (!overflow && value < min_int64_magnitude) {
+        obj = -static_cast<int64_t>(value);
+        return true;
+      }
+      if (!overflow && value == min_int64_magnitude) {
+        obj = std::numeric_limits<int64_t>::min();
+        return true;
+      }
+    }
+
+    std::istringstream stream(std::string(start, cur_));
+    stream.imbue(std::locale::classic());
+    double value = 0.0;
+    if (!(stream >> value)) {
+      return false;
+    }
+    obj = value;
+    return true;
+  }
+
+  const char* cur_;
+  const char* const end_;
+  uint32_t depth_;
+};
+
+}  // namespace
+
+const uint32_t JsonSmartObjectReader::kMaxDepth;
+
+bool JsonSmartObjectReader::Parse(const std::string& str,
+                                  ns_smart_objects::SmartObject& out,
+                                  ns_smart_objects::ISchemaItem* schema_item) {
+  Parser parser(str.data(), str.data() + str.size());
+  return parser.ParseDocument(out, schema_item);
+}
+
+}  // namespace formatters
+}  // namespace ns_json_handler
+}  // namespace ns_smart_device_link
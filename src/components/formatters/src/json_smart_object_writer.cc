@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "formatters/json_smart_object_writer.h"
+
+#include <string.h>
+
+#include "json/json.h"
+
+namespace ns_smart_device_link {
+namespace ns_json_handler {
+namespace formatters {
+
+namespace {
+
+using ns_smart_objects::SmartArray;
+using ns_smart_objects::SmartMap;
+using ns_smart_objects::SmartObject;
+
+/**
+ * @brief Width of indentation step in styled output
+ */
+const size_t kIndentSize = 3;
+
+/**
+ * @brief Arrays of scalars which fit into this width are written
+ * in a single line in styled output
+ */
+const size_t kRightMargin = 74;
+
+bool IsPlainString(const char* value) {
+  for (; '\0' != *value; ++value) {
+    const unsigned char c = static_cast<unsigned char>(*value);
+    if (c < 0x20 || c > 0x7E || '"' == c || '\\' == c) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsNonEmptyContainer(const SmartObject& value) {
+  switch (value.getType()) {
+    case ns_smart_objects::SmartType_Map:
+    case ns_smart_objects::SmartType_Array:
+      return 0 != value.length();
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+JsonSmartObjectWriter::JsonSmartObjectWriter(std::string& out,
+                                             const Style style)
+    : out_(out), style_(style), indent_(0) {
+  out_.clear();
+}
+
+void JsonSmartObjectWriter::WriteValue(const SmartObject& value) {
+  switch (value.getType()) {
+    case ns_smart_objects::SmartType_Map: {
+      BeginObject();
+      for (SmartMap::const_iterator it = value.map_begin();
+           it != value.map_end();
+           ++it) {
+        Key(it->first);
+        WriteValue(it->second);
+      }
+      EndObject();
+      break;
+    }
+    case ns_smart_objects::SmartType_Array:
+      WriteArray(*value.asArray());
+      break;
+    case ns_smart_objects::SmartType_Boolean:
+      WriteBool(value.asBool());
+      break;
+    case ns_smart_objects::SmartType_Integer:
+      WriteInt(value.asInt());
+      break;
+    case ns_smart_objects::SmartType_UInteger:
+      WriteUInt(value.asUInt());
+      break;
+    case ns_smart_objects::SmartType_Double:
+      WriteDouble(value.asDouble());
+      break;
+    case ns_smart_objects::SmartType_Null:
+      WriteNull();
+      break;
+    case ns_smart_objects::SmartType_String:
+      WriteQuoted(value.asCharArray());
+      break;
+    default:
+      WriteString(value.asString());
+      break;
+  }
+}
+
+void JsonSmartObjectWriter::WriteMerged(const SmartObject& base,
+                                        const SmartObject& overlay) {
+  const SmartMap empty;
+  const bool base_is_map = ns_smart_objects::SmartType_Map == base.getType();
+  const bool overlay_is_map =
+      ns_smart_objects::SmartType_Map == overlay.getType();
+  SmartMap::const_iterator base_it = base_is_map ? base.map_begin()
+                                                 : empty.begin();
+  const SmartMap::const_iterator base_end = base_is_map ? base.map_end()
+                                                        : empty.end();
+  SmartMap::const_iterator overlay_it = overlay_is_map ? overlay.map_begin()
+                                                       : empty.begin();
+  const SmartMap::const_iterator overlay_end =
+      overlay_is_map ? overlay.map_end() : empty.end();
+
+  BeginObject();
+  while (base_it != base_end || overlay_it != overlay_end) {
+    if (overlay_it == overlay_end ||
+        (base_it != base_end && base_it->first < overlay_it->first)) {
+      Key(base_it->first);
+      WriteValue(base_it->second);
+      ++base_it;
+      continue;
+    }
+    if (base_it != base_end && base_it->first == overlay_it->first) {
+      ++base_it;
+    }
+    Key(overlay_it->first);
+    WriteValue(overlay_it->second);
+    ++overlay_it;
+  }
+  EndObject();
+}
+
+void JsonSmartObjectWriter::WriteNull() {
+  out_ += "null";
+}
+
+void JsonSmartObjectWriter::WriteBool(const bool value) {
+  out_ += value ? "true" : "false";
+}
+
+void JsonSmartObjectWriter::WriteInt(const int64_t value) {
+  if (value < 0) {
+    out_ += '-';
+    // Negation is done in unsigned arithmetic to handle INT64_MIN
+    WriteUInt(0u - static_cast<uint64_t>(value));
+    return;
+  }
+  WriteUInt(static_cast<uint64_t>(value));
+}
+
+void JsonSmartObjectWriter::WriteUInt(uint64_t value) {
+  char buffer[20];
+  char* current = buffer + sizeof(buffer);
+  do {
+    *--current = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (0 != value);
+  out_.append(current, buffer + sizeof(buffer));
+}
+
+void JsonSmartObjectWriter::WriteDouble(const double value) {
+  // Doubles are rare in RPCs, so jsoncpp is used to keep exactly
+  // the same precision and notation
+  out_ += Json::valueToString(value);
+}
+
+void JsonSmartObjectWriter::WriteString(const char* value) {
+  WriteQuoted(value);
+}
+
+void JsonSmartObjectWriter::WriteString(const std::string& value) {
+  WriteQuoted(value.c_str());
+}
+
+void JsonSmartObjectWriter::BeginObject() {
+  object_has_members_.push_back(false);
+}
+
+void JsonSmartObjectWriter::Key(const char* key) {
+  DCHECK_OR_RETURN_VOID(!object_has_members_.empty());
+  if (object_has_members_.back()) {
+    out_ += ',';
+  } else {
+    object_has_members_.back() = true;
+    WriteWithIndent("{");
+    Indent();
+  }
+  WriteIndent();
+  WriteQuoted(key);
+  out_ += (kStyled == style_) ? " : " : ":";
+}
+
+void JsonSmartObjectWriter::Key(const std::string& key) {
+  Key(key.c_str());
+}
+
+void JsonSmartObjectWriter::EndObject() {
+  DCHECK_OR_RETURN_VOID(!object_has_members_.empty());
+  if (!object_has_members_.back()) {
+    out_ += "{}";
+  } else {
+    Unindent();
+    WriteWithIndent("}");
+  }
+  object_has_members_.pop_back();
+}
+
+void JsonSmartObjectWriter::Finish() {
+  if (kStyled == style_) {
+    out_ += '\n';
+  }
+}
+
+void JsonSmartObjectWriter::WriteArray(const SmartArray& array) {
+  if (array.empty()) {
+    out_ += "[]";
+    return;
+  }
+
+  if (kStyled == style_) {
+    // Arrays of scalars are written in a single line if they are short
+    // enough, same as Json::StyledWriter does
+    bool multiline = array.size() * 3 >= kRightMargin;
+    for (SmartArray::const_iterator it = array.begin();
+         !multiline && it != array.end();
+         ++it) {
+      multiline = IsNonEmptyContainer(*it);
+    }
+    if (!multiline) {
+      const size_t line_begin = out_.size();
+      out_ += "[ ";
+      for (SmartArray::const_iterator it = array.begin(); it != array.end();
+           ++it) {
+        if (it != array.begin()) {
+          out_ += ", ";
+        }
+        WriteValue(*it);
+      }
+      out_ += " ]";
+      if (out_.size() - line_begin < kRightMargin) {
+        return;
+      }
+      out_.resize(line_begin);
+    }
+  }
+
+  WriteWithIndent("[");
+  Indent();
+  for (SmartArray::const_iterator it = array.begin(); it != array.end();
+       ++it) {
+    if (it != array.begin()) {
+      out_ += ',';
+    }
+    WriteIndent();
+    WriteValue(*it);
+  }
+  Unindent();
+  WriteWithIndent("]");
+}
+
+void JsonSmartObjectWriter::WriteQuoted(const char* value) {
+  if (IsPlainString(value)) {
+    out_ += '"';
+    out_ += value;
+    out_ += '"';
+    return;
+  }
+  // Escaping rules differ between jsoncpp versions, so strings
+  // which require escaping are quoted by jsoncpp itself
+  out_ += Json::valueToQuotedString(value);
+}
+
+void JsonSmartObjectWriter::WriteIndent() {
+  if (kStyled != style_) {
+    return;
+  }
+  if (!out_.empty()) {
+    const char last = out_[out_.size() - 1];
+    if (' ' == last) {
+      // Already indented, e.g. value follows the member name
+      return;
+    }
+    if ('\n' != last) {
+      out_ += '\n';
+    }
+  }
+  out_.append(indent_, ' ');
+}
+
+void JsonSmartObjectWriter::WriteWithIndent(const char* value) {
+  WriteIndent();
+  out_ += value;
+}
+
+void JsonSmartObjectWriter::Indent() {
+  indent_ += kIndentSize;
+}
+
+void JsonSmartObjectWriter::Unindent() {
+  indent_ -= kIndentSize;
+}
+
+}  // namespace formatters
+}  // namespace ns_json_handler
+}  // namespace ns_smart_device_link
@@ -464,6 +464,77 @@ TEST(CSmartFactoryTest,
       test_factory.GetSchema(StructIdentifiersTest::INVALID_ENUM, schema));
 }
 
+TEST(CSmartFactoryTest, GetSchemaForVersion_ExpectResolvedOncePerVersion) {
+  CSmartFactoryTest test_factory;
+  CSmartSchema schema;
+  const utils::SemanticVersion version(5, 0, 0);
+  EXPECT_TRUE(test_factory.GetSchema(
+      FunctionIdTest::Function1, MessageTypeTest::request, version, schema));
+  EXPECT_EQ(1u, test_factory.resolved_schemes_count());
+  EXPECT_TRUE(test_factory.GetSchema(
+      FunctionIdTest::Function1, MessageTypeTest::request, version, schema));
+  EXPECT_EQ(1u, test_factory.resolved_schemes_count());
+  EXPECT_TRUE(test_factory.GetSchema(FunctionIdTest::Function1,
+                                     MessageTypeTest::request,
+                                     utils::SemanticVersion(6, 0, 0),
+                                     schema));
+  EXPECT_TRUE(test_factory.GetSchema(
+      FunctionIdTest::Function1, MessageTypeTest::response, version, schema));
+  EXPECT_EQ(3u, test_factory.resolved_schemes_count());
+
+  test_factory.reset_resolved_schemes(FunctionIdTest::Function1,
+                                      MessageTypeTest::request);
+  EXPECT_EQ(1u, test_factory.resolved_schemes_count());
+}
+
+TEST(CSmartFactoryTest,
+     GetSchemaForManyVersions_ExpectResolvedSchemesBounded) {
+  CSmartFactoryTest test_factory;
+  CSmartSchema schema;
+  const size_t max_count = test_factory.max_resolved_schemes_count();
+  for (size_t i = 0; i < max_count * 2; ++i) {
+    EXPECT_TRUE(test_factory.GetSchema(FunctionIdTest::Function1,
+                                       MessageTypeTest::request,
+                                       utils::SemanticVersion(5, 0, i),
+                                       schema));
+    EXPECT_LE(test_factory.resolved_schemes_count(), max_count);
+  }
+}
+
+TEST(CSmartFactoryTest,
+     GetNotExistedSchemaForVersion_ExpectNotReceivedSchema) {
+  CSmartFactoryTest test_factory;
+  CSmartSchema schema;
+  EXPECT_FALSE(test_factory.GetSchema(FunctionIdTest::Function1,
+                                      MessageTypeTest::INVALID_ENUM,
+                                      utils::SemanticVersion(5, 0, 0),
+                                      schema));
+  EXPECT_EQ(0u, test_factory.resolved_schemes_count());
+}
+
+TEST(CSmartFactoryTest, AttachSchemaForVersion_ExpectValidatedByResolved) {
+  CSmartFactoryTest test_factory;
+  const utils::SemanticVersion version(5, 0, 0);
+  SmartObject obj;
+  obj[S_PARAMS][S_FUNCTION_ID] = FunctionIdTest::Function1;
+  obj[S_PARAMS][S_MESSAGE_TYPE] = MessageTypeTest::request;
+  obj[S_PARAMS][S_CORRELATION_ID] = 444;
+  obj[S_PARAMS][S_PROTOCOL_VERSION] = 1;
+  obj[S_PARAMS][S_PROTOCOL_TYPE] = 0;
+  obj[S_MSG_PARAMS] = SmartObject(SmartType::SmartType_Map);
+  EXPECT_TRUE(test_factory.attachSchema(obj, false, version));
+  EXPECT_EQ(1u, test_factory.resolved_schemes_count());
+
+  rpc::ValidationReport report("RPC");
+  EXPECT_EQ(errors::eType::OK, obj.validate(&report, version));
+  EXPECT_EQ(std::string(""), rpc::PrettyFormat(report));
+
+  obj[S_PARAMS].erase(S_CORRELATION_ID);
+  EXPECT_EQ(errors::eType::MISSING_MANDATORY_PARAMETER,
+            obj.validate(&report, version));
+  EXPECT_NE(std::string(""), rpc::PrettyFormat(report));
+}
+
 }  // namespace formatters
 }  // namespace components
 }  // namespace test
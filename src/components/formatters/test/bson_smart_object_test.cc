@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string>
+#include <vector>
+
+#include "formatters/CFormatterBsonSDLRPCv2.h"
+#include "formatters/CFormatterJsonSDLRPCv2.h"
+#include "formatters/bson_smart_object_reader.h"
+#include "formatters/bson_smart_object_writer.h"
+#include "formatters/create_smartSchema.h"
+#include "formatters/json_smart_object_reader.h"
+#include "formatters/json_smart_object_writer.h"
+#include "gtest/gtest.h"
+
+namespace test {
+namespace components {
+namespace formatters {
+
+namespace {
+SmartObject FromJson(const std::string& json) {
+  SmartObject result;
+  EXPECT_TRUE(JsonSmartObjectReader::Parse(json, result, NULL)) << json;
+  return result;
+}
+
+std::string ToJson(const SmartObject& object) {
+  std::string result;
+  JsonSmartObjectWriter writer(result, JsonSmartObjectWriter::kCompact);
+  writer.WriteValue(object);
+  writer.Finish();
+  return result;
+}
+
+std::string ToBson(const SmartObject& object) {
+  std::string result;
+  BsonSmartObjectWriter writer(result);
+  writer.WriteDocument(object);
+  return result;
+}
+
+std::string Document(const std::string& elements) {
+  const uint32_t length = static_cast<uint32_t>(elements.size() + 5);
+  std::string result;
+  for (size_t byte = 0; byte < sizeof(length); ++byte) {
+    result += static_cast<char>(length >> (byte * 8));
+  }
+  result += elements;
+  result += '\0';
+  return result;
+}
+
+CSmartSchema CreateEnumSchema() {
+  std::set<Language::eType> languages;
+  languages.insert(Language::EN_EU);
+  languages.insert(Language::RU_RU);
+
+  std::set<AppTypeTest::eType> app_types;
+  app_types.insert(AppTypeTest::SYSTEM);
+  app_types.insert(AppTypeTest::MEDIA);
+
+  std::map<std::string, SMember> members;
+  members["language"] =
+      SMember(TEnumSchemaItem<Language::eType>::create(languages), false);
+  members["appType"] = SMember(
+      CArraySchemaItem::create(
+          TEnumSchemaItem<AppTypeTest::eType>::create(app_types)),
+      false);
+  members["info"] = SMember(CStringSchemaItem::create(), false);
+  return CSmartSchema(CObjectSchemaItem::create(members));
+}
+}  // namespace
+
+TEST(BsonSmartObjectTest, WriteThenParse_SameObject) {
+  std::vector<std::string> documents;
+  documents.push_back("{}");
+  documents.push_back("{\"a\":[1,2,[],{}],\"b\":{\"c\":{\"d\":[[\"e\"]]}}}");
+  documents.push_back(
+      "{\"str\":\"text\",\"t\":true,\"f\":false,\"empty\":\"\","
+      "\"utf\":\"\xd0\x9f\xd1\x80\xd0\xb8\",\"arr\":[1,\"2\",{\"x\":[3.5]}]}");
+  documents.push_back(
+      "{\"numbers\":[0,-1,2147483647,2147483648,-2147483648,-2147483649,"
+      "9223372036854775807,-9223372036854775808]}");
+  documents.push_back("{\"doubles\":[1.5,-250.0,0.1,123456789.125,1e300]}");
+
+  for (size_t i = 0; i < documents.size(); ++i) {
+    const SmartObject expected = FromJson(documents[i]);
+    SmartObject result;
+    EXPECT_TRUE(BsonSmartObjectReader::Parse(ToBson(expected), result, NULL))
+        << documents[i];
+    EXPECT_EQ(ToJson(expected), ToJson(result)) << documents[i];
+  }
+}
+
+TEST(BsonSmartObjectTest, Write_ElementLayout) {
+  SmartObject object(SmartType_Map);
+  object["i"] = 1;
+  object["s"] = "ab";
+  object["b"] = true;
+  object["l"] = static_cast<int64_t>(1) << 40;
+  object["u"] = static_cast<uint64_t>(3000000000u);
+  object["n"] = SmartObject(SmartType_Null);
+  object["a"] = SmartObject(SmartType_Array);
+  object["a"][0] = false;
+
+  // Members are written in SmartMap order, which is sorted by key
+  const std::string expected =
+      Document(std::string("\x04" "a\0", 3) +
+               Document(std::string("\x08" "0\0\0", 4)) +
+               std::string("\x08" "b\0\x01", 4) +
+               std::string("\x10" "i\0\x01\0\0\0", 7) +
+               std::string("\x12" "l\0\0\0\0\0\0\x01\0\0", 11) +
+               std::string("\x0A" "n\0", 3) +
+               std::string("\x02" "s\0\x03\0\0\0" "ab\0", 10) +
+               std::string("\x12" "u\0\x00\x5E\xD0\xB2\0\0\0\0", 11));
+  EXPECT_EQ(expected, ToBson(object));
+}
+
+TEST(BsonSmartObjectTest, Write_NotMap_EmptyDocument) {
+  EXPECT_EQ(Document(""), ToBson(SmartObject()));
+  EXPECT_EQ(Document(""), ToBson(SmartObject(42)));
+}
+
+TEST(BsonSmartObjectTest, WriteThenParse_BinaryAndNull) {
+  SmartObject object(SmartType_Map);
+  ns_smart_device_link::ns_smart_objects::SmartBinary binary;
+  binary.push_back(0x00);
+  binary.push_back(0xFF);
+  binary.push_back(0x10);
+  object["data"] = binary;
+  object["nothing"] = SmartObject(SmartType_Null);
+
+  SmartObject result;
+  ASSERT_TRUE(BsonSmartObjectReader::Parse(ToBson(object), result, NULL));
+  EXPECT_EQ(SmartType_Binary, result["data"].getType());
+  EXPECT_TRUE(binary == result["data"].asBinary());
+  EXPECT_TRUE(result.keyExists("nothing"));
+  EXPECT_EQ(SmartType_Null, result["nothing"].getType());
+}
+
+TEST(BsonSmartObjectTest, Parse_DuplicatedKey_LastValueWins) {
+  const std::string bson =
+      Document(std::string("\x10" "k\0\x01\0\0\0", 7) +
+               std::string("\x02" "k\0\x02\0\0\0" "x\0", 9));
+  SmartObject result;
+  ASSERT_TRUE(BsonSmartObjectReader::Parse(bson, result, NULL));
+  EXPECT_EQ(std::string("x"), result["k"].asString());
+}
+
+TEST(BsonSmartObjectTest, Parse_MalformedInput_Rejected) {
+  const std::string valid = Document(std::string("\x10" "i\0\x01\0\0\0", 7));
+  std::vector<std::string> documents;
+  documents.push_back("");
+  documents.push_back(std::string("\x05\0\0\0", 4));
+  // Truncated input
+  documents.push_back(valid.substr(0, valid.size() - 1));
+  // Trailing bytes after the document
+  documents.push_back(valid + '\0');
+  // Length shorter than content
+  documents.push_back(std::string("\x05\0\0\0", 4) + valid.substr(4));
+  // Missing terminator
+  std::string unterminated = valid;
+  unterminated[unterminated.size() - 1] = 'x';
+  documents.push_back(unterminated);
+  // Unsupported element type (ObjectId)
+  documents.push_back(Document(std::string("\x07" "o\0", 3) +
+                               std::string(12, '\x01')));
+  // Timestamp, not used for unsigned values
+  documents.push_back(
+      Document(std::string("\x11" "t\0", 3) + std::string(8, '\xFF')));
+  // Key is not terminated within the document
+  documents.push_back(Document(std::string("\x0A" "key", 4)));
+  // String without terminating NUL
+  documents.push_back(
+      Document(std::string("\x02" "s\0\x02\0\0\0" "ab", 9)));
+  // String length exceeding the document
+  documents.push_back(
+      Document(std::string("\x02" "s\0\x40\0\0\0" "a\0", 9)));
+  // Negative string length
+  documents.push_back(
+      Document(std::string("\x02" "s\0\xFF\xFF\xFF\xFF" "a\0", 9)));
+  // Boolean with value other than 0 or 1
+  documents.push_back(Document(std::string("\x08" "b\0\x02", 4)));
+  // Embedded document exceeding the outer one
+  documents.push_back(Document(std::string("\x03" "d\0\x40\0\0\0\0", 8)));
+
+  for (size_t i = 0; i < documents.size(); ++i) {
+    SmartObject result;
+    EXPECT_FALSE(BsonSmartObjectReader::Parse(documents[i], result, NULL))
+        << i;
+  }
+}
+
+TEST(BsonSmartObjectTest, Parse_TooDeepNesting_Rejected) {
+  SmartObject allowed(SmartType_Map);
+  SmartObject* current = &allowed;
+  for (uint32_t depth = 1; depth < BsonSmartObjectReader::kMaxDepth; ++depth) {
+    current = &(*current)["d"];
+    *current = SmartObject(SmartType_Map);
+  }
+  SmartObject result;
+  EXPECT_TRUE(BsonSmartObjectReader::Parse(ToBson(allowed), result, NULL));
+
+  SmartObject too_deep(SmartType_Map);
+  too_deep["d"] = allowed;
+  EXPECT_FALSE(BsonSmartObjectReader::Parse(ToBson(too_deep), result, NULL));
+}
+
+TEST(BsonSmartObjectTest, Parse_WithSchema_EnumsConverted) {
+  CSmartSchema schema = CreateEnumSchema();
+  const SmartObject object = FromJson(
+      "{\"language\":\"RU_RU\",\"appType\":[\"MEDIA\",\"UNKNOWN\"],"
+      "\"info\":\"EN_EU\",\"unknown\":\"RU_RU\"}");
+
+  SmartObject result;
+  ASSERT_TRUE(BsonSmartObjectReader::Parse(
+      ToBson(object), result, schema.getSchemaItem().get()));
+
+  EXPECT_EQ(SmartType_Integer, result["language"].getType());
+  EXPECT_EQ(Language::RU_RU, result["language"].asInt());
+  EXPECT_EQ(AppTypeTest::MEDIA, result["appType"][0].asInt());
+  EXPECT_EQ(std::string("UNKNOWN"), result["appType"][1].asString());
+  EXPECT_EQ(std::string("EN_EU"), result["info"].asString());
+  EXPECT_EQ(std::string("RU_RU"), result["unknown"].asString());
+}
+
+TEST(BsonSmartObjectTest, FormatterRoundTrip_SameAsJsonFormatter) {
+  CSmartSchema schema = CreateEnumSchema();
+  const std::string json =
+      "{\"language\":\"EN_EU\",\"appType\":[\"SYSTEM\"],\"number\":5,"
+      "\"nested\":{\"values\":[1.5,\"text\",false]}}";
+
+  SmartObject expected;
+  ASSERT_TRUE(
+      CFormatterJsonSDLRPCv2::fromString(json,
+                                         expected,
+                                         FunctionIDTest::RegisterAppInterface,
+                                         MessageTypeTest::request,
+                                         13,
+                                         schema.getSchemaItem().get()));
+
+  std::string bson;
+  ASSERT_TRUE(CFormatterBsonSDLRPCv2::toString(expected, bson));
+  SmartObject result;
+  ASSERT_TRUE(
+      CFormatterBsonSDLRPCv2::fromString(bson,
+                                         result,
+                                         FunctionIDTest::RegisterAppInterface,
+                                         MessageTypeTest::request,
+                                         13,
+                                         schema.getSchemaItem().get()));
+  EXPECT_EQ(ToJson(expected), ToJson(result));
+  EXPECT_EQ(Language::EN_EU, result[S_MSG_PARAMS]["language"].asInt());
+  EXPECT_EQ(13, result[S_PARAMS][S_CORRELATION_ID].asInt());
+}
+
+TEST(BsonSmartObjectTest, FromString_MalformedInput_Fails) {
+  SmartObject result;
+  EXPECT_FALSE(
+      CFormatterBsonSDLRPCv2::fromString(std::string("{}"),
+                                         result,
+                                         FunctionIDTest::RegisterAppInterface,
+                                         MessageTypeTest::request,
+                                         13,
+                                         NULL));
+  EXPECT_FALSE(result.keyExists(S_MSG_PARAMS));
+}
+
+}  // namespace formatters
+}  // namespace components
+}  // namespace test
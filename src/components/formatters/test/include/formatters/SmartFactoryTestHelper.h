@@ -104,6 +104,16 @@ class CSmartFactoryTest : public CSmartFactory<FunctionIdTest::eType,
   std::map<StructIdentifiersTest::eType, CSmartSchema> structs_schemes() {
     return structs_schemes_;
   }
+  size_t resolved_schemes_count() {
+    return resolved_schemes_.size();
+  }
+  size_t max_resolved_schemes_count() {
+    return functions_schemes_.size() * kMaxResolvedVersions;
+  }
+  void reset_resolved_schemes(const FunctionIdTest::eType function_id,
+                              const MessageTypeTest::eType message_type) {
+    ResetResolvedSchemes(function_id, message_type);
+  }
 
  protected:
   typedef std::map<const StructIdentifiersTest::eType,
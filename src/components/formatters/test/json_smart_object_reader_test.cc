@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string>
+#include <vector>
+
+#include "formatters/CFormatterJsonSDLRPCv2.h"
+#include "formatters/create_smartSchema.h"
+#include "formatters/json_smart_object_reader.h"
+#include "gtest/gtest.h"
+
+namespace test {
+namespace components {
+namespace formatters {
+
+namespace {
+SmartObject ParseWithJsoncpp(const std::string& json) {
+  Json::CharReaderBuilder reader_builder;
+  const std::unique_ptr<Json::CharReader> reader(
+      reader_builder.newCharReader());
+  Json::Value root;
+  EXPECT_TRUE(
+      reader->parse(json.c_str(), json.c_str() + json.size(), &root, nullptr))
+      << json;
+  SmartObject result;
+  CFormatterJsonBase::jsonValueToObj(root, result);
+  return result;
+}
+
+CSmartSchema CreateEnumSchema() {
+  std::set<Language::eType> languages;
+  languages.insert(Language::EN_EU);
+  languages.insert(Language::RU_RU);
+
+  std::set<AppTypeTest::eType> app_types;
+  app_types.insert(AppTypeTest::SYSTEM);
+  app_types.insert(AppTypeTest::MEDIA);
+
+  std::map<std::string, SMember> struct_members;
+  struct_members["language"] =
+      SMember(TEnumSchemaItem<Language::eType>::create(languages), false);
+
+  std::map<std::string, SMember> members;
+  members["language"] =
+      SMember(TEnumSchemaItem<Language::eType>::create(languages), false);
+  members["appType"] = SMember(
+      CArraySchemaItem::create(
+          TEnumSchemaItem<AppTypeTest::eType>::create(app_types)),
+      false);
+  members["info"] = SMember(CStringSchemaItem::create(), false);
+  members["nested"] =
+      SMember(CObjectSchemaItem::create(struct_members), false);
+  return CSmartSchema(CObjectSchemaItem::create(members));
+}
+}  // namespace
+
+TEST(JsonSmartObjectReaderTest, Parse_SameResultAsJsoncpp) {
+  std::vector<std::string> documents;
+  documents.push_back("{}");
+  documents.push_back("[]");
+  documents.push_back("  {\"a\" : [ 1 , 2 , [ ] , { } ] }  ");
+  documents.push_back(
+      "{\"str\":\"text\",\"t\":true,\"f\":false,\"n\":null,"
+      "\"arr\":[null,1,\"2\",{\"x\":[3.5]}]}");
+  documents.push_back("{\"dup\":1,\"dup\":\"two\",\"null_dup\":1,"
+                      "\"null_dup\":null}");
+  documents.push_back(
+      "[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\",\"\\u0041\\u00e9\\u4e2d\","
+      "\"\\ud83d\\ude00\",\"raw \xd0\x9f\xd1\x80\xd0\xb8\"]");
+  documents.push_back(
+      "[0,-0,1,-1,2147483647,2147483648,-2147483648,-2147483649,"
+      "4294967295,4294967296,9223372036854775807,9223372036854775808,"
+      "-9223372036854775808,18446744073709551615]");
+  documents.push_back(
+      "[18446744073709551616,-9223372036854775809,"
+      "99999999999999999999999]");
+  documents.push_back("[1.5,-0.25e3,1E2,1e-2,0.1,123456789.125,-0.0]");
+  documents.push_back("\"root string\"");
+  documents.push_back("42");
+
+  for (size_t i = 0; i < documents.size(); ++i) {
+    SmartObject result;
+    EXPECT_TRUE(JsonSmartObjectReader::Parse(documents[i], result, NULL))
+        << documents[i];
+    EXPECT_TRUE(ParseWithJsoncpp(documents[i]) == result) << documents[i];
+  }
+}
+
+TEST(JsonSmartObjectReaderTest, Parse_UnsupportedInput_Rejected) {
+  std::vector<std::string> documents;
+  documents.push_back("");
+  documents.push_back("{\"a\":1} // comment");
+  documents.push_back("{\"a\":1} trailing");
+  documents.push_back("{\"a\":1,}");
+  documents.push_back("[1 2]");
+  documents.push_back("{a:1}");
+  documents.push_back("[01]");
+  documents.push_back("[1.]");
+  documents.push_back("[\"unterminated]");
+  documents.push_back("[\"\\x\"]");
+  documents.push_back("[\"\\ud83d\"]");
+  documents.push_back("[tru]");
+  documents.push_back("[1e400]");
+
+  for (size_t i = 0; i < documents.size(); ++i) {
+    SmartObject result;
+    EXPECT_FALSE(JsonSmartObjectReader::Parse(documents[i], result, NULL))
+        << documents[i];
+  }
+}
+
+TEST(JsonSmartObjectReaderTest, Parse_TooDeepNesting_Rejected) {
+  const std::string allowed =
+      std::string(JsonSmartObjectReader::kMaxDepth, '[') +
+      std::string(JsonSmartObjectReader::kMaxDepth, ']');
+  SmartObject result;
+  EXPECT_TRUE(JsonSmartObjectReader::Parse(allowed, result, NULL));
+
+  const std::string too_deep = "[" + allowed + "]";
+  EXPECT_FALSE(JsonSmartObjectReader::Parse(too_deep, result, NULL));
+}
+
+TEST(JsonSmartObjectReaderTest, Parse_WithSchema_EnumsConverted) {
+  CSmartSchema schema = CreateEnumSchema();
+  const std::string json =
+      "{\"language\":\"RU_RU\",\"appType\":[\"MEDIA\",\"UNKNOWN\"],"
+      "\"info\":\"EN_EU\",\"nested\":{\"language\":\"EN_EU\"},"
+      "\"unknown\":\"RU_RU\"}";
+
+  SmartObject result;
+  ASSERT_TRUE(JsonSmartObjectReader::Parse(
+      json, result, schema.getSchemaItem().get()));
+
+  EXPECT_EQ(SmartType_Integer, result["language"].getType());
+  EXPECT_EQ(Language::RU_RU, result["language"].asInt());
+  EXPECT_EQ(AppTypeTest::MEDIA, result["appType"][0].asInt());
+  EXPECT_EQ(std::string("UNKNOWN"), result["appType"][1].asString());
+  EXPECT_EQ(std::string("EN_EU"), result["info"].asString());
+  EXPECT_EQ(Language::EN_EU, result["nested"]["language"].asInt());
+  EXPECT_EQ(std::string("RU_RU"), result["unknown"].asString());
+
+  // Applying schema afterwards gives the same object
+  SmartObject expected = ParseWithJsoncpp(json);
+  schema.applySchema(expected, false);
+  EXPECT_TRUE(expected == result);
+}
+
+TEST(JsonSmartObjectReaderTest, FromString_WithSchema_SameAsRegularPath) {
+  CSmartSchema schema = CreateEnumSchema();
+  const std::string json =
+      "{\"language\":\"EN_EU\",\"appType\":[\"SYSTEM\"],\"number\":5}";
+
+  SmartObject expected;
+  EXPECT_TRUE(CFormatterJsonSDLRPCv2::fromString(
+      json,
+      expected,
+      FunctionIDTest::RegisterAppInterface,
+      MessageTypeTest::request,
+      13));
+  schema.applySchema(expected[S_MSG_PARAMS], false);
+
+  SmartObject result;
+  EXPECT_TRUE(
+      CFormatterJsonSDLRPCv2::fromString(json,
+                                         result,
+                                         FunctionIDTest::RegisterAppInterface,
+                                         MessageTypeTest::request,
+                                         13,
+                                         schema.getSchemaItem().get()));
+  EXPECT_TRUE(expected == result);
+}
+
+TEST(JsonSmartObjectReaderTest, FromString_UnsupportedInput_FallsBack) {
+  const std::string json = "{\"a\":[1,2] /* comment */}";
+
+  SmartObject expected;
+  EXPECT_TRUE(CFormatterJsonSDLRPCv2::fromString(
+      json,
+      expected,
+      FunctionIDTest::RegisterAppInterface,
+      MessageTypeTest::request,
+      13));
+
+  SmartObject result;
+  EXPECT_TRUE(
+      CFormatterJsonSDLRPCv2::fromString(json,
+                                         result,
+                                         FunctionIDTest::RegisterAppInterface,
+                                         MessageTypeTest::request,
+                                         13,
+                                         NULL));
+  EXPECT_TRUE(expected == result);
+  EXPECT_EQ(2u, result[S_MSG_PARAMS]["a"].length());
+}
+
+}  // namespace formatters
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "formatters/CFormatterJsonBase.h"
+#include "formatters/json_smart_object_writer.h"
+#include "gtest/gtest.h"
+#include "json/json.h"
+
+namespace test {
+namespace components {
+namespace formatters {
+
+using ns_smart_device_link::ns_json_handler::formatters::CFormatterJsonBase;
+using ns_smart_device_link::ns_json_handler::formatters::
+    JsonSmartObjectWriter;
+using namespace ns_smart_device_link::ns_smart_objects;
+
+namespace {
+std::string WriteWithJsoncpp(const SmartObject& obj,
+                             const JsonSmartObjectWriter::Style style) {
+  Json::Value root;
+  CFormatterJsonBase::objToJsonValue(obj, root);
+  if (JsonSmartObjectWriter::kStyled == style) {
+    return root.toStyledString();
+  }
+  Json::StreamWriterBuilder writer_builder;
+  writer_builder["indentation"] = "";
+  return Json::writeString(writer_builder, root);
+}
+
+std::string Write(const SmartObject& obj,
+                  const JsonSmartObjectWriter::Style style) {
+  std::string result;
+  JsonSmartObjectWriter writer(result, style);
+  writer.WriteValue(obj);
+  writer.Finish();
+  return result;
+}
+
+std::vector<SmartObject> CreateObjects() {
+  std::vector<SmartObject> objects;
+  objects.push_back(SmartObject());
+  objects.push_back(SmartObject(true));
+  objects.push_back(SmartObject(-42));
+  objects.push_back(SmartObject(std::string("root \"string\"")));
+  objects.push_back(SmartObject(SmartType_Map));
+  objects.push_back(SmartObject(SmartType_Array));
+
+  SmartObject scalars(SmartType_Map);
+  scalars["int"] = 100500;
+  scalars["negative"] = -7;
+  scalars["int64_min"] = std::numeric_limits<int64_t>::min();
+  scalars["int64_max"] = std::numeric_limits<int64_t>::max();
+  scalars["uint"] = 3000000000u;
+  scalars["double"] = 15.2;
+  scalars["round_double"] = 10.0;
+  scalars["small_double"] = -0.000123;
+  scalars["bool"] = false;
+  scalars["char"] = 'c';
+  scalars["null"] = SmartObject();
+  scalars["plain"] = "Some text / with slash";
+  scalars["escaped"] = "quote \" backslash \\ tab \t line\nfeed \x01";
+  scalars["utf8"] =
+      "\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 \xe2\x82\xac";
+  scalars["empty_string"] = "";
+  objects.push_back(scalars);
+
+  SmartObject nested(SmartType_Map);
+  nested["subobject"]["boolField"] = false;
+  nested["subobject"]["arrayField"][0] = 0;
+  nested["subobject"]["arrayField"][1] = 'c';
+  nested["subobject"]["arrayField"][2][0] = 10.0;
+  nested["subobject"]["emptyMap"] = SmartObject(SmartType_Map);
+  nested["subobject"]["emptyArray"] = SmartObject(SmartType_Array);
+  nested["short"][0] = 1;
+  nested["short"][1] = "two";
+  nested["short"][2] = SmartObject(SmartType_Array);
+  nested["short"][3] = SmartObject(SmartType_Map);
+  nested["short"][4] = SmartObject();
+  nested["array_of_maps"][0]["key"] = "value";
+  nested["array_of_maps"][1]["key"][0] = 1;
+  nested["array_of_arrays"][0][0] = 1;
+  nested["array_of_arrays"][1][0][0] = "deep";
+  objects.push_back(nested);
+
+  // Arrays around the single line width limit
+  SmartObject arrays(SmartType_Map);
+  for (int32_t i = 0; i < 30; ++i) {
+    arrays["many"][i] = i;
+    if (i < 24) {
+      arrays["limit"][i] = i;
+    }
+  }
+  for (int32_t length = 60; length < 76; ++length) {
+    SmartObject& array = arrays["long"][length - 60];
+    array[0] = std::string(length - 6, 'x');
+    array[1] = 0;
+  }
+  objects.push_back(arrays);
+
+  SmartObject root_array(SmartType_Array);
+  root_array[0] = scalars;
+  root_array[1] = nested;
+  root_array[2] = 5;
+  objects.push_back(root_array);
+  return objects;
+}
+}  // namespace
+
+TEST(JsonSmartObjectWriterTest, WriteStyled_SameOutputAsJsoncpp) {
+  const std::vector<SmartObject> objects = CreateObjects();
+  for (size_t i = 0; i < objects.size(); ++i) {
+    EXPECT_EQ(WriteWithJsoncpp(objects[i], JsonSmartObjectWriter::kStyled),
+              Write(objects[i], JsonSmartObjectWriter::kStyled))
+        << "Object #" << i;
+  }
+}
+
+TEST(JsonSmartObjectWriterTest, WriteCompact_SameOutputAsJsoncpp) {
+  const std::vector<SmartObject> objects = CreateObjects();
+  for (size_t i = 0; i < objects.size(); ++i) {
+    EXPECT_EQ(WriteWithJsoncpp(objects[i], JsonSmartObjectWriter::kCompact),
+              Write(objects[i], JsonSmartObjectWriter::kCompact))
+        << "Object #" << i;
+  }
+}
+
+TEST(JsonSmartObjectWriterTest, WriteMerged_OverlayReplacesBaseMembers) {
+  SmartObject base(SmartType_Map);
+  base["a"] = 1;
+  base["code"] = "base code";
+  base["z"] = 2;
+  SmartObject overlay(SmartType_Map);
+  overlay["code"] = 0;
+  overlay["method"] = "VR.AddCommand";
+
+  std::string result;
+  JsonSmartObjectWriter writer(result, JsonSmartObjectWriter::kCompact);
+  writer.WriteMerged(base, overlay);
+  EXPECT_EQ("{\"a\":1,\"code\":0,\"method\":\"VR.AddCommand\",\"z\":2}",
+            result);
+
+  JsonSmartObjectWriter empty_writer(result, JsonSmartObjectWriter::kCompact);
+  empty_writer.WriteMerged(SmartObject(), SmartObject(SmartType_Map));
+  EXPECT_EQ("{}", result);
+}
+
+TEST(JsonSmartObjectWriterTest, BeginObject_MembersWritten) {
+  std::string result("previous content");
+  JsonSmartObjectWriter writer(result, JsonSmartObjectWriter::kStyled);
+  writer.BeginObject();
+  writer.Key("id");
+  writer.WriteUInt(4444u);
+  writer.Key("jsonrpc");
+  writer.WriteString("2.0");
+  writer.Key("params");
+  writer.BeginObject();
+  writer.EndObject();
+  writer.EndObject();
+  writer.Finish();
+
+  EXPECT_EQ(
+      "{\n"
+      "   \"id\" : 4444,\n"
+      "   \"jsonrpc\" : \"2.0\",\n"
+      "   \"params\" : {}\n"
+      "}\n",
+      result);
+}
+
+}  // namespace formatters
+}  // namespace components
+}  // namespace test
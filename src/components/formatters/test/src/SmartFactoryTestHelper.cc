@@ -48,6 +48,10 @@ const EnumConversionHelper<TestType::eType>::CStringToEnumMap
         EnumConversionHelper<test::components::formatters::TestType::eType>::
             InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* EnumConversionHelper<
+    test::components::formatters::TestType::eType>::hash_tables_ = NULL;
+
 template <>
 const char* const EnumConversionHelper<TestType::eType>::cstring_values_[] = {
     "APPLICATION_NOT_REGISTERED",
@@ -88,6 +92,10 @@ const EnumConversionHelper<FunctionIdTest::eType>::CStringToEnumMap
             test::components::formatters::FunctionIdTest::eType>::
             InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* EnumConversionHelper<
+    test::components::formatters::FunctionIdTest::eType>::hash_tables_ = NULL;
+
 template <>
 const char* const
     EnumConversionHelper<FunctionIdTest::eType>::cstring_values_[] = {
@@ -114,6 +122,10 @@ const EnumConversionHelper<MessageTypeTest::eType>::CStringToEnumMap
             test::components::formatters::MessageTypeTest::eType>::
             InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* EnumConversionHelper<
+    test::components::formatters::MessageTypeTest::eType>::hash_tables_ = NULL;
+
 template <>
 const char* const
     EnumConversionHelper<MessageTypeTest::eType>::cstring_values_[] = {
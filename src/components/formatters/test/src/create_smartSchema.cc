@@ -53,6 +53,10 @@ const EnumConversionHelper<FunctionIDTest::eType>::CStringToEnumMap
             test::components::formatters::FunctionIDTest::eType>::
             InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* EnumConversionHelper<
+    test::components::formatters::FunctionIDTest::eType>::hash_tables_ = NULL;
+
 template <>
 const char* const
     EnumConversionHelper<FunctionIDTest::eType>::cstring_values_[] = {
@@ -81,6 +85,10 @@ const EnumConversionHelper<Language::eType>::CStringToEnumMap
         EnumConversionHelper<test::components::formatters::Language::eType>::
             InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* EnumConversionHelper<
+    test::components::formatters::Language::eType>::hash_tables_ = NULL;
+
 template <>
 const char* const EnumConversionHelper<Language::eType>::cstring_values_[] = {
     "EN_EU", "RU_RU"};
@@ -104,6 +112,11 @@ const EnumConversionHelper<SpeechCapabilities::eType>::CStringToEnumMap
         EnumConversionHelper<test::components::formatters::SpeechCapabilities::
                                  eType>::InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* EnumConversionHelper<
+    test::components::formatters::SpeechCapabilities::eType>::hash_tables_ =
+        NULL;
+
 template <>
 const char* const
     EnumConversionHelper<SpeechCapabilities::eType>::cstring_values_[] = {
@@ -128,6 +141,10 @@ const EnumConversionHelper<AppTypeTest::eType>::CStringToEnumMap
             test::components::formatters::AppTypeTest::eType>::
             InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* EnumConversionHelper<
+    test::components::formatters::AppTypeTest::eType>::hash_tables_ = NULL;
+
 template <>
 const char* const EnumConversionHelper<AppTypeTest::eType>::cstring_values_[] =
     {"SYSTEM", "MEDIA"};
@@ -73,9 +73,11 @@ struct MessageToHmi : public MessageSharedPointer {
   }
 };
 
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageFromHmi> >
+typedef threads::MessageLoopThread<
+    utils::FixedPrioritizedQueue<MessageFromHmi> >
     FromHmiQueue;
-typedef threads::MessageLoopThread<utils::PrioritizedQueue<MessageToHmi> >
+typedef threads::MessageLoopThread<
+    utils::FixedPrioritizedQueue<MessageToHmi> >
     ToHmiQueue;
 }  // namespace impl
 
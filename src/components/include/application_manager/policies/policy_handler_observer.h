@@ -57,6 +57,13 @@ class PolicyHandlerObserver {
 
   virtual void OnPTUTimeoutExceeded() {}
 
+  /**
+   * @brief OnPermissionsUpdated is called when permissions of application
+   * have been changed by policy table update or user consent
+   * @param policy_app_id policy id of application
+   */
+  virtual void OnPermissionsUpdated(const std::string& policy_app_id) {}
+
 #ifdef EXTERNAL_PROPRIETARY_MODE
   /**
    * @brief OnCertDecryptFinished is called when certificate decryption is
@@ -240,6 +240,24 @@ class ConnectionHandler {
   virtual void BindProtocolVersionWithSession(
       uint32_t connection_key,
       const utils::SemanticVersion& full_protocol_version) = 0;
+
+  /**
+   * @brief binds RPC payload format negotiated for RPC service with session
+   * @param connection_key pair of connection and session id
+   * @param rpc_payload_format format of RPC payload used by the session
+   */
+  virtual void BindRpcPayloadFormatWithSession(
+      uint32_t connection_key,
+      const protocol_handler::RpcPayloadFormat rpc_payload_format) = 0;
+
+  /**
+   * @brief returns RPC payload format negotiated for session
+   * @param connection_key pair of connection and session id
+   * @return format bound with session, JSON if session does not exist
+   */
+  virtual protocol_handler::RpcPayloadFormat RpcPayloadFormatUsed(
+      uint32_t connection_key) const = 0;
+
   /**
    * \brief information about given Connection Key.
    * \param key Unique key used by other components as session identifier
@@ -37,6 +37,7 @@ namespace strings {
 extern const char* hash_id;
 extern const char* protocol_version;
 extern const char* mtu;
+extern const char* rpc_payload_format;
 extern const char* rejected_params;
 extern const char* height;
 extern const char* width;
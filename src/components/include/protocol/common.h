@@ -233,6 +233,22 @@ const size_t MAXIMUM_FRAME_DATA_V2_SIZE = 1488;
  */
 const uint8_t FIRST_FRAME_DATA_SIZE = 0x08;
 
+/**
+ *\brief Encoding of RPC payload (msg_params) negotiated for RPC service
+ * of the session in StartService ACK.
+ */
+enum RpcPayloadFormat {
+  /**
+   *\brief Default SDLRPCv2 JSON payload
+   */
+  RPC_PAYLOAD_FORMAT_JSON = 0,
+  /**
+   *\brief msg_params encoded as BSON document.
+   * Available since protocol version 5 if requested by mobile.
+   */
+  RPC_PAYLOAD_FORMAT_BSON = 1
+};
+
 /**
  *\enum RESULT_CODE
  *\brief Return type for operations with message handling.
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SRC_COMPONENTS_INCLUDE_PROTOCOL_FRAME_POOL_H_
+#define SRC_COMPONENTS_INCLUDE_PROTOCOL_FRAME_POOL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace protocol_handler {
+
+/**
+ * \brief Size-classed memory pool for frames, raw messages and their
+ * payload buffers.
+ * Each thread keeps a cache of free blocks per size class and exchanges
+ * blocks in batches with a shared depot, so steady-state traffic does not
+ * touch the heap even if blocks are allocated in one thread (transport)
+ * and freed in another one (protocol handler).
+ * Blocks bigger than the largest size class are taken from the heap
+ * directly. All functions are thread-safe.
+ */
+namespace frame_pool {
+
+/**
+ * \brief Counters of pool activity since process start
+ */
+struct Statistics {
+  Statistics() : pool_allocations(0u), heap_allocations(0u), released(0u) {}
+  /**
+   * \brief Allocations served from cached blocks
+   */
+  uint64_t pool_allocations;
+  /**
+   * \brief Allocations which had to take memory from the heap
+   */
+  uint64_t heap_allocations;
+  /**
+   * \brief Blocks returned to the heap
+   */
+  uint64_t released;
+};
+
+/**
+ * \brief Allocates block of at least size bytes
+ * \return Block pointer or NULL if memory could not be allocated
+ */
+void* Allocate(const size_t size);
+
+/**
+ * \brief Returns block allocated with Allocate() to the pool
+ */
+void Deallocate(void* block);
+
+/**
+ * \brief Gets current pool counters
+ */
+Statistics GetStatistics();
+
+/**
+ * \brief Sets amount of memory kept in free blocks of all size classes.
+ * Thread caches which exceed new limit shrink on their next deallocation.
+ * \param thread_cache_limit Bytes cached by each thread, 0 keeps default
+ * \param shared_cache_limit Bytes kept in shared depot, 0 keeps default
+ */
+void SetCacheLimits(const size_t thread_cache_limit,
+                    const size_t shared_cache_limit);
+
+/**
+ * \brief Returns to the heap blocks of shared depot which have not been
+ * used since previous call, so expected to be called periodically.
+ */
+void TrimIdleMemory();
+
+/**
+ * \brief Returns all cached blocks to the heap.
+ * Depot is released immediately, caches of other threads are released
+ * on their next pool operation.
+ */
+void ReleaseCachedMemory();
+
+/**
+ * \brief Deleter for buffers allocated with Allocate()
+ */
+struct Deleter {
+  void operator()(void* block) const {
+    Deallocate(block);
+  }
+};
+
+/**
+ * \brief Standard allocator taking memory from the pool
+ */
+template <typename T>
+class Allocator {
+ public:
+  typedef T value_type;
+
+  Allocator() {}
+
+  template <typename U>
+  Allocator(const Allocator<U>&) {}
+
+  T* allocate(const size_t n) {
+    void* block = Allocate(n * sizeof(T));
+    if (!block) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(block);
+  }
+
+  void deallocate(T* p, size_t) {
+    Deallocate(p);
+  }
+
+  template <typename U>
+  struct rebind {
+    typedef Allocator<U> other;
+  };
+};
+
+template <typename T, typename U>
+bool operator==(const Allocator<T>&, const Allocator<U>&) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const Allocator<T>&, const Allocator<U>&) {
+  return false;
+}
+
+/**
+ * \brief Creates object sharing single pool block with its control block
+ */
+template <typename T, typename... Args>
+std::shared_ptr<T> MakeShared(Args&&... args) {
+  return std::allocate_shared<T>(Allocator<T>(), std::forward<Args>(args)...);
+}
+
+/**
+ * \brief Allocates buffer of size bytes owned by shared pointer
+ * \return Buffer or empty pointer if memory could not be allocated
+ */
+inline std::shared_ptr<uint8_t> MakeSharedBuffer(const size_t size) {
+  uint8_t* buffer = static_cast<uint8_t*>(Allocate(size));
+  if (!buffer) {
+    return std::shared_ptr<uint8_t>();
+  }
+  return std::shared_ptr<uint8_t>(buffer, Deleter(), Allocator<uint8_t>());
+}
+
+}  // namespace frame_pool
+}  // namespace protocol_handler
+#endif  // SRC_COMPONENTS_INCLUDE_PROTOCOL_FRAME_POOL_H_
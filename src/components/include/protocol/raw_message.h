@@ -33,6 +33,7 @@
 #define SRC_COMPONENTS_INCLUDE_PROTOCOL_RAW_MESSAGE_H_
 
 #include <memory>
+#include <mutex>
 #include "protocol/message_priority.h"
 #include "protocol/service_type.h"
 #include "utils/macro.h"
@@ -61,10 +62,58 @@ class RawMessage {
              bool protection,
              uint8_t type = ServiceType::kRpc,
              uint32_t payload_size = 0);
+  /**
+   * \brief Constructor which shares data buffer instead of copying it
+   * \param connection_key Identifier of connection within which message
+   * is transferred
+   * \param protocolVersion Version of protocol of the message
+   * \param data Buffer holding message data, it is referenced by message
+   * until message is destroyed
+   * \param dataSize Message size
+   * \param payload_size Received data size
+   */
+  RawMessage(uint32_t connection_key,
+             uint32_t protocol_version,
+             const std::shared_ptr<uint8_t>& data,
+             uint32_t data_size,
+             bool protection,
+             uint8_t type = ServiceType::kRpc,
+             uint32_t payload_size = 0);
+  /**
+   * \brief Constructor for outgoing frame kept in two parts: header which
+   * is copied into message and tail which references shared buffer.
+   * Transports capable of gather writes send both parts as is,
+   * data() joins them on the first call.
+   * \param connection_key Identifier of connection within which message
+   * is transferred
+   * \param protocolVersion Version of protocol of the message
+   * \param header Frame header
+   * \param header_size Frame header size, up to kMaxHeaderSize bytes
+   * \param tail Buffer holding rest of the frame, it is referenced by message
+   * until message is destroyed
+   * \param tail_size Size of the rest of the frame
+   */
+  RawMessage(uint32_t connection_key,
+             uint32_t protocol_version,
+             const uint8_t* const header,
+             uint32_t header_size,
+             const std::shared_ptr<uint8_t>& tail,
+             uint32_t tail_size,
+             bool protection,
+             uint8_t type = ServiceType::kRpc);
   /**
    * \brief Destructor
    */
   ~RawMessage();
+  /**
+   * \brief Contiguous part of message data
+   */
+  struct Segment {
+    const uint8_t* data;
+    size_t size;
+  };
+  static const size_t kMaxSegments = 2u;
+  static const size_t kMaxHeaderSize = 16u;
   /**
    * \brief Connection Identifier
    * Obtained from \s ConnectionHandler
@@ -78,6 +127,19 @@ class RawMessage {
    * \brief Getter for message string data
    */
   uint8_t* data() const;
+  /**
+   * \brief Gets contiguous parts message data consists of without joining
+   * them
+   * \param segments Array of kMaxSegments elements to fill
+   * \return Amount of filled segments
+   */
+  size_t GetSegments(Segment* segments) const;
+  /**
+   * \brief Getter for buffer holding message data
+   * \return Buffer shared with message or empty pointer if message
+   * owns copy of its data
+   */
+  const std::shared_ptr<uint8_t>& buffer() const;
   /**
    * \brief Getter for message size
    */
@@ -108,8 +170,19 @@ class RawMessage {
   void set_waiting(bool v);
 
  private:
+  /**
+   * \brief Copies header and tail of the frame into single buffer
+   */
+  void JoinSegments() const;
+
   uint32_t connection_key_;
-  uint8_t* data_;
+  // Assigned lazily for frames kept in two parts
+  mutable uint8_t* data_;
+  std::shared_ptr<uint8_t> buffer_;
+  uint8_t header_[kMaxHeaderSize];
+  size_t header_size_;
+  std::shared_ptr<uint8_t> tail_;
+  mutable std::once_flag join_flag_;
   size_t data_size_;
   uint32_t protocol_version_;
   bool protection_;
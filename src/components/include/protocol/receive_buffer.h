@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SRC_COMPONENTS_INCLUDE_PROTOCOL_RECEIVE_BUFFER_H_
+#define SRC_COMPONENTS_INCLUDE_PROTOCOL_RECEIVE_BUFFER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <memory>
+
+#include "protocol/raw_message.h"
+#include "utils/macro.h"
+
+namespace protocol_handler {
+
+/**
+ * \class ReceiveBuffer
+ * \brief Refcounted memory slab transport reads incoming data into.
+ * Each read takes next free region of the slab and is passed further as
+ * RawMessage referencing that region, so received data is not copied.
+ * Slab is released when the last message or frame referencing it is
+ * destroyed. Once slab is exhausted new one is allocated. Frames kept
+ * after being handled should be detached from the slab with
+ * ProtocolPacket::DetachSharedData(), otherwise each of them holds whole slab.
+ * Not thread-safe, intended to be used by single receiving thread.
+ */
+class ReceiveBuffer {
+ public:
+  /**
+   * \brief Default size of single slab
+   */
+  static const size_t kDefaultSlabSize = 64 * 1024;
+
+  /**
+   * \brief Constructor
+   * \param slab_size Size of slabs to allocate
+   * \param min_read_size Minimal size of region returned by Prepare()
+   */
+  explicit ReceiveBuffer(const size_t slab_size = kDefaultSlabSize,
+                         const size_t min_read_size = 4096);
+
+  /**
+   * \brief Gets region for next read, allocates new slab if current one
+   * has less than min_read_size bytes left
+   * \return Pointer to writable region of writable_size() bytes or
+   * NULL if memory could not be allocated
+   */
+  uint8_t* Prepare();
+
+  /**
+   * \brief Size of region returned by Prepare()
+   */
+  size_t writable_size() const;
+
+  /**
+   * \brief Takes size bytes written to prepared region as a message
+   * sharing the slab
+   * \param size Amount of bytes written, must not exceed writable_size()
+   * \return Message referencing written data
+   */
+  RawMessagePtr Commit(const size_t size);
+
+ private:
+  const size_t slab_size_;
+  const size_t min_read_size_;
+  std::shared_ptr<uint8_t> slab_;
+  size_t used_;
+
+  DISALLOW_COPY_AND_ASSIGN(ReceiveBuffer);
+};
+
+}  // namespace protocol_handler
+#endif  // SRC_COMPONENTS_INCLUDE_PROTOCOL_RECEIVE_BUFFER_H_
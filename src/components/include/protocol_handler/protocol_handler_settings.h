@@ -35,6 +35,22 @@ class ProtocolHandlerSettings {
   virtual uint16_t max_supported_protocol_version() const = 0;
 
   virtual uint32_t multiframe_waiting_timeout() const = 0;
+
+  /**
+   * @brief Returns amount of frame memory cached by each thread in bytes
+   */
+  virtual size_t frame_pool_thread_cache_size() const = 0;
+
+  /**
+   * @brief Returns amount of frame memory shared between threads in bytes
+   */
+  virtual size_t frame_pool_shared_cache_size() const = 0;
+
+  /**
+   * @brief Returns period of returning unused frame memory to system
+   * in milliseconds
+   */
+  virtual uint32_t frame_pool_trim_period() const = 0;
 #ifdef ENABLE_SECURITY
   /**
    * @brief Returns force protected services
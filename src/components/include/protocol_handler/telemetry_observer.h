@@ -47,6 +47,9 @@ class PHTelemetryObserver {
     uint8_t connection_key;
     date_time::TimeDuration begin;
     date_time::TimeDuration end;
+    // Frame pool counters at the moment message processing was finished
+    uint64_t frame_pool_allocations;
+    uint64_t frame_heap_allocations;
   };
   virtual void StartMessageProcess(
       uint32_t message_id, const date_time::TimeDuration& start_time) = 0;
@@ -101,6 +101,13 @@ class MockConnectionHandler : public connection_handler::ConnectionHandler {
   MOCK_METHOD2(BindProtocolVersionWithSession,
                void(uint32_t connection_key,
                     const utils::SemanticVersion& full_protocol_version));
+  MOCK_METHOD2(
+      BindRpcPayloadFormatWithSession,
+      void(uint32_t connection_key,
+           const protocol_handler::RpcPayloadFormat rpc_payload_format));
+  MOCK_CONST_METHOD1(
+      RpcPayloadFormatUsed,
+      protocol_handler::RpcPayloadFormat(uint32_t connection_key));
   MOCK_CONST_METHOD4(GetDataOnSessionKey,
                      int32_t(uint32_t key,
                              uint32_t* app_id,
@@ -56,6 +56,9 @@ class MockProtocolHandlerSettings
   MOCK_CONST_METHOD0(max_supported_protocol_version, uint16_t());
   MOCK_CONST_METHOD0(enable_protocol_4, bool());
   MOCK_CONST_METHOD0(multiframe_waiting_timeout, uint32_t());
+  MOCK_CONST_METHOD0(frame_pool_thread_cache_size, size_t());
+  MOCK_CONST_METHOD0(frame_pool_shared_cache_size, size_t());
+  MOCK_CONST_METHOD0(frame_pool_trim_period, uint32_t());
 #ifdef ENABLE_SECURITY
   MOCK_CONST_METHOD0(force_protected_service, const std::vector<int>&());
   MOCK_CONST_METHOD0(force_unprotected_service, const std::vector<int>&());
@@ -47,6 +47,7 @@ class MockTransportManagerSettings
   MOCK_CONST_METHOD0(use_last_state, bool());
   MOCK_CONST_METHOD0(transport_manager_disconnect_timeout, uint32_t());
   MOCK_CONST_METHOD0(transport_manager_tcp_adapter_port, uint16_t());
+  MOCK_CONST_METHOD0(transport_manager_io_reactor_threads, uint32_t());
 
   // from mme settings
   MOCK_CONST_METHOD0(event_mq_name, const std::string&());
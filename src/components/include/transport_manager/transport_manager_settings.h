@@ -69,6 +69,11 @@ class TransportManagerSettings : public TransportManagerMMESettings {
    */
   virtual const std::string& transport_manager_tcp_adapter_network_interface()
       const = 0;
+
+  /**
+   * @brief Returns number of threads serving socket connections
+   */
+  virtual uint32_t transport_manager_io_reactor_threads() const = 0;
 #ifdef WEBSOCKET_SERVER_TRANSPORT_SUPPORT
   /**
    *@brief Returns websocket server address
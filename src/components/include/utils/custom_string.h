@@ -33,7 +33,11 @@
 #ifndef SRC_COMPONENTS_INCLUDE_UTILS_CUSTOM_STRING_H_
 #define SRC_COMPONENTS_INCLUDE_UTILS_CUSTOM_STRING_H_
 
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 #include <string>
+#include <unordered_set>
 
 namespace utils {
 namespace custom_string {
@@ -179,6 +183,12 @@ class CustomString {
    */
   bool CompareIgnoreCase(const char* str) const;
 
+  /**
+   * @brief Gets hash of the string which is equal for strings
+   * equal in terms of CompareIgnoreCase.
+   */
+  uint32_t HashIgnoreCase() const;
+
   /**
    * @brief Returns a pointer to string from CustomString.
    */
@@ -212,6 +222,70 @@ class CustomString {
   bool is_ascii_string_;
 };
 
+/**
+ * @brief Compares UTF8 strings ignoring case without converting
+ * them to unicode strings.
+ * Letters of Latin, Greek, Cyrillic and Armenian scripts are folded
+ * independently of process locale.
+ * @return Returns TRUE if strings are equal otherwise returns FALSE.
+ */
+bool EqualIgnoreCase(const char* lhs,
+                     const size_t lhs_length,
+                     const char* rhs,
+                     const size_t rhs_length);
+
+/**
+ * @brief Gets case insensitive faq6 hash of UTF8 string.
+ * Strings equal in terms of EqualIgnoreCase have equal hashes.
+ */
+uint32_t HashIgnoreCase(const char* str, const size_t length);
+
+/**
+ * @brief Reference to UTF8 string which is compared and hashed
+ * ignoring case. Referenced string is not copied, so it should outlive
+ * the reference.
+ */
+class StringRefIgnoreCase {
+ public:
+  StringRefIgnoreCase(const char* str, const size_t length)
+      : str_(str), length_(length), hash_(HashIgnoreCase(str, length)) {}
+
+  explicit StringRefIgnoreCase(const char* str)
+      : str_(str), length_(strlen(str)), hash_(HashIgnoreCase(str, length_)) {}
+
+  explicit StringRefIgnoreCase(const CustomString& str)
+      : str_(str.c_str())
+      , length_(str.length_bytes())
+      , hash_(str.HashIgnoreCase()) {}
+
+  bool operator==(const StringRefIgnoreCase& other) const {
+    return hash_ == other.hash_ &&
+           EqualIgnoreCase(str_, length_, other.str_, other.length_);
+  }
+
+  const char* c_str() const {
+    return str_;
+  }
+
+  struct Hash {
+    size_t operator()(const StringRefIgnoreCase& str) const {
+      return str.hash_;
+    }
+  };
+
+ private:
+  const char* str_;
+  size_t length_;
+  uint32_t hash_;
+};
+
+/**
+ * @brief Set of strings unique ignoring case, e.g. index of VR synonyms
+ * used to find duplicates in a single pass
+ */
+typedef std::unordered_set<StringRefIgnoreCase, StringRefIgnoreCase::Hash>
+    StringSetIgnoreCase;
+
 }  // namespace custom_string
 }  // namespace utils
 
@@ -35,6 +35,8 @@
 
 #include <algorithm>
 #include <queue>
+#include <utility>
+#include <vector>
 
 #include "utils/conditional_variable.h"
 #include "utils/lock.h"
@@ -91,6 +93,15 @@ class MessageQueue {
    */
   bool pop(T& element);
 
+  /**
+   * \brief Removes up to max_count elements from the queue
+   * within single lock acquisition and appends them to elements
+   * \param elements Container to append removed elements to
+   * \param max_count Maximal amount of elements to remove
+   * \return Amount of removed elements, 0 if queue is empty
+   */
+  size_t pop_batch(std::vector<T>& elements, const size_t max_count);
+
   /**
    * \brief Conditional wait.
    */
@@ -191,6 +202,22 @@ bool MessageQueue<T, Q>::pop(T& element) {
   return true;
 }
 
+template <typename T, class Q>
+size_t MessageQueue<T, Q>::pop_batch(std::vector<T>& elements,
+                                     const size_t max_count) {
+  sync_primitives::AutoLock auto_lock(queue_lock_);
+  size_t count = 0;
+  while (count < max_count && !queue_.empty()) {
+    elements.push_back(std::move(queue_.front()));
+    queue_.pop();
+    ++count;
+  }
+  if (count) {
+    queue_new_items_.Broadcast();
+  }
+  return count;
+}
+
 template <typename T, class Q>
 void MessageQueue<T, Q>::Shutdown() {
   sync_primitives::AutoLock auto_lock(queue_lock_);
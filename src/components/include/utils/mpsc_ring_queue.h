@@ -0,0 +1,414 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_MPSC_RING_QUEUE_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_MPSC_RING_QUEUE_H_
+
+#include <stddef.h>
+#include <atomic>
+#include <new>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+#include "utils/message_queue.h"
+
+namespace utils {
+
+/**
+ * \class MpscRingQueue
+ * \brief Bounded lock-free queue for many producers and single consumer.
+ * Each cell carries a sequence number, so producers only contend on a
+ * single CAS of the tail index and consumer never takes any lock.
+ * Indexes written by producers and by consumer live on different cache
+ * lines to avoid false sharing.
+ * Can be used as Q parameter of MessageQueue and MessageLoopThread,
+ * see MessageQueue specialization below.
+ */
+template <typename T, size_t Capacity = 1024>
+class MpscRingQueue {
+ public:
+  typedef T value_type;
+
+  MpscRingQueue();
+  ~MpscRingQueue();
+
+  /**
+   * \brief Adds element to the queue. Can be called from any thread.
+   * \return True on success, false if queue is full
+   */
+  bool TryPush(const T& element);
+
+  /**
+   * \brief Removes element from the queue. Must be called from
+   * consumer thread only.
+   * \return True on success, false if there is no published element
+   */
+  bool TryPop(T& element);
+
+  /**
+   * \brief Checks if there is no published element at the head
+   */
+  bool empty() const;
+
+  /**
+   * \brief Returns approximate amount of elements in the queue
+   */
+  size_t size() const;
+
+ private:
+  enum { kCacheLineSize = 64 };
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  T* Element(Cell& cell) {
+    return reinterpret_cast<T*>(&cell.storage);
+  }
+
+  char front_padding_[kCacheLineSize];
+  std::atomic<size_t> tail_;
+  char tail_padding_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> head_;
+  char head_padding_[kCacheLineSize - sizeof(std::atomic<size_t>)];
+  Cell* cells_;
+
+  static_assert(Capacity >= 2 && 0 == (Capacity & (Capacity - 1)),
+                "Capacity should be a power of two");
+
+  DISALLOW_COPY_AND_ASSIGN(MpscRingQueue);
+};
+
+template <typename T, size_t Capacity>
+MpscRingQueue<T, Capacity>::MpscRingQueue()
+    : tail_(0), head_(0), cells_(new Cell[Capacity]) {
+  for (size_t i = 0; i < Capacity; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+template <typename T, size_t Capacity>
+MpscRingQueue<T, Capacity>::~MpscRingQueue() {
+  T element;
+  while (TryPop(element)) {
+  }
+  delete[] cells_;
+}
+
+template <typename T, size_t Capacity>
+bool MpscRingQueue<T, Capacity>::TryPush(const T& element) {
+  size_t position = tail_.load(std::memory_order_relaxed);
+  Cell* cell = NULL;
+  for (;;) {
+    cell = &cells_[position & (Capacity - 1)];
+    const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    const ptrdiff_t difference =
+        static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position);
+    if (0 == difference) {
+      if (tail_.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      return false;
+    } else {
+      position = tail_.load(std::memory_order_relaxed);
+    }
+  }
+
+  new (&cell->storage) T(element);
+  cell->sequence.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T, size_t Capacity>
+bool MpscRingQueue<T, Capacity>::TryPop(T& element) {
+  const size_t position = head_.load(std::memory_order_relaxed);
+  Cell& cell = cells_[position & (Capacity - 1)];
+  if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+    return false;
+  }
+
+  T* stored = Element(cell);
+  element = std::move(*stored);
+  stored->~T();
+  cell.sequence.store(position + Capacity, std::memory_order_release);
+  head_.store(position + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T, size_t Capacity>
+bool MpscRingQueue<T, Capacity>::empty() const {
+  const size_t position = head_.load(std::memory_order_acquire);
+  const Cell& cell = cells_[position & (Capacity - 1)];
+  return cell.sequence.load(std::memory_order_acquire) != position + 1;
+}
+
+template <typename T, size_t Capacity>
+size_t MpscRingQueue<T, Capacity>::size() const {
+  const size_t head = head_.load(std::memory_order_acquire);
+  const size_t tail = tail_.load(std::memory_order_acquire);
+  return tail > head ? tail - head : 0;
+}
+
+/**
+ * \class MessageQueue
+ * \brief MessageQueue backed by MpscRingQueue.
+ * push() and pop() do not take any lock while queue is not full and
+ * consumer is busy. Consumer is woken up only if it waits in wait().
+ * Elements which do not fit into the ring are kept in overflow queue,
+ * so push() never blocks and per-producer order is preserved.
+ * pop(), pop_batch() and Reset() must be called from the single consumer
+ * thread only.
+ */
+template <typename T, size_t Capacity>
+class MessageQueue<T, MpscRingQueue<T, Capacity> > {
+ public:
+  typedef MpscRingQueue<T, Capacity> Queue;
+
+  MessageQueue();
+  ~MessageQueue();
+
+  size_t size() const;
+  bool empty() const;
+  bool IsShuttingDown() const;
+  void push(const T& element);
+  bool pop(T& element);
+
+  /**
+   * \brief Removes up to max_count elements from the queue
+   * and appends them to elements
+   * \return Amount of removed elements
+   */
+  size_t pop_batch(std::vector<T>& elements, const size_t max_count);
+
+  void wait();
+  void WaitUntilEmpty();
+  void Shutdown();
+  void Reset();
+
+ private:
+  bool PopElement(T& element);
+  void Clear();
+  void NotifyConsumer();
+  void NotifyEmptyWaiters();
+
+  Queue ring_;
+
+  /**
+   *\brief Elements pushed while ring was full
+   */
+  std::queue<T> overflow_;
+  std::atomic<size_t> overflow_size_;
+  sync_primitives::Lock overflow_lock_;
+
+  std::atomic<bool> shutting_down_;
+  std::atomic<bool> consumer_waiting_;
+  std::atomic<size_t> empty_waiters_;
+
+  sync_primitives::Lock wait_lock_;
+  sync_primitives::ConditionalVariable queue_new_items_;
+  sync_primitives::ConditionalVariable queue_emptied_;
+};
+
+template <typename T, size_t Capacity>
+MessageQueue<T, MpscRingQueue<T, Capacity> >::MessageQueue()
+    : overflow_size_(0)
+    , shutting_down_(false)
+    , consumer_waiting_(false)
+    , empty_waiters_(0) {}
+
+template <typename T, size_t Capacity>
+MessageQueue<T, MpscRingQueue<T, Capacity> >::~MessageQueue() {}
+
+template <typename T, size_t Capacity>
+size_t MessageQueue<T, MpscRingQueue<T, Capacity> >::size() const {
+  return ring_.size() + overflow_size_.load(std::memory_order_acquire);
+}
+
+template <typename T, size_t Capacity>
+bool MessageQueue<T, MpscRingQueue<T, Capacity> >::empty() const {
+  return ring_.empty() &&
+         0 == overflow_size_.load(std::memory_order_acquire);
+}
+
+template <typename T, size_t Capacity>
+bool MessageQueue<T, MpscRingQueue<T, Capacity> >::IsShuttingDown() const {
+  return shutting_down_;
+}
+
+template <typename T, size_t Capacity>
+void MessageQueue<T, MpscRingQueue<T, Capacity> >::push(const T& element) {
+  if (shutting_down_) {
+    return;
+  }
+  if (0 == overflow_size_.load(std::memory_order_acquire) &&
+      ring_.TryPush(element)) {
+    NotifyConsumer();
+    return;
+  }
+  {
+    sync_primitives::AutoLock auto_lock(overflow_lock_);
+    // Ring may be used again only after overflow has been drained,
+    // otherwise elements of the same producer could be reordered
+    if (!overflow_.empty() || !ring_.TryPush(element)) {
+      overflow_.push(element);
+      overflow_size_.fetch_add(1);
+    }
+  }
+  NotifyConsumer();
+}
+
+template <typename T, size_t Capacity>
+bool MessageQueue<T, MpscRingQueue<T, Capacity> >::pop(T& element) {
+  if (shutting_down_) {
+    Clear();
+    return false;
+  }
+  if (!PopElement(element)) {
+    return false;
+  }
+  NotifyEmptyWaiters();
+  return true;
+}
+
+template <typename T, size_t Capacity>
+size_t MessageQueue<T, MpscRingQueue<T, Capacity> >::pop_batch(
+    std::vector<T>& elements, const size_t max_count) {
+  if (shutting_down_) {
+    Clear();
+    return 0;
+  }
+  size_t count = 0;
+  T element;
+  while (count < max_count && PopElement(element)) {
+    elements.push_back(std::move(element));
+    // Moved-from element is not guaranteed to be empty
+    element = T();
+    ++count;
+  }
+  if (count) {
+    NotifyEmptyWaiters();
+  }
+  return count;
+}
+
+template <typename T, size_t Capacity>
+void MessageQueue<T, MpscRingQueue<T, Capacity> >::wait() {
+  sync_primitives::AutoLock auto_lock(wait_lock_);
+  consumer_waiting_.store(true);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  while (!shutting_down_ && empty()) {
+    queue_new_items_.Wait(auto_lock);
+  }
+  consumer_waiting_.store(false);
+}
+
+template <typename T, size_t Capacity>
+void MessageQueue<T, MpscRingQueue<T, Capacity> >::WaitUntilEmpty() {
+  empty_waiters_.fetch_add(1);
+  {
+    sync_primitives::AutoLock auto_lock(wait_lock_);
+    while (!shutting_down_ && !empty()) {
+      queue_emptied_.Wait(auto_lock);
+    }
+  }
+  empty_waiters_.fetch_sub(1);
+}
+
+template <typename T, size_t Capacity>
+void MessageQueue<T, MpscRingQueue<T, Capacity> >::Shutdown() {
+  // Elements are dropped by consumer on the next pop()
+  // as ring can not be drained from any other thread
+  sync_primitives::AutoLock auto_lock(wait_lock_);
+  shutting_down_ = true;
+  queue_new_items_.Broadcast();
+  queue_emptied_.Broadcast();
+}
+
+template <typename T, size_t Capacity>
+void MessageQueue<T, MpscRingQueue<T, Capacity> >::Reset() {
+  Clear();
+  shutting_down_ = false;
+}
+
+template <typename T, size_t Capacity>
+bool MessageQueue<T, MpscRingQueue<T, Capacity> >::PopElement(T& element) {
+  if (ring_.TryPop(element)) {
+    return true;
+  }
+  if (0 == overflow_size_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  sync_primitives::AutoLock auto_lock(overflow_lock_);
+  if (overflow_.empty()) {
+    return false;
+  }
+  element = std::move(overflow_.front());
+  overflow_.pop();
+  overflow_size_.fetch_sub(1);
+  return true;
+}
+
+template <typename T, size_t Capacity>
+void MessageQueue<T, MpscRingQueue<T, Capacity> >::Clear() {
+  T element;
+  while (PopElement(element)) {
+  }
+}
+
+template <typename T, size_t Capacity>
+void MessageQueue<T, MpscRingQueue<T, Capacity> >::NotifyConsumer() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (consumer_waiting_.load()) {
+    sync_primitives::AutoLock auto_lock(wait_lock_);
+    queue_new_items_.NotifyOne();
+  }
+}
+
+template <typename T, size_t Capacity>
+void MessageQueue<T, MpscRingQueue<T, Capacity> >::NotifyEmptyWaiters() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (empty_waiters_.load() && empty()) {
+    sync_primitives::AutoLock auto_lock(wait_lock_);
+    queue_emptied_.Broadcast();
+  }
+}
+
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_MPSC_RING_QUEUE_H_
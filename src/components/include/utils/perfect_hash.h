@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_INCLUDE_UTILS_PERFECT_HASH_H_
+#define SRC_COMPONENTS_INCLUDE_UTILS_PERFECT_HASH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace utils {
+namespace perfect_hash {
+
+/**
+ * Two level perfect hash used by generated enum conversion tables.
+ * Key hash selects bucket of displacements table, then hash mixed with
+ * displacement of that bucket selects slot of slots table. Code generators
+ * search seed and displacements at generation time so that all keys of
+ * an enum land into different slots, hence any change here must be mirrored
+ * in tools/InterfaceGenerator and tools/intergen.
+ */
+
+/**
+ * @brief Finalization mix of MurmurHash3
+ */
+inline uint32_t Mix(uint32_t hash) {
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+/**
+ * @brief Seeded FNV-1a hash of string
+ * @param str String to hash, does not need to be null-terminated
+ * @param length Amount of bytes to hash
+ * @param seed Hash seed used as FNV offset basis
+ */
+inline uint32_t HashString(const char* str,
+                           const size_t length,
+                           const uint32_t seed) {
+  uint32_t hash = seed;
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= static_cast<uint8_t>(str[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * @brief Seeded hash of integer value
+ */
+inline uint32_t HashValue(const int32_t value, const uint32_t seed) {
+  return Mix(static_cast<uint32_t>(value) ^ seed);
+}
+
+/**
+ * @brief Gets content of slot corresponding to key hash
+ * @param hash Key hash
+ * @param displacements Table of (bucket_mask + 1) displacements
+ * @param bucket_mask Displacements table size minus one
+ * @param slots Table of (slot_mask + 1) slots
+ * @param slot_mask Slots table size minus one
+ */
+template <typename SlotType>
+inline SlotType Lookup(const uint32_t hash,
+                       const uint32_t* displacements,
+                       const uint32_t bucket_mask,
+                       const SlotType* slots,
+                       const uint32_t slot_mask) {
+  const uint32_t displacement = displacements[hash & bucket_mask];
+  return slots[Mix(hash ^ displacement) & slot_mask];
+}
+
+}  // namespace perfect_hash
+}  // namespace utils
+
+#endif  // SRC_COMPONENTS_INCLUDE_UTILS_PERFECT_HASH_H_
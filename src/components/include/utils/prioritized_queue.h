@@ -33,9 +33,11 @@
 #ifndef SRC_COMPONENTS_INCLUDE_UTILS_PRIORITIZED_QUEUE_H_
 #define SRC_COMPONENTS_INCLUDE_UTILS_PRIORITIZED_QUEUE_H_
 
+#include <stdint.h>
 #include <algorithm>
 #include <map>
 #include <queue>
+#include <vector>
 
 #include "utils/macro.h"
 
@@ -87,6 +89,121 @@ class PrioritizedQueue {
   size_t total_size_;
 };
 
+/*
+ * Prioritized queue with fixed amount of priority levels.
+ * Keeps the same contract as PrioritizedQueue, but values returned by
+ * PriorityOrder() must be less than Levels (bigger ones are treated as
+ * the highest level). Each level is a ring buffer which keeps its storage
+ * once allocated, and non-empty levels are tracked by a bitmap, so push and
+ * pop do not allocate in steady state and take constant time.
+ * Default amount of levels covers all protocol_handler::MessagePriority
+ * ordering values.
+ */
+template <typename M, size_t Levels = 256>
+class FixedPrioritizedQueue {
+ public:
+  typedef M value_type;
+  FixedPrioritizedQueue() : total_size_(0) {
+    std::fill(non_empty_levels_, non_empty_levels_ + kWords, 0);
+  }
+  // All api mimics usual std queue interface
+  void push(const value_type& message) {
+    size_t level = message.PriorityOrder();
+    DCHECK(level < Levels);
+    if (level >= Levels) {
+      level = Levels - 1;
+    }
+    levels_[level].push(message);
+    non_empty_levels_[level / kWordBits] |= uint64_t(1) << (level % kWordBits);
+    ++total_size_;
+  }
+  size_t size() const {
+    return total_size_;
+  }
+  bool empty() const {
+    return 0 == total_size_;
+  }
+  void swap(FixedPrioritizedQueue<M, Levels>& x) {
+    std::swap(levels_, x.levels_);
+    std::swap(non_empty_levels_, x.non_empty_levels_);
+    std::swap(total_size_, x.total_size_);
+  }
+  value_type front() {
+    DCHECK(!empty());
+    return levels_[TopLevel()].front();
+  }
+  void pop() {
+    DCHECK(!empty());
+    const size_t level = TopLevel();
+    LevelQueue& queue = levels_[level];
+    queue.pop();
+    --total_size_;
+    if (queue.empty()) {
+      non_empty_levels_[level / kWordBits] &=
+          ~(uint64_t(1) << (level % kWordBits));
+    }
+  }
+
+ private:
+  enum { kWordBits = 64, kWords = (Levels + kWordBits - 1) / kWordBits };
+
+  /*
+   * FIFO ring buffer of single priority level.
+   * Capacity grows by power of two and is never released
+   */
+  class LevelQueue {
+   public:
+    LevelQueue() : head_(0), count_(0) {}
+    void push(const value_type& message) {
+      if (count_ == buffer_.size()) {
+        Grow();
+      }
+      buffer_[(head_ + count_) & (buffer_.size() - 1)] = message;
+      ++count_;
+    }
+    const value_type& front() const {
+      return buffer_[head_];
+    }
+    void pop() {
+      // Release message resources right away instead of on slot reuse
+      buffer_[head_] = value_type();
+      head_ = (head_ + 1) & (buffer_.size() - 1);
+      --count_;
+    }
+    bool empty() const {
+      return 0 == count_;
+    }
+
+   private:
+    void Grow() {
+      std::vector<value_type> buffer(buffer_.empty() ? 4 : buffer_.size() * 2);
+      for (size_t i = 0; i < count_; ++i) {
+        buffer[i] = buffer_[(head_ + i) & (buffer_.size() - 1)];
+      }
+      buffer_.swap(buffer);
+      head_ = 0;
+    }
+
+    std::vector<value_type> buffer_;
+    size_t head_;
+    size_t count_;
+  };
+
+  size_t TopLevel() const {
+    for (size_t word = kWords; word-- > 0;) {
+      if (non_empty_levels_[word]) {
+        return word * kWordBits + (kWordBits - 1) -
+               __builtin_clzll(non_empty_levels_[word]);
+      }
+    }
+    return 0;
+  }
+
+  LevelQueue levels_[Levels];
+  uint64_t non_empty_levels_[kWords];
+  size_t total_size_;
+};
+
 }  // namespace utils
 
 #endif  // SRC_COMPONENTS_INCLUDE_UTILS_PRIORITIZED_QUEUE_H_
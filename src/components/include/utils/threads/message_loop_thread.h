@@ -35,6 +35,7 @@
 
 #include <queue>
 #include <string>
+#include <vector>
 
 #include "utils/logger.h"
 #include "utils/macro.h"
@@ -71,6 +72,20 @@ class MessageLoopThread {
     // TODO (AKozoriz) : change to const reference (APPLINK-20235)
     virtual void Handle(const Message message) = 0;
 
+    /*
+     * Method called by MessageLoopThread to process several messages
+     * taken from it's queue at once. Default implementation passes them
+     * to Handle() one by one, handlers may override it to share
+     * per-message work (locks, lookups) across the whole batch.
+     */
+    virtual void HandleBatch(const std::vector<Message>& messages) {
+      for (typename std::vector<Message>::const_iterator it = messages.begin();
+           it != messages.end();
+           ++it) {
+        Handle(*it);
+      }
+    }
+
     virtual ~Handler() {}
   };
 
@@ -111,12 +126,16 @@ class MessageLoopThread {
     virtual void exitThreadMain() OVERRIDE;
 
    private:
+    // Maximal amount of messages passed to Handler::HandleBatch at once
+    static const size_t kMaxBatchSize = 64;
     // Handle all messages that are in the queue until it is empty
     void DrainQue();
     // Handler that processes messages
     Handler& handler_;
     // Message queue that is actually owned by MessageLoopThread
     MessageQueue<Message, Queue>& message_queue_;
+    // Messages taken from the queue, reused between batches
+    std::vector<Message> batch_;
   };
 
  private:
@@ -175,6 +194,7 @@ MessageLoopThread<Q>::LoopThreadDelegate::LoopThreadDelegate(
     : handler_(*handler), message_queue_(*message_queue) {
   DCHECK(handler != NULL);
   DCHECK(message_queue != NULL);
+  batch_.reserve(kMaxBatchSize);
 }
 
 template <class Q>
@@ -195,11 +215,9 @@ void MessageLoopThread<Q>::LoopThreadDelegate::exitThreadMain() {
 
 template <class Q>
 void MessageLoopThread<Q>::LoopThreadDelegate::DrainQue() {
-  while (!message_queue_.empty()) {
-    Message msg;
-    if (message_queue_.pop(msg)) {
-      handler_.Handle(msg);
-    }
+  while (message_queue_.pop_batch(batch_, kMaxBatchSize)) {
+    handler_.HandleBatch(batch_);
+    batch_.clear();
   }
 }
 
@@ -7,6 +7,7 @@ namespace strings {
 const char* hash_id = "hashId";
 const char* protocol_version = "protocolVersion";
 const char* mtu = "mtu";
+const char* rpc_payload_format = "rpcPayloadFormat";
 const char* rejected_params = "rejectedParams";
 const char* height = "height";
 const char* width = "width";
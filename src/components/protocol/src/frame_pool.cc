@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "protocol/frame_pool.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+
+#include "utils/lock.h"
+#include "utils/logger.h"
+#include "utils/macro.h"
+
+namespace protocol_handler {
+namespace frame_pool {
+
+SDL_CREATE_LOG_VARIABLE("ProtocolHandler")
+
+namespace {
+// Size classes are powers of two from 32 bytes to 128 KB
+const uint32_t kMinClassShift = 5u;
+const uint32_t kMaxClassShift = 17u;
+const uint32_t kClassesCount = kMaxClassShift - kMinClassShift + 1u;
+const uint32_t kHeapClass = kClassesCount;
+
+// Header in front of each block keeps its size class and alignment of payload
+const size_t kHeaderSize = 16u;
+
+// Amount of memory single thread may cache in all size classes
+const size_t kDefaultThreadCacheBytes = 512u * 1024u;
+// Amount of memory shared depot may keep in all size classes
+const size_t kDefaultDepotBytes = 2u * 1024u * 1024u;
+// Limits amount of blocks moved between thread cache and depot at once
+const size_t kMaxBatchCount = 64u;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+struct BlockHeader {
+  uint32_t size_class;
+};
+
+std::atomic<uint64_t> pool_allocations(0u);
+std::atomic<uint64_t> heap_allocations(0u);
+std::atomic<uint64_t> released(0u);
+std::atomic<uint32_t> generation(0u);
+std::atomic<size_t> thread_cache_bytes(kDefaultThreadCacheBytes);
+std::atomic<size_t> depot_bytes(kDefaultDepotBytes);
+
+size_t ClassSize(const uint32_t size_class) {
+  return size_t(1u) << (size_class + kMinClassShift);
+}
+
+uint32_t SizeClass(const size_t size) {
+  uint32_t size_class = 0u;
+  while (size_class < kClassesCount && ClassSize(size_class) < size) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+/**
+ * Amount of blocks taken from depot when thread cache of class is empty
+ */
+size_t BatchCount(const uint32_t size_class) {
+  return std::max<size_t>(
+      1u,
+      std::min(kMaxBatchCount,
+               thread_cache_bytes / 4u / ClassSize(size_class)));
+}
+
+void* HeapAllocate(const uint32_t size_class, const size_t size) {
+  void* raw = malloc(kHeaderSize + size);
+  if (!raw) {
+    SDL_LOG_ERROR("Failed to allocate " << size << " bytes");
+    return NULL;
+  }
+  ++heap_allocations;
+  static_cast<BlockHeader*>(raw)->size_class = size_class;
+  return static_cast<uint8_t*>(raw) + kHeaderSize;
+}
+
+void HeapFree(void* block) {
+  ++released;
+  free(static_cast<uint8_t*>(block) - kHeaderSize);
+}
+
+/**
+ * Detaches first count blocks of list and returns them
+ */
+FreeBlock* SplitList(FreeBlock*& list, const size_t count) {
+  FreeBlock* head = list;
+  FreeBlock* last = list;
+  for (size_t i = 1u; i < count; ++i) {
+    last = last->next;
+  }
+  list = last->next;
+  last->next = NULL;
+  return head;
+}
+
+void FreeList(FreeBlock* list) {
+  while (list) {
+    FreeBlock* next = list->next;
+    HeapFree(list);
+    list = next;
+  }
+}
+
+/**
+ * Free blocks shared between threads
+ */
+class Depot {
+ public:
+  Depot() : bytes_(0u) {
+    std::fill(lists_, lists_ + kClassesCount, static_cast<FreeBlock*>(NULL));
+    std::fill(counts_, counts_ + kClassesCount, 0u);
+    std::fill(idle_counts_, idle_counts_ + kClassesCount, 0u);
+  }
+
+  /**
+   * Moves up to max_count blocks to list
+   * @return Amount of moved blocks
+   */
+  size_t Take(const uint32_t size_class,
+              FreeBlock*& list,
+              const size_t max_count) {
+    sync_primitives::AutoLock auto_lock(locks_[size_class]);
+    const size_t count = std::min(max_count, counts_[size_class]);
+    if (count) {
+      list = SplitList(lists_[size_class], count);
+      counts_[size_class] -= count;
+      idle_counts_[size_class] =
+          std::min(idle_counts_[size_class], counts_[size_class]);
+      bytes_ -= count * ClassSize(size_class);
+    }
+    return count;
+  }
+
+  /**
+   * Takes blocks of list, blocks which exceed depot limit are freed
+   */
+  void Put(const uint32_t size_class, FreeBlock* list) {
+    const size_t size = ClassSize(size_class);
+    {
+      sync_primitives::AutoLock auto_lock(locks_[size_class]);
+      while (list && Reserve(size)) {
+        FreeBlock* next = list->next;
+        list->next = lists_[size_class];
+        lists_[size_class] = list;
+        ++counts_[size_class];
+        list = next;
+      }
+    }
+    FreeList(list);
+  }
+
+  /**
+   * Frees blocks which have not been taken since previous call
+   */
+  void Trim() {
+    for (uint32_t size_class = 0u; size_class < kClassesCount; ++size_class) {
+      FreeBlock* list = NULL;
+      {
+        sync_primitives::AutoLock auto_lock(locks_[size_class]);
+        const size_t count = idle_counts_[size_class];
+        if (count) {
+          list = SplitList(lists_[size_class], count);
+          counts_[size_class] -= count;
+          bytes_ -= count * ClassSize(size_class);
+        }
+        idle_counts_[size_class] = counts_[size_class];
+      }
+      FreeList(list);
+    }
+  }
+
+  void Release() {
+    for (uint32_t size_class = 0u; size_class < kClassesCount; ++size_class) {
+      FreeBlock* list = NULL;
+      {
+        sync_primitives::AutoLock auto_lock(locks_[size_class]);
+        list = lists_[size_class];
+        lists_[size_class] = NULL;
+        bytes_ -= counts_[size_class] * ClassSize(size_class);
+        counts_[size_class] = 0u;
+        idle_counts_[size_class] = 0u;
+      }
+      FreeList(list);
+    }
+  }
+
+ private:
+  /**
+   * Accounts block of size bytes if it fits depot limit
+   */
+  bool Reserve(const size_t size) {
+    if (bytes_.fetch_add(size) + size > depot_bytes) {
+      bytes_ -= size;
+      return false;
+    }
+    return true;
+  }
+
+  sync_primitives::Lock locks_[kClassesCount];
+  FreeBlock* lists_[kClassesCount];
+  size_t counts_[kClassesCount];
+  // Lowest amount of blocks since previous trim, never taken by threads
+  size_t idle_counts_[kClassesCount];
+  // Size of blocks kept in all size classes
+  std::atomic<size_t> bytes_;
+};
+
+Depot& depot() {
+  // Leaked intentionally: caches of threads finishing after static
+  // destruction still return their blocks here
+  static Depot* instance = new Depot();
+  return *instance;
+}
+
+/**
+ * Per-thread cache. Plain data so it stays usable after thread cache
+ * has been flushed on thread exit.
+ */
+struct ThreadCache {
+  FreeBlock* lists[kClassesCount];
+  size_t counts[kClassesCount];
+  size_t bytes;
+  uint32_t generation;
+  bool initialized;
+  bool finished;
+};
+
+thread_local ThreadCache thread_cache;
+pthread_key_t thread_exit_key;
+pthread_once_t thread_exit_key_once = PTHREAD_ONCE_INIT;
+
+void Flush(ThreadCache& cache, const bool to_depot) {
+  for (uint32_t size_class = 0u; size_class < kClassesCount; ++size_class) {
+    if (to_depot) {
+      depot().Put(size_class, cache.lists[size_class]);
+    } else {
+      FreeList(cache.lists[size_class]);
+    }
+    cache.lists[size_class] = NULL;
+    cache.counts[size_class] = 0u;
+  }
+  cache.bytes = 0u;
+}
+
+/**
+ * Moves blocks to depot until cache fits its limit. Half of blocks of
+ * size_class are moved first, then whole classes starting from the biggest.
+ */
+void Shrink(ThreadCache& cache, const uint32_t size_class) {
+  const size_t limit = thread_cache_bytes;
+  uint32_t shrunk_class = size_class;
+  size_t count = (cache.counts[size_class] + 1u) / 2u;
+  for (uint32_t next_class = kClassesCount; cache.bytes > limit;) {
+    if (count) {
+      FreeBlock* list = SplitList(cache.lists[shrunk_class], count);
+      cache.counts[shrunk_class] -= count;
+      cache.bytes -= count * ClassSize(shrunk_class);
+      depot().Put(shrunk_class, list);
+    }
+    if (0u == next_class) {
+      break;
+    }
+    shrunk_class = --next_class;
+    count = cache.counts[shrunk_class];
+  }
+}
+
+void OnThreadExit(void*) {
+  Flush(thread_cache, true);
+  thread_cache.finished = true;
+}
+
+void CreateThreadExitKey() {
+  pthread_key_create(&thread_exit_key, &OnThreadExit);
+}
+
+/**
+ * Gets cache of current thread or NULL if thread is finishing
+ */
+ThreadCache* GetThreadCache() {
+  ThreadCache& cache = thread_cache;
+  if (cache.finished) {
+    return NULL;
+  }
+  if (!cache.initialized) {
+    pthread_once(&thread_exit_key_once, &CreateThreadExitKey);
+    // Value is not used, it just makes OnThreadExit be called
+    pthread_setspecific(thread_exit_key, &cache);
+    cache.generation = generation;
+    cache.initialized = true;
+  }
+  if (cache.generation != generation) {
+    // Cached memory has been requested to be released
+    Flush(cache, false);
+    cache.generation = generation;
+  }
+  return &cache;
+}
+}  // namespace
+
+void* Allocate(const size_t size) {
+  const uint32_t size_class = SizeClass(size);
+  if (kHeapClass == size_class) {
+    return HeapAllocate(size_class, size);
+  }
+
+  FreeBlock* block = NULL;
+  ThreadCache* cache = GetThreadCache();
+  if (cache) {
+    if (!cache->lists[size_class]) {
+      cache->counts[size_class] = depot().Take(
+          size_class, cache->lists[size_class], BatchCount(size_class));
+      cache->bytes += cache->counts[size_class] * ClassSize(size_class);
+    }
+    if (cache->lists[size_class]) {
+      block = cache->lists[size_class];
+      cache->lists[size_class] = block->next;
+      --cache->counts[size_class];
+      cache->bytes -= ClassSize(size_class);
+    }
+  } else {
+    depot().Take(size_class, block, 1u);
+  }
+
+  if (!block) {
+    return HeapAllocate(size_class, ClassSize(size_class));
+  }
+  ++pool_allocations;
+  return block;
+}
+
+void Deallocate(void* block) {
+  if (!block) {
+    return;
+  }
+  const uint32_t size_class =
+      reinterpret_cast<BlockHeader*>(static_cast<uint8_t*>(block) -
+                                     kHeaderSize)->size_class;
+  DCHECK_OR_RETURN_VOID(size_class <= kHeapClass);
+  if (kHeapClass == size_class) {
+    HeapFree(block);
+    return;
+  }
+
+  FreeBlock* free_block = static_cast<FreeBlock*>(block);
+  free_block->next = NULL;
+  ThreadCache* cache = GetThreadCache();
+  if (!cache) {
+    depot().Put(size_class, free_block);
+    return;
+  }
+  free_block->next = cache->lists[size_class];
+  cache->lists[size_class] = free_block;
+  ++cache->counts[size_class];
+  cache->bytes += ClassSize(size_class);
+  if (cache->bytes > thread_cache_bytes) {
+    // Excess is shared with other threads
+    Shrink(*cache, size_class);
+  }
+}
+
+Statistics GetStatistics() {
+  Statistics statistics;
+  statistics.pool_allocations = pool_allocations;
+  statistics.heap_allocations = heap_allocations;
+  statistics.released = released;
+  return statistics;
+}
+
+void SetCacheLimits(const size_t thread_cache_limit,
+                    const size_t shared_cache_limit) {
+  SDL_LOG_DEBUG("Frame cache limits: " << thread_cache_limit << " per thread, "
+                                       << shared_cache_limit << " shared");
+  thread_cache_bytes =
+      thread_cache_limit ? thread_cache_limit : kDefaultThreadCacheBytes;
+  depot_bytes = shared_cache_limit ? shared_cache_limit : kDefaultDepotBytes;
+}
+
+void TrimIdleMemory() {
+  depot().Trim();
+}
+
+void ReleaseCachedMemory() {
+  SDL_LOG_DEBUG("Releasing cached frame memory");
+  ++generation;
+  depot().Release();
+  GetThreadCache();
+}
+
+}  // namespace frame_pool
+}  // namespace protocol_handler
@@ -33,6 +33,9 @@
 #include "protocol/raw_message.h"
 
 #include <memory.h>
+#include <algorithm>
+
+#include "protocol/frame_pool.h"
 
 namespace protocol_handler {
 
@@ -45,6 +48,7 @@ RawMessage::RawMessage(uint32_t connection_key,
                        uint32_t payload_size)
     : connection_key_(connection_key)
     , data_(NULL)
+    , header_size_(0)
     , data_size_(data_sz)
     , protocol_version_(protocol_version)
     , protection_(protection)
@@ -52,13 +56,59 @@ RawMessage::RawMessage(uint32_t connection_key,
     , payload_size_(payload_size)
     , waiting_(false) {
   if (data_param && data_sz > 0) {
-    data_ = new uint8_t[data_sz];
-    memcpy(data_, data_param, sizeof(*data_) * data_sz);
+    data_ = static_cast<uint8_t*>(frame_pool::Allocate(data_sz));
+    if (data_) {
+      memcpy(data_, data_param, sizeof(*data_) * data_sz);
+    } else {
+      data_size_ = 0;
+    }
   }
 }
 
+RawMessage::RawMessage(uint32_t connection_key,
+                       uint32_t protocol_version,
+                       const std::shared_ptr<uint8_t>& data,
+                       uint32_t data_sz,
+                       bool protection,
+                       uint8_t type,
+                       uint32_t payload_size)
+    : connection_key_(connection_key)
+    , data_(data.get())
+    , buffer_(data)
+    , header_size_(0)
+    , data_size_(data_sz)
+    , protocol_version_(protocol_version)
+    , protection_(protection)
+    , service_type_(ServiceTypeFromByte(type))
+    , payload_size_(payload_size)
+    , waiting_(false) {}
+
+RawMessage::RawMessage(uint32_t connection_key,
+                       uint32_t protocol_version,
+                       const uint8_t* const header,
+                       uint32_t header_size,
+                       const std::shared_ptr<uint8_t>& tail,
+                       uint32_t tail_size,
+                       bool protection,
+                       uint8_t type)
+    : connection_key_(connection_key)
+    , data_(NULL)
+    , header_size_(std::min<size_t>(header_size, kMaxHeaderSize))
+    , tail_(tail)
+    , data_size_(header_size_ + tail_size)
+    , protocol_version_(protocol_version)
+    , protection_(protection)
+    , service_type_(ServiceTypeFromByte(type))
+    , payload_size_(0)
+    , waiting_(false) {
+  DCHECK(header_size <= kMaxHeaderSize);
+  memcpy(header_, header, header_size_);
+}
+
 RawMessage::~RawMessage() {
-  delete[] data_;
+  if (!buffer_) {
+    frame_pool::Deallocate(data_);
+  }
 }
 
 uint32_t RawMessage::connection_key() const {
@@ -70,9 +120,37 @@ void RawMessage::set_connection_key(uint32_t key) {
 }
 
 uint8_t* RawMessage::data() const {
+  if (tail_) {
+    std::call_once(join_flag_, &RawMessage::JoinSegments, this);
+  }
   return data_;
 }
 
+size_t RawMessage::GetSegments(Segment* segments) const {
+  if (!tail_) {
+    segments[0].data = data_;
+    segments[0].size = data_size_;
+    return 1u;
+  }
+  segments[0].data = header_;
+  segments[0].size = header_size_;
+  segments[1].data = tail_.get();
+  segments[1].size = data_size_ - header_size_;
+  return 2u;
+}
+
+void RawMessage::JoinSegments() const {
+  data_ = static_cast<uint8_t*>(frame_pool::Allocate(data_size_));
+  if (data_) {
+    memcpy(data_, header_, header_size_);
+    memcpy(data_ + header_size_, tail_.get(), data_size_ - header_size_);
+  }
+}
+
+const std::shared_ptr<uint8_t>& RawMessage::buffer() const {
+  return buffer_;
+}
+
 size_t RawMessage::payload_size() const {
   return payload_size_;
 }
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "protocol/receive_buffer.h"
+
+#include <algorithm>
+
+#include "protocol/frame_pool.h"
+#include "utils/logger.h"
+
+namespace protocol_handler {
+
+SDL_CREATE_LOG_VARIABLE("ProtocolHandler")
+
+ReceiveBuffer::ReceiveBuffer(const size_t slab_size,
+                             const size_t min_read_size)
+    : slab_size_(std::max(slab_size, min_read_size))
+    , min_read_size_(min_read_size)
+    , slab_()
+    , used_(0u) {}
+
+uint8_t* ReceiveBuffer::Prepare() {
+  if (slab_ && slab_size_ - used_ >= min_read_size_) {
+    return slab_.get() + used_;
+  }
+  // Current slab stays alive while messages reference its regions
+  slab_ = frame_pool::MakeSharedBuffer(slab_size_);
+  used_ = 0u;
+  if (!slab_) {
+    SDL_LOG_ERROR("Failed to allocate receive slab of " << slab_size_
+                                                        << " bytes");
+    return NULL;
+  }
+  return slab_.get();
+}
+
+size_t ReceiveBuffer::writable_size() const {
+  return slab_ ? slab_size_ - used_ : 0u;
+}
+
+RawMessagePtr ReceiveBuffer::Commit(const size_t size) {
+  DCHECK_OR_RETURN(slab_ && size <= writable_size(), RawMessagePtr());
+  // Aliasing pointer shares ownership of the whole slab
+  const std::shared_ptr<uint8_t> region(slab_, slab_.get() + used_);
+  used_ += size;
+  return frame_pool::MakeShared<RawMessage>(0, 0, region, size, false);
+}
+
+}  // namespace protocol_handler
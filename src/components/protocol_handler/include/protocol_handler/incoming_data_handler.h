@@ -33,8 +33,10 @@
 #define SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_INCOMING_DATA_HANDLER_H_
 
 #include <map>
+#include <memory>
 #include <vector>
 #include "protocol_handler/protocol_packet.h"
+#include "protocol_handler/ring_buffer.h"
 #include "transport_manager/common.h"
 #include "utils/macro.h"
 
@@ -79,13 +81,57 @@ class IncomingDataHandler {
   void RemoveConnection(const transport_manager::ConnectionUID connection_id);
 
  private:
+  /**
+   * @brief Incoming data which consists of up to two contiguous segments
+   */
+  struct DataSegments {
+    DataSegments();
+    DataSegments(const uint8_t* data, const size_t size);
+
+    size_t size() const {
+      return first_size + second_size;
+    }
+
+    uint8_t operator[](const size_t offset) const {
+      return offset < first_size ? first[offset]
+                                 : second[offset - first_size];
+    }
+
+    /**
+     * @brief Copies size bytes starting from offset to out
+     */
+    void Copy(const size_t offset, const size_t size, uint8_t* out) const;
+
+    const uint8_t* first;
+    size_t first_size;
+    const uint8_t* second;
+    size_t second_size;
+  };
+
+  /**
+   * @brief Checks if first bytes at offset may start valid frame header,
+   * i.e. have known protocol version, frame type and service type.
+   * Requires at least two bytes to be available at offset.
+   */
+  static bool IsHeaderCandidate(const DataSegments& data, const size_t offset);
+
+  /**
+   * @brief Searches for the first offset starting from the given one which
+   * may start valid frame header
+   * @return Found offset or offset with less than header size bytes left
+   */
+  static size_t FindHeaderCandidate(const DataSegments& data, size_t offset);
+
   /**
    * @brief Returns size of frame to be formed from raw bytes.
    */
   static uint32_t GetPacketSize(const ProtocolPacket::ProtocolHeader& header);
   /**
    * @brief Try to create frame from incoming data
-   * \param incommung_data raw stream
+   * \param incoming_data raw stream
+   * \param buffer buffer holding raw stream if it is contiguous, if not empty
+   * created frames reference it instead of copying their payload
+   * \param processed_size amount of bytes consumed from raw stream
    * \param malformed_occurrence count of malformed messages occurrence
    * \param out_frames list for read frames
    *
@@ -94,14 +140,20 @@ class IncomingDataHandler {
    *   - RESULT_OK - one or more frames successfully created
    *   - RESULT_FAIL - packet serialization or validation error occurs
    */
-  RESULT_CODE CreateFrame(std::vector<uint8_t>& incoming_data,
+  RESULT_CODE CreateFrame(const DataSegments& incoming_data,
+                          const std::shared_ptr<uint8_t>& buffer,
+                          size_t& processed_size,
                           ProtocolFramePtrList& out_frames,
                           size_t& malformed_occurrence,
                           const transport_manager::ConnectionUID connection_id);
 
-  typedef std::map<transport_manager::ConnectionUID, std::vector<uint8_t> >
+  typedef std::map<transport_manager::ConnectionUID, RingBuffer>
       ConnectionsDataMap;
   ConnectionsDataMap connections_data_;
+  /**
+   * @brief Storage for frames wrapping around the end of reassembly buffer
+   */
+  std::vector<uint8_t> frame_data_;
   ProtocolPacket::ProtocolHeader header_;
   const ProtocolPacket::ProtocolHeaderValidator* validator_;
   bool last_portion_of_data_was_malformed_;
@@ -47,6 +47,7 @@
 #include "utils/custom_string.h"
 #include "utils/messagemeter.h"
 #include "utils/semantic_version.h"
+#include "utils/timer.h"
 
 #include "application_manager/policies/policy_handler_observer.h"
 #include "connection_handler/connection_handler.h"
@@ -135,10 +136,10 @@ struct RawFordMessageToMobile : public ProtocolFramePtr {
 
 // Short type names for prioritized message queues
 typedef threads::MessageLoopThread<
-    utils::PrioritizedQueue<RawFordMessageFromMobile> >
+    utils::FixedPrioritizedQueue<RawFordMessageFromMobile> >
     FromMobileQueue;
 typedef threads::MessageLoopThread<
-    utils::PrioritizedQueue<RawFordMessageToMobile> >
+    utils::FixedPrioritizedQueue<RawFordMessageToMobile> >
     ToMobileQueue;
 
 // Type to allow easy mapping between a device type and transport
@@ -612,7 +613,7 @@ class ProtocolHandlerImpl
    * \param protocol_version Version of Protocol used in message.
    * \param service_type Type of session, RPC or BULK Data
    * \param data_size Size of message excluding protocol header
-   * \param data Message string
+   * \param data Message string, frames reference parts of it
    * \param max_data_size Maximum allowed size of single frame.
    * \param is_final_message if is_final_message = true - it is last message
    * \return \saRESULT_CODE Status of operation
@@ -622,7 +623,7 @@ class ProtocolHandlerImpl
                                     const uint8_t protocol_version,
                                     const uint8_t service_type,
                                     const size_t data_size,
-                                    const uint8_t* data,
+                                    const std::shared_ptr<uint8_t>& data,
                                     const size_t max_frame_size,
                                     const bool needs_encryption,
                                     const bool is_final_message);
@@ -700,6 +701,11 @@ class ProtocolHandlerImpl
 
   bool TrackMessage(const uint32_t& connection_key);
 
+  /**
+   * \brief Returns frame memory unused since previous call to system
+   */
+  void OnFramePoolTrimTimeout();
+
   bool TrackMalformedMessage(const uint32_t& connection_key,
                              const size_t count);
   /**
@@ -757,6 +763,13 @@ class ProtocolHandlerImpl
   bool ParseFullVersion(utils::SemanticVersion& full_version,
                         const ProtocolFramePtr& packet) const;
 
+  /**
+   * \brief Parses RPC payload format requested in start service message
+   * \param packet Start service message
+   * \return BSON format if it has been requested by mobile, otherwise JSON
+   */
+  RpcPayloadFormat ParseRpcPayloadFormat(const ProtocolFramePtr& packet) const;
+
   const ProtocolHandlerSettings& settings_;
 
   /**
@@ -838,6 +851,8 @@ class ProtocolHandlerImpl
   // Thread that pumps messages prepared to being sent to mobile side.
   impl::ToMobileQueue raw_ford_messages_to_mobile_;
 
+  timer::Timer frame_pool_trim_timer_;
+
   sync_primitives::Lock protocol_observers_lock_;
 
   sync_primitives::Lock start_session_frame_map_lock_;
@@ -34,6 +34,7 @@
 #define SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_PROTOCOL_PACKET_H_
 
 #include <list>
+#include <memory>
 #include "protocol/common.h"
 #include "transport_manager/common.h"
 #include "utils/macro.h"
@@ -59,8 +60,16 @@ class ProtocolPacket {
   struct ProtocolData {
     ProtocolData();
     ~ProtocolData();
+    /**
+     * \brief Frees owned data or drops reference to shared buffer
+     */
+    void reset();
     uint8_t* data;
     uint32_t totalDataBytes;
+    /**
+     * \brief Buffer data points into if it is shared, empty if data is owned
+     */
+    std::shared_ptr<uint8_t> buffer;
   };
 
   /**
@@ -203,6 +212,16 @@ class ProtocolPacket {
   RESULT_CODE deserializePacket(const uint8_t* message,
                                 const size_t messageSize);
 
+  /**
+   * \brief Parses protocol header without copying message body
+   * \param message Buffer holding incoming message string, packet payload
+   * keeps reference to it
+   * \param messageSize Incoming message size
+   * \return \saRESULT_CODE Status of serialization
+   */
+  RESULT_CODE deserializePacket(const std::shared_ptr<uint8_t>& message,
+                                const size_t messageSize);
+
   /**
    * @brief Calculates FIRST_FRAME data for further handling of consecutive
    * frames
@@ -272,6 +291,20 @@ class ProtocolPacket {
    */
   void set_data(const uint8_t* const new_data, const size_t new_data_size);
 
+  /**
+   *\brief Makes packet reference data of shared buffer instead of copying it.
+   * Serialized packet references the same data.
+   */
+  void set_data(const std::shared_ptr<uint8_t>& new_data,
+                const size_t new_data_size);
+
+  /**
+   *\brief Copies data referenced in shared buffer into own memory, so packet
+   * kept for long does not hold whole receive buffer
+   * \return false if memory could not be allocated
+   */
+  bool DetachSharedData();
+
   /**
    *\brief Getter for size of multiframe message
    */
@@ -299,6 +332,10 @@ class ProtocolPacket {
   const ProtocolHeader& packet_header() const;
 
  private:
+  RESULT_CODE DeserializePacket(const uint8_t* message,
+                                const size_t messageSize,
+                                const std::shared_ptr<uint8_t>& buffer);
+
   /**
    *\brief Protocol header
    */
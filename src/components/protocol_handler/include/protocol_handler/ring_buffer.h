@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_RING_BUFFER_H_
+#define SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_RING_BUFFER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace protocol_handler {
+
+/**
+ * \class RingBuffer
+ * \brief Growable byte ring used for incoming data reassembly.
+ * Data is appended at the tail and consumed from the head without moving
+ * remaining bytes, so cost of reassembly is linear in amount of received
+ * data regardless of how it is split into portions.
+ * Capacity is always a power of two and grows when appended data does not
+ * fit, readable data is then at most two contiguous segments.
+ * Not thread-safe
+ */
+class RingBuffer {
+ public:
+  RingBuffer();
+
+  /**
+   * \brief Amount of readable bytes
+   */
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return 0u == size_;
+  }
+
+  size_t capacity() const {
+    return buffer_.size();
+  }
+
+  /**
+   * \brief Gets readable byte at offset from the head
+   */
+  uint8_t operator[](const size_t offset) const {
+    return buffer_[(head_ + offset) & (buffer_.size() - 1)];
+  }
+
+  /**
+   * \brief Appends data to the tail growing capacity if needed
+   */
+  void Append(const uint8_t* data, const size_t size);
+
+  /**
+   * \brief Gets readable data as two contiguous segments.
+   * Second segment is empty unless readable data wraps around the end.
+   */
+  void GetSegments(const uint8_t** first,
+                   size_t* first_size,
+                   const uint8_t** second,
+                   size_t* second_size) const;
+
+  /**
+   * \brief Drops size bytes from the head
+   */
+  void Consume(const size_t size);
+
+  /**
+   * \brief Drops all data
+   */
+  void Clear();
+
+ private:
+  std::vector<uint8_t> buffer_;
+  size_t head_;
+  size_t size_;
+};
+
+}  // namespace protocol_handler
+#endif  // SRC_COMPONENTS_PROTOCOL_HANDLER_INCLUDE_PROTOCOL_HANDLER_RING_BUFFER_H_
@@ -30,7 +30,12 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 #include "protocol_handler/incoming_data_handler.h"
+
+#include <string.h>
+#include <algorithm>
+
 #include "protocol/common.h"
+#include "protocol/frame_pool.h"
 #include "utils/logger.h"
 
 namespace protocol_handler {
@@ -71,14 +76,38 @@ ProtocolFramePtrList IncomingDataHandler::ProcessData(
     out_result = RESULT_FAIL;
     return ProtocolFramePtrList();
   }
-  std::vector<uint8_t>& connection_data = it->second;
-  connection_data.insert(connection_data.end(), data, data + tm_message_size);
-  SDL_LOG_TRACE("Total data size for connection " << connection_id << " is "
-                                                  << connection_data.size());
+  RingBuffer& connection_data = it->second;
   ProtocolFramePtrList out_frames;
   *malformed_occurrence = 0;
-  out_result = CreateFrame(
-      connection_data, out_frames, *malformed_occurrence, connection_id);
+  size_t processed_size = 0;
+  if (connection_data.empty()) {
+    // No partial frame is pending, so frames are taken right from
+    // the received data and share its buffer if there is one
+    out_result = CreateFrame(DataSegments(data, tm_message_size),
+                             tm_message.buffer(),
+                             processed_size,
+                             out_frames,
+                             *malformed_occurrence,
+                             connection_id);
+    connection_data.Append(data + processed_size,
+                           tm_message_size - processed_size);
+  } else {
+    connection_data.Append(data, tm_message_size);
+    SDL_LOG_TRACE("Total data size for connection "
+                  << connection_id << " is " << connection_data.size());
+    DataSegments segments;
+    connection_data.GetSegments(&segments.first,
+                                &segments.first_size,
+                                &segments.second,
+                                &segments.second_size);
+    out_result = CreateFrame(segments,
+                             std::shared_ptr<uint8_t>(),
+                             processed_size,
+                             out_frames,
+                             *malformed_occurrence,
+                             connection_id);
+    connection_data.Consume(processed_size);
+  }
   SDL_LOG_TRACE("New data size for connection " << connection_id << " is "
                                                 << connection_data.size());
   if (!out_frames.empty()) {
@@ -129,17 +158,80 @@ uint32_t IncomingDataHandler::GetPacketSize(
   return 0u;
 }
 
+IncomingDataHandler::DataSegments::DataSegments()
+    : first(NULL), first_size(0u), second(NULL), second_size(0u) {}
+
+IncomingDataHandler::DataSegments::DataSegments(const uint8_t* data,
+                                                const size_t size)
+    : first(data), first_size(size), second(NULL), second_size(0u) {}
+
+void IncomingDataHandler::DataSegments::Copy(const size_t offset,
+                                             const size_t size,
+                                             uint8_t* out) const {
+  size_t copied = 0u;
+  if (offset < first_size) {
+    copied = std::min(size, first_size - offset);
+    memcpy(out, first + offset, copied);
+  }
+  if (copied < size) {
+    memcpy(out + copied,
+           second + (offset + copied - first_size),
+           size - copied);
+  }
+}
+
+bool IncomingDataHandler::IsHeaderCandidate(const DataSegments& data,
+                                            const size_t offset) {
+  const uint8_t first_byte = data[offset];
+  const uint8_t version = first_byte >> 4u;
+  const uint8_t frame_type = first_byte & 0x07u;
+  if (version < PROTOCOL_VERSION_1 || version > PROTOCOL_VERSION_5 ||
+      frame_type > FRAME_TYPE_CONSECUTIVE) {
+    return false;
+  }
+  switch (data[offset + 1]) {
+    case SERVICE_TYPE_CONTROL:
+    case SERVICE_TYPE_RPC:
+    case SERVICE_TYPE_AUDIO:
+    case SERVICE_TYPE_NAVI:
+    case SERVICE_TYPE_BULK:
+      return true;
+    default:
+      return false;
+  }
+}
+
+size_t IncomingDataHandler::FindHeaderCandidate(const DataSegments& data,
+                                                size_t offset) {
+  const size_t size = data.size();
+  while (size - offset >= MIN_HEADER_SIZE && !IsHeaderCandidate(data, offset)) {
+    ++offset;
+  }
+  return offset;
+}
+
 RESULT_CODE IncomingDataHandler::CreateFrame(
-    std::vector<uint8_t>& incoming_data,
+    const DataSegments& incoming_data,
+    const std::shared_ptr<uint8_t>& buffer,
+    size_t& processed_size,
     ProtocolFramePtrList& out_frames,
     size_t& malformed_occurrence,
     const transport_manager::ConnectionUID connection_id) {
   SDL_LOG_AUTO_TRACE();
-  std::vector<uint8_t>::iterator data_it = incoming_data.begin();
-  size_t data_size = incoming_data.size();
+  const size_t incoming_data_size = incoming_data.size();
+  size_t offset = 0;
 
-  while (data_size >= MIN_HEADER_SIZE) {
-    header_.deserialize(&*data_it, data_size);
+  while (incoming_data_size - offset >= MIN_HEADER_SIZE) {
+    const size_t data_size = incoming_data_size - offset;
+    const size_t header_size =
+        std::min(data_size, static_cast<size_t>(PROTOCOL_HEADER_V2_SIZE));
+    if (offset + header_size <= incoming_data.first_size) {
+      header_.deserialize(incoming_data.first + offset, header_size);
+    } else {
+      uint8_t header_data[PROTOCOL_HEADER_V2_SIZE];
+      incoming_data.Copy(offset, header_size, header_data);
+      header_.deserialize(header_data, header_size);
+    }
     const RESULT_CODE validate_result =
         validator_ ? validator_->validate(header_) : RESULT_OK;
 
@@ -150,34 +242,46 @@ RESULT_CODE IncomingDataHandler::CreateFrame(
         SDL_LOG_DEBUG("Malformed message found " << malformed_occurrence);
       }
       last_portion_of_data_was_malformed_ = true;
-      ++data_it;
-      --data_size;
-      SDL_LOG_DEBUG("Moved to the next byte "
-                    << std::hex << static_cast<const void*>(&*data_it));
+      // Bytes which can not start a valid header are skipped
+      // without deserializing and validating header at each of them
+      const size_t next_offset = FindHeaderCandidate(incoming_data, offset + 1);
+      SDL_LOG_DEBUG("Skipped " << next_offset - offset << " bytes");
+      offset = next_offset;
       continue;
     }
     SDL_LOG_TRACE("Payload size " << header_.dataSize);
     const uint32_t packet_size = GetPacketSize(header_);
     if (packet_size == 0) {
       SDL_LOG_WARN("Null packet size");
-      ++data_it;
-      --data_size;
-      SDL_LOG_DEBUG("Moved to the next byte "
-                    << std::hex << static_cast<const void*>(&*data_it));
+      ++offset;
+      SDL_LOG_DEBUG("Moved to the next byte " << offset);
       continue;
     }
     if (data_size < packet_size) {
       SDL_LOG_TRACE("Packet data is not available yet");
-      incoming_data.erase(incoming_data.begin(), data_it);
+      processed_size = offset;
       return RESULT_DEFERRED;
     }
-    ProtocolFramePtr frame(new protocol_handler::ProtocolPacket(connection_id));
-    const RESULT_CODE deserialize_result =
-        frame->deserializePacket(&*data_it, packet_size);
+    ProtocolFramePtr frame =
+        frame_pool::MakeShared<protocol_handler::ProtocolPacket>(connection_id);
+    RESULT_CODE deserialize_result = RESULT_FAIL;
+    if (offset + packet_size > incoming_data.first_size) {
+      // Frame wraps around the end of reassembly buffer
+      frame_data_.resize(packet_size);
+      incoming_data.Copy(offset, packet_size, &frame_data_[0]);
+      deserialize_result =
+          frame->deserializePacket(&frame_data_[0], packet_size);
+    } else if (buffer) {
+      deserialize_result = frame->deserializePacket(
+          std::shared_ptr<uint8_t>(buffer, buffer.get() + offset), packet_size);
+    } else {
+      deserialize_result =
+          frame->deserializePacket(incoming_data.first + offset, packet_size);
+    }
     SDL_LOG_TRACE("Deserialized frame " << frame);
     if (deserialize_result != RESULT_OK) {
       SDL_LOG_WARN("Packet deserialization failed");
-      incoming_data.erase(incoming_data.begin(), data_it);
+      processed_size = offset;
       return RESULT_FAIL;
     }
 
@@ -186,10 +290,9 @@ RESULT_CODE IncomingDataHandler::CreateFrame(
     SDL_LOG_TRACE("Frame added. "
                   << "Connection ID " << connection_id);
 
-    data_it += packet_size;
-    data_size -= packet_size;
+    offset += packet_size;
   }
-  incoming_data.erase(incoming_data.begin(), data_it);
+  processed_size = offset;
   return RESULT_OK;
 }
 }  // namespace protocol_handler
@@ -39,9 +39,11 @@
 
 #include "connection_handler/connection_handler_impl.h"
 #include "protocol/common.h"
+#include "protocol/frame_pool.h"
 #include "protocol_handler/session_observer.h"
 #include "utils/byte_order.h"
 #include "utils/helpers.h"
+#include "utils/timer_task_impl.h"
 
 #ifdef ENABLE_SECURITY
 #include "security_manager/security_manager.h"
@@ -59,6 +61,7 @@ const utils::SemanticVersion min_multiple_transports_version(5, 1, 0);
 const utils::SemanticVersion min_cloud_app_version(5, 2, 0);
 const utils::SemanticVersion min_reason_param_version(5, 3, 0);
 const utils::SemanticVersion min_vehicle_data_version(5, 4, 0);
+const char kBsonRpcPayloadFormat[] = "BSON";
 
 ProtocolHandlerImpl::ProtocolHandlerImpl(
     const ProtocolHandlerSettings& settings,
@@ -80,6 +83,10 @@ ProtocolHandlerImpl::ProtocolHandlerImpl(
         "PH FromMobile", this, threads::ThreadOptions(kStackSize))
     , raw_ford_messages_to_mobile_(
           "PH ToMobile", this, threads::ThreadOptions(kStackSize))
+    , frame_pool_trim_timer_(
+          "PH FramePoolTrim",
+          new timer::TimerTaskImpl<ProtocolHandlerImpl>(
+              this, &ProtocolHandlerImpl::OnFramePoolTrimTimeout))
     , start_session_frame_map_lock_()
     , start_session_frame_map_()
     , tcp_enabled_(false)
@@ -138,6 +145,16 @@ ProtocolHandlerImpl::ProtocolHandlerImpl(
   }
   multiframe_builder_.set_waiting_timeout(
       get_settings().multiframe_waiting_timeout());
+
+  frame_pool::SetCacheLimits(get_settings().frame_pool_thread_cache_size(),
+                             get_settings().frame_pool_shared_cache_size());
+  const uint32_t frame_pool_trim_period =
+      get_settings().frame_pool_trim_period();
+  if (frame_pool_trim_period > 0u) {
+    frame_pool_trim_timer_.Start(frame_pool_trim_period, timer::kPeriodic);
+  } else {
+    SDL_LOG_WARN("Frame pool trimming is disabled");
+  }
 }
 
 ProtocolHandlerImpl::~ProtocolHandlerImpl() {
@@ -992,7 +1009,8 @@ void ProtocolHandlerImpl::SendMessageToMobileApp(const RawMessagePtr message,
                                                message->protocol_version(),
                                                message->service_type(),
                                                message->data_size(),
-                                               message->data(),
+                                               std::shared_ptr<uint8_t>(
+                                                   message, message->data()),
                                                frame_size,
                                                needs_encryption,
                                                final_message);
@@ -1117,25 +1135,27 @@ void ProtocolHandlerImpl::OnTMMessageSend(const RawMessagePtr message) {
     return;
   }
 
-  ProtocolPacket sent_message(message->connection_key());
-  const RESULT_CODE result =
-      sent_message.deserializePacket(message->data(), message->data_size());
-  if (result != RESULT_OK) {
+  // Only header is needed, so frame parts are not joined
+  RawMessage::Segment segments[RawMessage::kMaxSegments];
+  message->GetSegments(segments);
+  if (!segments[0].data || segments[0].size < PROTOCOL_HEADER_V1_SIZE) {
     SDL_LOG_ERROR("Error while message deserialization.");
     return;
   }
+  ProtocolPacket::ProtocolHeader sent_header;
+  sent_header.deserialize(segments[0].data, segments[0].size);
   std::map<uint8_t, uint32_t>::iterator it =
-      sessions_last_message_id_.find(sent_message.session_id());
+      sessions_last_message_id_.find(sent_header.sessionId);
 
   if (sessions_last_message_id_.end() != it) {
     uint32_t last_message_id = it->second;
     sessions_last_message_id_.erase(it);
-    if ((sent_message.message_id() == last_message_id) &&
-        ((FRAME_TYPE_SINGLE == sent_message.frame_type()) ||
-         ((FRAME_TYPE_CONSECUTIVE == sent_message.frame_type()) &&
-          (0 == sent_message.frame_data())))) {
+    if ((sent_header.messageId == last_message_id) &&
+        ((FRAME_TYPE_SINGLE == sent_header.frameType) ||
+         ((FRAME_TYPE_CONSECUTIVE == sent_header.frameType) &&
+          (0 == sent_header.frameData)))) {
       ready_to_close_connections_.push_back(connection_handle);
-      SendEndSession(connection_handle, sent_message.session_id());
+      SendEndSession(connection_handle, sent_header.sessionId);
     }
   }
   sync_primitives::AutoLock lock(protocol_observers_lock_);
@@ -1358,17 +1378,17 @@ RESULT_CODE ProtocolHandlerImpl::SendSingleFrameMessage(
   SDL_LOG_DEBUG("Packet needs encryption: " << std::boolalpha
                                             << needs_encryption);
 
-  ProtocolFramePtr ptr(
-      new protocol_handler::ProtocolPacket(connection_id,
-                                           protocol_version,
-                                           needs_encryption,
-                                           FRAME_TYPE_SINGLE,
-                                           service_type,
-                                           FRAME_DATA_SINGLE,
-                                           session_id,
-                                           data_size,
-                                           message_counters_[session_id]++,
-                                           data));
+  ProtocolFramePtr ptr = frame_pool::MakeShared<ProtocolPacket>(
+      connection_id,
+      protocol_version,
+      needs_encryption,
+      FRAME_TYPE_SINGLE,
+      service_type,
+      FRAME_DATA_SINGLE,
+      session_id,
+      data_size,
+      message_counters_[session_id]++,
+      data);
 
   raw_ford_messages_to_mobile_.PostMessage(
       impl::RawFordMessageToMobile(ptr, is_final_message));
@@ -1381,7 +1401,7 @@ RESULT_CODE ProtocolHandlerImpl::SendMultiFrameMessage(
     const uint8_t protocol_version,
     const uint8_t service_type,
     const size_t data_size,
-    const uint8_t* data,
+    const std::shared_ptr<uint8_t>& data,
     const size_t max_frame_size,
     const bool needs_encryption,
     const bool is_final_message) {
@@ -1419,17 +1439,17 @@ RESULT_CODE ProtocolHandlerImpl::SendMultiFrameMessage(
   // TODO(EZamakhov): investigate message_id for CONSECUTIVE frames -
   // APPLINK-9531
   const uint8_t message_id = message_counters_[session_id]++;
-  const ProtocolFramePtr firstPacket(
-      new protocol_handler::ProtocolPacket(connection_id,
-                                           protocol_version,
-                                           false,
-                                           FRAME_TYPE_FIRST,
-                                           service_type,
-                                           FRAME_DATA_FIRST,
-                                           session_id,
-                                           FIRST_FRAME_DATA_SIZE,
-                                           message_id,
-                                           out_data));
+  const ProtocolFramePtr firstPacket =
+      frame_pool::MakeShared<ProtocolPacket>(connection_id,
+                                             protocol_version,
+                                             false,
+                                             FRAME_TYPE_FIRST,
+                                             service_type,
+                                             FRAME_DATA_FIRST,
+                                             session_id,
+                                             FIRST_FRAME_DATA_SIZE,
+                                             message_id,
+                                             out_data);
 
   raw_ford_messages_to_mobile_.PostMessage(
       impl::RawFordMessageToMobile(firstPacket, false));
@@ -1443,17 +1463,20 @@ RESULT_CODE ProtocolHandlerImpl::SendMultiFrameMessage(
                                   : (i % FRAME_DATA_MAX_CONSECUTIVE + 1);
     const bool is_final_packet = is_last_frame ? is_final_message : false;
 
-    const ProtocolFramePtr ptr(
-        new protocol_handler::ProtocolPacket(connection_id,
-                                             protocol_version,
-                                             needs_encryption,
-                                             FRAME_TYPE_CONSECUTIVE,
-                                             service_type,
-                                             data_type,
-                                             session_id,
-                                             frame_size,
-                                             message_id,
-                                             data + max_frame_size * i));
+    const ProtocolFramePtr ptr =
+        frame_pool::MakeShared<ProtocolPacket>(connection_id,
+                                               protocol_version,
+                                               needs_encryption,
+                                               FRAME_TYPE_CONSECUTIVE,
+                                               service_type,
+                                               data_type,
+                                               session_id,
+                                               frame_size,
+                                               message_id);
+    // Frame references its part of the message instead of copying it
+    ptr->set_data(
+        std::shared_ptr<uint8_t>(data, data.get() + max_frame_size * i),
+        frame_size);
 
     raw_ford_messages_to_mobile_.PostMessage(
         impl::RawFordMessageToMobile(ptr, is_final_packet));
@@ -1503,13 +1526,14 @@ RESULT_CODE ProtocolHandlerImpl::HandleSingleFrameMessage(
   const uint32_t connection_key = session_observer_.KeyFromPair(
       packet->connection_id(), packet->session_id());
 
-  const RawMessagePtr rawMessage(new RawMessage(connection_key,
-                                                packet->protocol_version(),
-                                                packet->data(),
-                                                packet->total_data_bytes(),
-                                                packet->protection_flag(),
-                                                packet->service_type(),
-                                                packet->payload_size()));
+  const RawMessagePtr rawMessage =
+      frame_pool::MakeShared<RawMessage>(connection_key,
+                                         packet->protocol_version(),
+                                         packet->data(),
+                                         packet->total_data_bytes(),
+                                         packet->protection_flag(),
+                                         packet->service_type(),
+                                         packet->payload_size());
   if (!rawMessage) {
     return RESULT_FAIL;
   }
@@ -1519,6 +1543,9 @@ RESULT_CODE ProtocolHandlerImpl::HandleSingleFrameMessage(
     metric->message_id = packet->message_id();
     metric->connection_key = connection_key;
     metric->raw_msg = rawMessage;
+    const frame_pool::Statistics statistics = frame_pool::GetStatistics();
+    metric->frame_pool_allocations = statistics.pool_allocations;
+    metric->frame_heap_allocations = statistics.heap_allocations;
     metric_observer_->EndMessageProcess(metric);
   }
 #endif
@@ -1800,6 +1827,13 @@ RESULT_CODE ProtocolHandlerImpl::HandleControlMessageStartSession(
                                   << " and Connection ID "
                                   << static_cast<int>(connection_id));
 
+  // Frame is kept until session start is confirmed, so it should not hold
+  // the receive buffer it was read into
+  if (!packet->DetachSharedData()) {
+    SDL_LOG_ERROR("Failed to copy StartSession frame data");
+    return RESULT_FAIL;
+  }
+
   {
     sync_primitives::AutoLock auto_lock(start_session_frame_map_lock_);
     start_session_frame_map_[std::make_pair(connection_id, session_id)] =
@@ -1894,6 +1928,27 @@ bool ProtocolHandlerImpl::ParseFullVersion(
   return true;
 }
 
+RpcPayloadFormat ProtocolHandlerImpl::ParseRpcPayloadFormat(
+    const ProtocolFramePtr& packet) const {
+  SDL_LOG_AUTO_TRACE();
+
+  BsonObject request_params;
+  size_t request_params_size = bson_object_from_bytes_len(
+      &request_params, packet->data(), packet->total_data_bytes());
+  if (0 == request_params_size) {
+    SDL_LOG_WARN("Failed to parse start service packet for payload format");
+    return RPC_PAYLOAD_FORMAT_JSON;
+  }
+
+  char* format_param =
+      bson_object_get_string(&request_params, strings::rpc_payload_format);
+  const bool is_bson_requested =
+      format_param != NULL && 0 == strcmp(format_param, kBsonRpcPayloadFormat);
+  bson_object_deinitialize(&request_params);
+
+  return is_bson_requested ? RPC_PAYLOAD_FORMAT_BSON : RPC_PAYLOAD_FORMAT_JSON;
+}
+
 void ProtocolHandlerImpl::NotifySessionStarted(
     SessionContext& context,
     std::vector<std::string>& rejected_params,
@@ -1916,6 +1971,7 @@ void ProtocolHandlerImpl::NotifySessionStarted(
   const ServiceType service_type = ServiceTypeFromByte(packet->service_type());
   const uint8_t protocol_version = packet->protocol_version();
   utils::SemanticVersion full_version;
+  RpcPayloadFormat rpc_payload_format = RPC_PAYLOAD_FORMAT_JSON;
 
   // Can't check protocol_version because the first packet is v1, but there
   // could still be a payload, in which case we can get the real protocol
@@ -1926,6 +1982,10 @@ void ProtocolHandlerImpl::NotifySessionStarted(
           packet->connection_id(), context.new_session_id_);
       connection_handler_.BindProtocolVersionWithSession(connection_key,
                                                          full_version);
+      // Binary payload is an opt-in of mobile, available since v5 only
+      rpc_payload_format = ParseRpcPayloadFormat(packet);
+      connection_handler_.BindRpcPayloadFormatWithSession(connection_key,
+                                                          rpc_payload_format);
     } else {
       rejected_params.push_back(std::string(strings::protocol_version));
     }
@@ -1957,6 +2017,13 @@ void ProtocolHandlerImpl::NotifySessionStarted(
         delete obj;
       });
   bson_object_initialize_default(start_session_ack_params.get());
+  if (RPC_PAYLOAD_FORMAT_BSON == rpc_payload_format) {
+    char payload_format[sizeof(kBsonRpcPayloadFormat)];
+    strncpy(payload_format, kBsonRpcPayloadFormat, sizeof(payload_format));
+    bson_object_put_string(start_session_ack_params.get(),
+                           strings::rpc_payload_format,
+                           payload_format);
+  }
   // when video service is successfully started, copy input parameters
   // ("width", "height", "videoProtocol", "videoCodec") to the ACK packet
   if (packet->service_type() == kMobileNav && packet->data() != NULL) {
@@ -2176,19 +2243,23 @@ void ProtocolHandlerImpl::PopValidAndExpiredMultiframes() {
         frame->connection_id(), frame->session_id());
     SDL_LOG_TRACE("Result frame" << frame << "for connection "
                                  << connection_key);
-    const RawMessagePtr rawMessage(new RawMessage(connection_key,
-                                                  frame->protocol_version(),
-                                                  frame->data(),
-                                                  frame->total_data_bytes(),
-                                                  frame->protection_flag(),
-                                                  frame->service_type(),
-                                                  frame->payload_size()));
+    const RawMessagePtr rawMessage =
+        frame_pool::MakeShared<RawMessage>(connection_key,
+                                           frame->protocol_version(),
+                                           frame->data(),
+                                           frame->total_data_bytes(),
+                                           frame->protection_flag(),
+                                           frame->service_type(),
+                                           frame->payload_size());
     DCHECK(rawMessage);
 
 #ifdef TELEMETRY_MONITOR
     if (metric_observer_) {
       auto metric = std::make_shared<PHTelemetryObserver::MessageMetric>();
       metric->raw_msg = rawMessage;
+      const frame_pool::Statistics statistics = frame_pool::GetStatistics();
+      metric->frame_pool_allocations = statistics.pool_allocations;
+      metric->frame_heap_allocations = statistics.heap_allocations;
       metric_observer_->EndMessageProcess(metric);
     }
 #endif  // TELEMETRY_MONITOR
@@ -2196,6 +2267,11 @@ void ProtocolHandlerImpl::PopValidAndExpiredMultiframes() {
   }
 }
 
+void ProtocolHandlerImpl::OnFramePoolTrimTimeout() {
+  SDL_LOG_AUTO_TRACE();
+  frame_pool::TrimIdleMemory();
+}
+
 bool ProtocolHandlerImpl::TrackMessage(const uint32_t& connection_key) {
   SDL_LOG_AUTO_TRACE();
   const size_t& frequency_time = get_settings().message_frequency_time();
@@ -2292,6 +2368,7 @@ void ProtocolHandlerImpl::Handle(const impl::RawFordMessageToMobile message) {
 }
 
 void ProtocolHandlerImpl::Stop() {
+  frame_pool_trim_timer_.Stop();
   raw_ford_messages_from_mobile_.Shutdown();
   raw_ford_messages_to_mobile_.Shutdown();
 
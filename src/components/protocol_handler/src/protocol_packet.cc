@@ -36,9 +36,9 @@
 #include <cstring>
 #include <limits>
 #include <memory>
-#include <new>
 
 #include "protocol/common.h"
+#include "protocol/frame_pool.h"
 #include "protocol_handler/protocol_packet.h"
 #include "utils/byte_order.h"
 #include "utils/macro.h"
@@ -75,7 +75,16 @@ std::string StringifyFrameType(uint8_t type) {
 ProtocolPacket::ProtocolData::ProtocolData() : data(NULL), totalDataBytes(0u) {}
 
 ProtocolPacket::ProtocolData::~ProtocolData() {
-  delete[] data;
+  reset();
+}
+
+void ProtocolPacket::ProtocolData::reset() {
+  if (buffer) {
+    buffer.reset();
+  } else {
+    frame_pool::Deallocate(data);
+  }
+  data = NULL;
 }
 
 ProtocolPacket::ProtocolHeader::ProtocolHeader()
@@ -456,28 +465,40 @@ RawMessagePtr ProtocolPacket::serializePacket() const {
     header[offset++] = packet_header_.messageId;
   }
 
+  if (packet_data_.buffer && packet_data_.totalDataBytes) {
+    // Payload is sent from the buffer it is referenced in
+    return frame_pool::MakeShared<RawMessage>(connection_id(),
+                                              packet_header_.version,
+                                              header,
+                                              offset,
+                                              packet_data_.buffer,
+                                              packet_data_.totalDataBytes,
+                                              false,
+                                              packet_header_.serviceType);
+  }
+
   size_t total_packet_size =
       offset + (packet_data_.data ? packet_data_.totalDataBytes : 0);
 
-  uint8_t* packet = new (std::nothrow) uint8_t[total_packet_size];
+  // Message takes ownership of the serialized buffer, so it is not copied
+  const std::shared_ptr<uint8_t> packet =
+      frame_pool::MakeSharedBuffer(total_packet_size);
   if (!packet) {
     return RawMessagePtr();
   }
 
-  memcpy(packet, header, offset);
+  memcpy(packet.get(), header, offset);
   if (packet_data_.data && packet_data_.totalDataBytes) {
-    memcpy(packet + offset, packet_data_.data, packet_data_.totalDataBytes);
+    memcpy(
+        packet.get() + offset, packet_data_.data, packet_data_.totalDataBytes);
   }
 
-  const RawMessagePtr out_message(new RawMessage(connection_id(),
-                                                 packet_header_.version,
-                                                 packet,
-                                                 total_packet_size,
-                                                 false,
-                                                 packet_header_.serviceType));
-
-  delete[] packet;
-  return out_message;
+  return frame_pool::MakeShared<RawMessage>(connection_id(),
+                                            packet_header_.version,
+                                            packet,
+                                            total_packet_size,
+                                            false,
+                                            packet_header_.serviceType);
 }
 
 RESULT_CODE ProtocolPacket::appendData(uint8_t* chunkData,
@@ -537,6 +558,18 @@ void ProtocolPacket::HandleRawFirstFrameData(const uint8_t* message) {
 
 RESULT_CODE ProtocolPacket::deserializePacket(const uint8_t* message,
                                               const size_t messageSize) {
+  return DeserializePacket(message, messageSize, std::shared_ptr<uint8_t>());
+}
+
+RESULT_CODE ProtocolPacket::deserializePacket(
+    const std::shared_ptr<uint8_t>& message, const size_t messageSize) {
+  return DeserializePacket(message.get(), messageSize, message);
+}
+
+RESULT_CODE ProtocolPacket::DeserializePacket(
+    const uint8_t* message,
+    const size_t messageSize,
+    const std::shared_ptr<uint8_t>& buffer) {
   SDL_LOG_AUTO_TRACE();
   DCHECK_OR_RETURN(message, RESULT_FAIL);
   packet_header_.deserialize(message, messageSize);
@@ -559,9 +592,20 @@ RESULT_CODE ProtocolPacket::deserializePacket(const uint8_t* message,
     if (0 == packet_data_.data) {
       return RESULT_FAIL;
     }
+  } else if (dataPayloadSize && buffer) {
+    // Payload references the incoming buffer instead of being copied
+    packet_data_.reset();
+    packet_data_.buffer =
+        std::shared_ptr<uint8_t>(buffer, buffer.get() + offset);
+    packet_data_.data = packet_data_.buffer.get();
+    payload_size_ = dataPayloadSize;
   } else if (dataPayloadSize) {
-    delete[] packet_data_.data;
-    packet_data_.data = new (std::nothrow) uint8_t[dataPayloadSize];
+    packet_data_.reset();
+    packet_data_.data =
+        static_cast<uint8_t*>(frame_pool::Allocate(dataPayloadSize));
+    if (!packet_data_.data) {
+      return RESULT_FAIL;
+    }
     memcpy(packet_data_.data, message + offset, dataPayloadSize);
     payload_size_ = dataPayloadSize;
   }
@@ -617,8 +661,8 @@ void ProtocolPacket::set_total_data_bytes(size_t dataBytes) {
   SDL_LOG_AUTO_TRACE();
   SDL_LOG_DEBUG("Data bytes : " << dataBytes);
   if (dataBytes) {
-    delete[] packet_data_.data;
-    packet_data_.data = new (std::nothrow) uint8_t[dataBytes];
+    packet_data_.reset();
+    packet_data_.data = static_cast<uint8_t*>(frame_pool::Allocate(dataBytes));
     packet_data_.totalDataBytes = packet_data_.data ? dataBytes : 0u;
   }
 }
@@ -627,8 +671,9 @@ void ProtocolPacket::set_data(const uint8_t* const new_data,
                               const size_t new_data_size) {
   if (new_data_size && new_data) {
     packet_header_.dataSize = packet_data_.totalDataBytes = new_data_size;
-    delete[] packet_data_.data;
-    packet_data_.data = new (std::nothrow) uint8_t[packet_data_.totalDataBytes];
+    packet_data_.reset();
+    packet_data_.data = static_cast<uint8_t*>(
+        frame_pool::Allocate(packet_data_.totalDataBytes));
     if (packet_data_.data) {
       memcpy(packet_data_.data, new_data, packet_data_.totalDataBytes);
     } else {
@@ -638,6 +683,31 @@ void ProtocolPacket::set_data(const uint8_t* const new_data,
   }
 }
 
+void ProtocolPacket::set_data(const std::shared_ptr<uint8_t>& new_data,
+                              const size_t new_data_size) {
+  if (new_data_size && new_data) {
+    packet_header_.dataSize = packet_data_.totalDataBytes = new_data_size;
+    packet_data_.reset();
+    packet_data_.buffer = new_data;
+    packet_data_.data = new_data.get();
+  }
+}
+
+bool ProtocolPacket::DetachSharedData() {
+  if (!packet_data_.buffer) {
+    return true;
+  }
+  const uint32_t data_size = packet_data_.totalDataBytes;
+  uint8_t* data = static_cast<uint8_t*>(frame_pool::Allocate(data_size));
+  if (!data) {
+    return false;
+  }
+  memcpy(data, packet_data_.data, data_size);
+  packet_data_.reset();
+  packet_data_.data = data;
+  return true;
+}
+
 uint32_t ProtocolPacket::total_data_bytes() const {
   return packet_data_.totalDataBytes;
 }
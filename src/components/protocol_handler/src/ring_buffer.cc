@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "protocol_handler/ring_buffer.h"
+
+#include <string.h>
+#include <algorithm>
+
+#include "utils/macro.h"
+
+namespace protocol_handler {
+
+namespace {
+const size_t kInitialCapacity = 4096u;
+}  // namespace
+
+RingBuffer::RingBuffer() : buffer_(), head_(0u), size_(0u) {}
+
+void RingBuffer::Append(const uint8_t* data, const size_t size) {
+  if (0u == size) {
+    return;
+  }
+  DCHECK_OR_RETURN_VOID(data);
+  if (size_ + size > buffer_.size()) {
+    size_t new_capacity = std::max(buffer_.size(), kInitialCapacity);
+    while (new_capacity < size_ + size) {
+      new_capacity <<= 1;
+    }
+    std::vector<uint8_t> new_buffer(new_capacity);
+    const uint8_t* first = NULL;
+    const uint8_t* second = NULL;
+    size_t first_size = 0u;
+    size_t second_size = 0u;
+    GetSegments(&first, &first_size, &second, &second_size);
+    if (first_size) {
+      memcpy(&new_buffer[0], first, first_size);
+    }
+    if (second_size) {
+      memcpy(&new_buffer[first_size], second, second_size);
+    }
+    buffer_.swap(new_buffer);
+    head_ = 0u;
+  }
+
+  const size_t mask = buffer_.size() - 1;
+  const size_t tail = (head_ + size_) & mask;
+  const size_t tail_room = buffer_.size() - tail;
+  const size_t first_part = std::min(size, tail_room);
+  memcpy(&buffer_[tail], data, first_part);
+  if (first_part < size) {
+    memcpy(&buffer_[0], data + first_part, size - first_part);
+  }
+  size_ += size;
+}
+
+void RingBuffer::GetSegments(const uint8_t** first,
+                             size_t* first_size,
+                             const uint8_t** second,
+                             size_t* second_size) const {
+  DCHECK_OR_RETURN_VOID(first && first_size && second && second_size);
+  if (0u == size_) {
+    *first = *second = NULL;
+    *first_size = *second_size = 0u;
+    return;
+  }
+  const size_t head_room = buffer_.size() - head_;
+  *first = &buffer_[head_];
+  *first_size = std::min(size_, head_room);
+  *second_size = size_ - *first_size;
+  *second = *second_size ? &buffer_[0] : NULL;
+}
+
+void RingBuffer::Consume(const size_t size) {
+  DCHECK_OR_RETURN_VOID(size <= size_);
+  size_ -= size;
+  // Start from the beginning once buffer is drained so that following
+  // portions of data are more likely to be contiguous
+  head_ = size_ ? (head_ + size) & (buffer_.size() - 1) : 0u;
+}
+
+void RingBuffer::Clear() {
+  head_ = 0u;
+  size_ = 0u;
+}
+
+}  // namespace protocol_handler
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <vector>
+
+#include "protocol/frame_pool.h"
+#include "protocol/raw_message.h"
+#include "protocol_handler/protocol_packet.h"
+
+namespace test {
+namespace components {
+namespace protocol_handler_test {
+namespace frame_pool = ::protocol_handler::frame_pool;
+using ::protocol_handler::ProtocolPacket;
+using ::protocol_handler::RawMessage;
+using ::protocol_handler::RawMessagePtr;
+
+namespace {
+const size_t kCrossThreadBlockSize = 20000u;
+const size_t kCrossThreadBlocksCount = 32u;
+
+void* DeallocateBlocks(void* blocks) {
+  std::vector<void*>* blocks_vector = static_cast<std::vector<void*>*>(blocks);
+  for (size_t i = 0; i < blocks_vector->size(); ++i) {
+    frame_pool::Deallocate((*blocks_vector)[i]);
+  }
+  return NULL;
+}
+
+ProtocolFramePtr MakeFrame(const std::vector<uint8_t>& payload,
+                           const uint32_t message_id) {
+  return frame_pool::MakeShared<ProtocolPacket>(
+      1u,
+      ::protocol_handler::PROTOCOL_VERSION_3,
+      ::protocol_handler::PROTECTION_OFF,
+      ::protocol_handler::FRAME_TYPE_SINGLE,
+      ::protocol_handler::SERVICE_TYPE_RPC,
+      ::protocol_handler::FRAME_DATA_SINGLE,
+      1u,
+      payload.size(),
+      message_id,
+      &payload[0]);
+}
+}  // namespace
+
+TEST(FramePoolTest, Allocate_ReleasedBlock_Reused) {
+  void* block = frame_pool::Allocate(100u);
+  ASSERT_TRUE(NULL != block);
+  frame_pool::Deallocate(block);
+
+  const frame_pool::Statistics before = frame_pool::GetStatistics();
+  void* reused_block = frame_pool::Allocate(100u);
+  const frame_pool::Statistics after = frame_pool::GetStatistics();
+
+  EXPECT_EQ(block, reused_block);
+  EXPECT_EQ(before.pool_allocations + 1u, after.pool_allocations);
+  EXPECT_EQ(before.heap_allocations, after.heap_allocations);
+  frame_pool::Deallocate(reused_block);
+}
+
+TEST(FramePoolTest, Allocate_BigBlock_TakenFromHeap) {
+  const frame_pool::Statistics before = frame_pool::GetStatistics();
+  void* block = frame_pool::Allocate(1024u * 1024u);
+  ASSERT_TRUE(NULL != block);
+  frame_pool::Deallocate(block);
+  const frame_pool::Statistics after = frame_pool::GetStatistics();
+
+  EXPECT_EQ(before.heap_allocations + 1u, after.heap_allocations);
+  EXPECT_EQ(before.released + 1u, after.released);
+}
+
+TEST(FramePoolTest, MakeSharedBuffer_BufferReturnedToPool) {
+  uint8_t* data = NULL;
+  {
+    const std::shared_ptr<uint8_t> buffer = frame_pool::MakeSharedBuffer(500u);
+    ASSERT_TRUE(buffer);
+    data = buffer.get();
+    memset(data, 0xAB, 500u);
+  }
+  const std::shared_ptr<uint8_t> buffer = frame_pool::MakeSharedBuffer(500u);
+  EXPECT_EQ(data, buffer.get());
+}
+
+TEST(FramePoolTest, Deallocate_InOtherThread_BlocksReused) {
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < kCrossThreadBlocksCount; ++i) {
+    blocks.push_back(frame_pool::Allocate(kCrossThreadBlockSize));
+    ASSERT_TRUE(NULL != blocks.back());
+  }
+
+  pthread_t thread;
+  ASSERT_EQ(0, pthread_create(&thread, NULL, &DeallocateBlocks, &blocks));
+  pthread_join(thread, NULL);
+
+  const frame_pool::Statistics before = frame_pool::GetStatistics();
+  for (size_t i = 0; i < kCrossThreadBlocksCount; ++i) {
+    blocks[i] = frame_pool::Allocate(kCrossThreadBlockSize);
+  }
+  const frame_pool::Statistics after = frame_pool::GetStatistics();
+  EXPECT_EQ(before.heap_allocations, after.heap_allocations);
+  DeallocateBlocks(&blocks);
+}
+
+TEST(FramePoolTest, ReleaseCachedMemory_CachedBlocksReturnedToHeap) {
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < 10u; ++i) {
+    blocks.push_back(frame_pool::Allocate(3000u));
+  }
+  DeallocateBlocks(&blocks);
+
+  const frame_pool::Statistics before = frame_pool::GetStatistics();
+  frame_pool::ReleaseCachedMemory();
+  const frame_pool::Statistics after = frame_pool::GetStatistics();
+  EXPECT_LE(before.released + blocks.size(), after.released);
+
+  void* block = frame_pool::Allocate(3000u);
+  EXPECT_EQ(after.heap_allocations + 1u,
+            frame_pool::GetStatistics().heap_allocations);
+  frame_pool::Deallocate(block);
+}
+
+TEST(FramePoolTest, Deallocate_OverCacheLimits_ExcessReturnedToHeap) {
+  const size_t kCacheLimit = 64u * 1024u;
+  frame_pool::ReleaseCachedMemory();
+  frame_pool::SetCacheLimits(kCacheLimit, kCacheLimit);
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < kCrossThreadBlocksCount; ++i) {
+    blocks.push_back(frame_pool::Allocate(kCrossThreadBlockSize));
+  }
+
+  const frame_pool::Statistics before = frame_pool::GetStatistics();
+  DeallocateBlocks(&blocks);
+  const frame_pool::Statistics after = frame_pool::GetStatistics();
+  // Blocks of 20000 bytes are kept in 32 KB size class
+  const size_t kCachedBlocksCount = 2u * kCacheLimit / (32u * 1024u);
+  EXPECT_LE(before.released + kCrossThreadBlocksCount - kCachedBlocksCount,
+            after.released);
+  frame_pool::SetCacheLimits(0u, 0u);
+}
+
+TEST(FramePoolTest, TrimIdleMemory_UnusedSharedBlocks_ReturnedToHeap) {
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < kCrossThreadBlocksCount; ++i) {
+    blocks.push_back(frame_pool::Allocate(kCrossThreadBlockSize));
+  }
+  pthread_t thread;
+  ASSERT_EQ(0, pthread_create(&thread, NULL, &DeallocateBlocks, &blocks));
+  pthread_join(thread, NULL);
+
+  // Blocks put to depot after previous trim are kept
+  frame_pool::TrimIdleMemory();
+  const frame_pool::Statistics before = frame_pool::GetStatistics();
+  frame_pool::TrimIdleMemory();
+  const frame_pool::Statistics after = frame_pool::GetStatistics();
+  EXPECT_LE(before.released + kCrossThreadBlocksCount, after.released);
+}
+
+TEST(FramePoolTest, SteadyStateStreaming_NoHeapAllocations) {
+  const std::vector<uint8_t> payload(1000u, 0x5A);
+  const size_t kWarmUpFrames = 10u;
+  const size_t kFrames = 1000u;
+
+  frame_pool::Statistics before;
+  for (size_t i = 0; i < kWarmUpFrames + kFrames; ++i) {
+    if (kWarmUpFrames == i) {
+      before = frame_pool::GetStatistics();
+    }
+    const ProtocolFramePtr frame = MakeFrame(payload, i + 1);
+    const RawMessagePtr serialized = frame->serializePacket();
+    ASSERT_TRUE(serialized);
+
+    const ProtocolFramePtr received =
+        frame_pool::MakeShared<ProtocolPacket>(1u);
+    ASSERT_EQ(::protocol_handler::RESULT_OK,
+              received->deserializePacket(serialized->buffer(),
+                                          serialized->data_size()));
+    const RawMessagePtr message =
+        frame_pool::MakeShared<RawMessage>(1u,
+                                           received->protocol_version(),
+                                           received->data(),
+                                           received->total_data_bytes(),
+                                           received->protection_flag(),
+                                           received->service_type(),
+                                           received->payload_size());
+    ASSERT_EQ(payload.size(), message->data_size());
+  }
+  const frame_pool::Statistics after = frame_pool::GetStatistics();
+
+  EXPECT_EQ(before.heap_allocations, after.heap_allocations);
+  EXPECT_LT(before.pool_allocations, after.pool_allocations);
+}
+
+}  // namespace protocol_handler_test
+}  // namespace components
+}  // namespace test
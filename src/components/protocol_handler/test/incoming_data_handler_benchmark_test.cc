@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "protocol_handler/incoming_data_handler.h"
+#include "utils/macro.h"
+
+namespace test {
+namespace components {
+namespace protocol_handler_test {
+using namespace protocol_handler;
+
+/*
+ * Microbenchmark of incoming data reassembly.
+ * Data is fed in portions of fixed size, throughput is recorded as
+ * "kbytes_per_ms" test property, so it could be compared between builds
+ * with --gtest_output=xml. Disabled by default, run with
+ * --gtest_also_run_disabled_tests.
+ */
+class IncomingDataHandlerBenchmark : public ::testing::Test {
+ protected:
+  static const transport_manager::ConnectionUID kConnectionId = 1u;
+
+  void SetUp() OVERRIDE {
+    data_handler_.set_validator(&header_validator_);
+    data_handler_.AddConnection(kConnectionId);
+  }
+
+  void AppendFrames(const size_t frames_count, const size_t payload_size) {
+    const std::vector<uint8_t> payload(payload_size, 0xAB);
+    for (size_t i = 0; i < frames_count; ++i) {
+      const ProtocolPacket packet(kConnectionId,
+                                  PROTOCOL_VERSION_5,
+                                  PROTECTION_OFF,
+                                  FRAME_TYPE_CONSECUTIVE,
+                                  kMobileNav,
+                                  FRAME_DATA_LAST_CONSECUTIVE,
+                                  1u,
+                                  payload_size,
+                                  static_cast<uint32_t>(i + 1),
+                                  &payload[0]);
+      const RawMessagePtr message = packet.serializePacket();
+      stream_.insert(stream_.end(),
+                     message->data(),
+                     message->data() + message->data_size());
+    }
+  }
+
+  /**
+   * @return Amount of created frames
+   */
+  size_t Run(const size_t portion_size) {
+    size_t frames_count = 0u;
+    size_t malformed_occurrence = 0u;
+    RESULT_CODE result = RESULT_OK;
+    const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    for (size_t offset = 0; offset < stream_.size(); offset += portion_size) {
+      const size_t size = std::min(portion_size, stream_.size() - offset);
+      const RawMessage message(
+          kConnectionId, 0u, &stream_[offset], size, false);
+      frames_count +=
+          data_handler_.ProcessData(message, result, &malformed_occurrence)
+              .size();
+    }
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
+    if (elapsed_ms > 0) {
+      RecordProperty("kbytes_per_ms",
+                     static_cast<int>(stream_.size() / 1024.0 / elapsed_ms));
+    }
+    return frames_count;
+  }
+
+  ProtocolPacket::ProtocolHeaderValidator header_validator_;
+  IncomingDataHandler data_handler_;
+  std::vector<uint8_t> stream_;
+};
+
+TEST_F(IncomingDataHandlerBenchmark, DISABLED_LargeFramesInSmallPortions) {
+  // ~5 MB of video stream frames received in small TCP segments
+  const size_t kFramesCount = 40u;
+  AppendFrames(kFramesCount, 128u * 1024u);
+  EXPECT_EQ(kFramesCount, Run(64u));
+}
+
+TEST_F(IncomingDataHandlerBenchmark, DISABLED_SmallFramesInLargePortions) {
+  const size_t kFramesCount = 20000u;
+  AppendFrames(kFramesCount, 200u);
+  EXPECT_EQ(kFramesCount, Run(4096u));
+}
+
+TEST_F(IncomingDataHandlerBenchmark, DISABLED_ResyncAfterGarbage) {
+  AppendFrames(1u, 200u);
+  stream_.insert(stream_.end(), 1024u * 1024u, 0xFF);
+  AppendFrames(1u, 200u);
+  EXPECT_EQ(2u, Run(4096u));
+}
+
+}  // namespace protocol_handler_test
+}  // namespace components
+}  // namespace test
@@ -30,9 +30,11 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <list>
 #include <vector>
 
+#include "protocol/receive_buffer.h"
 #include "protocol_handler/incoming_data_handler.h"
 #include "utils/macro.h"
 
@@ -1064,6 +1066,152 @@ TEST_F(IncomingDataHandlerTest,
   EXPECT_EQ(RESULT_CODE::RESULT_MALFORMED_OCCURS, result_code);
 }
 
+TEST_F(IncomingDataHandlerTest, SharedBuffer_FramesReferenceReceivedData) {
+  const ProtocolPacket rpc_packet(uid1,
+                                  PROTOCOL_VERSION_3,
+                                  PROTECTION_OFF,
+                                  FRAME_TYPE_SINGLE,
+                                  kRpc,
+                                  FRAME_DATA_SINGLE,
+                                  some_session_id,
+                                  some_data2_size,
+                                  some_message_id,
+                                  some_data2);
+  AppendPacketToTMData(rpc_packet);
+  AppendPacketToTMData(rpc_packet);
+
+  ReceiveBuffer receive_buffer;
+  uint8_t* buffer = receive_buffer.Prepare();
+  ASSERT_TRUE(buffer);
+  ASSERT_LE(tm_data.size(), receive_buffer.writable_size());
+  std::copy(tm_data.begin(), tm_data.end(), buffer);
+  const RawMessagePtr tm_message = receive_buffer.Commit(tm_data.size());
+  tm_message->set_connection_key(uid1);
+
+  actual_frames =
+      data_handler.ProcessData(*tm_message, result_code, &malformed_occurs);
+  EXPECT_EQ(RESULT_OK, result_code);
+  ASSERT_EQ(2u, actual_frames.size());
+  for (FrameList::const_iterator it = actual_frames.begin();
+       it != actual_frames.end();
+       ++it) {
+    const ProtocolFramePtr& frame = *it;
+    EXPECT_EQ(rpc_packet, *frame);
+    // Payload is not copied, it points into the received data
+    EXPECT_GE(frame->data(), buffer);
+    EXPECT_LT(frame->data(), buffer + tm_data.size());
+  }
+}
+
+TEST_F(IncomingDataHandlerTest, SharedBuffer_PartialFrameCompletedLater) {
+  const ProtocolPacket rpc_packet(uid1,
+                                  PROTOCOL_VERSION_3,
+                                  PROTECTION_OFF,
+                                  FRAME_TYPE_SINGLE,
+                                  kRpc,
+                                  FRAME_DATA_SINGLE,
+                                  some_session_id,
+                                  some_data2_size,
+                                  some_message_id,
+                                  some_data2);
+  AppendPacketToTMData(rpc_packet);
+  AppendPacketToTMData(rpc_packet);
+  const size_t first_part_size = tm_data.size() * 3 / 4;
+
+  ReceiveBuffer receive_buffer;
+  std::copy(tm_data.begin(),
+            tm_data.begin() + first_part_size,
+            receive_buffer.Prepare());
+  RawMessagePtr tm_message = receive_buffer.Commit(first_part_size);
+  tm_message->set_connection_key(uid1);
+  actual_frames =
+      data_handler.ProcessData(*tm_message, result_code, &malformed_occurs);
+  EXPECT_EQ(RESULT_OK, result_code);
+  ASSERT_EQ(1u, actual_frames.size());
+  EXPECT_EQ(rpc_packet, *actual_frames.front());
+
+  std::copy(
+      tm_data.begin() + first_part_size, tm_data.end(), receive_buffer.Prepare());
+  tm_message = receive_buffer.Commit(tm_data.size() - first_part_size);
+  tm_message->set_connection_key(uid1);
+  actual_frames =
+      data_handler.ProcessData(*tm_message, result_code, &malformed_occurs);
+  EXPECT_EQ(RESULT_OK, result_code);
+  ASSERT_EQ(1u, actual_frames.size());
+  EXPECT_EQ(rpc_packet, *actual_frames.front());
+}
+
+TEST_F(IncomingDataHandlerTest, SmallPortions_FramesWrappingBufferCreated) {
+  FrameList mobile_packets;
+  for (uint32_t i = 0; i < 200u; ++i) {
+    mobile_packets.push_back(
+        std::make_shared<ProtocolPacket>(uid1,
+                                         PROTOCOL_VERSION_3,
+                                         PROTECTION_OFF,
+                                         FRAME_TYPE_CONSECUTIVE,
+                                         kMobileNav,
+                                         static_cast<uint8_t>(i),
+                                         some_session_id,
+                                         some_data2_size - i,
+                                         some_message_id + i,
+                                         some_data2));
+  }
+  for (FrameList::const_iterator it = mobile_packets.begin();
+       it != mobile_packets.end();
+       ++it) {
+    AppendPacketToTMData(**it);
+  }
+
+  // Portions of different size make frames wrap around the end
+  // of reassembly buffer at different offsets
+  FrameList received_packets;
+  const size_t portion_sizes[] = {7u, 113u, 1u, 2049u, 33u};
+  size_t offset = 0u;
+  for (size_t i = 0; offset < tm_data.size(); ++i) {
+    const size_t size = std::min(portion_sizes[i % ARRAYSIZE(portion_sizes)],
+                                 tm_data.size() - offset);
+    ProcessData(uid1, &tm_data[offset], size);
+    EXPECT_EQ(RESULT_OK, result_code);
+    received_packets.insert(
+        received_packets.end(), actual_frames.begin(), actual_frames.end());
+    offset += size;
+  }
+
+  ASSERT_EQ(mobile_packets.size(), received_packets.size());
+  FrameList::const_iterator expected_it = mobile_packets.begin();
+  for (FrameList::const_iterator it = received_packets.begin();
+       it != received_packets.end();
+       ++it, ++expected_it) {
+    EXPECT_EQ(**expected_it, **it);
+  }
+}
+
+TEST_F(IncomingDataHandlerTest, MalformedData_ResyncOnNextValidFrame) {
+  const ProtocolPacket rpc_packet(uid1,
+                                  PROTOCOL_VERSION_3,
+                                  PROTECTION_OFF,
+                                  FRAME_TYPE_SINGLE,
+                                  kRpc,
+                                  FRAME_DATA_SINGLE,
+                                  some_session_id,
+                                  some_data_size,
+                                  some_message_id,
+                                  some_data);
+  AppendPacketToTMData(rpc_packet);
+  // Garbage which partially looks like a header
+  for (size_t i = 0; i < 1000u; ++i) {
+    tm_data.push_back(i % 3 ? 0xFF : 0x31);
+  }
+  AppendPacketToTMData(rpc_packet);
+
+  ProcessData(uid1, &tm_data[0], tm_data.size());
+  EXPECT_EQ(RESULT_MALFORMED_OCCURS, result_code);
+  EXPECT_EQ(1u, malformed_occurs);
+  ASSERT_EQ(2u, actual_frames.size());
+  EXPECT_EQ(rpc_packet, *actual_frames.front());
+  EXPECT_EQ(rpc_packet, *actual_frames.back());
+}
+
 // TODO(EZamakhov): add tests for handling 2+ connection data
 
 }  // namespace protocol_handler_test
@@ -5247,6 +5247,85 @@ TEST_F(ProtocolHandlerImplTest, SendServiceDataAck_AfterVersion5) {
   EXPECT_TRUE(waiter->WaitFor(times, kAsyncExpectationsTimeout));
 }
 
+/*
+ * ProtocolHandler shall bind BSON RPC payload format with the session and
+ * respond with StartServiceACK if mobile requested it for RPC service
+ */
+TEST_F(ProtocolHandlerImplTest, StartSession_Rpc_BsonPayloadFormatRequested) {
+  using namespace protocol_handler;
+  AddConnection();
+  auto waiter = TestAsyncWaiter::createInstance();
+  uint32_t times = 0;
+
+  SessionContext context = GetSessionContext(connection_id,
+                                             NEW_SESSION_ID,
+                                             session_id,
+                                             kRpc,
+                                             HASH_ID_WRONG,
+                                             PROTECTION_OFF);
+
+  EXPECT_CALL(session_observer_mock,
+              TransportTypeProfileStringFromConnHandle(connection_id))
+      .WillRepeatedly(Return("TCP_WIFI"));
+  std::vector<std::string> allowed_transports{"TCP_WIFI"};
+  EXPECT_CALL(protocol_handler_settings_mock, audio_service_transports())
+      .WillRepeatedly(ReturnRef(allowed_transports));
+  EXPECT_CALL(protocol_handler_settings_mock, video_service_transports())
+      .WillRepeatedly(ReturnRef(allowed_transports));
+
+  EXPECT_CALL(session_observer_mock,
+              OnSessionStartedCallback(connection_id,
+                                       NEW_SESSION_ID,
+                                       kRpc,
+                                       PROTECTION_OFF,
+                                       An<const BsonObject*>()))
+      .WillOnce(DoAll(
+          NotifyTestAsyncWaiter(waiter),
+          InvokeMemberFuncWithArg3(
+              protocol_handler_impl.get(),
+              static_cast<void (ProtocolHandler::*)(SessionContext&,
+                                                    std::vector<std::string>&,
+                                                    const std::string)>(
+                  &ProtocolHandler::NotifySessionStarted),
+              ByRef(context),
+              ByRef(empty_rejected_param_),
+              std::string())));
+  times++;
+
+  EXPECT_CALL(connection_handler_mock,
+              BindRpcPayloadFormatWithSession(connection_key,
+                                              RPC_PAYLOAD_FORMAT_BSON))
+      .WillOnce(NotifyTestAsyncWaiter(waiter));
+  times++;
+
+  EXPECT_CALL(transport_manager_mock,
+              SendMessageToDevice(ControlMessage(FRAME_DATA_START_SERVICE_ACK,
+                                                 PROTECTION_OFF)))
+      .WillOnce(DoAll(NotifyTestAsyncWaiter(waiter), Return(E_SUCCESS)));
+  times++;
+
+  BsonObject request_params;
+  bson_object_initialize_default(&request_params);
+  bson_object_put_string(&request_params,
+                         protocol_handler::strings::protocol_version,
+                         const_cast<char*>("5.4.0"));
+  bson_object_put_string(&request_params,
+                         protocol_handler::strings::rpc_payload_format,
+                         const_cast<char*>("BSON"));
+  std::vector<uint8_t> params = CreateVectorFromBsonObject(&request_params);
+  bson_object_deinitialize(&request_params);
+
+  SendControlMessage(PROTECTION_OFF,
+                     kRpc,
+                     NEW_SESSION_ID,
+                     FRAME_DATA_START_SERVICE,
+                     PROTOCOL_VERSION_5,
+                     params.size(),
+                     &params[0]);
+
+  EXPECT_TRUE(waiter->WaitFor(times, kAsyncExpectationsTimeout));
+}
+
 /*
  * ProtocolHandler shall send StartServiceNAK with a reason param when starting
  * a video/audio service if the service type is disallowed by the settings
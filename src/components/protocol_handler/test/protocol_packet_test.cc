@@ -34,6 +34,7 @@
 #include "gtest/gtest.h"
 
 #include "protocol/common.h"
+#include "protocol/frame_pool.h"
 #include "protocol_handler/protocol_packet.h"
 #include "utils/macro.h"
 
@@ -62,6 +63,7 @@ using protocol_handler::PROTOCOL_VERSION_1;
 using protocol_handler::PROTOCOL_VERSION_3;
 using protocol_handler::PROTOCOL_VERSION_MAX;
 using protocol_handler::ProtocolPacket;
+using protocol_handler::RawMessage;
 using protocol_handler::RawMessagePtr;
 using protocol_handler::RESULT_CODE;
 using protocol_handler::RESULT_FAIL;
@@ -211,6 +213,80 @@ TEST_F(ProtocolPacketTest, SetData) {
   EXPECT_EQ(session_id, protocol_packet.data()[3]);
 }
 
+TEST_F(ProtocolPacketTest, SetSharedData_SerializedInParts) {
+  const size_t data_size = 2000u;
+  const std::shared_ptr<uint8_t> shared_data =
+      protocol_handler::frame_pool::MakeSharedBuffer(data_size);
+  ASSERT_TRUE(shared_data);
+  for (size_t i = 0; i < data_size; ++i) {
+    shared_data.get()[i] = static_cast<uint8_t>(i);
+  }
+  ProtocolPacket shared_packet(some_connection_id_,
+                               PROTOCOL_VERSION_3,
+                               PROTECTION_OFF,
+                               protocol_handler::FRAME_TYPE_CONSECUTIVE,
+                               kRpc,
+                               FRAME_DATA_LAST_CONSECUTIVE,
+                               some_session_id_,
+                               data_size,
+                               some_message_id_);
+  shared_packet.set_data(shared_data, data_size);
+  EXPECT_EQ(shared_data.get(), shared_packet.data());
+  EXPECT_EQ(data_size, shared_packet.data_size());
+
+  const RawMessagePtr message = shared_packet.serializePacket();
+  ASSERT_TRUE(message);
+  RawMessage::Segment segments[RawMessage::kMaxSegments];
+  ASSERT_EQ(2u, message->GetSegments(segments));
+  EXPECT_EQ(PROTOCOL_HEADER_V2_SIZE, segments[0].size);
+  EXPECT_EQ(shared_data.get(), segments[1].data);
+  EXPECT_EQ(data_size, segments[1].size);
+
+  ProtocolPacket copied_packet(some_connection_id_,
+                               PROTOCOL_VERSION_3,
+                               PROTECTION_OFF,
+                               protocol_handler::FRAME_TYPE_CONSECUTIVE,
+                               kRpc,
+                               FRAME_DATA_LAST_CONSECUTIVE,
+                               some_session_id_,
+                               data_size,
+                               some_message_id_,
+                               shared_data.get());
+  const RawMessagePtr copied_message = copied_packet.serializePacket();
+  ASSERT_TRUE(copied_message);
+  EXPECT_EQ(1u, copied_message->GetSegments(segments));
+  ASSERT_EQ(copied_message->data_size(), message->data_size());
+  EXPECT_EQ(std::vector<uint8_t>(copied_message->data(),
+                                 copied_message->data() +
+                                     copied_message->data_size()),
+            std::vector<uint8_t>(message->data(),
+                                 message->data() + message->data_size()));
+}
+
+TEST_F(ProtocolPacketTest, DetachSharedData_BufferReleased) {
+  const size_t data_size = 100u;
+  const std::shared_ptr<uint8_t> shared_data =
+      protocol_handler::frame_pool::MakeSharedBuffer(data_size);
+  ASSERT_TRUE(shared_data);
+  for (size_t i = 0; i < data_size; ++i) {
+    shared_data.get()[i] = static_cast<uint8_t>(i);
+  }
+  ProtocolPacket protocol_packet;
+  protocol_packet.set_data(shared_data, data_size);
+  EXPECT_EQ(2, shared_data.use_count());
+
+  EXPECT_TRUE(protocol_packet.DetachSharedData());
+  EXPECT_EQ(1, shared_data.use_count());
+  EXPECT_NE(shared_data.get(), protocol_packet.data());
+  ASSERT_EQ(data_size, protocol_packet.total_data_bytes());
+  EXPECT_EQ(0, memcmp(shared_data.get(), protocol_packet.data(), data_size));
+
+  // Owned data is kept as is
+  uint8_t* const data = protocol_packet.data();
+  EXPECT_TRUE(protocol_packet.DetachSharedData());
+  EXPECT_EQ(data, protocol_packet.data());
+}
+
 TEST_F(ProtocolPacketTest, DeserializeZeroPacket) {
   uint8_t message[] = {};
   ProtocolPacket protocol_packet;
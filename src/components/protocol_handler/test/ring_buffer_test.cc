@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "protocol_handler/ring_buffer.h"
+
+namespace test {
+namespace components {
+namespace protocol_handler_test {
+using ::protocol_handler::RingBuffer;
+
+namespace {
+std::vector<uint8_t> ReadAll(const RingBuffer& ring) {
+  const uint8_t* first = NULL;
+  const uint8_t* second = NULL;
+  size_t first_size = 0u;
+  size_t second_size = 0u;
+  ring.GetSegments(&first, &first_size, &second, &second_size);
+  std::vector<uint8_t> result(first, first + first_size);
+  result.insert(result.end(), second, second + second_size);
+  return result;
+}
+
+std::vector<uint8_t> MakeData(const size_t size, const uint8_t seed) {
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8_t>(seed + i);
+  }
+  return data;
+}
+}  // namespace
+
+TEST(RingBufferTest, DefaultCtor_Empty) {
+  RingBuffer ring;
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(0u, ring.size());
+  EXPECT_TRUE(ReadAll(ring).empty());
+}
+
+TEST(RingBufferTest, AppendConsume_DataKeptInOrder) {
+  RingBuffer ring;
+  const std::vector<uint8_t> data = MakeData(100u, 1u);
+  ring.Append(&data[0], data.size());
+  EXPECT_EQ(data, ReadAll(ring));
+
+  ring.Consume(40u);
+  EXPECT_EQ(60u, ring.size());
+  EXPECT_EQ(data[40], ring[0]);
+  EXPECT_EQ(std::vector<uint8_t>(data.begin() + 40, data.end()), ReadAll(ring));
+
+  ring.Consume(60u);
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(RingBufferTest, Append_WrapsAroundEnd_TwoSegments) {
+  RingBuffer ring;
+  const std::vector<uint8_t> data = MakeData(3000u, 7u);
+  ring.Append(&data[0], data.size());
+  const size_t capacity = ring.capacity();
+  ring.Consume(2500u);
+
+  const std::vector<uint8_t> tail = MakeData(capacity - 600u, 3u);
+  ring.Append(&tail[0], tail.size());
+  // Capacity does not change while data fits
+  EXPECT_EQ(capacity, ring.capacity());
+
+  const uint8_t* first = NULL;
+  const uint8_t* second = NULL;
+  size_t first_size = 0u;
+  size_t second_size = 0u;
+  ring.GetSegments(&first, &first_size, &second, &second_size);
+  EXPECT_GT(second_size, 0u);
+  EXPECT_EQ(500u + tail.size(), first_size + second_size);
+
+  std::vector<uint8_t> expected(data.begin() + 2500, data.end());
+  expected.insert(expected.end(), tail.begin(), tail.end());
+  EXPECT_EQ(expected, ReadAll(ring));
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i], ring[i]);
+  }
+}
+
+TEST(RingBufferTest, Append_DoesNotFit_GrowsKeepingData) {
+  RingBuffer ring;
+  const std::vector<uint8_t> data = MakeData(3000u, 11u);
+  ring.Append(&data[0], data.size());
+  ring.Consume(1000u);
+  const size_t capacity = ring.capacity();
+
+  const std::vector<uint8_t> big = MakeData(capacity * 2, 5u);
+  ring.Append(&big[0], big.size());
+  EXPECT_GT(ring.capacity(), capacity);
+  // Capacity is a power of two
+  EXPECT_EQ(0u, ring.capacity() & (ring.capacity() - 1));
+
+  std::vector<uint8_t> expected(data.begin() + 1000, data.end());
+  expected.insert(expected.end(), big.begin(), big.end());
+  EXPECT_EQ(expected, ReadAll(ring));
+}
+
+}  // namespace protocol_handler_test
+}  // namespace components
+}  // namespace test
@@ -126,6 +126,15 @@ class CArraySchemaItem : public ISchemaItem {
 
   TypeID GetType() OVERRIDE;
 
+  ISchemaItem* GetElementSchemaItem() OVERRIDE;
+
+  /**
+   * @brief Build copy of array with element schema item resolved
+   *        for message version
+   **/
+  ISchemaItemPtr ResolveVersion(const utils::SemanticVersion& MessageVersion,
+                                ResolvedItems& resolved) OVERRIDE;
+
  private:
   /**
    * @brief Constructor.
@@ -113,11 +113,13 @@ errors::eType CDefaultSchemaItem<Type>::validate(
     const utils::SemanticVersion& MessageVersion,
     const bool allow_unknown_enums) {
   if (getSmartType() != Object.getType()) {
-    std::string validation_info =
-        "Incorrect type, expected: " +
-        SmartObject::typeToString(getSmartType()) +
-        ", got: " + SmartObject::typeToString(Object.getType());
-    report->set_validation_info(validation_info);
+    if (report) {
+      std::string validation_info =
+          "Incorrect type, expected: " +
+          SmartObject::typeToString(getSmartType()) +
+          ", got: " + SmartObject::typeToString(Object.getType());
+      report->set_validation_info(validation_info);
+    }
     return errors::INVALID_VALUE;
   } else {
     return errors::OK;
@@ -42,6 +42,7 @@
 #include "smart_objects/default_shema_item.h"
 
 #include <boost/optional.hpp>
+#include "utils/perfect_hash.h"
 #include "utils/semantic_version.h"
 
 namespace ns_smart_device_link {
@@ -153,6 +154,14 @@ class TEnumSchemaItem : public CDefaultSchemaItem<EnumType> {
   void unapplySchema(SmartObject& Object,
                      const bool remove_unknown_parameters) OVERRIDE;
 
+  /**
+   * @brief Build copy of enum which allows only elements existing
+   *        in message version
+   **/
+  ISchemaItemPtr ResolveVersion(
+      const utils::SemanticVersion& MessageVersion,
+      ISchemaItem::ResolvedItems& resolved) OVERRIDE;
+
  private:
   /**
    * @brief Constructor.
@@ -188,6 +197,21 @@ struct CStringComparator {
   }
 };
 
+/**
+ * @brief Perfect hash tables generated for enum conversions.
+ * See utils/perfect_hash.h for lookup scheme. Slots contain index
+ * of element in cstring_values_/enum_values_ arrays or -1 for empty slot.
+ **/
+struct EnumHashTables {
+  uint32_t seed;
+  uint32_t bucket_mask;
+  uint32_t slot_mask;
+  const uint32_t* string_displacements;
+  const int16_t* string_slots;
+  const uint32_t* value_displacements;
+  const int16_t* value_slots;
+};
+
 template <typename EnumType>
 class EnumConversionHelper {
  public:
@@ -203,6 +227,9 @@ class EnumConversionHelper {
   }
 
   static bool CStringToEnum(const char* str, EnumType* value) {
+    if (hash_tables_) {
+      return HashedStringToEnum(str, strlen(str), value);
+    }
     typename CStringToEnumMap::const_iterator it =
         cstring_to_enum_map().find(str);
     if (it == cstring_to_enum_map().end()) {
@@ -218,6 +245,9 @@ class EnumConversionHelper {
   }
 
   static bool EnumToCString(EnumType value, const char** str) {
+    if (hash_tables_) {
+      return HashedEnumToCString(value, str);
+    }
     typename EnumToCStringMap::const_iterator it =
         enum_to_cstring_map().find(value);
     if (it == enum_to_cstring_map().end()) {
@@ -230,6 +260,9 @@ class EnumConversionHelper {
   }
 
   static bool StringToEnum(const std::string& str, EnumType* value) {
+    if (hash_tables_) {
+      return HashedStringToEnum(str.c_str(), str.size(), value);
+    }
     return CStringToEnum(str.c_str(), value);
   }
 
@@ -248,6 +281,13 @@ class EnumConversionHelper {
   static const EnumType enum_values_[];
   static const EnumToCStringMap enum_to_cstring_map_;
   static const CStringToEnumMap cstring_to_enum_map_;
+  /**
+   * @brief Tables emitted by code generator, NULL if enum has none
+   * and conversions should use maps.
+   * Pointer is not const on purpose: otherwise compiler folds NULL checks
+   * in translation unit defining tables and warns about them.
+   **/
+  static const EnumHashTables* hash_tables_;
 
   struct Size {
     enum { value = sizeof(cstring_values_) / sizeof(cstring_values_[0]) };
@@ -270,6 +310,46 @@ class EnumConversionHelper {
     }
     return result;
   }
+  static bool HashedStringToEnum(const char* str,
+                                 const size_t length,
+                                 EnumType* value) {
+    namespace ph = utils::perfect_hash;
+    const int16_t index =
+        ph::Lookup(ph::HashString(str, length, hash_tables_->seed),
+                   hash_tables_->string_displacements,
+                   hash_tables_->bucket_mask,
+                   hash_tables_->string_slots,
+                   hash_tables_->slot_mask);
+    if (index < 0 || strlen(cstring_values_[index]) != length ||
+        memcmp(cstring_values_[index], str, length) != 0) {
+      if (value) {
+        *value = EnumType::INVALID_ENUM;
+      }
+      return false;
+    }
+    if (value) {
+      *value = enum_values_[index];
+    }
+    return true;
+  }
+
+  static bool HashedEnumToCString(const EnumType value, const char** str) {
+    namespace ph = utils::perfect_hash;
+    const int16_t index = ph::Lookup(
+        ph::HashValue(static_cast<int32_t>(value), hash_tables_->seed),
+        hash_tables_->value_displacements,
+        hash_tables_->bucket_mask,
+        hash_tables_->value_slots,
+        hash_tables_->slot_mask);
+    if (index < 0 || enum_values_[index] != value) {
+      return false;
+    }
+    if (str) {
+      *str = cstring_values_[index];
+    }
+    return true;
+  }
+
   DISALLOW_COPY_AND_ASSIGN(EnumConversionHelper<EnumType>);
 };
 
@@ -322,11 +402,12 @@ bool TEnumSchemaItem<EnumType>::filterInvalidEnums(
     SmartObject& Object,
     const utils::SemanticVersion& MessageVersion,
     rpc::ValidationReport* report) {
-  rpc::ValidationReport dummy_report("");
-  if (validate(Object, &dummy_report, MessageVersion) == errors::OUT_OF_RANGE) {
-    std::string validation_info =
-        "Ignored invalid value - " + Object.asString();
-    report->set_validation_info(validation_info);
+  if (validate(Object, NULL, MessageVersion) == errors::OUT_OF_RANGE) {
+    if (report) {
+      std::string validation_info =
+          "Ignored invalid value - " + Object.asString();
+      report->set_validation_info(validation_info);
+    }
     return true;
   }
   return false;
@@ -342,15 +423,19 @@ errors::eType TEnumSchemaItem<EnumType>::validate(
     if (allow_unknown_enums) {
       return errors::OK;
     }
-    std::string validation_info = "Invalid enum value: " + Object.asString();
-    report->set_validation_info(validation_info);
+    if (report) {
+      std::string validation_info = "Invalid enum value: " + Object.asString();
+      report->set_validation_info(validation_info);
+    }
     return errors::OUT_OF_RANGE;
   } else if (SmartType_Integer != Object.getType()) {
-    std::string validation_info =
-        "Incorrect type, expected: " +
-        SmartObject::typeToString(SmartType_Integer) +
-        " (enum), got: " + SmartObject::typeToString(Object.getType());
-    report->set_validation_info(validation_info);
+    if (report) {
+      std::string validation_info =
+          "Incorrect type, expected: " +
+          SmartObject::typeToString(SmartType_Integer) +
+          " (enum), got: " + SmartObject::typeToString(Object.getType());
+      report->set_validation_info(validation_info);
+    }
     return errors::INVALID_VALUE;
   }
 
@@ -358,9 +443,11 @@ errors::eType TEnumSchemaItem<EnumType>::validate(
       mAllowedElements.find(static_cast<EnumType>(Object.asInt()));
 
   if (elements_it == mAllowedElements.end()) {
-    std::string validation_info =
-        "Invalid enum value: " + std::to_string(Object.asInt());
-    report->set_validation_info(validation_info);
+    if (report) {
+      std::string validation_info =
+          "Invalid enum value: " + std::to_string(Object.asInt());
+      report->set_validation_info(validation_info);
+    }
     return errors::OUT_OF_RANGE;
   }
 
@@ -374,18 +461,23 @@ errors::eType TEnumSchemaItem<EnumType>::validate(
             getSignature(signatures_it->second, MessageVersion);
         if (signature.mRemoved) {
           // Element was removed for this version
-          std::string validation_info = "Enum value : " + Object.asString() +
-                                        " removed for SyncMsgVersion " +
-                                        MessageVersion.toString();
-          report->set_validation_info(validation_info);
+          if (report) {
+            std::string validation_info = "Enum value : " + Object.asString() +
+                                          " removed for SyncMsgVersion " +
+                                          MessageVersion.toString();
+            report->set_validation_info(validation_info);
+          }
           return errors::OUT_OF_RANGE;
         } else if (signature.mSince == boost::none &&
                    signature.mUntil == boost::none) {
           // Element does not exist for this version
-          std::string validation_info = "Enum value : " + Object.asString() +
-                                        " does not exist for SyncMsgVersion " +
-                                        MessageVersion.toString();
-          report->set_validation_info(validation_info);
+          if (report) {
+            std::string validation_info =
+                "Enum value : " + Object.asString() +
+                " does not exist for SyncMsgVersion " +
+                MessageVersion.toString();
+            report->set_validation_info(validation_info);
+          }
           return errors::OUT_OF_RANGE;
         }
       }
@@ -419,6 +511,33 @@ void TEnumSchemaItem<EnumType>::unapplySchema(
   }
 }
 
+template <typename EnumType>
+ISchemaItemPtr TEnumSchemaItem<EnumType>::ResolveVersion(
+    const utils::SemanticVersion& MessageVersion,
+    ISchemaItem::ResolvedItems& resolved) {
+  if (!MessageVersion.isValid() || mElementSignatures.empty()) {
+    return ISchemaItemPtr();
+  }
+  std::set<EnumType> allowed_elements;
+  for (typename std::set<EnumType>::const_iterator it =
+           mAllowedElements.begin();
+       it != mAllowedElements.end();
+       ++it) {
+    auto signatures_it = mElementSignatures.find(*it);
+    if (signatures_it != mElementSignatures.end() &&
+        !signatures_it->second.empty()) {
+      const ElementSignature signature =
+          getSignature(signatures_it->second, MessageVersion);
+      if (signature.mRemoved || (signature.mSince == boost::none &&
+                                 signature.mUntil == boost::none)) {
+        continue;
+      }
+    }
+    allowed_elements.insert(*it);
+  }
+  return create(allowed_elements, mDefaultValue);
+}
+
 template <typename EnumType>
 SmartType TEnumSchemaItem<EnumType>::getSmartType() const {
   return SmartType_Integer;
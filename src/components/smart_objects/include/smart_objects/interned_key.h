@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_INTERNED_KEY_H_
+#define SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_INTERNED_KEY_H_
+
+#include <stddef.h>
+#include <string>
+
+namespace ns_smart_device_link {
+namespace ns_smart_objects {
+
+/**
+ * @brief Map key registered in process-wide key table.
+ *
+ * Table holds names of schema members and other well-known keys. Each name
+ * is stored once and never released, so two interned keys are equal
+ * if and only if they point to the same table entry.
+ * Keys which came from outside (e.g. unknown parameters of mobile
+ * messages) are never added to the table, so it can not grow unbounded.
+ **/
+class InternedKey {
+ public:
+  /**
+   * @brief Creates empty key, which is not equal to any interned key
+   **/
+  InternedKey() : value_(NULL) {}
+
+  /**
+   * @brief Adds key to the table if it is not there yet.
+   * @param key Key name
+   * @return Interned key, never empty
+   **/
+  static InternedKey Intern(const std::string& key);
+
+  /**
+   * @brief Looks key up in the table without adding it.
+   * @param key Key name
+   * @param length Length of key name
+   * @return Interned key or empty key if key has not been interned
+   **/
+  static InternedKey Find(const char* key, const size_t length);
+
+  /**
+   * @brief Checks if key refers to table entry
+   **/
+  bool empty() const {
+    return NULL == value_;
+  }
+
+  /**
+   * @brief Gets key name. Must not be called for empty key.
+   **/
+  const std::string& str() const {
+    return *value_;
+  }
+
+  bool operator==(const InternedKey& other) const {
+    return value_ == other.value_;
+  }
+
+  bool operator!=(const InternedKey& other) const {
+    return value_ != other.value_;
+  }
+
+ private:
+  explicit InternedKey(const std::string* value) : value_(value) {}
+
+  const std::string* value_;
+};
+
+}  // namespace ns_smart_objects
+}  // namespace ns_smart_device_link
+
+#endif  // SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_INTERNED_KEY_H_
@@ -151,10 +151,13 @@ errors::eType TNumberSchemaItem<NumberType>::validate(
     SmartType expectedType = (typeid(double) == typeid(Object.getType()))
                                  ? SmartType_Double
                                  : SmartType_Integer;
-    std::string validation_info =
-        "Incorrect type, expected: " + SmartObject::typeToString(expectedType) +
-        ", got: " + SmartObject::typeToString(Object.getType());
-    report->set_validation_info(validation_info);
+    if (report) {
+      std::string validation_info =
+          "Incorrect type, expected: " +
+          SmartObject::typeToString(expectedType) +
+          ", got: " + SmartObject::typeToString(Object.getType());
+      report->set_validation_info(validation_info);
+    }
     return errors::INVALID_VALUE;
   }
   NumberType value(0);
@@ -174,20 +177,24 @@ errors::eType TNumberSchemaItem<NumberType>::validate(
 
   NumberType rangeLimit;
   if (mMinValue.getValue(rangeLimit) && (value < rangeLimit)) {
-    std::stringstream stream;
-    stream << "Value too small, got: " << value
-           << ", minimum allowed: " << rangeLimit;
-    std::string validation_info = stream.str();
-    report->set_validation_info(validation_info);
+    if (report) {
+      std::stringstream stream;
+      stream << "Value too small, got: " << value
+             << ", minimum allowed: " << rangeLimit;
+      std::string validation_info = stream.str();
+      report->set_validation_info(validation_info);
+    }
     return errors::OUT_OF_RANGE;
   }
 
   if (mMaxValue.getValue(rangeLimit) && (value > rangeLimit)) {
-    std::stringstream stream;
-    stream << "Value too large, got: " << value
-           << ", maximum allowed: " << rangeLimit;
-    std::string validation_info = stream.str();
-    report->set_validation_info(validation_info);
+    if (report) {
+      std::stringstream stream;
+      stream << "Value too large, got: " << value
+             << ", maximum allowed: " << rangeLimit;
+      std::string validation_info = stream.str();
+      report->set_validation_info(validation_info);
+    }
     return errors::OUT_OF_RANGE;
   }
   return errors::OK;
@@ -35,11 +35,13 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <boost/optional.hpp>
 #include "utils/macro.h"
 #include "utils/semantic_version.h"
 
+#include "smart_objects/interned_key.h"
 #include "smart_objects/schema_item.h"
 #include "smart_objects/schema_item_parameter.h"
 
@@ -179,6 +181,14 @@ class CObjectSchemaItem : public ISchemaItem {
   void AddMemberSchemaItem(const std::string& member_key,
                            SMember& member) OVERRIDE;
 
+  /**
+   * @brief Build copy of object with correct member chosen for every key.
+   * Members which do not exist in specified version are kept as not
+   * mandatory ones which do not accept any value.
+   **/
+  ISchemaItemPtr ResolveVersion(const utils::SemanticVersion& MessageVersion,
+                                ResolvedItems& resolved) OVERRIDE;
+
  protected:
   /**
    * @brief Constructor.
@@ -206,11 +216,27 @@ class CObjectSchemaItem : public ISchemaItem {
   const SMember* GetCorrectMember(const SMember& member,
                                   const utils::SemanticVersion& messageVersion);
 
+  /**
+   * @brief Interns names of all members into mMemberKeys
+   **/
+  void InternMemberKeys();
+
   /**
    * @brief Map of member name to SMember structure describing the object
    *        member.
    **/
   Members mMembers;
+
+  /**
+   * @brief Interned names of members in the same order as in mMembers
+   **/
+  std::vector<InternedKey> mMemberKeys;
+
+  /**
+   * @brief true if members are already resolved for message version,
+   *        so history of members is not checked anymore
+   **/
+  bool mIsVersionResolved;
   DISALLOW_COPY_AND_ASSIGN(CObjectSchemaItem);
 };
 }  // namespace ns_smart_objects
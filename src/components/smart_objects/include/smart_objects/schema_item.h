@@ -38,6 +38,7 @@
 
 #include "smart_objects/errors.h"
 
+#include <map>
 #include <memory>
 #include <vector>
 #include "boost/optional/optional.hpp"
@@ -69,7 +70,8 @@ class ISchemaItem {
    *
    * @param Object Object to validate.
    * @param report object for reporting errors during validation
-   * message if an error occurs
+   * message if an error occurs. May be NULL, in this case validation only
+   * returns result and must not allocate anything for valid object.
    * @param MessageVersion to check mobile RPC version against RPC Spec History
    * @param allow_unknown_enums
    *   false - unknown enum values (left as string values after applySchema)
@@ -149,6 +151,28 @@ class ISchemaItem {
   virtual void BuildObjectBySchema(const SmartObject& pattern_object,
                                    SmartObject& result_object);
 
+  /**
+   * @brief Map of source schema items to their version resolved copies.
+   * NULL copy means that source item does not depend on version.
+   **/
+  typedef std::map<const ISchemaItem*, std::shared_ptr<ISchemaItem> >
+      ResolvedItems;
+
+  /**
+   * @brief Build copy of schema item with RPC Spec History resolved for
+   * specified message version, so validation of messages of this version
+   * by the copy does not need to check history anymore.
+   *
+   * @param MessageVersion the version to resolve schema for
+   * @param resolved items already resolved for this version, items shared
+   * in source schema stay shared in resolved one
+   *
+   * @return Resolved copy or NULL if item does not depend on version
+   *         and may be used as is.
+   **/
+  virtual std::shared_ptr<ISchemaItem> ResolveVersion(
+      const utils::SemanticVersion& MessageVersion, ResolvedItems& resolved);
+
   virtual boost::optional<SMember&> GetMemberSchemaItem(
       const std::string& member_key) {
     UNUSED(member_key);
@@ -160,6 +184,15 @@ class ISchemaItem {
     UNUSED(member_key);
     UNUSED(member);
   }
+
+  /**
+   * @brief Get schema item of array elements
+   *
+   * @return Element schema item or NULL if schema does not describe array
+   */
+  virtual ISchemaItem* GetElementSchemaItem() {
+    return NULL;
+  }
   /**
    * @brief Get value param, depends of children
    *
@@ -175,6 +208,17 @@ class ISchemaItem {
   virtual TypeID GetType();
 
   virtual ~ISchemaItem() {}
+
+ protected:
+  /**
+   * @brief Resolves child schema item using already resolved copy if any
+   *
+   * @return Resolved copy or NULL if item may be used as is
+   **/
+  static std::shared_ptr<ISchemaItem> ResolveChildVersion(
+      ISchemaItem* item,
+      const utils::SemanticVersion& MessageVersion,
+      ResolvedItems& resolved);
 };
 typedef std::shared_ptr<ISchemaItem> ISchemaItemPtr;
 }  // namespace ns_smart_objects
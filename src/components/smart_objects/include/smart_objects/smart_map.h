@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_SMART_MAP_H_
+#define SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_SMART_MAP_H_
+
+#include <stddef.h>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "smart_objects/interned_key.h"
+
+namespace ns_smart_device_link {
+namespace ns_smart_objects {
+
+class SmartObject;
+
+/**
+ * @brief Map of SmartObject members.
+ *
+ * Members are kept in vector sorted by key, so iteration order is the same
+ * as for std::map. Each member is allocated separately, so references to
+ * members stay valid until member is erased, but unlike std::map iterators
+ * are invalidated by insertion and erasure.
+ * Members with interned keys are found by comparing key pointers when map
+ * is small, other lookups use binary search.
+ **/
+class SmartMap {
+ public:
+  typedef std::string key_type;
+  typedef SmartObject mapped_type;
+  typedef std::pair<const std::string, SmartObject> value_type;
+  typedef size_t size_type;
+
+ private:
+  struct Entry {
+    /**
+     * @brief Interned key of member, empty if key was not interned
+     * when member was added
+     */
+    InternedKey key;
+    value_type* value;
+  };
+  typedef std::vector<Entry> Entries;
+
+  template <typename Value, typename EntryIterator>
+  class IteratorBase {
+   public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef ptrdiff_t difference_type;
+    typedef Value* pointer;
+    typedef Value& reference;
+
+    IteratorBase() : it_() {}
+    explicit IteratorBase(const EntryIterator& it) : it_(it) {}
+
+    /**
+     * @brief Converts iterator to const_iterator
+     */
+    template <typename OtherValue, typename OtherIterator>
+    IteratorBase(const IteratorBase<OtherValue, OtherIterator>& other,
+                 typename std::enable_if<std::is_convertible<
+                     OtherIterator,
+                     EntryIterator>::value>::type* = NULL)
+        : it_(other.base()) {}
+
+    reference operator*() const {
+      return *it_->value;
+    }
+    pointer operator->() const {
+      return it_->value;
+    }
+    IteratorBase& operator++() {
+      ++it_;
+      return *this;
+    }
+    IteratorBase operator++(int) {
+      IteratorBase result(*this);
+      ++it_;
+      return result;
+    }
+    IteratorBase& operator--() {
+      --it_;
+      return *this;
+    }
+    IteratorBase operator--(int) {
+      IteratorBase result(*this);
+      --it_;
+      return result;
+    }
+    template <typename OtherValue, typename OtherIterator>
+    bool operator==(
+        const IteratorBase<OtherValue, OtherIterator>& other) const {
+      return it_ == other.base();
+    }
+    template <typename OtherValue, typename OtherIterator>
+    bool operator!=(
+        const IteratorBase<OtherValue, OtherIterator>& other) const {
+      return it_ != other.base();
+    }
+    const EntryIterator& base() const {
+      return it_;
+    }
+
+   private:
+    EntryIterator it_;
+  };
+
+ public:
+  typedef IteratorBase<value_type, Entries::iterator> iterator;
+  typedef IteratorBase<const value_type, Entries::const_iterator>
+      const_iterator;
+
+  SmartMap();
+  SmartMap(const SmartMap& other);
+  SmartMap& operator=(const SmartMap& other);
+  ~SmartMap();
+
+  iterator begin() {
+    return iterator(entries_.begin());
+  }
+  iterator end() {
+    return iterator(entries_.end());
+  }
+  const_iterator begin() const {
+    return const_iterator(entries_.begin());
+  }
+  const_iterator end() const {
+    return const_iterator(entries_.end());
+  }
+  size_type size() const {
+    return entries_.size();
+  }
+  bool empty() const {
+    return entries_.empty();
+  }
+
+  iterator find(const std::string& key);
+  const_iterator find(const std::string& key) const;
+  iterator find(const char* key);
+  const_iterator find(const char* key) const;
+  iterator find(const InternedKey& key);
+  const_iterator find(const InternedKey& key) const;
+
+  /**
+   * @brief Gets member with given key, adds Null member if there is no one
+   **/
+  SmartObject& operator[](const std::string& key);
+  SmartObject& operator[](const char* key);
+  SmartObject& operator[](const InternedKey& key);
+
+  /**
+   * @brief Removes member with given key
+   * @return Number of removed members
+   **/
+  size_type erase(const std::string& key);
+  iterator erase(iterator position);
+
+  void clear();
+  void swap(SmartMap& other);
+
+ private:
+  /**
+   * @brief Max size of map which is searched linearly by interned key
+   */
+  static const size_t kLinearSearchLimit = 16;
+
+  Entries::const_iterator LowerBound(const char* key,
+                                     const size_t length) const;
+  Entries::const_iterator FindKey(const char* key, const size_t length) const;
+  Entries::const_iterator FindInterned(const InternedKey& key) const;
+  SmartObject& Insert(const char* key,
+                      const size_t length,
+                      const InternedKey& interned);
+
+  iterator MakeIterator(const Entries::const_iterator& it) {
+    return iterator(entries_.begin() + (it - entries_.begin()));
+  }
+
+  Entries entries_;
+
+  /**
+   * @brief Number of members which have no interned key
+   */
+  size_t uninterned_count_;
+};
+
+}  // namespace ns_smart_objects
+}  // namespace ns_smart_device_link
+
+#endif  // SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_SMART_MAP_H_
@@ -40,6 +40,8 @@
 #include <vector>
 
 #include "rpc_base/validation_report.h"
+#include "smart_objects/interned_key.h"
+#include "smart_objects/smart_map.h"
 #include "smart_objects/smart_schema.h"
 #include "utils/custom_string.h"
 
@@ -117,11 +119,6 @@ enum SmartType {
  **/
 typedef std::vector<SmartObject> SmartArray;
 
-/**
- * @brief SmartMap type
- **/
-typedef std::map<std::string, SmartObject> SmartMap;
-
 /**
  * @brief SmartBinary type
  **/
@@ -141,6 +138,13 @@ typedef std::vector<SmartObjectSPtr> SmartObjectList;
  *primitive type
  * like bool, int32_t, char, double, string and as complex type like array and
  *map.
+ *
+ * When built with ENABLE_SMART_OBJECTS_COW copies of map, array and binary
+ * objects share their payload until one of the copies is modified. Payload
+ * which has handed out mutable access (non-const operator[], asArray,
+ * map_begin etc.) is never shared again, so references obtained that way
+ * stay valid and private. Const references into a shared payload obtained
+ * before the owner is modified keep pointing to the old payload.
  **/
 
 class SmartObject FINAL {
@@ -159,6 +163,15 @@ class SmartObject FINAL {
    **/
   SmartObject(const SmartObject& Other);
 
+  /**
+   * @brief Move constructor.
+   *
+   * Takes over data and schema of other object, which becomes Null.
+   *
+   * @param Other Object to be moved from.
+   **/
+  SmartObject(SmartObject&& Other) noexcept;
+
   /**
    * @brief Constructor for avoid cast
    * from unknown type
@@ -191,6 +204,17 @@ class SmartObject FINAL {
    **/
   SmartObject& operator=(const SmartObject& Other);
 
+  /**
+   * @brief Move assignment operator.
+   *
+   * Like copy assignment leaves object unchanged if other object is Null,
+   * otherwise takes over its data and schema leaving it Null.
+   *
+   * @param  Other Other SmartObject
+   * @return SmartObject&
+   **/
+  SmartObject& operator=(SmartObject&& Other) noexcept;
+
   /**
    * @brief Comparison operator
    *
@@ -527,9 +551,22 @@ class SmartObject FINAL {
   /**
    * @brief Returns current object converted to array
    *
+   * Returned array may be shared with copies of this object, so it is
+   * read only.
+   *
    * @return SmartArray
    **/
-  SmartArray* asArray() const;
+  const SmartArray* asArray() const;
+
+  /**
+   * @brief Returns current object converted to array
+   *
+   * Unlike const version makes payload private to this object first,
+   * so returned array may be modified.
+   *
+   * @return SmartArray
+   **/
+  SmartArray* asArray();
 
   /**
    * @brief Assignment operator for type: binary
@@ -613,6 +650,17 @@ class SmartObject FINAL {
    **/
   const SmartObject& operator[](const char* Key) const;
 
+  /**
+   * @brief Support of map-like access by interned key
+   *
+   * Interned keys of small maps are compared by pointer.
+   *
+   * @param  Key Key of element to return
+   * @return SmartObject&
+   **/
+  SmartObject& operator[](const InternedKey& Key);
+  const SmartObject& operator[](const InternedKey& Key) const;
+
   /**
    * @brief Get map element.
    *
@@ -625,6 +673,7 @@ class SmartObject FINAL {
    * @return Element of map or null object if element can't be provided.
    **/
   const SmartObject& getElement(const std::string& Key) const;
+  const SmartObject& getElement(const InternedKey& Key) const;
 
   /**
    * @brief Enumerates content of the object when it behaves like a map.
@@ -633,14 +682,16 @@ class SmartObject FINAL {
    **/
   std::set<std::string> enumerate() const;
 
-  SmartMap::iterator map_begin() const {
+  SmartMap::const_iterator map_begin() const {
     DCHECK(m_type == SmartType_Map);
-    return m_data.map_value->begin();
+    return static_cast<const SmartMap*>(m_data.map_value)->begin();
   }
-  SmartMap::iterator map_end() const {
+  SmartMap::const_iterator map_end() const {
     DCHECK(m_type == SmartType_Map);
-    return m_data.map_value->end();
+    return static_cast<const SmartMap*>(m_data.map_value)->end();
   }
+  SmartMap::iterator map_begin();
+  SmartMap::iterator map_end();
 
   /**
    * @brief Checks for key presense when object is behaves like a map
@@ -649,6 +700,8 @@ class SmartObject FINAL {
    * @return bool
    **/
   bool keyExists(const std::string& Key) const;
+  bool keyExists(const char* Key) const;
+  bool keyExists(const InternedKey& Key) const;
 
   /**
    * @brief Removes element from the map.
@@ -934,7 +987,26 @@ class SmartObject FINAL {
    * @param Key Key of element to retrieve
    * @return SmartObject&
    **/
-  inline SmartObject& handle_map_access(const std::string& Key);
+  template <typename KeyType>
+  SmartObject& handle_map_access(const KeyType& Key);
+
+  /**
+   * @brief Returns element of internal map data by it's key
+   *
+   * @param Key Key of element to retrieve
+   * @return Element or invalid object if there is no such element
+   **/
+  template <typename KeyType>
+  const SmartObject& get_map_element(const KeyType& Key) const;
+
+  /**
+   * @brief Checks if internal map data contains key
+   *
+   * @param Key Key to check
+   * @return bool
+   **/
+  template <typename KeyType>
+  bool map_key_exists(const KeyType& Key) const;
 
   /**
    * @brief Converts string to double
@@ -973,6 +1045,24 @@ class SmartObject FINAL {
    **/
   void duplicate(const SmartObject& OtherObject);
 
+  /**
+   * @brief Takes over data and schema of another SmartObject
+   *
+   * Does nothing if other object is Null, same as duplicate().
+   *
+   * @param  OtherObject Object to be moved from, becomes Null
+   * @return void
+   **/
+  void move_from(SmartObject& OtherObject) noexcept;
+
+  /**
+   * @brief Makes map, array or binary payload private to this object
+   * before it is modified or mutable access to it is handed out.
+   *
+   * @return void
+   **/
+  void unshare_data();
+
   /**
    * @brief Cleans up internal data for some types (like string, array or map)
    *
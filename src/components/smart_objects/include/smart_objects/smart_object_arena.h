@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_SMART_OBJECT_ARENA_H_
+#define SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_SMART_OBJECT_ARENA_H_
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "utils/macro.h"
+
+namespace ns_smart_device_link {
+namespace ns_smart_objects {
+
+/**
+ * @brief Monotonic arena for payloads of SmartObjects which share
+ * lifetime of a single message.
+ *
+ * Strings, maps, arrays, binaries and map members are allocated from the
+ * arena installed for the current thread with Scope, or from the heap if
+ * there is no such arena. Arena memory is handed out by bumping a pointer
+ * in a chunk, so decoding a message does not touch the global allocator
+ * for each member.
+ *
+ * Chunk is released when the arena has moved past it and all blocks
+ * allocated from it have been freed, so objects may outlive the arena
+ * and may be destroyed in any thread. Objects copied outside of any
+ * arena scope are allocated from the heap, which is how the parts of
+ * a message stored for longer than the message itself are promoted
+ * out of the arena.
+ *
+ * Allocation is not thread-safe and should be done from the thread
+ * which has installed the arena only, deallocation is thread-safe.
+ */
+class SmartObjectArena {
+ public:
+  /**
+   * @brief Installs arena for the current thread until scope destruction
+   */
+  class Scope {
+   public:
+    /**
+     * @param arena Arena to allocate from, NULL to allocate from the heap
+     */
+    explicit Scope(SmartObjectArena* arena);
+    ~Scope();
+
+   private:
+    SmartObjectArena* previous_;
+
+    DISALLOW_COPY_AND_ASSIGN(Scope);
+  };
+
+  /**
+   * @brief Alignment of each allocated block, same as of ::operator new.
+   * Chunk pointer preceding the block is padded to this size, so block
+   * stays aligned on targets where it exceeds pointer size.
+   */
+  static const size_t kAlignment = alignof(std::max_align_t);
+
+  SmartObjectArena();
+
+  /**
+   * @brief Releases arena's hold on the current chunk.
+   * Chunk memory is kept until all blocks allocated from it are freed.
+   */
+  ~SmartObjectArena();
+
+  /**
+   * @brief Gets arena installed for the current thread
+   * @return Arena or NULL if payloads are allocated from the heap
+   */
+  static SmartObjectArena* Current();
+
+  /**
+   * @brief Allocates block from the current arena or from the heap
+   * @throws std::bad_alloc if memory could not be allocated
+   */
+  static void* Allocate(const size_t size);
+
+  /**
+   * @brief Frees block allocated with Allocate()
+   */
+  static void Deallocate(void* block);
+
+  /**
+   * @brief Checks if block allocated with Allocate() belongs to an arena
+   */
+  static bool IsArenaBlock(const void* block);
+
+  /**
+   * @brief Gets amount of chunks taken from the heap by this arena
+   */
+  size_t chunks_count() const {
+    return chunks_count_;
+  }
+
+ private:
+  struct Chunk;
+
+  void* AllocateBlock(const size_t size);
+  void NewChunk(const size_t size);
+
+  Chunk* chunk_;
+  char* cursor_;
+  char* end_;
+  size_t chunks_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(SmartObjectArena);
+};
+
+/**
+ * @brief Creates object in memory of the current arena
+ */
+template <typename T, typename... Args>
+T* ArenaNew(Args&&... args) {
+  static_assert(alignof(T) <= SmartObjectArena::kAlignment,
+                "Type alignment is not supported by SmartObjectArena");
+  void* block = SmartObjectArena::Allocate(sizeof(T));
+  try {
+    return new (block) T(std::forward<Args>(args)...);
+  } catch (...) {
+    SmartObjectArena::Deallocate(block);
+    throw;
+  }
+}
+
+/**
+ * @brief Destroys object created with ArenaNew()
+ */
+template <typename T>
+void ArenaDelete(T* object) {
+  if (object) {
+    object->~T();
+    SmartObjectArena::Deallocate(object);
+  }
+}
+
+}  // namespace ns_smart_objects
+}  // namespace ns_smart_device_link
+
+#endif  // SRC_COMPONENTS_SMART_OBJECTS_INCLUDE_SMART_OBJECTS_SMART_OBJECT_ARENA_H_
@@ -63,8 +63,12 @@ class CSmartSchema FINAL {
   /**
    * @brief Validate smart object.
    *
+   * Object is validated without report first, so valid objects are checked
+   * without building report tree. Report is filled by second validation
+   * pass only if the first one has failed.
+   *
    * @param Object Object to validate.
-   * @param report object for reporting errors during validation
+   * @param report object for reporting errors during validation, may be NULL
    * @param MessageVersion to check mobile RPC version against RPC Spec History
    * @param allow_unknown_enums
    *   false - unknown enum values (left as string values after applySchema)
@@ -129,11 +133,42 @@ class CSmartSchema FINAL {
   void BuildObjectBySchema(const SmartObject& pattern_object,
                            SmartObject& result_object) const;
 
+  /**
+   * @brief Creates schema resolved for specified message version.
+   *
+   * Resolved schema validates messages of this version and filters their
+   * enums without checking RPC Spec History. Other versions and detailed
+   * validation reports are still handled by the source schema.
+   *
+   * @param MessageVersion Version to resolve schema for.
+   *
+   * @return Resolved schema.
+   */
+  CSmartSchema ResolveVersion(
+      const utils::SemanticVersion& MessageVersion) const;
+
  protected:
+  /**
+   * @brief Gets root schema item to be used for message version.
+   */
+  ISchemaItem* GetVersionSchemaItem(
+      const utils::SemanticVersion& MessageVersion) const;
+
   /**
    * @brief Root schema item.
    */
   ISchemaItemPtr mSchemaItem;
+
+  /**
+   * @brief Root schema item resolved for mResolvedVersion, NULL if schema
+   * has not been resolved.
+   */
+  ISchemaItemPtr mResolvedSchemaItem;
+
+  /**
+   * @brief Version mResolvedSchemaItem is resolved for.
+   */
+  utils::SemanticVersion mResolvedVersion;
 };
 }  // namespace ns_smart_objects
 }  // namespace ns_smart_device_link
@@ -46,7 +46,9 @@ errors::eType CAlwaysFalseSchemaItem::validate(
     rpc::ValidationReport* report,
     const utils::SemanticVersion& MessageVersion,
     const bool allow_unknown_enums) {
-  report->set_validation_info("Generic error");
+  if (report) {
+    report->set_validation_info("Generic error");
+  }
   return errors::ERROR;
 }
 
@@ -58,37 +58,43 @@ errors::eType CArraySchemaItem::validate(
     const utils::SemanticVersion& MessageVersion,
     const bool allow_unknown_enums) {
   if (SmartType_Array != Object.getType()) {
-    std::string validation_info =
-        "Incorrect type, expected: " +
-        SmartObject::typeToString(SmartType_Array) +
-        ", got: " + SmartObject::typeToString(Object.getType());
-    report->set_validation_info(validation_info);
+    if (report) {
+      std::string validation_info =
+          "Incorrect type, expected: " +
+          SmartObject::typeToString(SmartType_Array) +
+          ", got: " + SmartObject::typeToString(Object.getType());
+      report->set_validation_info(validation_info);
+    }
     return errors::INVALID_VALUE;
   }
   size_t sizeLimit;
   const size_t array_len = Object.length();
 
   if (mMinSize.getValue(sizeLimit) && (array_len < sizeLimit)) {
-    std::stringstream stream;
-    stream << "Got array of size: " << array_len
-           << ", minimum allowed: " << sizeLimit;
-    std::string validation_info = stream.str();
-    report->set_validation_info(validation_info);
+    if (report) {
+      std::stringstream stream;
+      stream << "Got array of size: " << array_len
+             << ", minimum allowed: " << sizeLimit;
+      std::string validation_info = stream.str();
+      report->set_validation_info(validation_info);
+    }
     return errors::OUT_OF_RANGE;
   }
   if (mMaxSize.getValue(sizeLimit) && (array_len > sizeLimit)) {
-    std::stringstream stream;
-    stream << "Got array of size: " << array_len
-           << ", maximum allowed: " << sizeLimit;
-    std::string validation_info = stream.str();
-    report->set_validation_info(validation_info);
+    if (report) {
+      std::stringstream stream;
+      stream << "Got array of size: " << array_len
+             << ", maximum allowed: " << sizeLimit;
+      std::string validation_info = stream.str();
+      report->set_validation_info(validation_info);
+    }
     return errors::OUT_OF_RANGE;
   }
 
   for (size_t i = 0u; i < array_len; ++i) {
     const errors::eType result = mElementSchemaItem->validate(
         Object.getElement(i),
-        &report->ReportSubobject(std::to_string(i)),
+        report ? &report->ReportSubobject(std::to_string(i)) : NULL,
         MessageVersion,
         allow_unknown_enums);
     if (errors::OK != result) {
@@ -169,6 +175,20 @@ TypeID CArraySchemaItem::GetType() {
   return TYPE_ARRAY;
 }
 
+ISchemaItem* CArraySchemaItem::GetElementSchemaItem() {
+  return mElementSchemaItem;
+}
+
+ISchemaItemPtr CArraySchemaItem::ResolveVersion(
+    const utils::SemanticVersion& MessageVersion, ResolvedItems& resolved) {
+  const ISchemaItemPtr element =
+      ResolveChildVersion(mElementSchemaItem, MessageVersion, resolved);
+  if (!element) {
+    return ISchemaItemPtr();
+  }
+  return create(element, mMinSize, mMaxSize);
+}
+
 CArraySchemaItem::CArraySchemaItem(ISchemaItem* ElementSchemaItem,
                                    const TSchemaItemParameter<size_t>& MinSize,
                                    const TSchemaItemParameter<size_t>& MaxSize)
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "smart_objects/interned_key.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <set>
+
+#include "utils/lock.h"
+#include "utils/macro.h"
+
+namespace ns_smart_device_link {
+namespace ns_smart_objects {
+
+namespace {
+
+/**
+ * @brief Insert-only open addressing hash table of key names.
+ * Lookups are lock-free, insertions are serialized by lock.
+ */
+class KeyTable {
+ public:
+  static KeyTable& instance() {
+    // Never destroyed, interned keys stay valid until process exit
+    static KeyTable* table = new KeyTable();
+    return *table;
+  }
+
+  const std::string* Find(const char* key, const size_t length) const {
+    for (size_t index = Hash(key, length);; index = (index + 1) & kMask) {
+      const std::string* entry = slots_[index].load(std::memory_order_acquire);
+      if (NULL == entry) {
+        return NULL;
+      }
+      if (entry->size() == length && 0 == memcmp(entry->data(), key, length)) {
+        return entry;
+      }
+    }
+  }
+
+  const std::string* Insert(const std::string& key) {
+    sync_primitives::AutoLock lock(insert_lock_);
+    size_t index = Hash(key.data(), key.size());
+    for (;; index = (index + 1) & kMask) {
+      const std::string* entry = slots_[index].load(std::memory_order_relaxed);
+      if (NULL == entry) {
+        break;
+      }
+      if (*entry == key) {
+        return entry;
+      }
+    }
+    if (size_ >= kMaxSize) {
+      return &*overflow_.insert(key).first;
+    }
+    const std::string* entry = new std::string(key);
+    slots_[index].store(entry, std::memory_order_release);
+    ++size_;
+    return entry;
+  }
+
+ private:
+  enum {
+    kCapacity = 1 << 13,
+    kMask = kCapacity - 1,
+    // Keeps probe sequences short and guarantees empty slot for lookups
+    kMaxSize = kCapacity / 4 * 3
+  };
+
+  KeyTable() : size_(0) {
+    for (size_t i = 0; i < kCapacity; ++i) {
+      slots_[i].store(NULL, std::memory_order_relaxed);
+    }
+  }
+
+  static size_t Hash(const char* key, const size_t length) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+      hash = (hash ^ static_cast<uint8_t>(key[i])) * 16777619u;
+    }
+    return hash & kMask;
+  }
+
+  std::atomic<const std::string*> slots_[kCapacity];
+  size_t size_;
+
+  /**
+   * @brief Keys interned after table is full. Such keys are still unique,
+   * but are not found by Find(), so members are matched by their names
+   */
+  std::set<std::string> overflow_;
+  sync_primitives::Lock insert_lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(KeyTable);
+};
+
+}  // namespace
+
+InternedKey InternedKey::Intern(const std::string& key) {
+  return InternedKey(KeyTable::instance().Insert(key));
+}
+
+InternedKey InternedKey::Find(const char* key, const size_t length) {
+  return InternedKey(KeyTable::instance().Find(key, length));
+}
+
+}  // namespace ns_smart_objects
+}  // namespace ns_smart_device_link
@@ -129,15 +129,20 @@ errors::eType CObjectSchemaItem::validate(
     const utils::SemanticVersion& MessageVersion,
     const bool allow_unknown_enums) {
   if (SmartType_Map != object.getType()) {
-    std::string validation_info =
-        "Incorrect type, expected: " +
-        SmartObject::typeToString(SmartType_Map) +
-        ", got: " + SmartObject::typeToString(object.getType());
-    report->set_validation_info(validation_info);
+    if (report) {
+      std::string validation_info =
+          "Incorrect type, expected: " +
+          SmartObject::typeToString(SmartType_Map) +
+          ", got: " + SmartObject::typeToString(object.getType());
+      report->set_validation_info(validation_info);
+    }
     return errors::INVALID_VALUE;
   }
 
-  std::set<std::string> object_keys = object.enumerate();
+  // Both members and object fields are sorted by key, so they are walked
+  // in lockstep. Fields unknown to the schema are skipped.
+  SmartMap::const_iterator field_it = object.map_begin();
+  const SmartMap::const_iterator fields_end = object.map_end();
 
   for (Members::const_iterator it = mMembers.begin(); it != mMembers.end();
        ++it) {
@@ -145,34 +150,41 @@ errors::eType CObjectSchemaItem::validate(
     const SMember& member = it->second;
     const SMember* correct_member = GetCorrectMember(member, MessageVersion);
 
-    std::set<std::string>::const_iterator key_it = object_keys.find(key);
-    if (object_keys.end() == key_it) {
+    while (fields_end != field_it && field_it->first.compare(key) < 0) {
+      ++field_it;
+    }
+    if (fields_end == field_it || field_it->first != key) {
       if (correct_member && correct_member->mIsMandatory == true &&
           correct_member->mIsRemoved == false) {
-        std::string validation_info = "Missing mandatory parameter: " + key;
-        report->set_validation_info(validation_info);
+        if (report) {
+          std::string validation_info = "Missing mandatory parameter: " + key;
+          report->set_validation_info(validation_info);
+        }
         return errors::MISSING_MANDATORY_PARAMETER;
       } else if (key.compare(msg_params) == 0) {
         // If the message params struct was filtered, that means that the
         // app's version is too low to use the message.
-        std::string validation_info =
-            "Function is not available for SyncMsgVersion " +
-            MessageVersion.toString();
-        report->set_validation_info(validation_info);
+        if (report) {
+          std::string validation_info =
+              "Function is not available for SyncMsgVersion " +
+              MessageVersion.toString();
+          report->set_validation_info(validation_info);
+        }
         return errors::INVALID_VALUE;
       }
       continue;
     }
-    const SmartObject& field = object.getElement(key);
+    const SmartObject& field = field_it->second;
+    ++field_it;
 
     errors::eType result;
     // Check if MessageVersion matches schema version
     if (correct_member) {
-      result =
-          correct_member->mSchemaItem->validate(field,
-                                                &report->ReportSubobject(key),
-                                                MessageVersion,
-                                                allow_unknown_enums);
+      result = correct_member->mSchemaItem->validate(
+          field,
+          report ? &report->ReportSubobject(key) : NULL,
+          MessageVersion,
+          allow_unknown_enums);
     } else {
       result = errors::ERROR;
     }
@@ -180,7 +192,6 @@ errors::eType CObjectSchemaItem::validate(
     if (errors::OK != result) {
       return result;
     }
-    object_keys.erase(key_it);
   }
 
   return errors::OK;
@@ -230,9 +241,11 @@ void CObjectSchemaItem::applySchema(
 
   SmartObject default_value;
 
-  for (const auto& item : mMembers) {
-    const std::string& key = item.first;
-    const SMember& member = item.second;
+  std::vector<InternedKey>::const_iterator key_it = mMemberKeys.begin();
+  for (Members::const_iterator it = mMembers.begin(); it != mMembers.end();
+       ++it, ++key_it) {
+    const InternedKey& key = *key_it;
+    const SMember& member = it->second;
     if (!Object.keyExists(key)) {
       if (member.mSchemaItem->setDefaultValue(default_value)) {
         Object[key] = default_value;
@@ -255,19 +268,27 @@ void CObjectSchemaItem::unapplySchema(SmartObject& Object,
   if (SmartType_Map != Object.getType()) {
     return;
   }
-  for (SmartMap::const_iterator it = Object.map_begin();
-       it != Object.map_end();) {
-    const std::string& key = it->first;
-    // move next to avoid wrong iterator on erase
-    ++it;
-    if (mMembers.end() == mMembers.find(key) && remove_unknown_parameters) {
-      // remove fake params
-      Object.erase(key);
+  if (remove_unknown_parameters) {
+    // SmartMap iterators are invalidated on erase, so fake params are
+    // collected first
+    std::vector<std::string> fake_params;
+    for (SmartMap::const_iterator it = Object.map_begin();
+         it != Object.map_end();
+         ++it) {
+      if (mMembers.end() == mMembers.find(it->first)) {
+        fake_params.push_back(it->first);
+      }
+    }
+    for (std::vector<std::string>::const_iterator it = fake_params.begin();
+         it != fake_params.end();
+         ++it) {
+      Object.erase(*it);
     }
   }
+  std::vector<InternedKey>::const_iterator key_it = mMemberKeys.begin();
   for (Members::const_iterator it = mMembers.begin(); it != mMembers.end();
-       ++it) {
-    const std::string& key = it->first;
+       ++it, ++key_it) {
+    const InternedKey& key = *key_it;
     const SMember& member = it->second;
     if (Object.keyExists(key)) {
       member.mSchemaItem->unapplySchema(Object[key], remove_unknown_parameters);
@@ -280,9 +301,10 @@ void CObjectSchemaItem::BuildObjectBySchema(const SmartObject& pattern_object,
   result_object = SmartObject(SmartType_Map);
   const bool pattern_is_map = SmartType_Map == pattern_object.getType();
 
+  std::vector<InternedKey>::const_iterator key_it = mMemberKeys.begin();
   for (Members::const_iterator it = mMembers.begin(); it != mMembers.end();
-       ++it) {
-    const std::string& key = it->first;
+       ++it, ++key_it) {
+    const InternedKey& key = *key_it;
     const SMember& member = it->second;
     const bool pattern_exists = pattern_is_map && pattern_object.keyExists(key);
     member.mSchemaItem->BuildObjectBySchema(
@@ -312,10 +334,44 @@ boost::optional<SMember&> CObjectSchemaItem::GetMemberSchemaItem(
 void CObjectSchemaItem::AddMemberSchemaItem(const std::string& member_key,
                                             SMember& member) {
   mMembers[member_key] = member;
+  InternMemberKeys();
+}
+
+ISchemaItemPtr CObjectSchemaItem::ResolveVersion(
+    const utils::SemanticVersion& MessageVersion, ResolvedItems& resolved) {
+  Members members;
+  for (Members::const_iterator it = mMembers.begin(); it != mMembers.end();
+       ++it) {
+    const SMember* correct_member =
+        GetCorrectMember(it->second, MessageVersion);
+    // Default member rejects any value
+    SMember member;
+    if (correct_member) {
+      member = *correct_member;
+      member.mSince = boost::none;
+      member.mUntil = boost::none;
+      member.mHistoryVector.clear();
+      const ISchemaItemPtr item =
+          ResolveChildVersion(member.mSchemaItem, MessageVersion, resolved);
+      if (item) {
+        member.mSchemaItem = item.get();
+        member.mSchemaItemShared = item;
+      }
+    } else {
+      member.mIsMandatory = false;
+    }
+    members.insert(std::make_pair(it->first, member));
+  }
+
+  std::shared_ptr<CObjectSchemaItem> result(new CObjectSchemaItem(members));
+  result->mIsVersionResolved = true;
+  return result;
 }
 
 CObjectSchemaItem::CObjectSchemaItem(const Members& members)
-    : mMembers(members) {}
+    : mMembers(members), mIsVersionResolved(false) {
+  InternMemberKeys();
+}
 
 void CObjectSchemaItem::RemoveUnknownParams(
     SmartObject& Object, const utils::SemanticVersion& MessageVersion) {
@@ -337,8 +393,20 @@ void CObjectSchemaItem::RemoveUnknownParams(
   }
 }
 
+void CObjectSchemaItem::InternMemberKeys() {
+  mMemberKeys.clear();
+  mMemberKeys.reserve(mMembers.size());
+  for (Members::const_iterator it = mMembers.begin(); it != mMembers.end();
+       ++it) {
+    mMemberKeys.push_back(InternedKey::Intern(it->first));
+  }
+}
+
 const SMember* CObjectSchemaItem::GetCorrectMember(
     const SMember& member, const utils::SemanticVersion& messageVersion) {
+  if (mIsVersionResolved) {
+    return &member;
+  }
   // Check if member is the correct version
   if (member.CheckHistoryFieldVersion(messageVersion)) {
     return &member;
@@ -65,6 +65,24 @@ void ISchemaItem::applySchema(SmartObject& Object,
 void ISchemaItem::unapplySchema(SmartObject& Object,
                                 const bool remove_unknown_parameters) {}
 
+ISchemaItemPtr ISchemaItem::ResolveVersion(
+    const utils::SemanticVersion& MessageVersion, ResolvedItems& resolved) {
+  return ISchemaItemPtr();
+}
+
+ISchemaItemPtr ISchemaItem::ResolveChildVersion(
+    ISchemaItem* item,
+    const utils::SemanticVersion& MessageVersion,
+    ResolvedItems& resolved) {
+  ResolvedItems::const_iterator it = resolved.find(item);
+  if (resolved.end() != it) {
+    return it->second;
+  }
+  const ISchemaItemPtr result = item->ResolveVersion(MessageVersion, resolved);
+  resolved[item] = result;
+  return result;
+}
+
 void ISchemaItem::BuildObjectBySchema(const SmartObject& pattern_object,
                                       SmartObject& result_object) {}
 
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "smart_objects/smart_map.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+
+#include "smart_objects/smart_object.h"
+#include "smart_objects/smart_object_arena.h"
+
+namespace ns_smart_device_link {
+namespace ns_smart_objects {
+
+namespace {
+/**
+ * @brief Compares keys same way as std::string::compare does
+ */
+int CompareKeys(const std::string& lhs, const char* rhs, const size_t length) {
+  // Keys mostly differ in the first character
+  if (!lhs.empty() && length && lhs[0] != rhs[0]) {
+    return static_cast<uint8_t>(lhs[0]) < static_cast<uint8_t>(rhs[0]) ? -1
+                                                                        : 1;
+  }
+  const size_t common = std::min(lhs.size(), length);
+  const int result = common ? memcmp(lhs.data(), rhs, common) : 0;
+  if (0 != result) {
+    return result;
+  }
+  if (lhs.size() == length) {
+    return 0;
+  }
+  return lhs.size() < length ? -1 : 1;
+}
+}  // namespace
+
+SmartMap::SmartMap() : uninterned_count_(0) {}
+
+SmartMap::SmartMap(const SmartMap& other)
+    : uninterned_count_(other.uninterned_count_) {
+  entries_.reserve(other.entries_.size());
+  try {
+    for (Entries::const_iterator it = other.entries_.begin();
+         it != other.entries_.end();
+         ++it) {
+      Entry entry = {it->key, ArenaNew<value_type>(*it->value)};
+      entries_.push_back(entry);
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+SmartMap& SmartMap::operator=(const SmartMap& other) {
+  if (this != &other) {
+    SmartMap copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+SmartMap::~SmartMap() {
+  clear();
+}
+
+SmartMap::iterator SmartMap::find(const std::string& key) {
+  return MakeIterator(FindKey(key.data(), key.size()));
+}
+
+SmartMap::const_iterator SmartMap::find(const std::string& key) const {
+  return const_iterator(FindKey(key.data(), key.size()));
+}
+
+SmartMap::iterator SmartMap::find(const char* key) {
+  return MakeIterator(FindKey(key, strlen(key)));
+}
+
+SmartMap::const_iterator SmartMap::find(const char* key) const {
+  return const_iterator(FindKey(key, strlen(key)));
+}
+
+SmartMap::iterator SmartMap::find(const InternedKey& key) {
+  return MakeIterator(FindInterned(key));
+}
+
+SmartMap::const_iterator SmartMap::find(const InternedKey& key) const {
+  return const_iterator(FindInterned(key));
+}
+
+SmartObject& SmartMap::operator[](const std::string& key) {
+  return Insert(key.data(), key.size(), InternedKey());
+}
+
+SmartObject& SmartMap::operator[](const char* key) {
+  return Insert(key, strlen(key), InternedKey());
+}
+
+SmartObject& SmartMap::operator[](const InternedKey& key) {
+  if (key.empty()) {
+    return Insert("", 0, InternedKey());
+  }
+  const Entries::const_iterator it = FindInterned(key);
+  if (entries_.end() != it) {
+    return it->value->second;
+  }
+  return Insert(key.str().data(), key.str().size(), key);
+}
+
+SmartMap::size_type SmartMap::erase(const std::string& key) {
+  const Entries::const_iterator it = FindKey(key.data(), key.size());
+  if (entries_.end() == it) {
+    return 0;
+  }
+  erase(MakeIterator(it));
+  return 1;
+}
+
+SmartMap::iterator SmartMap::erase(iterator position) {
+  value_type* value = position.base()->value;
+  if (position.base()->key.empty()) {
+    --uninterned_count_;
+  }
+  const iterator result(entries_.erase(position.base()));
+  ArenaDelete(value);
+  return result;
+}
+
+void SmartMap::clear() {
+  for (Entries::iterator it = entries_.begin(); it != entries_.end(); ++it) {
+    ArenaDelete(it->value);
+  }
+  entries_.clear();
+  uninterned_count_ = 0;
+}
+
+void SmartMap::swap(SmartMap& other) {
+  entries_.swap(other.entries_);
+  std::swap(uninterned_count_, other.uninterned_count_);
+}
+
+SmartMap::Entries::const_iterator SmartMap::LowerBound(
+    const char* key, const size_t length) const {
+  Entries::const_iterator first = entries_.begin();
+  size_t count = entries_.size();
+  while (count > 0) {
+    const size_t step = count / 2;
+    const Entries::const_iterator middle = first + step;
+    if (CompareKeys(middle->value->first, key, length) < 0) {
+      first = middle + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return first;
+}
+
+SmartMap::Entries::const_iterator SmartMap::FindKey(
+    const char* key, const size_t length) const {
+  const Entries::const_iterator it = LowerBound(key, length);
+  if (entries_.end() != it &&
+      0 == CompareKeys(it->value->first, key, length)) {
+    return it;
+  }
+  return entries_.end();
+}
+
+SmartMap::Entries::const_iterator SmartMap::FindInterned(
+    const InternedKey& key) const {
+  if (key.empty()) {
+    return entries_.end();
+  }
+  if (entries_.size() <= kLinearSearchLimit) {
+    for (Entries::const_iterator it = entries_.begin(); it != entries_.end();
+         ++it) {
+      if (it->key == key) {
+        return it;
+      }
+    }
+    // Members added before key has been interned may still match it
+    if (0 == uninterned_count_) {
+      return entries_.end();
+    }
+  }
+  return FindKey(key.str().data(), key.str().size());
+}
+
+SmartObject& SmartMap::Insert(const char* key,
+                              const size_t length,
+                              const InternedKey& interned) {
+  const Entries::const_iterator it = LowerBound(key, length);
+  if (entries_.end() != it &&
+      0 == CompareKeys(it->value->first, key, length)) {
+    return it->value->second;
+  }
+  Entry entry = {interned.empty() ? InternedKey::Find(key, length) : interned,
+                 NULL};
+  entry.value =
+      ArenaNew<value_type>(std::string(key, length), SmartObject());
+  const Entries::iterator position =
+      entries_.begin() + (it - entries_.begin());
+  try {
+    entries_.insert(position, entry);
+  } catch (...) {
+    ArenaDelete(entry.value);
+    throw;
+  }
+  if (entry.key.empty()) {
+    ++uninterned_count_;
+  }
+  return entry.value->second;
+}
+
+}  // namespace ns_smart_objects
+}  // namespace ns_smart_device_link
@@ -36,11 +36,14 @@
 #include <inttypes.h>
 #include <stdlib.h>
 #include <algorithm>
+#include <atomic>
 #include <iomanip>
 #include <iterator>
 #include <limits>
 #include <sstream>
 
+#include "smart_objects/smart_object_arena.h"
+
 namespace ns_smart_device_link {
 namespace ns_smart_objects {
 
@@ -49,6 +52,101 @@ namespace ns_smart_objects {
  **/
 static const char* invalid_cstr_value = "";
 
+namespace {
+
+#ifdef SMART_OBJECTS_COW
+/**
+ * @brief Map, array or binary payload with reference counter.
+ * Payload is allocated as a whole, SmartObject keeps pointer to its
+ * container part.
+ */
+template <typename Container>
+class SharedPayload : public Container {
+ public:
+  SharedPayload() : refs_(1), shareable_(true) {}
+  explicit SharedPayload(const Container& other)
+      : Container(other), refs_(1), shareable_(true) {}
+
+  std::atomic<uint32_t> refs_;
+  /**
+   * @brief False once mutable access to the payload has been handed out
+   */
+  std::atomic<bool> shareable_;
+};
+
+template <typename Container>
+SharedPayload<Container>* AsShared(Container* payload) {
+  return static_cast<SharedPayload<Container>*>(payload);
+}
+
+template <typename Container>
+Container* CreatePayload() {
+  return ArenaNew<SharedPayload<Container> >();
+}
+
+template <typename Container>
+Container* CopyPayload(Container* payload) {
+  SharedPayload<Container>* shared = AsShared(payload);
+  // Sharing arena payload with heap object would pin the arena memory,
+  // so such payload is copied to promote it out of the arena
+  const bool promote = !SmartObjectArena::Current() &&
+                       SmartObjectArena::IsArenaBlock(shared);
+  if (!promote && shared->shareable_.load(std::memory_order_acquire)) {
+    shared->refs_.fetch_add(1, std::memory_order_relaxed);
+    return payload;
+  }
+  return ArenaNew<SharedPayload<Container> >(*payload);
+}
+
+template <typename Container>
+void ReleasePayload(Container* payload) {
+  SharedPayload<Container>* shared = AsShared(payload);
+  if (1 == shared->refs_.fetch_sub(1, std::memory_order_acq_rel)) {
+    ArenaDelete(shared);
+  }
+}
+
+template <typename Container>
+Container* UnsharePayload(Container* payload) {
+  if (1 != AsShared(payload)->refs_.load(std::memory_order_acquire)) {
+    Container* copy = ArenaNew<SharedPayload<Container> >(*payload);
+    ReleasePayload(payload);
+    payload = copy;
+  }
+  AsShared(payload)->shareable_.store(false, std::memory_order_release);
+  return payload;
+}
+#else
+template <typename Container>
+Container* CreatePayload() {
+  return ArenaNew<Container>();
+}
+
+template <typename Container>
+Container* CopyPayload(Container* payload) {
+  return ArenaNew<Container>(*payload);
+}
+
+template <typename Container>
+void ReleasePayload(Container* payload) {
+  ArenaDelete(payload);
+}
+
+template <typename Container>
+Container* UnsharePayload(Container* payload) {
+  return payload;
+}
+#endif  // SMART_OBJECTS_COW
+
+template <typename Container>
+Container* CreatePayload(const Container& value) {
+  Container* payload = CreatePayload<Container>();
+  *payload = value;
+  return payload;
+}
+
+}  // namespace
+
 SmartObject::SmartObject() : m_type(SmartType_Null), m_schema() {
   m_data.str_value = NULL;
 }
@@ -59,6 +157,12 @@ SmartObject::SmartObject(const SmartObject& Other)
   duplicate(Other);
 }
 
+SmartObject::SmartObject(SmartObject&& Other) noexcept
+    : m_type(SmartType_Null), m_schema() {
+  m_data.str_value = NULL;
+  move_from(Other);
+}
+
 SmartObject::SmartObject(SmartType Type) : m_type(SmartType_Null), m_schema() {
   switch (Type) {
     case SmartType_Null:
@@ -82,11 +186,11 @@ SmartObject::SmartObject(SmartType Type) : m_type(SmartType_Null), m_schema() {
       set_value_string(custom_str::CustomString());
       break;
     case SmartType_Map:
-      m_data.map_value = new SmartMap();
+      m_data.map_value = CreatePayload<SmartMap>();
       m_type = SmartType_Map;
       break;
     case SmartType_Array:
-      m_data.array_value = new SmartArray();
+      m_data.array_value = CreatePayload<SmartArray>();
       m_type = SmartType_Array;
       break;
     case SmartType_Binary:
@@ -111,6 +215,12 @@ SmartObject& SmartObject::operator=(const SmartObject& Other) {
   return *this;
 }
 
+SmartObject& SmartObject::operator=(SmartObject&& Other) noexcept {
+  if (this != &Other)
+    move_from(Other);
+  return *this;
+}
+
 bool SmartObject::operator==(const SmartObject& Other) const {
   if (m_type != Other.m_type)
     return false;
@@ -471,7 +581,7 @@ bool SmartObject::operator==(const std::string& Value) const {
 
 void SmartObject::set_value_string(const custom_str::CustomString& NewValue) {
   set_new_type(SmartType_String);
-  m_data.str_value = new custom_str::CustomString(NewValue);
+  m_data.str_value = ArenaNew<custom_str::CustomString>(NewValue);
 }
 
 std::string SmartObject::convert_string() const {
@@ -546,13 +656,21 @@ SmartBinary SmartObject::asBinary() const {
   return convert_binary();
 }
 
-SmartArray* SmartObject::asArray() const {
+const SmartArray* SmartObject::asArray() const {
   if (m_type != SmartType_Array) {
     return NULL;
   }
   return m_data.array_value;
 }
 
+SmartArray* SmartObject::asArray() {
+  if (m_type != SmartType_Array) {
+    return NULL;
+  }
+  unshare_data();
+  return m_data.array_value;
+}
+
 SmartObject& SmartObject::operator=(const SmartBinary& NewValue) {
   if (m_type != SmartType_Invalid) {
     set_value_binary(NewValue);
@@ -572,7 +690,7 @@ bool SmartObject::operator==(const SmartBinary& Value) const {
 
 void SmartObject::set_value_binary(const SmartBinary& NewValue) {
   set_new_type(SmartType_Binary);
-  m_data.binary_value = new SmartBinary(NewValue);
+  m_data.binary_value = CreatePayload(NewValue);
 }
 
 SmartBinary SmartObject::convert_binary() const {
@@ -605,8 +723,9 @@ inline SmartObject& SmartObject::handle_array_access(const int32_t Index) {
   if (m_type != SmartType_Array) {
     cleanup_data();
     m_type = SmartType_Array;
-    m_data.array_value = new SmartArray();
+    m_data.array_value = CreatePayload<SmartArray>();
   }
+  unshare_data();
   SmartArray& array = *m_data.array_value;
   if (Index == -1 || static_cast<size_t>(Index) == array.size()) {
     array.push_back(SmartObject());
@@ -633,19 +752,27 @@ const SmartObject& SmartObject::operator[](const std::string& Key) const {
 }
 
 SmartObject& SmartObject::operator[](char* Key) {
-  return handle_map_access(std::string(Key));
+  return handle_map_access(static_cast<const char*>(Key));
 }
 
 const SmartObject& SmartObject::operator[](char* Key) const {
-  return getElement(std::string(Key));
+  return get_map_element(static_cast<const char*>(Key));
 }
 
 SmartObject& SmartObject::operator[](const char* Key) {
-  return handle_map_access(std::string(Key));
+  return handle_map_access(Key);
 }
 
 const SmartObject& SmartObject::operator[](const char* Key) const {
-  return getElement(std::string(Key));
+  return get_map_element(Key);
+}
+
+SmartObject& SmartObject::operator[](const InternedKey& Key) {
+  return handle_map_access(Key);
+}
+
+const SmartObject& SmartObject::operator[](const InternedKey& Key) const {
+  return get_map_element(Key);
 }
 
 const SmartObject& SmartObject::getElement(size_t Index) const {
@@ -658,16 +785,36 @@ const SmartObject& SmartObject::getElement(size_t Index) const {
 }
 
 const SmartObject& SmartObject::getElement(const std::string& Key) const {
+  return get_map_element(Key);
+}
+
+const SmartObject& SmartObject::getElement(const InternedKey& Key) const {
+  return get_map_element(Key);
+}
+
+template <typename KeyType>
+const SmartObject& SmartObject::get_map_element(const KeyType& Key) const {
   if (SmartType_Map == m_type) {
-    SmartMap::const_iterator it = m_data.map_value->find(Key);
-    if (it != m_data.map_value->end()) {
+    const SmartMap& map = *m_data.map_value;
+    SmartMap::const_iterator it = map.find(Key);
+    if (it != map.end()) {
       return it->second;
     }
   }
   return invalid_object_value;
 }
 
-SmartObject& SmartObject::handle_map_access(const std::string& Key) {
+template <typename KeyType>
+bool SmartObject::map_key_exists(const KeyType& Key) const {
+  if (m_type != SmartType_Map) {
+    return false;
+  }
+  const SmartMap& map = *m_data.map_value;
+  return map.find(Key) != map.end();
+}
+
+template <typename KeyType>
+SmartObject& SmartObject::handle_map_access(const KeyType& Key) {
   if (m_type == SmartType_Invalid) {
     return *this;
   }
@@ -675,8 +822,9 @@ SmartObject& SmartObject::handle_map_access(const std::string& Key) {
   if (m_type != SmartType_Map) {
     cleanup_data();
     m_type = SmartType_Map;
-    m_data.map_value = new SmartMap();
+    m_data.map_value = CreatePayload<SmartMap>();
   }
+  unshare_data();
   SmartMap& map = *m_data.map_value;
 
   return map[Key];
@@ -692,10 +840,10 @@ void SmartObject::duplicate(const SmartObject& OtherObject) {
     case SmartType_Null:  // on duplicate empty SmartObject
       return;
     case SmartType_Map:
-      newData.map_value = new SmartMap(*OtherObject.m_data.map_value);
+      newData.map_value = CopyPayload(OtherObject.m_data.map_value);
       break;
     case SmartType_Array:
-      newData.array_value = new SmartArray(*OtherObject.m_data.array_value);
+      newData.array_value = CopyPayload(OtherObject.m_data.array_value);
       break;
     case SmartType_Integer:
       newData.int_value = OtherObject.m_data.int_value;
@@ -713,11 +861,11 @@ void SmartObject::duplicate(const SmartObject& OtherObject) {
       newData.char_value = OtherObject.m_data.char_value;
       break;
     case SmartType_String:
-      newData.str_value =
-          new custom_str::CustomString(*OtherObject.m_data.str_value);
+      newData.str_value = ArenaNew<custom_str::CustomString>(
+          *OtherObject.m_data.str_value);
       break;
     case SmartType_Binary:
-      newData.binary_value = new SmartBinary(*OtherObject.m_data.binary_value);
+      newData.binary_value = CopyPayload(OtherObject.m_data.binary_value);
       break;
     default:
       DCHECK(!"Unhandled smart object type");
@@ -731,32 +879,61 @@ void SmartObject::duplicate(const SmartObject& OtherObject) {
   m_data = newData;
 }
 
+void SmartObject::move_from(SmartObject& OtherObject) noexcept {
+  if (SmartType_Null == OtherObject.m_type) {
+    return;
+  }
+  cleanup_data();
+  std::swap(m_schema, OtherObject.m_schema);
+
+  m_type = OtherObject.m_type;
+  m_data = OtherObject.m_data;
+  OtherObject.m_type = SmartType_Null;
+  OtherObject.m_data.str_value = NULL;
+}
+
+void SmartObject::unshare_data() {
+  switch (m_type) {
+    case SmartType_Map:
+      m_data.map_value = UnsharePayload(m_data.map_value);
+      break;
+    case SmartType_Array:
+      m_data.array_value = UnsharePayload(m_data.array_value);
+      break;
+    case SmartType_Binary:
+      m_data.binary_value = UnsharePayload(m_data.binary_value);
+      break;
+    default:
+      break;
+  }
+}
+
 void SmartObject::cleanup_data() {
   switch (m_type) {
     case SmartType_String:
       if (m_data.str_value) {
-        delete m_data.str_value;
+        ArenaDelete(m_data.str_value);
         m_data.str_value = nullptr;
         m_type = SmartType_Null;
       }
       break;
     case SmartType_Map:
       if (m_data.map_value) {
-        delete m_data.map_value;
+        ReleasePayload(m_data.map_value);
         m_data.map_value = nullptr;
         m_type = SmartType_Null;
       }
       break;
     case SmartType_Array:
       if (m_data.array_value) {
-        delete m_data.array_value;
+        ReleasePayload(m_data.array_value);
         m_data.array_value = nullptr;
         m_type = SmartType_Null;
       }
       break;
     case SmartType_Binary:
       if (m_data.binary_value) {
-        delete m_data.binary_value;
+        ReleasePayload(m_data.binary_value);
         m_data.binary_value = nullptr;
         m_type = SmartType_Null;
       }
@@ -872,23 +1049,40 @@ std::set<std::string> SmartObject::enumerate() const {
   return keys;
 }
 
+SmartMap::iterator SmartObject::map_begin() {
+  DCHECK(m_type == SmartType_Map);
+  unshare_data();
+  return m_data.map_value->begin();
+}
+
+SmartMap::iterator SmartObject::map_end() {
+  DCHECK(m_type == SmartType_Map);
+  unshare_data();
+  return m_data.map_value->end();
+}
+
 bool SmartObject::keyExists(const std::string& Key) const {
-  if (m_type != SmartType_Map) {
-    return false;
-  }
-  return m_data.map_value->find(Key) != m_data.map_value->end();
+  return map_key_exists(Key);
+}
+
+bool SmartObject::keyExists(const char* Key) const {
+  return map_key_exists(Key);
+}
+
+bool SmartObject::keyExists(const InternedKey& Key) const {
+  return map_key_exists(Key);
 }
 
 bool SmartObject::erase(const std::string& Key) {
-  if (m_type != SmartType_Map) {
+  if (!keyExists(Key)) {
     return false;
   }
+  unshare_data();
   return (m_data.map_value->erase(Key) > 0);
 }
 
 bool SmartObject::isValid() const {
-  rpc::ValidationReport report("RPC");
-  return (errors::OK == m_schema.validate(*this, &report));
+  return (errors::OK == m_schema.validate(*this, NULL));
 }
 
 errors::eType SmartObject::validate(
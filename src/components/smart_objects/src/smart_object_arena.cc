@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "smart_objects/smart_object_arena.h"
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+
+namespace ns_smart_device_link {
+namespace ns_smart_objects {
+
+namespace {
+/**
+ * @brief Chunk size doubles for each new chunk of arena
+ * until it reaches kFirstChunkSize << kChunkSizeSteps
+ */
+const size_t kFirstChunkSize = 4096;
+const size_t kChunkSizeSteps = 4;
+
+/**
+ * @brief Value chunk counter starts from, so counter stays positive
+ * until arena has moved past the chunk and reported amount of its blocks
+ */
+const int64_t kChunkBias = INT64_C(1) << 62;
+
+thread_local SmartObjectArena* current_arena = NULL;
+
+size_t AlignUp(const size_t size) {
+  return (size + SmartObjectArena::kAlignment - 1) &
+         ~(SmartObjectArena::kAlignment - 1);
+}
+}  // namespace
+
+/**
+ * @brief Arena chunk, blocks follow the chunk header.
+ * Every block is preceded by pointer to its chunk, NULL for heap blocks.
+ */
+struct SmartObjectArena::Chunk {
+  Chunk() : pending_(kChunkBias), blocks_(0) {}
+
+  /**
+   * @brief Decrements counter and frees the chunk once it reaches zero
+   */
+  void Release(const int64_t count) {
+    if (count == pending_.fetch_sub(count, std::memory_order_acq_rel)) {
+      this->~Chunk();
+      ::operator delete(this);
+    }
+  }
+
+  /**
+   * @brief kChunkBias minus blocks freed so far
+   */
+  std::atomic<int64_t> pending_;
+
+  /**
+   * @brief Blocks allocated from the chunk, accessed by arena thread only
+   */
+  int64_t blocks_;
+};
+
+SmartObjectArena::Scope::Scope(SmartObjectArena* arena)
+    : previous_(current_arena) {
+  current_arena = arena;
+}
+
+SmartObjectArena::Scope::~Scope() {
+  current_arena = previous_;
+}
+
+SmartObjectArena::SmartObjectArena()
+    : chunk_(NULL), cursor_(NULL), end_(NULL), chunks_count_(0) {}
+
+SmartObjectArena::~SmartObjectArena() {
+  if (chunk_) {
+    chunk_->Release(kChunkBias - chunk_->blocks_);
+  }
+}
+
+SmartObjectArena* SmartObjectArena::Current() {
+  return current_arena;
+}
+
+void* SmartObjectArena::Allocate(const size_t size) {
+  if (current_arena) {
+    return current_arena->AllocateBlock(AlignUp(size) + kAlignment);
+  }
+  void* block = ::operator new(kAlignment + size);
+  *static_cast<Chunk**>(block) = NULL;
+  return static_cast<char*>(block) + kAlignment;
+}
+
+void SmartObjectArena::Deallocate(void* block) {
+  if (!block) {
+    return;
+  }
+  Chunk** header =
+      reinterpret_cast<Chunk**>(static_cast<char*>(block) - kAlignment);
+  if (*header) {
+    (*header)->Release(1);
+    return;
+  }
+  ::operator delete(header);
+}
+
+bool SmartObjectArena::IsArenaBlock(const void* block) {
+  return NULL != *reinterpret_cast<Chunk* const*>(
+                     static_cast<const char*>(block) - kAlignment);
+}
+
+void* SmartObjectArena::AllocateBlock(const size_t size) {
+  if (static_cast<size_t>(end_ - cursor_) < size) {
+    NewChunk(size);
+  }
+  char* block = cursor_;
+  cursor_ += size;
+  ++chunk_->blocks_;
+  *reinterpret_cast<Chunk**>(block) = chunk_;
+  return block + kAlignment;
+}
+
+void SmartObjectArena::NewChunk(const size_t size) {
+  const size_t header_size = AlignUp(sizeof(Chunk));
+  size_t chunk_size =
+      kFirstChunkSize << std::min(chunks_count_, kChunkSizeSteps);
+  if (chunk_size < header_size + size) {
+    chunk_size = header_size + size;
+  }
+  char* memory = static_cast<char*>(::operator new(chunk_size));
+  if (chunk_) {
+    chunk_->Release(kChunkBias - chunk_->blocks_);
+  }
+  chunk_ = new (memory) Chunk();
+  cursor_ = memory + header_size;
+  end_ = memory + chunk_size;
+  ++chunks_count_;
+}
+
+}  // namespace ns_smart_objects
+}  // namespace ns_smart_device_link
@@ -35,7 +35,18 @@
 namespace ns_smart_device_link {
 namespace ns_smart_objects {
 
-CSmartSchema::CSmartSchema() : mSchemaItem(CAlwaysTrueSchemaItem::create()) {}
+namespace {
+/**
+ * @brief Schema item of objects without schema. Item has no state, so
+ * single instance is shared to keep SmartObject construction allocation-free.
+ */
+const ISchemaItemPtr& DefaultSchemaItem() {
+  static const ISchemaItemPtr item = CAlwaysTrueSchemaItem::create();
+  return item;
+}
+}  // namespace
+
+CSmartSchema::CSmartSchema() : mSchemaItem(DefaultSchemaItem()) {}
 
 CSmartSchema::CSmartSchema(const ISchemaItemPtr SchemaItem)
     : mSchemaItem(SchemaItem) {}
@@ -45,12 +56,18 @@ errors::eType CSmartSchema::validate(
     rpc::ValidationReport* report,
     const utils::SemanticVersion& MessageVersion,
     const bool allow_unknown_enums) const {
+  const errors::eType result = GetVersionSchemaItem(MessageVersion)->validate(
+      object, NULL, MessageVersion, allow_unknown_enums);
+  if (errors::OK == result || NULL == report) {
+    return result;
+  }
   return mSchemaItem->validate(
       object, report, MessageVersion, allow_unknown_enums);
 }
 
 void CSmartSchema::setSchemaItem(const ISchemaItemPtr schemaItem) {
   mSchemaItem = schemaItem;
+  mResolvedSchemaItem.reset();
 }
 
 ISchemaItemPtr CSmartSchema::getSchemaItem() {
@@ -67,7 +84,8 @@ void CSmartSchema::applySchema(SmartObject& Object,
     if (!report) {
       report = &dummy_report;
     }
-    mSchemaItem->filterInvalidEnums(Object, MessageVersion, report);
+    GetVersionSchemaItem(MessageVersion)
+        ->filterInvalidEnums(Object, MessageVersion, report);
   }
 }
 
@@ -81,5 +99,26 @@ void CSmartSchema::BuildObjectBySchema(const SmartObject& pattern_object,
   mSchemaItem->BuildObjectBySchema(pattern_object, result_object);
 }
 
+CSmartSchema CSmartSchema::ResolveVersion(
+    const utils::SemanticVersion& MessageVersion) const {
+  CSmartSchema result(mSchemaItem);
+  ISchemaItem::ResolvedItems resolved;
+  result.mResolvedSchemaItem =
+      mSchemaItem->ResolveVersion(MessageVersion, resolved);
+  if (!result.mResolvedSchemaItem) {
+    result.mResolvedSchemaItem = mSchemaItem;
+  }
+  result.mResolvedVersion = MessageVersion;
+  return result;
+}
+
+ISchemaItem* CSmartSchema::GetVersionSchemaItem(
+    const utils::SemanticVersion& MessageVersion) const {
+  if (mResolvedSchemaItem && mResolvedVersion == MessageVersion) {
+    return mResolvedSchemaItem.get();
+  }
+  return mSchemaItem.get();
+}
+
 }  // namespace ns_smart_objects
 }  // namespace ns_smart_device_link
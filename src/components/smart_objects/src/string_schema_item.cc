@@ -52,31 +52,38 @@ errors::eType CStringSchemaItem::validate(
     const utils::SemanticVersion& MessageVersion,
     const bool allow_unknown_enums) {
   if (SmartType_String != Object.getType()) {
-    std::string validation_info =
-        "Incorrect type, expected: " +
-        SmartObject::typeToString(SmartType_String) +
-        ", got: " + SmartObject::typeToString(Object.getType());
-    report->set_validation_info(validation_info);
+    if (report) {
+      std::string validation_info =
+          "Incorrect type, expected: " +
+          SmartObject::typeToString(SmartType_String) +
+          ", got: " + SmartObject::typeToString(Object.getType());
+      report->set_validation_info(validation_info);
+    }
     return errors::INVALID_VALUE;
   }
 
-  const custom_str::CustomString value = Object.asCustomString();
+  // Amount of characters, same as CustomString::size() but without a copy
+  const size_t value_length = Object.length();
   size_t length;
 
-  if (mMinLength.getValue(length) && (value.size() < length)) {
-    std::stringstream stream;
-    stream << "Got string of size: " << value.size()
-           << ", minimum allowed: " << length;
-    std::string validation_info = stream.str();
-    report->set_validation_info(validation_info);
+  if (mMinLength.getValue(length) && (value_length < length)) {
+    if (report) {
+      std::stringstream stream;
+      stream << "Got string of size: " << value_length
+             << ", minimum allowed: " << length;
+      std::string validation_info = stream.str();
+      report->set_validation_info(validation_info);
+    }
     return errors::OUT_OF_RANGE;
   }
-  if (mMaxLength.getValue(length) && (value.size() > length)) {
-    std::stringstream stream;
-    stream << "Got string of size: " << value.size()
-           << ", maximum allowed: " << length;
-    std::string validation_info = stream.str();
-    report->set_validation_info(validation_info);
+  if (mMaxLength.getValue(length) && (value_length > length)) {
+    if (report) {
+      std::stringstream stream;
+      stream << "Got string of size: " << value_length
+             << ", maximum allowed: " << length;
+      std::string validation_info = stream.str();
+      report->set_validation_info(validation_info);
+    }
     return errors::OUT_OF_RANGE;
   }
   return errors::OK;
@@ -531,6 +531,9 @@ template <>
 const EnumConverter::CStringToEnumMap EnumConverter::cstring_to_enum_map_ =
     EnumConverter::InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* EnumConverter::hash_tables_ = NULL;
+
 template <>
 const char* const EnumConverter::cstring_values_[] = {
     "Value0", "Value1", "Value2"};
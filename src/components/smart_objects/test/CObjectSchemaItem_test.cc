@@ -623,6 +623,84 @@ TEST_F(ObjectSchemaItemTest, filter_unknown_enums_mandatory_subparam) {
   EXPECT_EQ(std::string(""), rpc::PrettyFormat(report));
 }
 
+TEST_F(ObjectSchemaItemTest, resolved_schema_same_result_as_source) {
+  const CSmartSchema schema(schema_item);
+
+  SmartObject obj;
+  obj[S_PARAMS][S_FUNCTION_ID] = 0;
+  obj[S_PARAMS][S_CORRELATION_ID] = 0XFF0;
+  obj[S_PARAMS][S_PROTOCOL_VERSION] = 1;
+  obj[S_MSG_PARAMS][Keys::RESULT_CODE] = 0;
+  obj[S_MSG_PARAMS][Keys::INFO] = "0123456789";
+
+  SmartObject obj_with_fake_param = obj;
+  obj_with_fake_param[S_MSG_PARAMS]["fakeParam"][0] = "value";
+
+  const utils::SemanticVersion versions[] = {utils::SemanticVersion(3, 0, 0),
+                                             utils::SemanticVersion(4, 5, 0),
+                                             utils::SemanticVersion(6, 0, 0)};
+  const SmartObject* objects[] = {&obj, &obj_with_fake_param};
+
+  for (size_t i = 0; i < sizeof(versions) / sizeof(versions[0]); ++i) {
+    const CSmartSchema resolved = schema.ResolveVersion(versions[i]);
+    for (size_t j = 0; j < sizeof(objects) / sizeof(objects[0]); ++j) {
+      rpc::ValidationReport source_report("RPC");
+      rpc::ValidationReport resolved_report("RPC");
+      EXPECT_EQ(schema.validate(*objects[j], &source_report, versions[i]),
+                resolved.validate(*objects[j], &resolved_report, versions[i]));
+      EXPECT_EQ(rpc::PrettyFormat(source_report),
+                rpc::PrettyFormat(resolved_report));
+    }
+  }
+
+  rpc::ValidationReport report("RPC");
+  EXPECT_EQ(errors::MISSING_MANDATORY_PARAMETER,
+            schema.ResolveVersion(utils::SemanticVersion(3, 0, 0))
+                .validate(obj, &report, utils::SemanticVersion(3, 0, 0)));
+  EXPECT_EQ(errors::OK,
+            schema.ResolveVersion(utils::SemanticVersion(4, 5, 0))
+                .validate(obj, &report, utils::SemanticVersion(4, 5, 0)));
+}
+
+TEST(ResolvedSchemaTest, EnumElementRemovedInVersion_Rejected) {
+  std::set<FunctionID::eType> function_values;
+  function_values.insert(FunctionID::Function0);
+  function_values.insert(FunctionID::Function1);
+  std::map<FunctionID::eType, std::vector<ElementSignature> > signatures;
+  signatures[FunctionID::Function1].push_back(
+      ElementSignature("5.0.0", "", true));
+  signatures[FunctionID::Function1].push_back(
+      ElementSignature("1.0.0", "5.0.0", false));
+
+  Members members;
+  members[Keys::OPTIONAL_PARAM] =
+      SMember(TEnumSchemaItem<FunctionID::eType>::createWithSignatures(
+                  function_values, signatures),
+              false);
+  const CSmartSchema schema(CObjectSchemaItem::create(members));
+
+  SmartObject obj(SmartType_Map);
+  obj[Keys::OPTIONAL_PARAM] = FunctionID::Function1;
+
+  const utils::SemanticVersion old_version(4, 0, 0);
+  rpc::ValidationReport report("RPC");
+  EXPECT_EQ(errors::OK,
+            schema.ResolveVersion(old_version)
+                .validate(obj, &report, old_version));
+
+  const utils::SemanticVersion new_version(5, 0, 0);
+  const CSmartSchema resolved = schema.ResolveVersion(new_version);
+  EXPECT_EQ(errors::OUT_OF_RANGE, resolved.validate(obj, &report, new_version));
+  // Report is built by source schema, so it still explains the reason
+  EXPECT_THAT(rpc::PrettyFormat(report),
+              ::testing::HasSubstr("removed for SyncMsgVersion 5.0.0"));
+
+  // Removed element is filtered out when schema is applied for the version
+  CSmartSchema applied = resolved;
+  applied.applySchema(obj, true, new_version);
+  EXPECT_FALSE(obj.keyExists(Keys::OPTIONAL_PARAM));
+}
+
 }  // namespace smart_object_test
 }  // namespace components
 }  // namespace test
@@ -643,6 +721,9 @@ const FunctionConverter::CStringToEnumMap
     FunctionConverter::cstring_to_enum_map_ =
         FunctionConverter::InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* FunctionConverter::hash_tables_ = NULL;
+
 template <>
 const char* const FunctionConverter::cstring_values_[] = {"Function0",
                                                           "Function1",
@@ -677,6 +758,9 @@ const ResultTypeConverter::CStringToEnumMap
     ResultTypeConverter::cstring_to_enum_map_ =
         ResultTypeConverter::InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* ResultTypeConverter::hash_tables_ = NULL;
+
 template <>
 const char* const ResultTypeConverter::cstring_values_[] = {
     "APPLICATION_NOT_REGISTERED",
@@ -254,6 +254,11 @@ const EnumConversionHelper<test::components::SmartObjects::SchemaItem::
         EnumConversionHelper<test::components::SmartObjects::SchemaItem::
                                  TestType::eType>::InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* EnumConversionHelper<
+    test::components::SmartObjects::SchemaItem::TestType::eType>::hash_tables_ =
+        NULL;
+
 template <>
 const char* const EnumConversionHelper<
     test::components::SmartObjects::SchemaItem::TestType::eType>::
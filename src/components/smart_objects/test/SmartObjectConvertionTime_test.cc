@@ -568,6 +568,11 @@ const EnumConversionHelper<test::components::SmartObjects::
             test::components::SmartObjects::SmartObjectConvertionTimeTest::
                 TestType::eType>::InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* EnumConversionHelper<
+    test::components::SmartObjects::SmartObjectConvertionTimeTest::TestType::
+        eType>::hash_tables_ = NULL;
+
 template <>
 const char* const EnumConversionHelper<
     test::components::SmartObjects::SmartObjectConvertionTimeTest::TestType::
@@ -630,6 +635,11 @@ const EnumConversionHelper<
             test::components::SmartObjects::SmartObjectConvertionTimeTest::
                 FunctionIdTest::eType>::InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* EnumConversionHelper<
+    test::components::SmartObjects::SmartObjectConvertionTimeTest::
+        FunctionIdTest::eType>::hash_tables_ = NULL;
+
 template <>
 const char* const EnumConversionHelper<
     test::components::SmartObjects::SmartObjectConvertionTimeTest::
@@ -670,6 +680,11 @@ const EnumConversionHelper<
             test::components::SmartObjects::SmartObjectConvertionTimeTest::
                 MessageTypeTest::eType>::InitCStringToEnumMap();
 
+template <>
+const EnumHashTables* EnumConversionHelper<
+    test::components::SmartObjects::SmartObjectConvertionTimeTest::
+        MessageTypeTest::eType>::hash_tables_ = NULL;
+
 template <>
 const char* const EnumConversionHelper<
     test::components::SmartObjects::SmartObjectConvertionTimeTest::
@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "smart_objects/enum_schema_item.h"
+
+namespace test {
+namespace components {
+namespace enum_conversion_test {
+
+namespace FunctionID {
+enum eType {
+  INVALID_ENUM = -1,
+  RegisterAppInterfaceID = 1,
+  UnregisterAppInterfaceID = 2,
+  SetGlobalPropertiesID = 3,
+  ResetGlobalPropertiesID = 4,
+  AddCommandID = 5,
+  DeleteCommandID = 6,
+  AddSubMenuID = 7,
+  DeleteSubMenuID = 8,
+  CreateInteractionChoiceSetID = 9,
+  PerformInteractionID = 10,
+  DeleteInteractionChoiceSetID = 11,
+  AlertID = 12,
+  ShowID = 13,
+  SpeakID = 14,
+  SetMediaClockTimerID = 15,
+  PerformAudioPassThruID = 16,
+  EndAudioPassThruID = 17,
+  SubscribeButtonID = 18,
+  UnsubscribeButtonID = 19,
+  SubscribeVehicleDataID = 20,
+  UnsubscribeVehicleDataID = 21,
+  GetVehicleDataID = 22,
+  ReadDIDID = 23,
+  GetDTCsID = 24,
+  ScrollableMessageID = 25,
+  SliderID = 26,
+  ShowConstantTBTID = 27,
+  AlertManeuverID = 28,
+  UpdateTurnListID = 29,
+  ChangeRegistrationID = 30,
+  GenericResponseID = 31,
+  PutFileID = 32,
+  DeleteFileID = 33,
+  ListFilesID = 34,
+  SetAppIconID = 35,
+  SetDisplayLayoutID = 36,
+  DiagnosticMessageID = 37,
+  SystemRequestID = 38,
+  SendLocationID = 39,
+  DialNumberID = 40,
+  OnHMIStatusID = 32768,
+  OnAppInterfaceUnregisteredID = 32769,
+  OnButtonEventID = 32770,
+  OnButtonPressID = 32771,
+  OnVehicleDataID = 32772,
+  OnCommandID = 32773,
+  OnTBTClientStateID = 32774,
+  OnDriverDistractionID = 32775,
+  OnPermissionsChangeID = 32776,
+  OnAudioPassThruID = 32777,
+  OnLanguageChangeID = 32778,
+  OnKeyboardInputID = 32779,
+  OnTouchEventID = 32780,
+  OnSystemRequestID = 32781,
+  OnHashChangeID = 32782,
+};
+}  // namespace FunctionID
+
+}  // namespace enum_conversion_test
+}  // namespace components
+}  // namespace test
+
+namespace ns_smart_device_link {
+namespace ns_smart_objects {
+
+namespace TestFunctionID = test::components::enum_conversion_test::FunctionID;
+typedef EnumConversionHelper<TestFunctionID::eType> TestFunctionConverter;
+
+template <>
+const TestFunctionConverter::EnumToCStringMap
+    TestFunctionConverter::enum_to_cstring_map_ =
+        TestFunctionConverter::InitEnumToCStringMap();
+
+template <>
+const TestFunctionConverter::CStringToEnumMap
+    TestFunctionConverter::cstring_to_enum_map_ =
+        TestFunctionConverter::InitCStringToEnumMap();
+
+template <>
+const char* const TestFunctionConverter::cstring_values_[] = {
+    "RegisterAppInterface",
+    "UnregisterAppInterface",
+    "SetGlobalProperties",
+    "ResetGlobalProperties",
+    "AddCommand",
+    "DeleteCommand",
+    "AddSubMenu",
+    "DeleteSubMenu",
+    "CreateInteractionChoiceSet",
+    "PerformInteraction",
+    "DeleteInteractionChoiceSet",
+    "Alert",
+    "Show",
+    "Speak",
+    "SetMediaClockTimer",
+    "PerformAudioPassThru",
+    "EndAudioPassThru",
+    "SubscribeButton",
+    "UnsubscribeButton",
+    "SubscribeVehicleData",
+    "UnsubscribeVehicleData",
+    "GetVehicleData",
+    "ReadDID",
+    "GetDTCs",
+    "ScrollableMessage",
+    "Slider",
+    "ShowConstantTBT",
+    "AlertManeuver",
+    "UpdateTurnList",
+    "ChangeRegistration",
+    "GenericResponse",
+    "PutFile",
+    "DeleteFile",
+    "ListFiles",
+    "SetAppIcon",
+    "SetDisplayLayout",
+    "DiagnosticMessage",
+    "SystemRequest",
+    "SendLocation",
+    "DialNumber",
+    "OnHMIStatus",
+    "OnAppInterfaceUnregistered",
+    "OnButtonEvent",
+    "OnButtonPress",
+    "OnVehicleData",
+    "OnCommand",
+    "OnTBTClientState",
+    "OnDriverDistraction",
+    "OnPermissionsChange",
+    "OnAudioPassThru",
+    "OnLanguageChange",
+    "OnKeyboardInput",
+    "OnTouchEvent",
+    "OnSystemRequest",
+    "OnHashChange"};
+
+template <>
+const TestFunctionID::eType TestFunctionConverter::enum_values_[] = {
+    TestFunctionID::RegisterAppInterfaceID,
+    TestFunctionID::UnregisterAppInterfaceID,
+    TestFunctionID::SetGlobalPropertiesID,
+    TestFunctionID::ResetGlobalPropertiesID,
+    TestFunctionID::AddCommandID,
+    TestFunctionID::DeleteCommandID,
+    TestFunctionID::AddSubMenuID,
+    TestFunctionID::DeleteSubMenuID,
+    TestFunctionID::CreateInteractionChoiceSetID,
+    TestFunctionID::PerformInteractionID,
+    TestFunctionID::DeleteInteractionChoiceSetID,
+    TestFunctionID::AlertID,
+    TestFunctionID::ShowID,
+    TestFunctionID::SpeakID,
+    TestFunctionID::SetMediaClockTimerID,
+    TestFunctionID::PerformAudioPassThruID,
+    TestFunctionID::EndAudioPassThruID,
+    TestFunctionID::SubscribeButtonID,
+    TestFunctionID::UnsubscribeButtonID,
+    TestFunctionID::SubscribeVehicleDataID,
+    TestFunctionID::UnsubscribeVehicleDataID,
+    TestFunctionID::GetVehicleDataID,
+    TestFunctionID::ReadDIDID,
+    TestFunctionID::GetDTCsID,
+    TestFunctionID::ScrollableMessageID,
+    TestFunctionID::SliderID,
+    TestFunctionID::ShowConstantTBTID,
+    TestFunctionID::AlertManeuverID,
+    TestFunctionID::UpdateTurnListID,
+    TestFunctionID::ChangeRegistrationID,
+    TestFunctionID::GenericResponseID,
+    TestFunctionID::PutFileID,
+    TestFunctionID::DeleteFileID,
+    TestFunctionID::ListFilesID,
+    TestFunctionID::SetAppIconID,
+    TestFunctionID::SetDisplayLayoutID,
+    TestFunctionID::DiagnosticMessageID,
+    TestFunctionID::SystemRequestID,
+    TestFunctionID::SendLocationID,
+    TestFunctionID::DialNumberID,
+    TestFunctionID::OnHMIStatusID,
+    TestFunctionID::OnAppInterfaceUnregisteredID,
+    TestFunctionID::OnButtonEventID,
+    TestFunctionID::OnButtonPressID,
+    TestFunctionID::OnVehicleDataID,
+    TestFunctionID::OnCommandID,
+    TestFunctionID::OnTBTClientStateID,
+    TestFunctionID::OnDriverDistractionID,
+    TestFunctionID::OnPermissionsChangeID,
+    TestFunctionID::OnAudioPassThruID,
+    TestFunctionID::OnLanguageChangeID,
+    TestFunctionID::OnKeyboardInputID,
+    TestFunctionID::OnTouchEventID,
+    TestFunctionID::OnSystemRequestID,
+    TestFunctionID::OnHashChangeID};
+
+// Tables below are produced by tools/InterfaceGenerator for the enum above
+namespace {
+constexpr uint32_t kTestFunctionIDStringDisplacements[] = {
+  0, 0, 0, 0, 0, 0, 1, 0, 0, 3, 0, 1, 0, 1, 0, 0, 0, 0, 2, 0, 0, 2, 0, 0, 2,
+  0, 0, 0, 0, 0, 1, 1};
+
+constexpr int16_t kTestFunctionIDStringSlots[] = {
+  -1, -1, 41, -1, 28, 21, -1, -1, -1, -1, 15, -1, -1, -1, -1, 9, -1, -1, 19,
+  22, 3, 42, -1, -1, -1, 31, 37, 5, -1, -1, -1, -1, 35, -1, -1, 2, -1, 25, -1,
+  36, -1, -1, 18, -1, -1, -1, 13, -1, -1, -1, -1, -1, 53, 29, -1, -1, -1, -1,
+  54, -1, -1, -1, -1, 45, -1, -1, -1, -1, 1, -1, 48, -1, 14, -1, 51, 24, -1,
+  26, 32, -1, 46, 0, 10, 38, 7, -1, 17, 40, 52, -1, -1, 30, 4, 39, -1, -1, 49,
+  27, 50, 44, 11, 33, 20, -1, 12, -1, -1, -1, -1, -1, 6, -1, -1, 34, 47, 23,
+  8, -1, 16, -1, -1, -1, -1, -1, -1, -1, -1, 43};
+
+constexpr uint32_t kTestFunctionIDValueDisplacements[] = {
+  0, 0, 2, 0, 0, 0, 0, 0, 1, 0, 0, 1, 3, 0, 0, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 1, 1, 0, 0, 3};
+
+constexpr int16_t kTestFunctionIDValueSlots[] = {
+  -1, -1, -1, -1, 31, 22, 16, -1, 1, 40, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  52, -1, -1, 12, -1, 14, 47, 26, -1, 50, 44, 11, -1, -1, 0, 34, 2, -1, 7, 9,
+  -1, -1, -1, 5, 48, -1, 10, -1, -1, 6, -1, -1, 36, 38, 51, 32, 42, -1, 49,
+  -1, 54, -1, -1, -1, 46, -1, 45, -1, 27, 17, -1, -1, 21, 43, -1, -1, -1, -1,
+  3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 37, 33, -1, -1, 13, 30,
+  -1, 28, -1, -1, -1, -1, 41, 15, -1, -1, 23, 35, -1, -1, 18, 19, 39, -1, 25,
+  -1, 20, -1, -1, -1, -1, 24, 53, 8, 29, -1, -1, -1};
+
+constexpr EnumHashTables kTestFunctionIDHashTables = {
+    2166136261u, 31u, 127u,
+    kTestFunctionIDStringDisplacements, kTestFunctionIDStringSlots,
+    kTestFunctionIDValueDisplacements, kTestFunctionIDValueSlots};
+}  // namespace
+
+template <>
+const EnumHashTables* TestFunctionConverter::hash_tables_ =
+    &kTestFunctionIDHashTables;
+
+}  // namespace ns_smart_objects
+}  // namespace ns_smart_device_link
+
+namespace test {
+namespace components {
+namespace enum_conversion_test {
+
+using ns_smart_device_link::ns_smart_objects::TestFunctionConverter;
+
+namespace {
+const size_t kIterations = 20000;
+
+template <typename Lookup>
+double MeasureNsPerLookup(const size_t lookups, Lookup lookup) {
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kIterations; ++i) {
+    lookup();
+  }
+  const std::chrono::nanoseconds elapsed =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start);
+  return static_cast<double>(elapsed.count()) / (kIterations * lookups);
+}
+}  // namespace
+
+TEST(EnumConversionTest, HashTables_SameResultAsMaps) {
+  const TestFunctionConverter::CStringToEnumMap& strings =
+      TestFunctionConverter::cstring_to_enum_map();
+  for (TestFunctionConverter::CStringToEnumMap::const_iterator it =
+           strings.begin();
+       it != strings.end();
+       ++it) {
+    FunctionID::eType value = FunctionID::INVALID_ENUM;
+    EXPECT_TRUE(TestFunctionConverter::CStringToEnum(it->first, &value));
+    EXPECT_EQ(it->second, value);
+    value = FunctionID::INVALID_ENUM;
+    EXPECT_TRUE(
+        TestFunctionConverter::StringToEnum(std::string(it->first), &value));
+    EXPECT_EQ(it->second, value);
+  }
+
+  const TestFunctionConverter::EnumToCStringMap& values =
+      TestFunctionConverter::enum_to_cstring_map();
+  for (TestFunctionConverter::EnumToCStringMap::const_iterator it =
+           values.begin();
+       it != values.end();
+       ++it) {
+    const char* str = NULL;
+    EXPECT_TRUE(TestFunctionConverter::EnumToCString(it->first, &str));
+    EXPECT_STREQ(it->second, str);
+  }
+}
+
+TEST(EnumConversionTest, HashTables_UnknownElementsRejected) {
+  const char* unknown[] = {
+      "", "Show1", "Sho", "ShowID", "show", "OnHashChangeOnHashChange"};
+  for (size_t i = 0; i < sizeof(unknown) / sizeof(unknown[0]); ++i) {
+    FunctionID::eType value = FunctionID::ShowID;
+    EXPECT_FALSE(TestFunctionConverter::CStringToEnum(unknown[i], &value));
+    EXPECT_EQ(FunctionID::INVALID_ENUM, value);
+  }
+  FunctionID::eType value = FunctionID::ShowID;
+  EXPECT_FALSE(TestFunctionConverter::StringToEnum(std::string("Show\0", 5),
+                                                   &value));
+  EXPECT_EQ(FunctionID::INVALID_ENUM, value);
+
+  const char* str = NULL;
+  EXPECT_FALSE(
+      TestFunctionConverter::EnumToCString(FunctionID::INVALID_ENUM, &str));
+  EXPECT_FALSE(TestFunctionConverter::EnumToCString(
+      static_cast<FunctionID::eType>(100), &str));
+  EXPECT_EQ(NULL, str);
+}
+
+/*
+ * Compares lookup time of generated hash tables with std::map.
+ * Nanoseconds per lookup are recorded as test properties, so they could be
+ * compared between builds with --gtest_output=xml. Disabled by default,
+ * run with --gtest_also_run_disabled_tests.
+ */
+TEST(EnumConversionPerformanceTest, DISABLED_HashTablesVsMaps) {
+  const TestFunctionConverter::CStringToEnumMap& strings =
+      TestFunctionConverter::cstring_to_enum_map();
+  const TestFunctionConverter::EnumToCStringMap& values =
+      TestFunctionConverter::enum_to_cstring_map();
+
+  std::vector<std::string> names;
+  std::vector<FunctionID::eType> ids;
+  for (TestFunctionConverter::CStringToEnumMap::const_iterator it =
+           strings.begin();
+       it != strings.end();
+       ++it) {
+    names.push_back(it->first);
+    ids.push_back(it->second);
+  }
+
+  size_t map_found = 0;
+  const double map_string_ns = MeasureNsPerLookup(names.size(), [&]() {
+    for (size_t i = 0; i < names.size(); ++i) {
+      map_found += strings.find(names[i].c_str()) != strings.end();
+    }
+  });
+  size_t hash_found = 0;
+  const double hash_string_ns = MeasureNsPerLookup(names.size(), [&]() {
+    FunctionID::eType value;
+    for (size_t i = 0; i < names.size(); ++i) {
+      hash_found += TestFunctionConverter::StringToEnum(names[i], &value);
+    }
+  });
+  EXPECT_EQ(map_found, hash_found);
+
+  const double map_enum_ns = MeasureNsPerLookup(ids.size(), [&]() {
+    for (size_t i = 0; i < ids.size(); ++i) {
+      map_found += values.find(ids[i]) != values.end();
+    }
+  });
+  const double hash_enum_ns = MeasureNsPerLookup(ids.size(), [&]() {
+    const char* str;
+    for (size_t i = 0; i < ids.size(); ++i) {
+      hash_found += TestFunctionConverter::EnumToCString(ids[i], &str);
+    }
+  });
+  EXPECT_EQ(map_found, hash_found);
+
+  RecordProperty("map_string_to_enum_ns", static_cast<int>(map_string_ns));
+  RecordProperty("hash_string_to_enum_ns", static_cast<int>(hash_string_ns));
+  RecordProperty("map_enum_to_string_ns", static_cast<int>(map_enum_ns));
+  RecordProperty("hash_enum_to_string_ns", static_cast<int>(hash_enum_ns));
+}
+
+}  // namespace enum_conversion_test
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "smart_objects/interned_key.h"
+#include "smart_objects/smart_map.h"
+#include "smart_objects/smart_object.h"
+
+namespace test {
+namespace components {
+namespace smart_object_test {
+
+using namespace ns_smart_device_link::ns_smart_objects;
+
+namespace {
+const char* kKeys[] = {"speed",
+                       "",
+                       "rpm",
+                       "s",
+                       "speedLimit",
+                       "gps",
+                       "Speed",
+                       "fuelLevel",
+                       "fuelLevel_State",
+                       "\xD0\x9A\xD0\xBB\xD1\x8E\xD1\x87"};
+const size_t kKeysCount = sizeof(kKeys) / sizeof(kKeys[0]);
+}  // namespace
+
+TEST(SmartMapTest, Iteration_SameOrderAsStdMap) {
+  SmartMap map;
+  std::map<std::string, int> expected;
+  for (size_t i = 0; i < kKeysCount; ++i) {
+    map[kKeys[i]] = static_cast<int>(i);
+    expected[kKeys[i]] = static_cast<int>(i);
+  }
+
+  ASSERT_EQ(expected.size(), map.size());
+  std::map<std::string, int>::const_iterator expected_it = expected.begin();
+  for (SmartMap::const_iterator it = map.begin(); it != map.end();
+       ++it, ++expected_it) {
+    EXPECT_EQ(expected_it->first, it->first);
+    EXPECT_EQ(expected_it->second, it->second.asInt());
+  }
+}
+
+TEST(SmartMapTest, Insertion_KeepsReferencesValid) {
+  SmartObject object(SmartType_Map);
+  SmartObject& first = object["m"];
+  first = 1;
+  for (int i = 0; i < 100; ++i) {
+    object[std::string(1, 'a' + i % 26) + std::to_string(i)] = i;
+  }
+
+  first = 2;
+  EXPECT_EQ(2, object["m"].asInt());
+  EXPECT_EQ(101u, object.length());
+}
+
+TEST(SmartMapTest, Erase_RemovesOnlyGivenKey) {
+  SmartMap map;
+  for (size_t i = 0; i < kKeysCount; ++i) {
+    map[kKeys[i]] = static_cast<int>(i);
+  }
+
+  EXPECT_EQ(1u, map.erase(std::string("rpm")));
+  EXPECT_EQ(0u, map.erase(std::string("rpm")));
+  EXPECT_TRUE(map.end() == map.find("rpm"));
+  EXPECT_EQ(kKeysCount - 1, map.size());
+
+  SmartMap::iterator it = map.find("gps");
+  ASSERT_TRUE(map.end() != it);
+  it = map.erase(it);
+  ASSERT_TRUE(map.end() != it);
+  EXPECT_EQ("s", it->first);
+  EXPECT_EQ(kKeysCount - 2, map.size());
+}
+
+TEST(SmartMapTest, Copy_IsIndependent) {
+  SmartMap map;
+  map["key"] = "value";
+  SmartMap copy(map);
+  copy["key"] = "other";
+  copy["new"] = 1;
+
+  EXPECT_EQ("value", map["key"].asString());
+  EXPECT_EQ(1u, map.size());
+  EXPECT_EQ(2u, copy.size());
+}
+
+TEST(InternedKeyTest, Intern_ReturnsSameKeyForSameName) {
+  const std::string name = "interned_key_test_name";
+  EXPECT_TRUE(InternedKey::Find(name.data(), name.size()).empty());
+
+  const InternedKey key = InternedKey::Intern(name);
+  ASSERT_FALSE(key.empty());
+  EXPECT_EQ(name, key.str());
+  EXPECT_TRUE(key == InternedKey::Intern(name));
+  EXPECT_TRUE(key == InternedKey::Find(name.data(), name.size()));
+  EXPECT_TRUE(key != InternedKey::Intern(name + "_other"));
+}
+
+TEST(InternedKeyTest, InternedKey_FindsMembersAddedByName) {
+  const InternedKey key = InternedKey::Intern("interned_key_test_member");
+
+  SmartObject object;
+  object["interned_key_test_member"] = 5;
+  object["other"] = 1;
+
+  EXPECT_TRUE(object.keyExists(key));
+  EXPECT_EQ(5, object.getElement(key).asInt());
+
+  object[key] = 6;
+  EXPECT_EQ(6, object["interned_key_test_member"].asInt());
+  EXPECT_EQ(2u, object.length());
+}
+
+TEST(InternedKeyTest, MembersAddedBeforeInterning_AreFound) {
+  const std::string name = "interned_key_test_late";
+  SmartObject small_object;
+  small_object[name] = 1;
+  SmartObject large_object;
+  for (int i = 0; i < 50; ++i) {
+    large_object["large_" + std::to_string(i)] = i;
+  }
+  large_object[name] = 2;
+
+  const InternedKey key = InternedKey::Intern(name);
+  EXPECT_TRUE(small_object.keyExists(key));
+  EXPECT_EQ(1, small_object[key].asInt());
+  EXPECT_EQ(1u, small_object.length());
+  EXPECT_TRUE(large_object.keyExists(key));
+  EXPECT_EQ(2, large_object[key].asInt());
+  EXPECT_EQ(51u, large_object.length());
+}
+
+TEST(InternedKeyTest, MissingKey_NotFound) {
+  const InternedKey key = InternedKey::Intern("interned_key_test_missing");
+  const SmartObject object(SmartType_Map);
+
+  EXPECT_FALSE(object.keyExists(key));
+  EXPECT_EQ(SmartType_Invalid, object[key].getType());
+}
+
+}  // namespace smart_object_test
+}  // namespace components
+}  // namespace test
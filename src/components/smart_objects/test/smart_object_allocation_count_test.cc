@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "rpc_base/validation_report.h"
+#include "smart_objects/smart_object.h"
+#include "smart_objects/smart_object_arena.h"
+#include "vehicle_data_message.h"
+
+/*
+ * Tests counting heap allocations made by SmartObject.
+ * Global allocation functions are replaced for the whole executable,
+ * so these tests are built separately from smart_object_test.
+ */
+
+namespace {
+std::atomic<size_t> allocations_count(0);
+}  // namespace
+
+// Global allocation functions are replaced to count allocations made
+// by SmartObject. Kept out of line, otherwise compiler may pair inlined
+// free() with new-expression and report mismatch.
+void* operator new(size_t size) __attribute__((noinline));
+void operator delete(void* memory) noexcept __attribute__((noinline));
+void operator delete(void* memory, size_t size) noexcept
+    __attribute__((noinline));
+
+void* operator new(size_t size) {
+  allocations_count.fetch_add(1, std::memory_order_relaxed);
+  void* memory = malloc(size ? size : 1);
+  if (!memory) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void operator delete(void* memory) noexcept {
+  free(memory);
+}
+
+// Sized version is called by code built with sized deallocation
+void operator delete(void* memory, size_t size) noexcept {
+  free(memory);
+}
+
+namespace test {
+namespace components {
+namespace smart_object_test {
+
+using namespace ns_smart_device_link::ns_smart_objects;
+
+namespace {
+const size_t kApplicationsCount = 20;
+const size_t kIterations = 1000;
+
+template <typename Flow>
+size_t CountAllocations(Flow flow, double* duration_us) {
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  const size_t before = allocations_count.load();
+  for (size_t i = 0; i < kIterations; ++i) {
+    flow();
+  }
+  const size_t after = allocations_count.load();
+  *duration_us = std::chrono::duration<double, std::micro>(
+                     std::chrono::steady_clock::now() - start)
+                     .count() /
+                 kIterations;
+  return (after - before) / kIterations;
+}
+
+/**
+ * @brief Records allocations and duration of flow as test properties,
+ * so they could be compared between builds with --gtest_output=xml
+ */
+void RecordFlow(const std::string& name,
+                const size_t allocations,
+                const double duration_us) {
+  ::testing::Test::RecordProperty(name + "_allocations",
+                                  static_cast<int>(allocations));
+  ::testing::Test::RecordProperty(name + "_ns",
+                                  static_cast<int>(duration_us * 1000));
+}
+}  // namespace
+
+TEST(SmartObjectAllocationTest, MoveConstruction_NoAllocations) {
+  SmartObject message = MakeVehicleDataMessage();
+  const SmartObject expected(message);
+
+  const size_t before = allocations_count.load();
+  SmartObject moved(std::move(message));
+  EXPECT_EQ(before, allocations_count.load());
+
+  EXPECT_EQ(expected, moved);
+  EXPECT_EQ(SmartType_Null, message.getType());
+}
+
+TEST(SmartObjectAllocationTest, MoveAssignment_NoAllocations) {
+  SmartObject message = MakeVehicleDataMessage();
+  const SmartObject expected(message);
+  SmartObject target("to be replaced");
+
+  const size_t before = allocations_count.load();
+  target = std::move(message);
+  EXPECT_EQ(before, allocations_count.load());
+
+  EXPECT_EQ(expected, target);
+  EXPECT_EQ(SmartType_Null, message.getType());
+}
+
+#ifdef SMART_OBJECTS_COW
+TEST(SmartObjectAllocationTest, CopyOfUnmodifiedObject_SharesPayload) {
+  // Built message has handed out references, so only its copy is shareable
+  const SmartObject message = MakeVehicleDataMessage();
+  const SmartObject stored(message);
+
+  const size_t before = allocations_count.load();
+  const SmartObject copy(stored);
+  EXPECT_EQ(before, allocations_count.load());
+  EXPECT_EQ(stored, copy);
+}
+#endif  // SMART_OBJECTS_COW
+
+TEST(SmartObjectAllocationTest, ValidationOfValidMessage_NoAllocations) {
+  const CSmartSchema schema = MakeVehicleDataSchema();
+  const SmartObject message = MakeVehicleDataMessage();
+  rpc::ValidationReport report("RPC");
+
+  const size_t before = allocations_count.load();
+  const errors::eType result = schema.validate(message, &report);
+  EXPECT_EQ(before, allocations_count.load());
+
+  EXPECT_EQ(errors::OK, result);
+  EXPECT_TRUE(report.subobject_reports().empty());
+}
+
+/*
+ * Allocations and time spent in typical RPC flows, copy vs move.
+ * Disabled by default, run with --gtest_also_run_disabled_tests.
+ */
+TEST(SmartObjectAllocationTest, DISABLED_RpcFlowsBenchmark) {
+  const SmartObject message = MakeVehicleDataMessage();
+  double copy_us = 0;
+  double move_us = 0;
+
+  // Response is built and stored in event, like Event::set_smart_object
+  const size_t store_copy = CountAllocations(
+      [&message]() {
+        SmartObject response(message);
+        SmartObject event_response;
+        event_response = response;
+      },
+      &copy_us);
+  const size_t store_move = CountAllocations(
+      [&message]() {
+        SmartObject response(message);
+        SmartObject event_response;
+        event_response = std::move(response);
+      },
+      &move_us);
+  RecordFlow("store_in_event_copy", store_copy, copy_us);
+  RecordFlow("store_in_event_move", store_move, move_us);
+  EXPECT_LE(store_move, store_copy);
+
+  // Per-application notifications collected into vector
+  const size_t fan_out_copy = CountAllocations(
+      [&message]() {
+        std::vector<SmartObject> notifications;
+        for (size_t i = 0; i < kApplicationsCount; ++i) {
+          SmartObject notification(message);
+          notification["params"]["connection_key"] = static_cast<int>(i);
+          notifications.push_back(notification);
+        }
+      },
+      &copy_us);
+  const size_t fan_out_move = CountAllocations(
+      [&message]() {
+        std::vector<SmartObject> notifications;
+        for (size_t i = 0; i < kApplicationsCount; ++i) {
+          SmartObject notification(message);
+          notification["params"]["connection_key"] = static_cast<int>(i);
+          notifications.push_back(std::move(notification));
+        }
+      },
+      &move_us);
+  RecordFlow("fan_out_to_apps_copy", fan_out_copy, copy_us);
+  RecordFlow("fan_out_to_apps_move", fan_out_move, move_us);
+  EXPECT_LE(fan_out_move, fan_out_copy);
+
+  // Cached module data retrieved by value, like InteriorDataCache::Retrieve
+  const SmartObject cached(message);
+  const size_t retrieve = CountAllocations(
+      [&cached]() {
+        const SmartObject retrieved(cached);
+        EXPECT_FALSE(retrieved.empty());
+      },
+      &copy_us);
+  RecordFlow("retrieve_from_cache", retrieve, copy_us);
+#ifdef SMART_OBJECTS_COW
+  EXPECT_EQ(0u, retrieve);
+#endif  // SMART_OBJECTS_COW
+}
+
+TEST(SmartObjectAllocationTest, BuildInArena_FewerHeapAllocations) {
+  double heap_us = 0;
+  double arena_us = 0;
+  const size_t heap = CountAllocations(
+      []() { EXPECT_FALSE(MakeVehicleDataMessage().empty()); }, &heap_us);
+  const size_t arena = CountAllocations(
+      []() {
+        SmartObjectArena message_arena;
+        SmartObjectArena::Scope scope(&message_arena);
+        EXPECT_FALSE(MakeVehicleDataMessage().empty());
+      },
+      &arena_us);
+  RecordFlow("build_message_heap", heap, heap_us);
+  RecordFlow("build_message_arena", arena, arena_us);
+  EXPECT_LT(arena, heap);
+}
+
+}  // namespace smart_object_test
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "rpc_base/validation_report.h"
+#include "smart_objects/smart_object.h"
+#include "smart_objects/smart_object_arena.h"
+#include "vehicle_data_message.h"
+
+namespace test {
+namespace components {
+namespace smart_object_test {
+
+using namespace ns_smart_device_link::ns_smart_objects;
+
+namespace {
+const size_t kApplicationsCount = 20;
+}  // namespace
+
+TEST(SmartObjectAllocationTest, MoveAssignmentFromNull_KeepsValue) {
+  SmartObject target(5);
+  target = SmartObject();
+  EXPECT_EQ(SmartType_Integer, target.getType());
+  EXPECT_EQ(5, target.asInt());
+}
+
+TEST(SmartObjectAllocationTest, MovedFromObject_IsReusable) {
+  SmartObject message = MakeVehicleDataMessage();
+  SmartObject moved(std::move(message));
+
+  message["key"] = "value";
+  EXPECT_EQ("value", message["key"].asString());
+  EXPECT_TRUE(message.isValid());
+  EXPECT_FALSE(moved.keyExists("key"));
+}
+
+TEST(SmartObjectAllocationTest, CopyModification_DoesNotAffectOriginal) {
+  const SmartObject original = MakeVehicleDataMessage();
+  SmartObject stored(original);
+  const SmartObject expected(stored);
+
+  SmartObject copy(stored);
+  copy["msg_params"]["gps"]["actual"] = false;
+  copy["msg_params"]["fuelRange"].asArray()->clear();
+  copy["msg_params"]["tirePressure"].erase("leftFront");
+  EXPECT_EQ(expected, stored);
+
+  SmartObject iterated(stored);
+  SmartObject& gps = iterated["msg_params"]["gps"];
+  for (SmartMap::iterator it = gps.map_begin(); it != gps.map_end(); ++it) {
+    it->second = 0;
+  }
+  EXPECT_EQ(expected, stored);
+  EXPECT_NE(expected, iterated);
+}
+
+TEST(SmartObjectAllocationTest, ReferenceIntoObject_StaysPrivateAfterCopy) {
+  SmartObject stored(MakeVehicleDataMessage());
+  SmartObject& gps = stored["msg_params"]["gps"];
+
+  const SmartObject copy(stored);
+  gps["actual"] = false;
+
+  EXPECT_TRUE(copy["msg_params"]["gps"]["actual"].asBool());
+  EXPECT_FALSE(stored["msg_params"]["gps"]["actual"].asBool());
+}
+
+TEST(SmartObjectAllocationTest, ValidationOfInvalidMessage_DetailedReport) {
+  const CSmartSchema schema = MakeVehicleDataSchema();
+  SmartObject message = MakeVehicleDataMessage();
+  message["msg_params"]["tirePressure"]["rightRear"].erase("status");
+  rpc::ValidationReport report("RPC");
+
+  EXPECT_EQ(errors::MISSING_MANDATORY_PARAMETER,
+            schema.validate(message, &report));
+  EXPECT_EQ(
+      "RPC.msg_params.tirePressure.rightRear: "
+      "Missing mandatory parameter: status",
+      rpc::PrettyFormat(report));
+}
+
+TEST(SmartObjectAllocationTest, ValidationOfInvalidArrayItem_DetailedReport) {
+  const CSmartSchema schema = MakeVehicleDataSchema();
+  SmartObject message = MakeVehicleDataMessage();
+  message["msg_params"]["fuelRange"][1]["type"] = 5;
+  rpc::ValidationReport report("RPC");
+
+  EXPECT_EQ(errors::INVALID_VALUE, schema.validate(message, &report));
+  EXPECT_EQ(
+      "RPC.msg_params.fuelRange.1.type: "
+      "Incorrect type, expected: String, got: Integer",
+      rpc::PrettyFormat(report));
+}
+
+TEST(SmartObjectAllocationTest, ObjectBuiltInArena_OutlivesArena) {
+  SmartObject message;
+  {
+    SmartObjectArena message_arena;
+    SmartObjectArena::Scope scope(&message_arena);
+    message = MakeVehicleDataMessage();
+    EXPECT_EQ(&message_arena, SmartObjectArena::Current());
+    EXPECT_LT(0u, message_arena.chunks_count());
+  }
+  EXPECT_EQ(NULL, SmartObjectArena::Current());
+
+  EXPECT_EQ(MakeVehicleDataMessage(), message);
+  message["msg_params"]["vin"] = "changed";
+  message["msg_params"].erase("gps");
+  EXPECT_EQ("changed", message["msg_params"]["vin"].asString());
+}
+
+TEST(SmartObjectAllocationTest, CopyOutsideArena_PromotedToHeap) {
+  SmartObjectArena message_arena;
+  SmartObject message;
+  {
+    SmartObjectArena::Scope scope(&message_arena);
+    message = MakeVehicleDataMessage();
+  }
+  const SmartObject& built = message;
+  EXPECT_TRUE(SmartObjectArena::IsArenaBlock(
+      built["msg_params"]["fuelRange"].asArray()));
+
+  const SmartObject stored(built["msg_params"]);
+  EXPECT_FALSE(SmartObjectArena::IsArenaBlock(stored["fuelRange"].asArray()));
+  EXPECT_EQ(built["msg_params"], stored);
+
+  {
+    // Objects may be built in heap from inside of an arena scope
+    SmartObjectArena::Scope heap_scope(NULL);
+    const SmartObject heap_copy(built);
+    EXPECT_FALSE(SmartObjectArena::IsArenaBlock(
+        heap_copy["msg_params"]["fuelRange"].asArray()));
+  }
+}
+
+TEST(SmartObjectAllocationTest, ArenaAndHeapBlocks_MaxAligned) {
+  const size_t kSizes[] = {1u, 3u, 8u, 12u, 24u, 100u};
+  std::vector<void*> blocks;
+  {
+    SmartObjectArena message_arena;
+    SmartObjectArena::Scope scope(&message_arena);
+    for (const size_t size : kSizes) {
+      blocks.push_back(SmartObjectArena::Allocate(size));
+    }
+  }
+  for (const size_t size : kSizes) {
+    blocks.push_back(SmartObjectArena::Allocate(size));
+  }
+  for (void* block : blocks) {
+    EXPECT_EQ(0u,
+              reinterpret_cast<uintptr_t>(block) % alignof(std::max_align_t));
+    SmartObjectArena::Deallocate(block);
+  }
+}
+
+TEST(SmartObjectAllocationTest, ObjectBuiltInArena_DestroyedInOtherThread) {
+  std::vector<SmartObject> messages;
+  {
+    SmartObjectArena message_arena;
+    SmartObjectArena::Scope scope(&message_arena);
+    for (size_t i = 0; i < kApplicationsCount; ++i) {
+      messages.push_back(MakeVehicleDataMessage());
+    }
+  }
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < messages.size(); ++i) {
+    threads.push_back(std::thread(
+        [](SmartObject& message) { SmartObject(std::move(message)); },
+        std::ref(messages[i])));
+  }
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+  for (size_t i = 0; i < messages.size(); ++i) {
+    EXPECT_EQ(SmartType_Null, messages[i].getType());
+  }
+}
+
+}  // namespace smart_object_test
+}  // namespace components
+}  // namespace test
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_SMART_OBJECTS_TEST_VEHICLE_DATA_MESSAGE_H_
+#define SRC_COMPONENTS_SMART_OBJECTS_TEST_VEHICLE_DATA_MESSAGE_H_
+
+#include <stdint.h>
+
+#include "smart_objects/array_schema_item.h"
+#include "smart_objects/bool_schema_item.h"
+#include "smart_objects/number_schema_item.h"
+#include "smart_objects/object_schema_item.h"
+#include "smart_objects/smart_object.h"
+#include "smart_objects/string_schema_item.h"
+
+namespace test {
+namespace components {
+namespace smart_object_test {
+
+using namespace ns_smart_device_link::ns_smart_objects;
+
+/**
+ * @brief Builds object shaped like OnVehicleData notification
+ */
+inline SmartObject MakeVehicleDataMessage() {
+  SmartObject message(SmartType_Map);
+  message["params"]["message_type"] = 2;
+  message["params"]["function_id"] = 32783;
+  message["params"]["correlation_id"] = 1;
+  message["params"]["protocol_type"] = 0;
+  message["params"]["protocol_version"] = 5;
+
+  SmartObject& msg_params = message["msg_params"];
+  SmartObject& gps = msg_params["gps"];
+  gps["longitudeDegrees"] = 42.5;
+  gps["latitudeDegrees"] = -83.3;
+  gps["utcYear"] = 2021;
+  gps["utcMonth"] = 6;
+  gps["utcDay"] = 1;
+  gps["compassDirection"] = "NORTH";
+  gps["actual"] = true;
+  msg_params["speed"] = 80.5;
+  msg_params["rpm"] = 2100;
+  msg_params["vin"] = "1FMCU0GX0DUA12345";
+  for (int i = 0; i < 2; ++i) {
+    SmartObject& range = msg_params["fuelRange"][i];
+    range["type"] = "GASOLINE";
+    range["range"] = 400.0 + i;
+  }
+  const char* tires[] = {"leftFront", "rightFront", "leftRear", "rightRear"};
+  for (size_t i = 0; i < sizeof(tires) / sizeof(tires[0]); ++i) {
+    SmartObject& tire = msg_params["tirePressure"][tires[i]];
+    tire["status"] = "NORMAL";
+    tire["pressure"] = 230.0;
+  }
+  msg_params["gpsData"] = SmartBinary(64, 0x5A);
+  return message;
+}
+
+/**
+ * @brief Builds schema of message made by MakeVehicleDataMessage
+ */
+inline CSmartSchema MakeVehicleDataSchema() {
+  typedef TNumberSchemaItem<int32_t> IntItem;
+  typedef TNumberSchemaItem<double> DoubleItem;
+  typedef TSchemaItemParameter<size_t> SizeParam;
+
+  Members params;
+  params["message_type"] = SMember(IntItem::create(), true);
+  params["function_id"] = SMember(IntItem::create(), true);
+  params["correlation_id"] = SMember(IntItem::create(), false);
+  params["protocol_type"] = SMember(IntItem::create(), true);
+  params["protocol_version"] = SMember(IntItem::create(), true);
+
+  Members gps;
+  gps["longitudeDegrees"] = SMember(
+      DoubleItem::create(TSchemaItemParameter<double>(-180.0),
+                         TSchemaItemParameter<double>(180.0)),
+      true);
+  gps["latitudeDegrees"] = SMember(
+      DoubleItem::create(TSchemaItemParameter<double>(-90.0),
+                         TSchemaItemParameter<double>(90.0)),
+      true);
+  gps["utcYear"] = SMember(IntItem::create(), false);
+  gps["utcMonth"] = SMember(IntItem::create(), false);
+  gps["utcDay"] = SMember(IntItem::create(), false);
+  gps["compassDirection"] = SMember(CStringSchemaItem::create(), false);
+  gps["actual"] = SMember(CBoolSchemaItem::create(), false);
+  gps["altitude"] = SMember(DoubleItem::create(), false);
+
+  Members fuel_range;
+  fuel_range["type"] = SMember(CStringSchemaItem::create(), false);
+  fuel_range["range"] = SMember(DoubleItem::create(), false);
+
+  Members tire;
+  tire["status"] = SMember(CStringSchemaItem::create(), true);
+  tire["pressure"] = SMember(DoubleItem::create(), false);
+  const ISchemaItemPtr tire_item = CObjectSchemaItem::create(tire);
+
+  Members tire_pressure;
+  tire_pressure["leftFront"] = SMember(tire_item, false);
+  tire_pressure["rightFront"] = SMember(tire_item, false);
+  tire_pressure["leftRear"] = SMember(tire_item, false);
+  tire_pressure["rightRear"] = SMember(tire_item, false);
+
+  Members msg_params;
+  msg_params["gps"] = SMember(CObjectSchemaItem::create(gps), false);
+  msg_params["speed"] = SMember(DoubleItem::create(), false);
+  msg_params["rpm"] = SMember(IntItem::create(), false);
+  msg_params["vin"] = SMember(
+      CStringSchemaItem::create(SizeParam(), SizeParam(17)), false);
+  msg_params["fuelRange"] =
+      SMember(CArraySchemaItem::create(CObjectSchemaItem::create(fuel_range),
+                                       SizeParam(1),
+                                       SizeParam(100)),
+              false);
+  msg_params["tirePressure"] =
+      SMember(CObjectSchemaItem::create(tire_pressure), false);
+
+  Members root;
+  root["params"] = SMember(CObjectSchemaItem::create(params), true);
+  root["msg_params"] = SMember(CObjectSchemaItem::create(msg_params), true);
+  return CSmartSchema(CObjectSchemaItem::create(root));
+}
+
+}  // namespace smart_object_test
+}  // namespace components
+}  // namespace test
+
+#endif  // SRC_COMPONENTS_SMART_OBJECTS_TEST_VEHICLE_DATA_MESSAGE_H_
@@ -47,6 +47,8 @@ const char connection_key[] = "connection_key";
 const char stime[] = "stime";
 const char utime[] = "utime";
 const char memory[] = "RAM";
+const char frame_pool_allocations[] = "frame_pool_allocations";
+const char frame_heap_allocations[] = "frame_heap_allocations";
 }  // namespace strings
 }  // namespace telemetry_monitor
 #endif  // SRC_COMPONENTS_TELEMETRY_MONITOR_INCLUDE_TELEMETRY_MONITOR_JSON_KEYS_H_
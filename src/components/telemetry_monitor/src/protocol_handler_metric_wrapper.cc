@@ -44,6 +44,10 @@ Json::Value ProtocolHandlerMecticWrapper::GetJsonMetric() {
   result[strings::end] = Json::Int64(date_time::getuSecs(message_metric->end));
   result[strings::message_id] = message_metric->message_id;
   result[strings::connection_key] = message_metric->connection_key;
+  result[strings::frame_pool_allocations] =
+      Json::UInt64(message_metric->frame_pool_allocations);
+  result[strings::frame_heap_allocations] =
+      Json::UInt64(message_metric->frame_heap_allocations);
   return result;
 }
 
@@ -61,6 +61,8 @@ TEST(ProtocolHandlerMetricTest, GetJsonMetric) {
   metric_test.message_metric->end = end_time;
   metric_test.message_metric->message_id = 5;
   metric_test.message_metric->connection_key = 2;
+  metric_test.message_metric->frame_pool_allocations = 100;
+  metric_test.message_metric->frame_heap_allocations = 3;
   Json::Value jvalue = metric_test.GetJsonMetric();
 
   EXPECT_EQ("\"ProtocolHandler\"\n", jvalue[strings::logger].toStyledString());
@@ -72,6 +74,8 @@ TEST(ProtocolHandlerMetricTest, GetJsonMetric) {
   EXPECT_EQ(date_time::getuSecs(end_time), jvalue[strings::end].asInt64());
   EXPECT_EQ(5, jvalue[strings::message_id].asInt64());
   EXPECT_EQ(2, jvalue[strings::connection_key].asInt());
+  EXPECT_EQ(100u, jvalue[strings::frame_pool_allocations].asUInt64());
+  EXPECT_EQ(3u, jvalue[strings::frame_heap_allocations].asUInt64());
 }
 
 TEST(ProtocolHandlerMetricTest, GetJsonMetricWithGrabResources) {
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_IO_REACTOR_H_
+#define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_IO_REACTOR_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
+
+namespace transport_manager {
+namespace transport_adapter {
+
+class IoReactor;
+
+/**
+ * @brief Receiver of events of file descriptor registered in IoReactor.
+ * Handler is owned by client, reactor only keeps pointer to it
+ * until handler is removed.
+ */
+class IoReactorHandler {
+ public:
+  enum Event { kReadable = 1, kWritable = 2, kError = 4, kWakeUp = 8 };
+
+  IoReactorHandler() : worker_(NULL), id_(0u), wakeup_pending_(false) {}
+  virtual ~IoReactorHandler() {}
+
+  /**
+   * @brief Called from reactor thread handler is assigned to, so calls
+   * for the same handler never overlap.
+   * Readiness is edge-triggered: handler is notified once descriptor becomes
+   * readable or writable, so it has to read or write until EAGAIN.
+   * IoReactor::Remove waits for running notification, so notification must
+   * not take locks which may be held while handler is removed. Calls to
+   * other components should be passed to IoReactor::Defer instead.
+   * @param events Bit mask of Event values
+   */
+  virtual void OnIoEvents(const uint32_t events) = 0;
+
+ private:
+  friend class IoReactor;
+
+  /**
+   * @brief Reactor thread handler is assigned to, set on first registration
+   */
+  std::atomic<void*> worker_;
+
+  /**
+   * @brief Identifier of current registration, 0 if handler is not
+   * registered. Every registration gets new identifier, so events fetched
+   * for removed handler are not delivered to another one which has been
+   * registered later, even at the same address.
+   * Protected by lock of handler worker.
+   */
+  uint64_t id_;
+
+  /**
+   * @brief Set if handler is queued for kWakeUp event.
+   * Protected by lock of handler worker.
+   */
+  bool wakeup_pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(IoReactorHandler);
+};
+
+/**
+ * @brief Process-wide reactor multiplexing socket connections on
+ * a small number of epoll threads.
+ * Descriptors are registered edge-triggered, so each one costs nothing
+ * until it becomes ready. Every handler is served by a single thread chosen
+ * on registration, threads are woken up by eventfd.
+ * Thread-safe class
+ */
+class IoReactor {
+ public:
+  typedef std::function<void()> Task;
+
+  /**
+   * @brief Sets number of reactor threads.
+   * Should be called before first instance() call, otherwise it is ignored.
+   * @param threads_count Number of threads, 0 means default
+   */
+  static void set_threads_count(const uint32_t threads_count);
+
+  /**
+   * @brief Gets process-wide reactor instance.
+   * Reactor threads are started on first call and live until process exit.
+   */
+  static IoReactor& instance();
+
+  /**
+   * @brief Registers descriptor for readable, writable and error events
+   * @param fd Descriptor to watch, it is not owned by reactor
+   * @param handler Handler to notify
+   * @return True if descriptor has been registered
+   */
+  bool Add(const int fd, IoReactorHandler* handler);
+
+  /**
+   * @brief Unregisters handler descriptor, should be called before
+   * descriptor is closed.
+   * If handler is notified in reactor thread at the moment and method is
+   * called from any other thread it waits for notification completion,
+   * so handler can be safely destroyed after method returns. Tasks deferred
+   * by notification are not waited for.
+   * @param fd Registered descriptor
+   * @param handler Registered handler
+   */
+  void Remove(const int fd, IoReactorHandler* handler);
+
+  /**
+   * @brief Runs task once notification running in current reactor thread
+   * is completed, so the task is not waited for by Remove and may take any
+   * lock. Tasks are run in order they have been deferred. Task must not
+   * access handler as it may be destroyed by then.
+   * If called outside of notification task is run right away.
+   * @param task Task to run
+   */
+  void Defer(const Task& task);
+
+  /**
+   * @brief Waits until notifications running at the moment and tasks
+   * deferred by them are completed, so objects used by deferred tasks
+   * may be destroyed after method returns.
+   * Must not be called from reactor thread or under locks deferred tasks
+   * may take.
+   */
+  void Flush();
+
+  /**
+   * @brief Schedules kWakeUp notification of registered handler.
+   * Several wake-ups requested before notification are merged into one.
+   */
+  void WakeUp(IoReactorHandler* handler);
+
+  /**
+   * @brief Gets number of reactor threads
+   */
+  size_t threads_count() const {
+    return workers_.size();
+  }
+
+ private:
+  class Worker : public threads::ThreadDelegate {
+   public:
+    explicit Worker(const uint32_t index);
+    bool Add(const int fd, IoReactorHandler* handler);
+    void Remove(const int fd, IoReactorHandler* handler);
+    void WakeUp(IoReactorHandler* handler);
+    void threadMain() OVERRIDE;
+
+    /**
+     * @brief Queues task to be run after current notification
+     * @return False if worker is not running notification in current thread
+     */
+    bool Defer(const Task& task);
+    void Flush();
+
+   private:
+    /**
+     * @brief Notifies handler if registration is still active
+     * and runs tasks deferred by notification
+     * @param id Handler registration identifier
+     */
+    void Dispatch(const uint64_t id, const uint32_t events);
+
+    /**
+     * @brief Notifies handlers woken up since previous call
+     */
+    void DispatchWakeUps();
+
+    int epoll_fd_;
+    int event_fd_;
+
+    sync_primitives::Lock lock_;
+    sync_primitives::ConditionalVariable dispatch_done_;
+    std::unordered_map<uint64_t, IoReactorHandler*> handlers_;
+    std::vector<uint64_t> woken_handlers_;
+    uint64_t last_id_;
+
+    /**
+     * @brief Handler which is notified at the moment
+     */
+    IoReactorHandler* dispatching_;
+
+    /**
+     * @brief Tasks deferred by running notification, used by worker
+     * thread only
+     */
+    std::vector<Task> deferred_tasks_;
+    bool in_dispatch_;
+
+    /**
+     * @brief Numbers of the last started and the last completed
+     * notifications including their deferred tasks
+     */
+    uint64_t started_dispatches_;
+    uint64_t completed_dispatches_;
+    threads::Thread* thread_;
+  };
+
+  explicit IoReactor(const uint32_t threads_count);
+
+  static Worker* WorkerOf(IoReactorHandler* handler) {
+    return static_cast<Worker*>(handler->worker_.load());
+  }
+
+  static std::atomic<uint32_t> configured_threads_count_;
+
+  std::vector<Worker*> workers_;
+  std::atomic<uint32_t> next_worker_;
+
+  DISALLOW_COPY_AND_ASSIGN(IoReactor);
+};
+
+}  // namespace transport_adapter
+}  // namespace transport_manager
+
+#endif  // SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_IO_REACTOR_H_
@@ -35,12 +35,15 @@
 #ifndef SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_THREADED_SOCKET_CONNECTION_H_
 #define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_TRANSPORT_ADAPTER_THREADED_SOCKET_CONNECTION_H_
 
-#include <poll.h>
-#include <queue>
+#include <sys/uio.h>
+#include <deque>
+#include <functional>
 
 #include <atomic>
 #include "protocol/common.h"
+#include "protocol/receive_buffer.h"
 #include "transport_manager/transport_adapter/connection.h"
+#include "transport_manager/transport_adapter/io_reactor.h"
 #include "utils/lock.h"
 #include "utils/threads/thread_delegate.h"
 
@@ -55,8 +58,10 @@ class TransportAdapterController;
 
 /**
  * @brief Class responsible for communication over sockets.
+ * Socket is served by shared IoReactor thread, own thread is used
+ * only to establish connection which has no socket on start.
  */
-class ThreadedSocketConnection : public Connection {
+class ThreadedSocketConnection : public Connection, private IoReactorHandler {
  public:
   /**
    * @brief Send data frame.
@@ -77,9 +82,11 @@ class ThreadedSocketConnection : public Connection {
   void Terminate() OVERRIDE;
 
   /**
-   * @brief Start thread creation.
+   * @brief Start serving connection. If socket has been set already it is
+   * registered in I/O reactor right away, otherwise thread is created
+   * to establish connection first.
    *
-   * @return Information about possible reason of thread creation error.
+   * @return Information about possible reason of start error.
    */
   TransportAdapter::Error Start();
 
@@ -170,7 +177,8 @@ class ThreadedSocketConnection : public Connection {
 
   /**
    * @brief This method will ensure that thread has finished running and then it
-   * will delete this thread.
+   * will delete this thread. Also removes socket from I/O reactor, so
+   * connection is not notified anymore after method returns.
    */
   void StopAndJoinThread();
 
@@ -185,12 +193,23 @@ class ThreadedSocketConnection : public Connection {
     ThreadedSocketConnection* connection_;
   };
 
-  int read_fd_;
-  int write_fd_;
+  typedef std::function<void(TransportAdapterController* controller,
+                             const DeviceUID& device_uid,
+                             const ApplicationHandle& app_handle)>
+      ControllerNotification;
+
   void threadMain();
-  void Transmit();
+  void OnIoEvents(const uint32_t events) OVERRIDE;
+
+  /**
+   * @brief Passes notification to controller. Notifications made by reactor
+   * thread are deferred until reactor notification is completed, so
+   * controller locks are never taken while IoReactor::Remove waits for it.
+   * @param notification Notification to pass, it must not access connection
+   */
+  void NotifyController(const ControllerNotification& notification);
+  bool EstablishConnection();
   void Finalize();
-  TransportAdapter::Error Notify() const;
   bool Receive();
   bool Send();
   void Abort();
@@ -199,13 +218,54 @@ class ThreadedSocketConnection : public Connection {
   /**
    * @brief Frames that must be sent to remote device.
    **/
-  typedef std::queue<protocol_handler::RawMessagePtr> FrameQueue;
+  typedef std::deque<protocol_handler::RawMessagePtr> FrameQueue;
   FrameQueue frames_to_send_;
   mutable sync_primitives::Lock frames_to_send_mutex_;
 
+  /**
+   * @brief Frames taken from frames_to_send_ which socket has not accepted
+   * completely yet, used by reactor thread only.
+   **/
+  FrameQueue pending_frames_;
+
+  /**
+   * @brief Amount of bytes of the first pending frame sent already
+   **/
+  size_t pending_offset_;
+
+  /**
+   * @brief Maximum amount of data parts passed to single sendmsg() call
+   **/
+  static const size_t kMaxSendSegments = 64u;
+
+  /**
+   * @brief Fills data parts of queued frames to be sent with single call
+   * @param frames Frames to send
+   * @param offset Amount of bytes of the first frame sent already
+   * @param segments Array of kMaxSendSegments elements to fill
+   * @return Amount of filled segments
+   **/
+  static size_t FillSendSegments(const FrameQueue& frames,
+                                 size_t offset,
+                                 struct iovec* segments);
+
+  /**
+   * @brief Slab incoming data is read into, used by reactor thread only.
+   **/
+  protocol_handler::ReceiveBuffer receive_buffer_;
+
+  /**
+   * @brief Set if data left in socket once receive budget has been spent,
+   * used by reactor thread only.
+   **/
+  bool receive_pending_;
+
   std::atomic_int socket_;
-  bool terminate_flag_;
+  std::atomic_bool terminate_flag_;
   bool unexpected_disconnect_;
+  bool established_;
+  std::atomic_bool started_;
+  std::atomic_bool finalized_;
   const DeviceUID device_uid_;
   const ApplicationHandle app_handle_;
   threads::Thread* thread_;
@@ -55,11 +55,13 @@
 #endif  // TELEMETRY_MONITOR
 #include "transport_manager/transport_adapter/transport_adapter_event.h"
 #include "transport_manager/transport_manager_settings.h"
+#include "utils/mpsc_ring_queue.h"
 #include "utils/threads/message_loop_thread.h"
 
 namespace transport_manager {
 
-typedef threads::MessageLoopThread<std::queue<protocol_handler::RawMessagePtr> >
+typedef threads::MessageLoopThread<
+    utils::MpscRingQueue<protocol_handler::RawMessagePtr> >
     RawMessageLoopThread;
 typedef threads::MessageLoopThread<std::queue<TransportAdapterEvent> >
     TransportAdapterEventLoopThread;
@@ -307,6 +309,17 @@ class TransportManagerImpl
   void Handle(::protocol_handler::RawMessagePtr msg);
   void Handle(TransportAdapterEvent msg);
 
+  /**
+   * @brief Sends batch of messages taken from the message queue at once.
+   * Connection is looked up and connections lock is taken once for each
+   * run of consecutive messages of the same connection.
+   *
+   * @param messages Messages to send.
+   **/
+  void HandleBatch(const std::vector<protocol_handler::RawMessagePtr>& messages)
+      OVERRIDE;
+  using TransportAdapterEventLoopThread::Handler::HandleBatch;
+
   /**
    * @brief Post event to the container of events.
    *
@@ -451,6 +464,22 @@ class TransportManagerImpl
    */
   ConnectionInternal* GetConnection(const ConnectionUID id);
 
+  /**
+   * @brief Blocks until events processing is activated.
+   */
+  void WaitForEventsProcessing();
+
+  /**
+   * @brief Passes message to transport adapter of the connection or
+   * notifies listeners about send failure.
+   *
+   * @param connection Connection to send message to, may be NULL.
+   * @param msg Message to send.
+   * @note Should be called under connections_lock_.
+   */
+  void SendToTransportAdapter(ConnectionInternal* connection,
+                              ::protocol_handler::RawMessagePtr msg);
+
   /**
    * @brief Returns connection from connections list by device unique id
    * and application handle
@@ -32,10 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_WEBSOCKET_SERVER_WEBSOCKET_CONNECTION_H_
 
 #include <memory>
-#include <queue>
 #include "transport_manager/transport_adapter/connection.h"
-#include "utils/message_queue.h"
-#include "utils/threads/thread.h"
 
 #ifdef ENABLE_SECURITY
 #include "transport_manager/websocket_server/websocket_secure_session.h"
@@ -46,10 +43,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace transport_manager {
 namespace transport_adapter {
 
-using ::utils::MessageQueue;
-
-typedef std::queue<Message> AsyncQueue;
-
 class TransportAdapterController;
 
 template <typename Session = WebSocketSession<> >
@@ -93,27 +86,6 @@ class WebSocketConnection
   TransportAdapterController* controller_;
 
   std::atomic_bool shutdown_;
-
-  MessageQueue<Message, AsyncQueue> message_queue_;
-
-  class LoopThreadDelegate : public threads::ThreadDelegate {
-   public:
-    LoopThreadDelegate(MessageQueue<Message, AsyncQueue>* message_queue,
-                       DataWriteCallback data_write);
-
-    virtual void threadMain() OVERRIDE;
-    virtual void exitThreadMain() OVERRIDE;
-
-    void SetShutdown();
-
-   private:
-    void DrainQueue();
-    MessageQueue<Message, AsyncQueue>& message_queue_;
-    DataWriteCallback data_write_;
-  };
-
-  LoopThreadDelegate* thread_delegate_;
-  threads::Thread* thread_;
 };
 
 }  // namespace transport_adapter
@@ -42,6 +42,7 @@
 #include "transport_manager/transport_adapter/client_connection_listener.h"
 #include "transport_manager/transport_manager_settings.h"
 #include "transport_manager/websocket_server/websocket_connection.h"
+#include "utils/lock.h"
 
 namespace transport_manager {
 namespace transport_adapter {
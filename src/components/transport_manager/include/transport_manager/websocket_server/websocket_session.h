@@ -32,9 +32,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SRC_COMPONENTS_TRANSPORT_MANAGER_INCLUDE_TRANSPORT_MANAGER_WEBSOCKET_SERVER_WEBSOCKET_SESSION_H_
 
 #include <boost/asio/bind_executor.hpp>
+#include <boost/asio/strand.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
+#include <atomic>
+#include <deque>
 #include <functional>
+#include <vector>
 
 #include "protocol/raw_message.h"
 #include "transport_manager/transport_adapter/transport_adapter.h"
@@ -88,21 +92,81 @@ class WebSocketSession
 
   virtual void AsyncRead(boost::system::error_code ec);
 
+  /**
+   * @brief Queues message to be written asynchronously.
+   * Data send done or failed callback is called from I/O thread
+   * once message has been written.
+   */
   virtual void WriteDown(Message message);
 
+  /**
+   * @brief Checks if amount of queued data has reached the high-water mark,
+   * so further messages should not be queued until it is written.
+   */
+  virtual bool IsWriteQueueFull() const;
+
+  /**
+   * @brief Reports I/O error from I/O thread, so the caller is not blocked
+   * by connection abort. Error is reported once and not after shutdown.
+   */
+  virtual void PostIOError();
+
   virtual void Read(boost::system::error_code ec,
                     std::size_t bytes_transferred);
 
+  /**
+   * @brief Closes socket. Messages which have not been written are
+   * reported as failed afterwards from I/O thread.
+   */
   virtual bool Shutdown();
 
  protected:
+  using Strand = boost::asio::strand<boost::asio::io_context::executor_type>;
+
+  /**
+   * @brief Starts writing of the first queued message, each message is
+   * written as separate websocket message. Called on the strand.
+   */
+  void WriteQueued();
+
+  void OnWrite(boost::system::error_code ec, std::size_t bytes_transferred);
+
+  /**
+   * @brief Reports queued messages as failed. Messages being written
+   * at the moment are reported by write completion handler, as their
+   * data is used until then. Called on the strand.
+   */
+  void FailQueuedWrites();
+
+  /**
+   * @brief Decreases amount of queued data
+   */
+  void ReleaseQueuedBytes(const std::size_t size);
+
   tcp::socket socket_;
+  Strand strand_;
   websocket::stream<ExecutorType> ws_;
   boost::beast::flat_buffer buffer_;
   DataReceiveCallback data_receive_;
   DataSendDoneCallback data_send_done_;
   DataSendFailedCallback data_send_failed_;
   OnIOErrorCallback on_io_error_;
+
+  /**
+   * @brief Messages waiting to be written and being written at the moment,
+   * accessed on the strand only.
+   */
+  std::deque<Message> write_queue_;
+  Message writing_;
+  std::vector<boost::asio::const_buffer> write_buffers_;
+  bool accepted_;
+
+  /**
+   * @brief Amount of queued data including the one being written
+   */
+  std::atomic<std::size_t> queued_bytes_;
+  std::atomic_bool io_error_posted_;
+  std::atomic_bool shutdown_;
 };
 
 }  // namespace transport_adapter
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "transport_manager/transport_adapter/io_reactor.h"
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+
+#include "utils/logger.h"
+
+namespace transport_manager {
+namespace transport_adapter {
+
+SDL_CREATE_LOG_VARIABLE("TransportManager")
+
+namespace {
+const uint32_t kDefaultThreadsCount = 2u;
+const int kMaxEventsPerWait = 64;
+
+/**
+ * @brief Identifier of eventfd registration, handlers get identifiers
+ * starting from the next one
+ */
+const uint64_t kWakeUpEventId = 0u;
+}  // namespace
+
+std::atomic<uint32_t> IoReactor::configured_threads_count_(
+    kDefaultThreadsCount);
+
+void IoReactor::set_threads_count(const uint32_t threads_count) {
+  configured_threads_count_ = threads_count ? threads_count
+                                            : kDefaultThreadsCount;
+}
+
+IoReactor& IoReactor::instance() {
+  // Reactor is intentionally never destroyed: connections owned by static
+  // objects may be removed during static deinitialization
+  static IoReactor* reactor = new IoReactor(configured_threads_count_);
+  return *reactor;
+}
+
+IoReactor::IoReactor(const uint32_t threads_count) : next_worker_(0u) {
+  SDL_LOG_DEBUG("Starting I/O reactor with " << threads_count << " threads");
+  for (uint32_t i = 0; i < threads_count; ++i) {
+    workers_.push_back(new Worker(i));
+  }
+}
+
+bool IoReactor::Add(const int fd, IoReactorHandler* handler) {
+  DCHECK_OR_RETURN(handler && -1 != fd, false);
+  if (!handler->worker_) {
+    // Handlers are spread between threads evenly. Handler keeps the first
+    // assigned thread, even if it is assigned concurrently with wake-up
+    void* expected = NULL;
+    handler->worker_.compare_exchange_strong(
+        expected, workers_[next_worker_++ % workers_.size()]);
+  }
+  return WorkerOf(handler)->Add(fd, handler);
+}
+
+void IoReactor::Remove(const int fd, IoReactorHandler* handler) {
+  DCHECK_OR_RETURN_VOID(handler);
+  if (handler->worker_) {
+    WorkerOf(handler)->Remove(fd, handler);
+  }
+}
+
+void IoReactor::WakeUp(IoReactorHandler* handler) {
+  DCHECK_OR_RETURN_VOID(handler);
+  if (handler->worker_) {
+    WorkerOf(handler)->WakeUp(handler);
+  }
+}
+
+void IoReactor::Defer(const Task& task) {
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    if (workers_[i]->Defer(task)) {
+      return;
+    }
+  }
+  task();
+}
+
+void IoReactor::Flush() {
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    workers_[i]->Flush();
+  }
+}
+
+IoReactor::Worker::Worker(const uint32_t index)
+    : epoll_fd_(epoll_create1(EPOLL_CLOEXEC))
+    , event_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    , last_id_(kWakeUpEventId)
+    , dispatching_(NULL)
+    , in_dispatch_(false)
+    , started_dispatches_(0u)
+    , completed_dispatches_(0u)
+    , thread_(NULL) {
+  DCHECK(-1 != epoll_fd_);
+  DCHECK(-1 != event_fd_);
+  struct epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.u64 = kWakeUpEventId;
+  if (-1 == epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, event_fd_, &event)) {
+    SDL_LOG_ERROR_WITH_ERRNO("Failed to add eventfd to epoll");
+  }
+  const std::string thread_name = "IoReactor " + std::to_string(index);
+  thread_ = threads::CreateThread(thread_name.c_str(), this);
+  thread_->Start();
+}
+
+bool IoReactor::Worker::Add(const int fd, IoReactorHandler* handler) {
+  sync_primitives::AutoLock auto_lock(lock_);
+  const uint64_t id = ++last_id_;
+  struct epoll_event event = {};
+  event.events = EPOLLIN | EPOLLPRI | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+  event.data.u64 = id;
+  if (-1 == epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event)) {
+    SDL_LOG_ERROR_WITH_ERRNO("Failed to add descriptor " << fd
+                                                         << " to epoll");
+    return false;
+  }
+  handler->id_ = id;
+  handlers_[id] = handler;
+  return true;
+}
+
+void IoReactor::Worker::Remove(const int fd, IoReactorHandler* handler) {
+  sync_primitives::AutoLock auto_lock(lock_);
+  if (handlers_.erase(handler->id_)) {
+    if (-1 == epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, NULL)) {
+      SDL_LOG_WARN("Failed to remove descriptor " << fd << " from epoll");
+    }
+  }
+  if (handler->wakeup_pending_) {
+    handler->wakeup_pending_ = false;
+    woken_handlers_.erase(std::remove(woken_handlers_.begin(),
+                                      woken_handlers_.end(),
+                                      handler->id_),
+                          woken_handlers_.end());
+  }
+  handler->id_ = 0u;
+  if (thread_->IsCurrentThread()) {
+    return;
+  }
+  while (dispatching_ == handler) {
+    dispatch_done_.Wait(auto_lock);
+  }
+}
+
+void IoReactor::Worker::WakeUp(IoReactorHandler* handler) {
+  sync_primitives::AutoLock auto_lock(lock_);
+  if (handler->wakeup_pending_ || 0u == handler->id_) {
+    return;
+  }
+  handler->wakeup_pending_ = true;
+  woken_handlers_.push_back(handler->id_);
+  const uint64_t value = 1u;
+  if (sizeof(value) != write(event_fd_, &value, sizeof(value))) {
+    SDL_LOG_ERROR_WITH_ERRNO("Failed to wake up reactor thread");
+  }
+}
+
+bool IoReactor::Worker::Defer(const Task& task) {
+  // Flag is changed by worker thread only, so it is safe to read it
+  // from the same thread without lock
+  if (!thread_->IsCurrentThread() || !in_dispatch_) {
+    return false;
+  }
+  deferred_tasks_.push_back(task);
+  return true;
+}
+
+void IoReactor::Worker::Flush() {
+  DCHECK_OR_RETURN_VOID(!thread_->IsCurrentThread());
+  sync_primitives::AutoLock auto_lock(lock_);
+  const uint64_t last_started = started_dispatches_;
+  while (completed_dispatches_ < last_started) {
+    dispatch_done_.Wait(auto_lock);
+  }
+}
+
+void IoReactor::Worker::threadMain() {
+  struct epoll_event events[kMaxEventsPerWait];
+  while (true) {
+    const int count = epoll_wait(epoll_fd_, events, kMaxEventsPerWait, -1);
+    if (-1 == count) {
+      if (EINTR != errno) {
+        SDL_LOG_ERROR_WITH_ERRNO("epoll_wait failed");
+      }
+      continue;
+    }
+    for (int i = 0; i < count; ++i) {
+      const uint64_t id = events[i].data.u64;
+      if (kWakeUpEventId == id) {
+        DispatchWakeUps();
+        continue;
+      }
+      uint32_t handler_events = 0u;
+      if (events[i].events & (EPOLLIN | EPOLLPRI | EPOLLRDHUP)) {
+        handler_events |= IoReactorHandler::kReadable;
+      }
+      if (events[i].events & EPOLLOUT) {
+        handler_events |= IoReactorHandler::kWritable;
+      }
+      if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+        handler_events |= IoReactorHandler::kError;
+      }
+      Dispatch(id, handler_events);
+    }
+  }
+}
+
+void IoReactor::Worker::Dispatch(const uint64_t id, const uint32_t events) {
+  IoReactorHandler* handler = NULL;
+  {
+    sync_primitives::AutoLock auto_lock(lock_);
+    // Handler may have been removed after events were fetched
+    auto it = handlers_.find(id);
+    if (handlers_.end() == it) {
+      return;
+    }
+    handler = it->second;
+    dispatching_ = handler;
+    ++started_dispatches_;
+  }
+  in_dispatch_ = true;
+  handler->OnIoEvents(events);
+  in_dispatch_ = false;
+  {
+    sync_primitives::AutoLock auto_lock(lock_);
+    dispatching_ = NULL;
+    dispatch_done_.Broadcast();
+  }
+  // Handler may be destroyed from now on
+  std::vector<Task> tasks;
+  tasks.swap(deferred_tasks_);
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    tasks[i]();
+  }
+  sync_primitives::AutoLock auto_lock(lock_);
+  completed_dispatches_ = started_dispatches_;
+  dispatch_done_.Broadcast();
+}
+
+void IoReactor::Worker::DispatchWakeUps() {
+  uint64_t value = 0u;
+  if (-1 == read(event_fd_, &value, sizeof(value)) && EAGAIN != errno) {
+    SDL_LOG_ERROR_WITH_ERRNO("Failed to clear reactor eventfd");
+  }
+  std::vector<uint64_t> woken_handlers;
+  {
+    sync_primitives::AutoLock auto_lock(lock_);
+    woken_handlers.swap(woken_handlers_);
+    for (size_t i = 0; i < woken_handlers.size(); ++i) {
+      auto it = handlers_.find(woken_handlers[i]);
+      if (handlers_.end() != it) {
+        it->second->wakeup_pending_ = false;
+      }
+    }
+  }
+  for (size_t i = 0; i < woken_handlers.size(); ++i) {
+    Dispatch(woken_handlers[i], IoReactorHandler::kWakeUp);
+  }
+}
+
+}  // namespace transport_adapter
+}  // namespace transport_manager
@@ -31,12 +31,12 @@
  */
 
 #include <errno.h>
-#include <fcntl.h>
 #include <memory.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include <algorithm>
+#include <functional>
 
 #include "utils/logger.h"
 #include "utils/threads/thread.h"
@@ -48,36 +48,44 @@ namespace transport_manager {
 namespace transport_adapter {
 SDL_CREATE_LOG_VARIABLE("TransportManager")
 
+using std::placeholders::_1;
+using std::placeholders::_2;
+using std::placeholders::_3;
+
+namespace {
+/**
+ * @brief Amount of data read from connection per reactor notification.
+ * The rest is read on the next notification, so connection which streams
+ * data does not starve other connections served by the same thread.
+ */
+const size_t kReceiveBudget =
+    4u * protocol_handler::ReceiveBuffer::kDefaultSlabSize;
+}  // namespace
+
 ThreadedSocketConnection::ThreadedSocketConnection(
     const DeviceUID& device_id,
     const ApplicationHandle& app_handle,
     TransportAdapterController* controller)
-    : read_fd_(-1)
-    , write_fd_(-1)
-    , controller_(controller)
+    : controller_(controller)
     , frames_to_send_()
     , frames_to_send_mutex_()
+    , pending_frames_()
+    , pending_offset_(0)
+    , receive_buffer_()
+    , receive_pending_(false)
     , socket_(-1)
     , terminate_flag_(false)
     , unexpected_disconnect_(false)
+    , established_(false)
+    , started_(false)
+    , finalized_(false)
     , device_uid_(device_id)
     , app_handle_(app_handle)
-    , thread_(nullptr) {
-  const std::string thread_name = std::string("Socket ") + device_handle();
-  thread_ = threads::CreateThread(thread_name.c_str(),
-                                  new SocketConnectionDelegate(this));
-}
+    , thread_(nullptr) {}
 
 ThreadedSocketConnection::~ThreadedSocketConnection() {
   SDL_LOG_AUTO_TRACE();
   DCHECK(nullptr == thread_);
-
-  if (-1 != read_fd_) {
-    close(read_fd_);
-  }
-  if (-1 != write_fd_) {
-    close(write_fd_);
-  }
 }
 
 void ThreadedSocketConnection::StopAndJoinThread() {
@@ -88,6 +96,14 @@ void ThreadedSocketConnection::StopAndJoinThread() {
     threads::DeleteThread(thread_);
     thread_ = nullptr;
   }
+  // Waits for notification running in reactor thread, if any. It does not
+  // take controller locks, so caller may hold them
+  IoReactor::instance().Remove(socket_, this);
+  if (started_ && !finalized_) {
+    Finalize();
+  } else {
+    ShutdownAndCloseSocket();
+  }
 }
 
 void ThreadedSocketConnection::Abort() {
@@ -98,25 +114,26 @@ void ThreadedSocketConnection::Abort() {
 
 TransportAdapter::Error ThreadedSocketConnection::Start() {
   SDL_LOG_AUTO_TRACE();
-  int fds[2];
-  const int pipe_ret = pipe(fds);
-  if (0 == pipe_ret) {
-    SDL_LOG_DEBUG("pipe created");
-    read_fd_ = fds[0];
-    write_fd_ = fds[1];
-  } else {
-    SDL_LOG_ERROR("pipe creation failed");
-    return TransportAdapter::FAIL;
-  }
-  const int fcntl_ret =
-      fcntl(read_fd_, F_SETFL, fcntl(read_fd_, F_GETFL) | O_NONBLOCK);
-  if (0 != fcntl_ret) {
-    SDL_LOG_ERROR("fcntl failed");
-    return TransportAdapter::FAIL;
+  started_ = true;
+  if (-1 != socket_) {
+    // Connection is established already, so it is completed
+    // in reactor thread on the first notification
+    if (!IoReactor::instance().Add(socket_, this)) {
+      SDL_LOG_ERROR("Failed to register socket in I/O reactor");
+      started_ = false;
+      return TransportAdapter::FAIL;
+    }
+    IoReactor::instance().WakeUp(this);
+    SDL_LOG_INFO("socket registered in I/O reactor");
+    return TransportAdapter::OK;
   }
 
+  const std::string thread_name = std::string("Socket ") + device_handle();
+  thread_ = threads::CreateThread(thread_name.c_str(),
+                                  new SocketConnectionDelegate(this));
   if (!thread_->Start()) {
     SDL_LOG_ERROR("thread creation failed");
+    started_ = false;
     return TransportAdapter::FAIL;
   }
   SDL_LOG_INFO("thread created");
@@ -125,48 +142,74 @@ TransportAdapter::Error ThreadedSocketConnection::Start() {
 
 void ThreadedSocketConnection::Finalize() {
   SDL_LOG_AUTO_TRACE();
+  if (finalized_.exchange(true)) {
+    return;
+  }
+  // Socket has to be unregistered before it is closed, otherwise
+  // its number may be reused by another connection in the meantime
+  IoReactor::instance().Remove(socket_, this);
   if (unexpected_disconnect_) {
     SDL_LOG_DEBUG("unexpected_disconnect");
-    controller_->ConnectionAborted(
-        device_handle(), application_handle(), CommunicationError());
+    NotifyController(std::bind(&TransportAdapterController::ConnectionAborted,
+                               _1,
+                               _2,
+                               _3,
+                               CommunicationError()));
   } else {
     SDL_LOG_DEBUG("not unexpected_disconnect");
-    controller_->ConnectionFinished(device_handle(), application_handle());
+    NotifyController(
+        std::bind(&TransportAdapterController::ConnectionFinished, _1, _2, _3));
   }
 
   ShutdownAndCloseSocket();
-}
 
-TransportAdapter::Error ThreadedSocketConnection::Notify() const {
-  SDL_LOG_AUTO_TRACE();
-  if (-1 == write_fd_) {
-    SDL_LOG_ERROR_WITH_ERRNO(
-        "Failed to wake up connection thread for connection " << this);
-    SDL_LOG_TRACE("exit with TransportAdapter::BAD_STATE");
-    return TransportAdapter::BAD_STATE;
+  while (!pending_frames_.empty()) {
+    SDL_LOG_INFO("removing message");
+    ::protocol_handler::RawMessagePtr message = pending_frames_.front();
+    pending_frames_.pop_front();
+    NotifyController(std::bind(&TransportAdapterController::DataSendFailed,
+                               _1,
+                               _2,
+                               _3,
+                               message,
+                               DataSendError()));
   }
-  uint8_t c = 0;
-  if (1 != write(write_fd_, &c, 1)) {
-    SDL_LOG_ERROR_WITH_ERRNO(
-        "Failed to wake up connection thread for connection " << this);
-    return TransportAdapter::FAIL;
+  sync_primitives::AutoLock auto_lock(frames_to_send_mutex_);
+  while (!frames_to_send_.empty()) {
+    SDL_LOG_INFO("removing message");
+    ::protocol_handler::RawMessagePtr message = frames_to_send_.front();
+    frames_to_send_.pop_front();
+    NotifyController(std::bind(&TransportAdapterController::DataSendFailed,
+                               _1,
+                               _2,
+                               _3,
+                               message,
+                               DataSendError()));
   }
-  return TransportAdapter::OK;
 }
 
 TransportAdapter::Error ThreadedSocketConnection::SendData(
     ::protocol_handler::RawMessagePtr message) {
   SDL_LOG_AUTO_TRACE();
-  sync_primitives::AutoLock auto_lock(frames_to_send_mutex_);
-  frames_to_send_.push(message);
-  return Notify();
+  {
+    sync_primitives::AutoLock auto_lock(frames_to_send_mutex_);
+    frames_to_send_.push_back(message);
+  }
+  IoReactor::instance().WakeUp(this);
+  return TransportAdapter::OK;
 }
 
 TransportAdapter::Error ThreadedSocketConnection::Disconnect() {
   SDL_LOG_AUTO_TRACE();
   terminate_flag_ = true;
-  ShutdownAndCloseSocket();
-  return Notify();
+  // Socket is closed by reactor thread once it is unregistered,
+  // shutdown is enough to interrupt pending operations
+  const int socket = socket_;
+  if (-1 != socket && 0 != shutdown(socket, SHUT_RDWR)) {
+    SDL_LOG_WARN("Socket was unable to be shutdowned");
+  }
+  IoReactor::instance().WakeUp(this);
+  return TransportAdapter::OK;
 }
 
 void ThreadedSocketConnection::Terminate() {
@@ -174,30 +217,72 @@ void ThreadedSocketConnection::Terminate() {
   StopAndJoinThread();
 }
 
-void ThreadedSocketConnection::threadMain() {
+bool ThreadedSocketConnection::EstablishConnection() {
   SDL_LOG_AUTO_TRACE();
   ConnectError* connect_error = nullptr;
   if (!Establish(&connect_error)) {
     SDL_LOG_ERROR("Connection Establish failed");
     delete connect_error;
+    return false;
+  }
+  SDL_LOG_DEBUG("Connection established");
+  established_ = true;
+  NotifyController(
+      std::bind(&TransportAdapterController::ConnectDone, _1, _2, _3));
+  return true;
+}
+
+void ThreadedSocketConnection::threadMain() {
+  SDL_LOG_AUTO_TRACE();
+  if (!EstablishConnection()) {
     Abort();
-  } else {
-    SDL_LOG_DEBUG("Connection established");
-    controller_->ConnectDone(device_handle(), application_handle());
+    Finalize();
+    return;
   }
+  if (!IoReactor::instance().Add(socket_, this)) {
+    SDL_LOG_ERROR("Failed to register socket in I/O reactor");
+    Abort();
+    Finalize();
+    return;
+  }
+  // Frames queued and disconnection requested during Establish are
+  // handled in reactor thread
+  IoReactor::instance().WakeUp(this);
+}
 
-  while (!terminate_flag_) {
-    Transmit();
+void ThreadedSocketConnection::OnIoEvents(const uint32_t io_events) {
+  SDL_LOG_TRACE("Connection " << this << " events: " << io_events);
+  if (finalized_) {
+    return;
   }
-  SDL_LOG_DEBUG("Connection is to finalize");
-  Finalize();
-  sync_primitives::AutoLock auto_lock(frames_to_send_mutex_);
-  while (!frames_to_send_.empty()) {
-    SDL_LOG_INFO("removing message");
-    ::protocol_handler::RawMessagePtr message = frames_to_send_.front();
-    frames_to_send_.pop();
-    controller_->DataSendFailed(
-        device_handle(), application_handle(), message, DataSendError());
+  uint32_t events = io_events;
+  if (receive_pending_) {
+    // Reading has been interrupted by receive budget, no new edge
+    // is reported for data left in socket
+    receive_pending_ = false;
+    events |= kReadable;
+  }
+  if (terminate_flag_) {
+    // Disconnection has been requested, socket errors caused by
+    // its shutdown are not reported as unexpected disconnect
+  } else if (!established_ && !EstablishConnection()) {
+    Abort();
+  } else if (!Send()) {
+    SDL_LOG_ERROR("Send() failed ");
+    Abort();
+  } else if ((events & (kReadable | kError)) && !Receive()) {
+    // Data received before hang up is delivered first
+    SDL_LOG_ERROR("Receive() failed ");
+    Abort();
+  } else if ((events & kError) && !receive_pending_) {
+    // Error is reported by recv() once data left in socket is read
+    SDL_LOG_WARN("Connection " << this << " terminated");
+    Abort();
+  }
+
+  if (terminate_flag_) {
+    SDL_LOG_DEBUG("Connection is to finalize");
+    Finalize();
   }
 }
 
@@ -223,96 +308,36 @@ void ThreadedSocketConnection::ShutdownAndCloseSocket() {
   }
 }
 
-void ThreadedSocketConnection::Transmit() {
-  SDL_LOG_AUTO_TRACE();
-
-  const nfds_t kPollFdsSize = 2;
-  pollfd poll_fds[kPollFdsSize];
-  poll_fds[0].fd = socket_;
-
-  const bool is_queue_empty_on_poll = IsFramesToSendQueueEmpty();
-
-  poll_fds[0].events =
-      POLLIN | POLLPRI | (is_queue_empty_on_poll ? 0 : POLLOUT);
-  poll_fds[1].fd = read_fd_;
-  poll_fds[1].events = POLLIN | POLLPRI;
-
-  SDL_LOG_TRACE("poll " << this);
-  if (-1 == poll(poll_fds, kPollFdsSize, -1)) {
-    SDL_LOG_ERROR_WITH_ERRNO("poll failed for connection " << this);
-    Abort();
-    return;
-  }
-  SDL_LOG_TRACE("poll is ok " << this << " revents0: " << std::hex
-                              << poll_fds[0].revents << " revents1:" << std::hex
-                              << poll_fds[1].revents);
-  // error check
-  if (0 != (poll_fds[1].revents & (POLLERR | POLLHUP | POLLNVAL))) {
-    SDL_LOG_ERROR("Notification pipe for connection " << this << " terminated");
-    Abort();
-    return;
-  }
-
-  if (poll_fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
-    SDL_LOG_WARN("Connection " << this << " terminated");
-    Abort();
-    return;
-  }
-
-  // clear notifications
-  char buffer[256];
-  ssize_t bytes_read = -1;
-  do {
-    bytes_read = read(read_fd_, buffer, sizeof(buffer));
-  } while (bytes_read > 0);
-  if ((bytes_read < 0) && (EAGAIN != errno)) {
-    SDL_LOG_ERROR_WITH_ERRNO("Failed to clear notification pipe");
-    SDL_LOG_ERROR_WITH_ERRNO("poll failed for connection " << this);
-    Abort();
-    return;
-  }
-
-  const bool is_queue_empty = IsFramesToSendQueueEmpty();
-
-  // Send data if possible
-  if (!is_queue_empty && (poll_fds[0].revents & POLLOUT)) {
-    SDL_LOG_DEBUG("frames_to_send_ not empty() ");
-
-    // send data
-    const bool send_ok = Send();
-    if (!send_ok) {
-      SDL_LOG_ERROR("Send() failed ");
-      Abort();
-      return;
-    }
-  }
-
-  // receive data
-  if (poll_fds[0].revents & (POLLIN | POLLPRI)) {
-    const bool receive_ok = Receive();
-    if (!receive_ok) {
-      SDL_LOG_ERROR("Receive() failed ");
-      Abort();
-      return;
-    }
-  }
-}
-
 bool ThreadedSocketConnection::Receive() {
   SDL_LOG_AUTO_TRACE();
-  uint8_t buffer[4096];
   ssize_t bytes_read = -1;
+  size_t budget = kReceiveBudget;
 
   do {
-    bytes_read = recv(socket_, buffer, sizeof(buffer), MSG_DONTWAIT);
+    // Data is read directly into refcounted slab and passed further
+    // without copying
+    uint8_t* buffer = receive_buffer_.Prepare();
+    if (NULL == buffer) {
+      SDL_LOG_ERROR("No memory to receive data for connection " << this);
+      return false;
+    }
+    bytes_read = recv(
+        socket_, buffer, receive_buffer_.writable_size(), MSG_DONTWAIT);
 
     if (bytes_read > 0) {
       SDL_LOG_TRACE("Received " << bytes_read << " bytes for connection "
                                 << this);
-      ::protocol_handler::RawMessagePtr frame(
-          new protocol_handler::RawMessage(0, 0, buffer, bytes_read, false));
-      controller_->DataReceiveDone(
-          device_handle(), application_handle(), frame);
+      ::protocol_handler::RawMessagePtr frame =
+          receive_buffer_.Commit(bytes_read);
+      NotifyController(std::bind(
+          &TransportAdapterController::DataReceiveDone, _1, _2, _3, frame));
+      if (static_cast<size_t>(bytes_read) >= budget) {
+        SDL_LOG_TRACE("Receive budget of connection " << this << " is spent");
+        receive_pending_ = true;
+        IoReactor::instance().WakeUp(this);
+        return true;
+      }
+      budget -= bytes_read;
     } else if (bytes_read < 0) {
       if (EAGAIN != errno && EWOULDBLOCK != errno) {
         SDL_LOG_ERROR_WITH_ERRNO("recv() failed for connection " << this);
@@ -329,41 +354,102 @@ bool ThreadedSocketConnection::Receive() {
 
 bool ThreadedSocketConnection::Send() {
   SDL_LOG_AUTO_TRACE();
-  FrameQueue frames_to_send_local;
-
   {
     sync_primitives::AutoLock auto_lock(frames_to_send_mutex_);
-    std::swap(frames_to_send_local, frames_to_send_);
+    pending_frames_.insert(
+        pending_frames_.end(), frames_to_send_.begin(), frames_to_send_.end());
+    frames_to_send_.clear();
   }
 
-  size_t offset = 0;
-  while (!frames_to_send_local.empty()) {
-    SDL_LOG_INFO("frames_to_send is not empty");
-    ::protocol_handler::RawMessagePtr frame = frames_to_send_local.front();
+  // Several frames are sent with single call, frames kept in parts
+  // are sent without joining them
+  struct iovec segments[kMaxSendSegments];
+  while (!pending_frames_.empty()) {
+    struct msghdr message_header;
+    memset(&message_header, 0, sizeof(message_header));
+    message_header.msg_iov = segments;
+    message_header.msg_iovlen =
+        FillSendSegments(pending_frames_, pending_offset_, segments);
     const ssize_t bytes_sent =
-        ::send(socket_, frame->data() + offset, frame->data_size() - offset, 0);
+        ::sendmsg(socket_, &message_header, MSG_DONTWAIT);
 
     if (bytes_sent >= 0) {
       SDL_LOG_DEBUG("bytes_sent >= 0");
-      offset += bytes_sent;
-      if (offset == frame->data_size()) {
-        frames_to_send_local.pop();
-        offset = 0;
-        controller_->DataSendDone(device_handle(), application_handle(), frame);
+      size_t bytes_left = bytes_sent;
+      while (!pending_frames_.empty()) {
+        ::protocol_handler::RawMessagePtr frame = pending_frames_.front();
+        const size_t frame_bytes_left = frame->data_size() - pending_offset_;
+        if (bytes_left < frame_bytes_left) {
+          pending_offset_ += bytes_left;
+          break;
+        }
+        bytes_left -= frame_bytes_left;
+        pending_frames_.pop_front();
+        pending_offset_ = 0;
+        NotifyController(std::bind(
+            &TransportAdapterController::DataSendDone, _1, _2, _3, frame));
       }
+    } else if (EAGAIN == errno || EWOULDBLOCK == errno) {
+      // Sending is continued once socket becomes writable again
+      SDL_LOG_DEBUG("Socket buffer is full for connection " << this);
+      break;
     } else {
-      SDL_LOG_DEBUG("bytes_sent < 0");
       SDL_LOG_ERROR_WITH_ERRNO("Send failed for connection " << this);
-      frames_to_send_local.pop();
-      offset = 0;
-      controller_->DataSendFailed(
-          device_handle(), application_handle(), frame, DataSendError());
+      ::protocol_handler::RawMessagePtr frame = pending_frames_.front();
+      pending_frames_.pop_front();
+      pending_offset_ = 0;
+      NotifyController(std::bind(&TransportAdapterController::DataSendFailed,
+                                 _1,
+                                 _2,
+                                 _3,
+                                 frame,
+                                 DataSendError()));
     }
   }
 
   return true;
 }
 
+void ThreadedSocketConnection::NotifyController(
+    const ControllerNotification& notification) {
+  TransportAdapterController* controller = controller_;
+  const DeviceUID device_uid = device_uid_;
+  const ApplicationHandle app_handle = app_handle_;
+  IoReactor::instance().Defer(
+      [notification, controller, device_uid, app_handle]() {
+        notification(controller, device_uid, app_handle);
+      });
+}
+
+size_t ThreadedSocketConnection::FillSendSegments(const FrameQueue& frames,
+                                                  size_t offset,
+                                                  struct iovec* segments) {
+  using ::protocol_handler::RawMessage;
+  size_t count = 0;
+  for (FrameQueue::const_iterator it = frames.begin(); it != frames.end();
+       ++it) {
+    RawMessage::Segment frame_segments[RawMessage::kMaxSegments];
+    const size_t frame_segments_count = (*it)->GetSegments(frame_segments);
+    if (count + frame_segments_count > kMaxSendSegments) {
+      break;
+    }
+    for (size_t i = 0; i < frame_segments_count; ++i) {
+      const RawMessage::Segment& segment = frame_segments[i];
+      // Skip part of the first frame which has been sent already
+      const size_t skipped = std::min(offset, segment.size);
+      offset -= skipped;
+      if (skipped == segment.size) {
+        continue;
+      }
+      segments[count].iov_base =
+          const_cast<uint8_t*>(segment.data) + skipped;
+      segments[count].iov_len = segment.size - skipped;
+      ++count;
+    }
+  }
+  return count;
+}
+
 ThreadedSocketConnection::SocketConnectionDelegate::SocketConnectionDelegate(
     ThreadedSocketConnection* connection)
     : connection_(connection) {}
@@ -37,6 +37,7 @@
 
 #include "transport_manager/transport_adapter/client_connection_listener.h"
 #include "transport_manager/transport_adapter/device_scanner.h"
+#include "transport_manager/transport_adapter/io_reactor.h"
 #include "transport_manager/transport_adapter/server_connection_factory.h"
 #include "transport_manager/transport_adapter/transport_adapter_impl.h"
 #include "transport_manager/transport_adapter/transport_adapter_listener.h"
@@ -143,6 +144,11 @@ void TransportAdapterImpl::Terminate() {
       info.connection->Terminate();
     }
   }
+  if (!connections.empty()) {
+    // Socket connections notify adapter from I/O reactor thread,
+    // notifications must be completed before adapter is destroyed
+    IoReactor::instance().Flush();
+  }
   connections.clear();
 
   SDL_LOG_DEBUG("Connections deleted");
@@ -34,6 +34,7 @@
  */
 #include "transport_manager/transport_manager_default.h"
 #include "transport_manager/tcp/tcp_transport_adapter.h"
+#include "transport_manager/transport_adapter/io_reactor.h"
 #include "utils/logger.h"
 
 #ifdef BLUETOOTH_SUPPORT
@@ -114,6 +115,10 @@ int TransportManagerDefault::Init(
 
   const auto& settings = get_settings();
 
+  // Has to be set before the first socket connection is started
+  transport_adapter::IoReactor::set_threads_count(
+      settings.transport_manager_io_reactor_threads());
+
 #if defined(BLUETOOTH_SUPPORT)
   auto ta_bluetooth =
       ta_factory_.ta_bluetooth_creator_(last_state_wrapper, settings);
@@ -1351,15 +1351,46 @@ void TransportManagerImpl::SetTelemetryObserver(TMTelemetryObserver* observer) {
 
 void TransportManagerImpl::Handle(::protocol_handler::RawMessagePtr msg) {
   SDL_LOG_TRACE("enter");
+  WaitForEventsProcessing();
 
+  sync_primitives::AutoReadLock lock(connections_lock_);
+  SendToTransportAdapter(GetConnection(msg->connection_key()), msg);
+  SDL_LOG_TRACE("exit");
+}
+
+void TransportManagerImpl::HandleBatch(
+    const std::vector<protocol_handler::RawMessagePtr>& messages) {
+  SDL_LOG_TRACE("enter. Messages count: " << messages.size());
+  WaitForEventsProcessing();
+
+  std::vector<protocol_handler::RawMessagePtr>::const_iterator it =
+      messages.begin();
+  while (it != messages.end()) {
+    // Consecutive messages of the same connection are sent under single
+    // lock and lookup of the connection. Connection may be removed once
+    // lock is released, so it is looked up again for the next run.
+    const ConnectionUID connection_key = (*it)->connection_key();
+    sync_primitives::AutoReadLock lock(connections_lock_);
+    ConnectionInternal* connection = GetConnection(connection_key);
+    do {
+      SendToTransportAdapter(connection, *it);
+      ++it;
+    } while (it != messages.end() &&
+             (*it)->connection_key() == connection_key);
+  }
+  SDL_LOG_TRACE("exit");
+}
+
+void TransportManagerImpl::WaitForEventsProcessing() {
   if (!events_processing_is_active_) {
     SDL_LOG_DEBUG("Waiting for events handling unlock");
     sync_primitives::AutoLock auto_lock(events_processing_lock_);
     events_processing_cond_var_.Wait(auto_lock);
   }
+}
 
-  sync_primitives::AutoReadLock lock(connections_lock_);
-  ConnectionInternal* connection = GetConnection(msg->connection_key());
+void TransportManagerImpl::SendToTransportAdapter(
+    ConnectionInternal* connection, ::protocol_handler::RawMessagePtr msg) {
   if (connection == NULL) {
     SDL_LOG_WARN("Connection " << msg->connection_key() << " not found");
     RaiseEvent(&TransportManagerListener::OnTMMessageSendFailed,
@@ -1391,7 +1422,6 @@ void TransportManagerImpl::Handle(::protocol_handler::RawMessagePtr msg) {
                  msg);
     }
   }
-  SDL_LOG_TRACE("exit");
 }
 
 TransportManagerImpl::ConnectionInternal::ConnectionInternal(
@@ -47,20 +47,23 @@ WebSocketConnection<WebSocketSession<> >::WebSocketConnection(
     TransportAdapterController* controller)
     : device_uid_(device_uid)
     , app_handle_(app_handle)
+    // Session reports messages which have not been written after connection
+    // shutdown, so its data callbacks do not refer to connection
     , session_(new WebSocketSession<>(
           std::move(socket),
-          [this](Message frame) { DataReceive(frame); },
-          [this](Message frame) { DataSendDone(frame); },
-          [this](Message frame) { DataSendFailed(frame); },
+          [controller, device_uid, app_handle](Message frame) {
+            controller->DataReceiveDone(device_uid, app_handle, frame);
+          },
+          [controller, device_uid, app_handle](Message frame) {
+            controller->DataSendDone(device_uid, app_handle, frame);
+          },
+          [controller, device_uid, app_handle](Message frame) {
+            controller->DataSendFailed(
+                device_uid, app_handle, frame, DataSendError());
+          },
           [this]() { OnError(); }))
     , controller_(controller)
-    , shutdown_(false)
-    , thread_delegate_(new LoopThreadDelegate(
-          &message_queue_,
-          [this](Message frame) { session_->WriteDown(frame); }))
-    , thread_(threads::CreateThread("WS Async Send", thread_delegate_)) {
-  thread_->Start(threads::ThreadOptions());
-}
+    , shutdown_(false) {}
 
 #ifdef ENABLE_SECURITY
 template <>
@@ -75,18 +78,19 @@ WebSocketConnection<WebSocketSecureSession<> >::WebSocketConnection(
     , session_(new WebSocketSecureSession<>(
           std::move(socket),
           ctx,
-          [this](Message frame) { DataReceive(frame); },
-          [this](Message frame) { DataSendDone(frame); },
-          [this](Message frame) { DataSendFailed(frame); },
+          [controller, device_uid, app_handle](Message frame) {
+            controller->DataReceiveDone(device_uid, app_handle, frame);
+          },
+          [controller, device_uid, app_handle](Message frame) {
+            controller->DataSendDone(device_uid, app_handle, frame);
+          },
+          [controller, device_uid, app_handle](Message frame) {
+            controller->DataSendFailed(
+                device_uid, app_handle, frame, DataSendError());
+          },
           [this]() { OnError(); }))
     , controller_(controller)
-    , shutdown_(false)
-    , thread_delegate_(new LoopThreadDelegate(
-          &message_queue_,
-          [this](Message frame) { session_->WriteDown(frame); }))
-    , thread_(threads::CreateThread("WS Async Send", thread_delegate_)) {
-  thread_->Start(threads::ThreadOptions());
-}
+    , shutdown_(false) {}
 template class WebSocketConnection<WebSocketSecureSession<> >;
 #endif  // ENABLE_SECURITY
 
@@ -101,16 +105,11 @@ template <typename Session>
 void WebSocketConnection<Session>::OnError() {
   SDL_LOG_AUTO_TRACE();
 
-  if (IsShuttingDown()) {
+  if (shutdown_.exchange(true)) {
     SDL_LOG_DEBUG("Session is shutting down...");
     return;
   }
 
-  Message message_ptr;
-  while (message_queue_.pop(message_ptr)) {
-    DataSendFailed(message_ptr);
-  }
-
   controller_->ConnectionAborted(
       device_uid_, app_handle_, CommunicationError());
 
@@ -135,7 +134,17 @@ TransportAdapter::Error WebSocketConnection<Session>::SendData(
     return TransportAdapter::BAD_STATE;
   }
 
-  message_queue_.push(message);
+  // Sending thread is shared by all connections, so it must not wait for
+  // the client. Single frames are not dropped as it would corrupt multiframe
+  // messages, client which does not read is disconnected from I/O thread.
+  if (session_->IsWriteQueueFull()) {
+    SDL_LOG_WARN("Write queue of connection " << app_handle_
+                                              << " is full, aborting");
+    session_->PostIOError();
+    return TransportAdapter::FAIL;
+  }
+
+  session_->WriteDown(message);
 
   return TransportAdapter::OK;
 }
@@ -164,15 +173,8 @@ void WebSocketConnection<Session>::Run() {
 template <typename Session>
 void WebSocketConnection<Session>::Shutdown() {
   SDL_LOG_AUTO_TRACE();
-  shutdown_ = true;
-  if (thread_delegate_) {
+  if (!shutdown_.exchange(true)) {
     session_->Shutdown();
-    thread_delegate_->SetShutdown();
-    thread_->Stop(threads::Thread::kThreadSoftStop);
-    delete thread_delegate_;
-    thread_delegate_ = nullptr;
-    threads::DeleteThread(thread_);
-    thread_ = nullptr;
   }
 }
 
@@ -181,41 +183,6 @@ bool WebSocketConnection<Session>::IsShuttingDown() {
   return shutdown_;
 }
 
-template <typename Session>
-WebSocketConnection<Session>::LoopThreadDelegate::LoopThreadDelegate(
-    MessageQueue<Message, AsyncQueue>* message_queue,
-    DataWriteCallback data_write)
-    : message_queue_(*message_queue), data_write_(data_write) {}
-
-template <typename Session>
-void WebSocketConnection<Session>::LoopThreadDelegate::threadMain() {
-  while (!message_queue_.IsShuttingDown()) {
-    DrainQueue();
-    message_queue_.wait();
-  }
-  DrainQueue();
-}
-
-template <typename Session>
-void WebSocketConnection<Session>::LoopThreadDelegate::exitThreadMain() {
-  SetShutdown();
-}
-
-template <typename Session>
-void WebSocketConnection<Session>::LoopThreadDelegate::DrainQueue() {
-  Message message_ptr;
-  while (!message_queue_.IsShuttingDown() && message_queue_.pop(message_ptr)) {
-    data_write_(message_ptr);
-  }
-}
-
-template <typename Session>
-void WebSocketConnection<Session>::LoopThreadDelegate::SetShutdown() {
-  if (!message_queue_.IsShuttingDown()) {
-    message_queue_.Shutdown();
-  }
-}
-
 template class WebSocketConnection<WebSocketSession<> >;
 
 }  // namespace transport_adapter
@@ -39,6 +39,13 @@ SDL_CREATE_LOG_VARIABLE("WebSocketSession")
 
 using namespace boost::beast::websocket;
 
+namespace {
+/**
+ * @brief Amount of queued data connection stops accepting messages at
+ */
+const std::size_t kWriteQueueHighWaterMark = 4u * 1024u * 1024u;
+}  // namespace
+
 template <>
 WebSocketSession<tcp::socket&>::WebSocketSession(
     boost::asio::ip::tcp::socket socket,
@@ -47,11 +54,18 @@ WebSocketSession<tcp::socket&>::WebSocketSession(
     DataSendFailedCallback data_send_failed,
     OnIOErrorCallback on_error)
     : socket_(std::move(socket))
+    , strand_(static_cast<boost::asio::io_context&>(
+                  socket_.get_executor().context())
+                  .get_executor())
     , ws_(socket_)
     , data_receive_(data_receive)
     , data_send_done_(data_send_done)
     , data_send_failed_(data_send_failed)
-    , on_io_error_(on_error) {
+    , on_io_error_(on_error)
+    , accepted_(false)
+    , queued_bytes_(0u)
+    , io_error_posted_(false)
+    , shutdown_(false) {
   ws_.binary(true);
 }
 
@@ -65,11 +79,18 @@ WebSocketSession<ssl::stream<tcp::socket&> >::WebSocketSession(
     DataSendFailedCallback data_send_failed,
     OnIOErrorCallback on_error)
     : socket_(std::move(socket))
+    , strand_(static_cast<boost::asio::io_context&>(
+                  socket_.get_executor().context())
+                  .get_executor())
     , ws_(socket_, ctx)
     , data_receive_(data_receive)
     , data_send_done_(data_send_done)
     , data_send_failed_(data_send_failed)
-    , on_io_error_(on_error) {
+    , on_io_error_(on_error)
+    , accepted_(false)
+    , queued_bytes_(0u)
+    , io_error_posted_(false)
+    , shutdown_(false) {
   ws_.binary(true);
 }
 template class WebSocketSession<ssl::stream<tcp::socket&> >;
@@ -81,9 +102,11 @@ WebSocketSession<ExecutorType>::~WebSocketSession() {}
 template <typename ExecutorType>
 void WebSocketSession<ExecutorType>::AsyncAccept() {
   SDL_LOG_AUTO_TRACE();
-  ws_.async_accept(std::bind(&WebSocketSession::AsyncRead,
-                             this->shared_from_this(),
-                             std::placeholders::_1));
+  ws_.async_accept(
+      boost::asio::bind_executor(strand_,
+                                 std::bind(&WebSocketSession::AsyncRead,
+                                           this->shared_from_this(),
+                                           std::placeholders::_1)));
 }
 
 template <typename ExecutorType>
@@ -93,29 +116,129 @@ void WebSocketSession<ExecutorType>::AsyncRead(boost::system::error_code ec) {
     auto str_err = "ErrorMessage: " + ec.message();
     SDL_LOG_ERROR(str_err);
     buffer_.consume(buffer_.size());
-    on_io_error_();
+    FailQueuedWrites();
+    if (!shutdown_) {
+      on_io_error_();
+    }
     return;
   }
 
+  if (!accepted_) {
+    // Writing is possible only once handshake has been completed
+    accepted_ = true;
+    if (!write_queue_.empty()) {
+      WriteQueued();
+    }
+  }
+
   ws_.async_read(buffer_,
-                 std::bind(&WebSocketSession::Read,
-                           this->shared_from_this(),
-                           std::placeholders::_1,
-                           std::placeholders::_2));
+                 boost::asio::bind_executor(
+                     strand_,
+                     std::bind(&WebSocketSession::Read,
+                               this->shared_from_this(),
+                               std::placeholders::_1,
+                               std::placeholders::_2)));
 }
 
 template <typename ExecutorType>
 void WebSocketSession<ExecutorType>::WriteDown(Message message) {
-  boost::system::error_code ec;
-  ws_.write(boost::asio::buffer(message->data(), message->data_size()), ec);
+  queued_bytes_ += message->data_size();
+  auto self = this->shared_from_this();
+  boost::asio::post(strand_, [self, message]() {
+    if (self->shutdown_) {
+      self->ReleaseQueuedBytes(message->data_size());
+      self->data_send_failed_(message);
+      return;
+    }
+    self->write_queue_.push_back(message);
+    // Messages queued while previous write is in progress
+    // are written by its completion handler
+    if (self->accepted_ && !self->writing_) {
+      self->WriteQueued();
+    }
+  });
+}
+
+template <typename ExecutorType>
+bool WebSocketSession<ExecutorType>::IsWriteQueueFull() const {
+  return queued_bytes_ >= kWriteQueueHighWaterMark;
+}
+
+template <typename ExecutorType>
+void WebSocketSession<ExecutorType>::PostIOError() {
+  if (io_error_posted_.exchange(true)) {
+    return;
+  }
+  auto self = this->shared_from_this();
+  boost::asio::post(strand_, [self]() {
+    if (!self->shutdown_) {
+      self->on_io_error_();
+    }
+  });
+}
+
+template <typename ExecutorType>
+void WebSocketSession<ExecutorType>::ReleaseQueuedBytes(
+    const std::size_t size) {
+  queued_bytes_ -= size;
+}
+
+template <typename ExecutorType>
+void WebSocketSession<ExecutorType>::WriteQueued() {
+  using ::protocol_handler::RawMessage;
+  writing_ = write_queue_.front();
+  write_queue_.pop_front();
+  // Frame kept in parts is written without joining them
+  RawMessage::Segment segments[RawMessage::kMaxSegments];
+  const std::size_t segments_count = writing_->GetSegments(segments);
+  write_buffers_.clear();
+  for (std::size_t i = 0; i < segments_count; ++i) {
+    write_buffers_.push_back(
+        boost::asio::const_buffer(segments[i].data, segments[i].size));
+  }
 
+  ws_.async_write(write_buffers_,
+                  boost::asio::bind_executor(
+                      strand_,
+                      std::bind(&WebSocketSession::OnWrite,
+                                this->shared_from_this(),
+                                std::placeholders::_1,
+                                std::placeholders::_2)));
+}
+
+template <typename ExecutorType>
+void WebSocketSession<ExecutorType>::OnWrite(boost::system::error_code ec,
+                                             std::size_t bytes_transferred) {
+  boost::ignore_unused(bytes_transferred);
+  Message written;
+  written.swap(writing_);
+  ReleaseQueuedBytes(written->data_size());
   if (ec) {
     SDL_LOG_ERROR("A system error has occurred: " << ec.message());
-    data_send_failed_(message);
-    on_io_error_();
+    data_send_failed_(written);
+    FailQueuedWrites();
+    if (!shutdown_) {
+      on_io_error_();
+    }
     return;
   }
-  data_send_done_(message);
+
+  data_send_done_(written);
+
+  // Messages left after shutdown are reported as failed once socket is closed
+  if (!write_queue_.empty() && !shutdown_) {
+    WriteQueued();
+  }
+}
+
+template <typename ExecutorType>
+void WebSocketSession<ExecutorType>::FailQueuedWrites() {
+  std::deque<Message> failed;
+  failed.swap(write_queue_);
+  for (auto& message : failed) {
+    ReleaseQueuedBytes(message->data_size());
+    data_send_failed_(message);
+  }
 }
 
 template <typename ExecutorType>
@@ -126,7 +249,10 @@ void WebSocketSession<ExecutorType>::Read(boost::system::error_code ec,
   if (ec) {
     SDL_LOG_ERROR(ec.message());
     buffer_.consume(buffer_.size());
-    on_io_error_();
+    FailQueuedWrites();
+    if (!shutdown_) {
+      on_io_error_();
+    }
     return;
   }
 
@@ -149,16 +275,25 @@ void WebSocketSession<ExecutorType>::Read(boost::system::error_code ec,
 template <typename ExecutorType>
 bool WebSocketSession<ExecutorType>::Shutdown() {
   SDL_LOG_AUTO_TRACE();
-  boost::system::error_code ec;
-  if (socket_.is_open()) {
-    socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
-    socket_.close();
-  }
-  buffer_.consume(buffer_.size());
-  if (ec) {
-    SDL_LOG_ERROR(ec.message());
-    return false;
-  }
+  // I/O errors are not reported after shutdown, but messages which have
+  // not been written still are
+  shutdown_ = true;
+  // Socket must not be touched concurrently with handlers of pending
+  // operations, so it is shut down and closed on the strand. Pending
+  // operations are interrupted and their handlers report the failures.
+  auto self = this->shared_from_this();
+  boost::asio::dispatch(strand_, [self]() {
+    if (self->socket_.is_open()) {
+      boost::system::error_code ec;
+      self->socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+      if (ec) {
+        SDL_LOG_ERROR(ec.message());
+      }
+      self->socket_.close(ec);
+    }
+    self->buffer_.consume(self->buffer_.size());
+    self->FailQueuedWrites();
+  });
   return true;
 }
 
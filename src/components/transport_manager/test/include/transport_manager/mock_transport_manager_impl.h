@@ -62,6 +62,11 @@ class MockTransportManagerImpl
   void TestHandle(::protocol_handler::RawMessagePtr msg) {
     Handle(msg);
   }
+
+  void TestHandleBatch(
+      const std::vector< ::protocol_handler::RawMessagePtr>& messages) {
+    HandleBatch(messages);
+  }
 };
 
 }  // namespace transport_manager_test
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+
+#include "gtest/gtest.h"
+#include "transport_manager/transport_adapter/io_reactor.h"
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+
+namespace test {
+namespace components {
+namespace transport_manager_test {
+
+using ::transport_manager::transport_adapter::IoReactor;
+using ::transport_manager::transport_adapter::IoReactorHandler;
+
+namespace {
+const uint32_t kWaitTimeoutMsec = 5000u;
+
+class TestHandler : public IoReactorHandler {
+ public:
+  TestHandler() : delay_msec_(0u), events_(0u), calls_(0u) {}
+
+  void OnIoEvents(const uint32_t events) OVERRIDE {
+    if (delay_msec_) {
+      usleep(delay_msec_ * 1000u);
+    }
+    if (deferred_task_) {
+      IoReactor::instance().Defer(deferred_task_);
+    }
+    sync_primitives::AutoLock auto_lock(lock_);
+    events_ |= events;
+    ++calls_;
+    cond_.Broadcast();
+  }
+
+  bool WaitForEvents(const uint32_t events) {
+    sync_primitives::AutoLock auto_lock(lock_);
+    while ((events_ & events) != events) {
+      if (sync_primitives::ConditionalVariable::kTimeout ==
+          cond_.WaitFor(auto_lock, kWaitTimeoutMsec)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  uint32_t calls() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return calls_;
+  }
+
+  void Reset() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    events_ = 0u;
+    calls_ = 0u;
+  }
+
+  std::atomic<uint32_t> delay_msec_;
+  IoReactor::Task deferred_task_;
+
+ private:
+  sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable cond_;
+  uint32_t events_;
+  uint32_t calls_;
+};
+}  // namespace
+
+class IoReactorTest : public ::testing::Test {
+ protected:
+  void SetUp() OVERRIDE {
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sockets_));
+  }
+
+  void TearDown() OVERRIDE {
+    close(sockets_[0]);
+    close(sockets_[1]);
+  }
+
+  int sockets_[2];
+};
+
+TEST_F(IoReactorTest, Add_Socket_WritableReported) {
+  TestHandler handler;
+  ASSERT_TRUE(IoReactor::instance().Add(sockets_[0], &handler));
+  EXPECT_TRUE(handler.WaitForEvents(IoReactorHandler::kWritable));
+  IoReactor::instance().Remove(sockets_[0], &handler);
+}
+
+TEST_F(IoReactorTest, PeerSendsData_ReadableReported) {
+  TestHandler handler;
+  ASSERT_TRUE(IoReactor::instance().Add(sockets_[0], &handler));
+  const char data = 'a';
+  ASSERT_EQ(1, send(sockets_[1], &data, 1, 0));
+  EXPECT_TRUE(handler.WaitForEvents(IoReactorHandler::kReadable));
+  IoReactor::instance().Remove(sockets_[0], &handler);
+}
+
+TEST_F(IoReactorTest, WakeUp_RegisteredHandler_Notified) {
+  TestHandler handler;
+  ASSERT_TRUE(IoReactor::instance().Add(sockets_[0], &handler));
+  IoReactor::instance().WakeUp(&handler);
+  EXPECT_TRUE(handler.WaitForEvents(IoReactorHandler::kWakeUp));
+  IoReactor::instance().Remove(sockets_[0], &handler);
+}
+
+TEST_F(IoReactorTest, WakeUp_SeveralTimesDuringDispatch_Merged) {
+  TestHandler handler;
+  ASSERT_TRUE(IoReactor::instance().Add(sockets_[0], &handler));
+  ASSERT_TRUE(handler.WaitForEvents(IoReactorHandler::kWritable));
+
+  handler.delay_msec_ = 100u;
+  IoReactor::instance().WakeUp(&handler);
+  // Wait until the first wake-up is being dispatched
+  usleep(20000u);
+  handler.Reset();
+  for (int i = 0; i < 100; ++i) {
+    IoReactor::instance().WakeUp(&handler);
+  }
+  EXPECT_TRUE(handler.WaitForEvents(IoReactorHandler::kWakeUp));
+  usleep(300000u);
+  // The first wake-up and merged ones
+  EXPECT_GE(2u, handler.calls());
+  IoReactor::instance().Remove(sockets_[0], &handler);
+}
+
+TEST_F(IoReactorTest, Remove_DuringDispatch_WaitsForCompletion) {
+  TestHandler handler;
+  ASSERT_TRUE(IoReactor::instance().Add(sockets_[0], &handler));
+  ASSERT_TRUE(handler.WaitForEvents(IoReactorHandler::kWritable));
+
+  handler.delay_msec_ = 200u;
+  handler.Reset();
+  IoReactor::instance().WakeUp(&handler);
+  usleep(50000u);
+  IoReactor::instance().Remove(sockets_[0], &handler);
+  // Notification has completed before Remove returned
+  EXPECT_EQ(1u, handler.calls());
+
+  IoReactor::instance().WakeUp(&handler);
+  usleep(50000u);
+  EXPECT_EQ(1u, handler.calls());
+}
+
+TEST_F(IoReactorTest, Remove_UnderLockNeededByDeferredTask_NoDeadlock) {
+  sync_primitives::Lock client_lock;
+  std::atomic<bool> task_done(false);
+  TestHandler handler;
+  ASSERT_TRUE(IoReactor::instance().Add(sockets_[0], &handler));
+  ASSERT_TRUE(handler.WaitForEvents(IoReactorHandler::kWritable));
+
+  handler.delay_msec_ = 100u;
+  handler.deferred_task_ = [&client_lock, &task_done]() {
+    sync_primitives::AutoLock auto_lock(client_lock);
+    task_done = true;
+  };
+  IoReactor::instance().WakeUp(&handler);
+  usleep(20000u);
+  {
+    sync_primitives::AutoLock auto_lock(client_lock);
+    IoReactor::instance().Remove(sockets_[0], &handler);
+    EXPECT_FALSE(task_done);
+  }
+  for (int i = 0; i < 100 && !task_done; ++i) {
+    usleep(10000u);
+  }
+  // Task has released the lock before it is destroyed
+  sync_primitives::AutoLock auto_lock(client_lock);
+  EXPECT_TRUE(task_done);
+}
+
+TEST_F(IoReactorTest, Defer_OutsideNotification_RunRightAway) {
+  bool task_done = false;
+  IoReactor::instance().Defer([&task_done]() { task_done = true; });
+  EXPECT_TRUE(task_done);
+}
+
+}  // namespace transport_manager_test
+}  // namespace components
+}  // namespace test
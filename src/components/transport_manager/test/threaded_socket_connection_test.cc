@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "protocol/frame_pool.h"
+#include "protocol/raw_message.h"
+#include "transport_manager/transport_adapter/mock_transport_adapter_controller.h"
+#include "transport_manager/transport_adapter/threaded_socket_connection.h"
+#include "utils/test_async_waiter.h"
+
+namespace test {
+namespace components {
+namespace transport_manager_test {
+
+using ::protocol_handler::RawMessage;
+using ::protocol_handler::RawMessagePtr;
+using ::testing::_;
+using ::testing::AtLeast;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using namespace ::transport_manager;
+using namespace ::transport_manager::transport_adapter;
+
+namespace {
+const uint32_t kSendTimeoutMsec = 5000u;
+const size_t kHeaderSize = 12u;
+
+class TestSocketConnection : public ThreadedSocketConnection {
+ public:
+  TestSocketConnection(const int socket,
+                       TransportAdapterController* controller)
+      : ThreadedSocketConnection("test_device", 1, controller)
+      , test_socket_(socket) {}
+
+  ~TestSocketConnection() {
+    StopAndJoinThread();
+  }
+
+ protected:
+  bool Establish(ConnectError** error) OVERRIDE {
+    if (-1 == get_socket()) {
+      set_socket(test_socket_);
+    }
+    return true;
+  }
+
+ private:
+  const int test_socket_;
+};
+
+std::vector<uint8_t> MakeData(const size_t size, const uint8_t seed) {
+  std::vector<uint8_t> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8_t>(seed + i);
+  }
+  return data;
+}
+
+RawMessagePtr MakeScatteredMessage(const std::vector<uint8_t>& data) {
+  const std::shared_ptr<uint8_t> tail =
+      ::protocol_handler::frame_pool::MakeSharedBuffer(data.size() -
+                                                       kHeaderSize);
+  memcpy(tail.get(), &data[kHeaderSize], data.size() - kHeaderSize);
+  return std::make_shared<RawMessage>(
+      1, 3, &data[0], kHeaderSize, tail, data.size() - kHeaderSize, false);
+}
+}  // namespace
+
+class ThreadedSocketConnectionTest : public ::testing::Test {
+ protected:
+  void SetUp() OVERRIDE {
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, sockets_));
+  }
+
+  void TearDown() OVERRIDE {
+    // Controller notifications of finished connections may still be running
+    IoReactor::instance().Flush();
+    close(sockets_[1]);
+  }
+
+  std::vector<uint8_t> ReadFromPeer(const size_t size) {
+    std::vector<uint8_t> data(size);
+    size_t received = 0u;
+    while (received < size) {
+      const ssize_t result =
+          recv(sockets_[1], &data[received], size - received, 0);
+      if (result <= 0) {
+        break;
+      }
+      received += result;
+    }
+    data.resize(received);
+    return data;
+  }
+
+  void SendFramesAndCheckInOrder(TestSocketConnection& connection) {
+    const size_t kFramesCount = 20u;
+    std::vector<RawMessagePtr> frames;
+    std::vector<uint8_t> expected_data;
+    for (size_t i = 0; i < kFramesCount; ++i) {
+      // One big frame does not fit socket buffer and is sent in portions
+      const size_t size =
+          (kFramesCount / 2 == i) ? 512u * 1024u : 100u + i * 50u;
+      const std::vector<uint8_t> data = MakeData(size, i);
+      expected_data.insert(expected_data.end(), data.begin(), data.end());
+      frames.push_back(i % 2 ? MakeScatteredMessage(data)
+                             : std::make_shared<RawMessage>(
+                                   1, 3, &data[0], data.size(), false));
+    }
+
+    auto waiter = TestAsyncWaiter::createInstance();
+    EXPECT_CALL(controller_, DataSendDone(_, _, _))
+        .Times(kFramesCount)
+        .WillRepeatedly(NotifyTestAsyncWaiter(waiter));
+    EXPECT_CALL(controller_, DataSendFailed(_, _, _, _)).Times(0);
+
+    ASSERT_EQ(TransportAdapter::OK, connection.Start());
+    for (size_t i = 0; i < frames.size(); ++i) {
+      EXPECT_EQ(TransportAdapter::OK, connection.SendData(frames[i]));
+    }
+
+    EXPECT_EQ(expected_data, ReadFromPeer(expected_data.size()));
+    EXPECT_TRUE(waiter->WaitFor(kFramesCount, kSendTimeoutMsec));
+  }
+
+  int sockets_[2];
+  NiceMock<MockTransportAdapterController> controller_;
+};
+
+TEST_F(ThreadedSocketConnectionTest,
+       SendData_ContiguousAndScatteredFrames_SentInOrder) {
+  TestSocketConnection connection(sockets_[0], &controller_);
+  SendFramesAndCheckInOrder(connection);
+}
+
+TEST_F(ThreadedSocketConnectionTest,
+       SendData_SocketSetBeforeStart_SentInOrderFromReactor) {
+  TestSocketConnection connection(sockets_[0], &controller_);
+  connection.set_socket(sockets_[0]);
+  SendFramesAndCheckInOrder(connection);
+}
+
+TEST_F(ThreadedSocketConnectionTest, Receive_PeerClosed_ConnectionAborted) {
+  auto waiter = TestAsyncWaiter::createInstance();
+  const std::vector<uint8_t> data = MakeData(300u, 1u);
+  EXPECT_CALL(controller_, ConnectDone(_, _));
+  EXPECT_CALL(controller_, DataReceiveDone(_, _, _)).Times(AtLeast(1));
+  EXPECT_CALL(controller_, ConnectionAborted(_, _, _))
+      .WillOnce(NotifyTestAsyncWaiter(waiter));
+  EXPECT_CALL(controller_, ConnectionFinished(_, _)).Times(0);
+
+  TestSocketConnection connection(sockets_[0], &controller_);
+  connection.set_socket(sockets_[0]);
+  ASSERT_EQ(TransportAdapter::OK, connection.Start());
+  ASSERT_EQ(static_cast<ssize_t>(data.size()),
+            send(sockets_[1], &data[0], data.size(), 0));
+  shutdown(sockets_[1], SHUT_RDWR);
+
+  EXPECT_TRUE(waiter->WaitFor(1u, kSendTimeoutMsec));
+  EXPECT_TRUE(connection.IsConnectionTerminated());
+}
+
+TEST_F(ThreadedSocketConnectionTest,
+       Receive_MoreThanReceiveBudget_AllDataDeliveredInOrder) {
+  // Exceeds data read from connection per reactor notification
+  const std::vector<uint8_t> data = MakeData(2u * 1024u * 1024u, 7u);
+  std::vector<uint8_t> received_data;
+  sync_primitives::Lock received_data_lock;
+  auto waiter = TestAsyncWaiter::createInstance();
+  EXPECT_CALL(controller_, DataReceiveDone(_, _, _))
+      .WillRepeatedly(Invoke([&](const DeviceUID&,
+                                 const ApplicationHandle&,
+                                 RawMessagePtr message) {
+        sync_primitives::AutoLock auto_lock(received_data_lock);
+        received_data.insert(received_data.end(),
+                             message->data(),
+                             message->data() + message->data_size());
+      }));
+  EXPECT_CALL(controller_, ConnectionAborted(_, _, _))
+      .WillOnce(NotifyTestAsyncWaiter(waiter));
+
+  TestSocketConnection connection(sockets_[0], &controller_);
+  connection.set_socket(sockets_[0]);
+  ASSERT_EQ(TransportAdapter::OK, connection.Start());
+  size_t sent = 0u;
+  while (sent < data.size()) {
+    const ssize_t result =
+        send(sockets_[1], &data[sent], data.size() - sent, 0);
+    ASSERT_LT(0, result);
+    sent += result;
+  }
+  shutdown(sockets_[1], SHUT_RDWR);
+
+  EXPECT_TRUE(waiter->WaitFor(1u, kSendTimeoutMsec));
+  sync_primitives::AutoLock auto_lock(received_data_lock);
+  EXPECT_EQ(data, received_data);
+}
+
+TEST_F(ThreadedSocketConnectionTest, Disconnect_ConnectionFinished) {
+  auto waiter = TestAsyncWaiter::createInstance();
+  EXPECT_CALL(controller_, ConnectionFinished(_, _))
+      .WillOnce(NotifyTestAsyncWaiter(waiter));
+  EXPECT_CALL(controller_, ConnectionAborted(_, _, _)).Times(0);
+
+  TestSocketConnection connection(sockets_[0], &controller_);
+  connection.set_socket(sockets_[0]);
+  ASSERT_EQ(TransportAdapter::OK, connection.Start());
+  EXPECT_EQ(TransportAdapter::OK, connection.Disconnect());
+
+  EXPECT_TRUE(waiter->WaitFor(1u, kSendTimeoutMsec));
+  EXPECT_TRUE(connection.IsConnectionTerminated());
+}
+
+TEST(RawMessageTest, GetSegments_ScatteredMessage_JoinedOnDataRequest) {
+  const std::vector<uint8_t> data = MakeData(1000u, 5u);
+  const RawMessagePtr message = MakeScatteredMessage(data);
+
+  RawMessage::Segment segments[RawMessage::kMaxSegments];
+  ASSERT_EQ(2u, message->GetSegments(segments));
+  EXPECT_EQ(kHeaderSize, segments[0].size);
+  EXPECT_EQ(data.size() - kHeaderSize, segments[1].size);
+  EXPECT_EQ(data.size(), message->data_size());
+  EXPECT_EQ(data,
+            std::vector<uint8_t>(message->data(),
+                                 message->data() + message->data_size()));
+}
+
+}  // namespace transport_manager_test
+}  // namespace components
+}  // namespace test
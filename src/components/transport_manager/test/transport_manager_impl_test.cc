@@ -981,6 +981,38 @@ TEST_F(TransportManagerImplTest, HandleMessage_ConnectionNotExist) {
   EXPECT_TRUE(waiter->WaitFor(1, kAsyncExpectationsTimeout));
 }
 
+TEST_F(TransportManagerImplTest,
+       HandleBatch_SeveralConnections_MessagesSentInOrder) {
+  HandleConnection();
+
+  const uint8_t data[] = {0x20, 0x07, 0x01, 0x00};
+  std::vector<RawMessagePtr> messages;
+  messages.push_back(test_message_);
+  messages.push_back(std::make_shared<RawMessage>(
+      connection_key_, 1u, data, sizeof(data), false));
+  const RawMessagePtr not_connected_message = std::make_shared<RawMessage>(
+      connection_key_ + 1, 1u, data, sizeof(data), false);
+  messages.push_back(not_connected_message);
+  messages.push_back(std::make_shared<RawMessage>(
+      connection_key_, 1u, data, sizeof(data), false));
+
+  {
+    ::testing::InSequence s;
+    EXPECT_CALL(*mock_adapter_,
+                SendData(mac_address_, application_id_, messages[0]))
+        .WillOnce(Return(TransportAdapter::OK));
+    EXPECT_CALL(*mock_adapter_,
+                SendData(mac_address_, application_id_, messages[1]))
+        .WillOnce(Return(TransportAdapter::OK));
+    EXPECT_CALL(*tm_listener_, OnTMMessageSendFailed(_, not_connected_message));
+    EXPECT_CALL(*mock_adapter_,
+                SendData(mac_address_, application_id_, messages[3]))
+        .WillOnce(Return(TransportAdapter::OK));
+  }
+
+  tm_.TestHandleBatch(messages);
+}
+
 TEST_F(TransportManagerImplTest, SearchDevices_TMIsNotInitialized) {
   // Check before Act
   UninitializeTM();
@@ -32,8 +32,11 @@
 
 #include "gtest/gtest.h"
 
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "resumption/last_state_impl.h"
 #include "transport_manager/websocket_server/websocket_connection.h"
@@ -41,6 +44,7 @@
 
 #include "transport_manager/mock_transport_manager_settings.h"
 #include "transport_manager/transport_adapter/mock_transport_adapter_controller.h"
+#include "utils/test_async_waiter.h"
 
 namespace {
 const std::string kHost = "127.0.0.1";
@@ -50,6 +54,8 @@ const std::uint32_t kConnectionKey = 1u;
 const std::uint32_t kProtocolVersion = 5u;
 const std::string kDeviceUid_ = "deviceUID";
 const transport_manager::ApplicationHandle kAppHandle = 12345u;
+const uint32_t kWaitTimeoutMsec = 5000u;
+const int kServerSendBufferSize = 16 * 1024;
 }  // namespace
 
 namespace test {
@@ -57,6 +63,9 @@ namespace components {
 namespace transport_manager_test {
 
 using ::testing::_;
+using ::testing::AtLeast;
+using ::testing::DoAll;
+using ::testing::Invoke;
 using ::testing::NiceMock;
 using ::testing::Return;
 
@@ -165,6 +174,185 @@ TEST_F(WebsocketNotSecureSessionConnectionTest, DataReceive_SUCCESS) {
   websocket_connection_->DataReceive(message);
 }
 
+class WebsocketConnectedSessionTest : public testing::Test {
+ public:
+  WebsocketConnectedSessionTest()
+      : work_guard_(boost::asio::make_work_guard(i_co_))
+      , client_ws_(i_co_) {}
+
+  void SetUp() OVERRIDE {
+    tcp::acceptor acceptor(
+        i_co_, tcp::endpoint(boost::asio::ip::make_address(kHost), 0));
+    tcp::socket server_socket(i_co_);
+    client_ws_.next_layer().connect(acceptor.local_endpoint());
+    acceptor.accept(server_socket);
+    // Small socket buffer keeps data which client does not read
+    // in the session write queue
+    server_socket.set_option(
+        boost::asio::socket_base::send_buffer_size(kServerSendBufferSize));
+
+    websocket_connection_ =
+        std::make_shared<WebSocketConnection<WebSocketSession<> > >(
+            kDeviceUid_,
+            kAppHandle,
+            std::move(server_socket),
+            &mock_transport_adapter_ctrl_);
+    io_thread_ = std::thread([this]() { i_co_.run(); });
+    websocket_connection_->Run();
+    client_ws_.binary(true);
+    client_ws_.handshake(kHost, kPath);
+  }
+
+  void TearDown() OVERRIDE {
+    websocket_connection_.reset();
+    work_guard_.reset();
+    i_co_.stop();
+    io_thread_.join();
+  }
+
+  RawMessagePtr CreateRawMessage(const size_t size, const uint8_t seed) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+      data[i] = static_cast<uint8_t>(seed + i);
+    }
+    return std::make_shared<::protocol_handler::RawMessage>(
+        kConnectionKey, kProtocolVersion, &data[0], data.size(), false);
+  }
+
+ protected:
+  boost::asio::io_context i_co_;
+  boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
+      work_guard_;
+  websocket::stream<tcp::socket> client_ws_;
+  std::thread io_thread_;
+  std::shared_ptr<WebSocketConnection<WebSocketSession<> > >
+      websocket_connection_;
+  NiceMock<MockTransportAdapterController> mock_transport_adapter_ctrl_;
+};
+
+TEST_F(WebsocketConnectedSessionTest, SendData_SeveralMessages_WrittenInOrder) {
+  const size_t kMessagesCount = 50u;
+  std::vector<RawMessagePtr> messages;
+  for (size_t i = 0; i < kMessagesCount; ++i) {
+    messages.push_back(CreateRawMessage(100u + i * 10u, i));
+  }
+
+  auto waiter = TestAsyncWaiter::createInstance();
+  EXPECT_CALL(mock_transport_adapter_ctrl_,
+              DataSendDone(kDeviceUid_, kAppHandle, _))
+      .Times(kMessagesCount)
+      .WillRepeatedly(NotifyTestAsyncWaiter(waiter));
+  EXPECT_CALL(mock_transport_adapter_ctrl_, DataSendFailed(_, _, _, _))
+      .Times(0);
+
+  for (auto& message : messages) {
+    EXPECT_EQ(TransportAdapter::OK, websocket_connection_->SendData(message));
+  }
+
+  // Each message is received as separate websocket message
+  for (auto& message : messages) {
+    boost::beast::flat_buffer buffer;
+    client_ws_.read(buffer);
+    const uint8_t* data = static_cast<const uint8_t*>(
+        boost::beast::buffers_front(buffer.data()).data());
+    EXPECT_EQ(std::vector<uint8_t>(
+                  message->data(), message->data() + message->data_size()),
+              std::vector<uint8_t>(data, data + buffer.size()));
+  }
+  EXPECT_TRUE(waiter->WaitFor(kMessagesCount, kWaitTimeoutMsec));
+}
+
+TEST_F(WebsocketConnectedSessionTest,
+       SendData_SegmentedFrame_ReceivedAsSingleMessage) {
+  const uint8_t header[] = {0x51, 0x07, 0x01, 0x01};
+  const size_t kTailSize = 1000u;
+  const std::shared_ptr<uint8_t> tail(new uint8_t[kTailSize],
+                                      std::default_delete<uint8_t[]>());
+  std::vector<uint8_t> expected_data(header, header + sizeof(header));
+  for (size_t i = 0; i < kTailSize; ++i) {
+    tail.get()[i] = static_cast<uint8_t>(i);
+    expected_data.push_back(tail.get()[i]);
+  }
+  const RawMessagePtr message =
+      std::make_shared<::protocol_handler::RawMessage>(kConnectionKey,
+                                                       kProtocolVersion,
+                                                       header,
+                                                       sizeof(header),
+                                                       tail,
+                                                       kTailSize,
+                                                       false);
+
+  auto waiter = TestAsyncWaiter::createInstance();
+  EXPECT_CALL(mock_transport_adapter_ctrl_,
+              DataSendDone(kDeviceUid_, kAppHandle, _))
+      .WillOnce(NotifyTestAsyncWaiter(waiter));
+  EXPECT_EQ(TransportAdapter::OK, websocket_connection_->SendData(message));
+
+  boost::beast::flat_buffer buffer;
+  client_ws_.read(buffer);
+  const uint8_t* data = static_cast<const uint8_t*>(
+      boost::beast::buffers_front(buffer.data()).data());
+  EXPECT_EQ(expected_data, std::vector<uint8_t>(data, data + buffer.size()));
+  EXPECT_TRUE(waiter->WaitFor(1u, kWaitTimeoutMsec));
+}
+
+TEST_F(WebsocketConnectedSessionTest,
+       SendData_ClientNotReading_AbortedFromIOThreadWithoutBlocking) {
+  // 6MB exceed the high-water mark of write queue
+  const size_t kMessagesCount = 48u;
+  const size_t kMessageSize = 128u * 1024u;
+
+  const std::thread::id sender_thread_id = std::this_thread::get_id();
+  std::thread::id aborting_thread_id;
+  auto waiter = TestAsyncWaiter::createInstance();
+  EXPECT_CALL(mock_transport_adapter_ctrl_,
+              ConnectionAborted(kDeviceUid_, kAppHandle, _))
+      .WillOnce(DoAll(Invoke([&aborting_thread_id](const DeviceUID&,
+                                                   const ApplicationHandle&,
+                                                   const CommunicationError&) {
+                        aborting_thread_id = std::this_thread::get_id();
+                      }),
+                      NotifyTestAsyncWaiter(waiter)));
+
+  size_t failed_count = 0u;
+  for (size_t i = 0; i < kMessagesCount; ++i) {
+    if (TransportAdapter::OK !=
+        websocket_connection_->SendData(CreateRawMessage(kMessageSize, i))) {
+      ++failed_count;
+    }
+  }
+
+  EXPECT_LT(0u, failed_count);
+  EXPECT_TRUE(waiter->WaitFor(1u, kWaitTimeoutMsec));
+  EXPECT_NE(sender_thread_id, aborting_thread_id);
+}
+
+TEST_F(WebsocketConnectedSessionTest,
+       Disconnect_MessagesNotWritten_ReportedAsFailed) {
+  // Client does not read, so most of messages stay queued
+  const size_t kMessagesCount = 16u;
+  const size_t kMessageSize = 128u * 1024u;
+
+  auto waiter = TestAsyncWaiter::createInstance();
+  EXPECT_CALL(mock_transport_adapter_ctrl_,
+              DataSendDone(kDeviceUid_, kAppHandle, _))
+      .WillRepeatedly(NotifyTestAsyncWaiter(waiter));
+  EXPECT_CALL(mock_transport_adapter_ctrl_,
+              DataSendFailed(kDeviceUid_, kAppHandle, _, _))
+      .Times(AtLeast(1))
+      .WillRepeatedly(NotifyTestAsyncWaiter(waiter));
+
+  for (size_t i = 0; i < kMessagesCount; ++i) {
+    EXPECT_EQ(TransportAdapter::OK,
+              websocket_connection_->SendData(
+                  CreateRawMessage(kMessageSize, i)));
+  }
+  EXPECT_EQ(TransportAdapter::OK, websocket_connection_->Disconnect());
+
+  // Every message is reported either as sent or as failed
+  EXPECT_TRUE(waiter->WaitFor(kMessagesCount, kWaitTimeoutMsec));
+}
+
 }  // namespace transport_manager_test
 }  // namespace components
 }  // namespace test
@@ -38,9 +38,8 @@
 
 #include "utils/lock.h"
 #include "utils/macro.h"
-#include "utils/threads/thread.h"
-#include "utils/threads/thread_delegate.h"
 #include "utils/timer_task.h"
+#include "utils/timer_wheel.h"
 
 namespace timer {
 
@@ -66,6 +65,10 @@ enum TimerType {
 /**
  * @brief Timer calls custom callback function after
  * specified timeout has been elapsed.
+ * Timers do not own threads, all of them are served by TimerWheel.
+ * Tasks are run from small pool of wheel dispatch threads, so long task
+ * delays other timers only while all of the pool threads are busy.
+ * Work which blocks for long should be moved to a dedicated thread.
  * Thread-safe class
  */
 class Timer {
@@ -113,101 +116,30 @@ class Timer {
 
  private:
   /**
-   * @brief Delegate for timer thread
+   * @brief Timer entry scheduled in the shared timer wheel
    */
-  class TimerDelegate : public threads::ThreadDelegate {
+  class TimerEntry : public TimerWheelEntry {
    public:
     /**
      * @brief Constructor
      * @param timer Timer instance pointer for callback calling
      */
-    TimerDelegate(Timer* timer, sync_primitives::Lock& state_lock_ref);
+    explicit TimerEntry(Timer* timer);
 
-    /**
-     * @brief Sets timer timeout
-     * @param timeout Timeout in milliseconds to be set
-     */
-    void set_timeout(const Milliseconds timeout);
-
-    /**
-     * @brief Gets timer timeout
-     * @return Timer timeout
-     */
-    Milliseconds timeout() const;
-
-    /**
-     * @brief Sets timer delegate stop flag
-     * @param stop_flag Bool flag to be set
-     */
-    void set_stop_flag(const bool stop_flag);
-
-    /**
-     * @brief Gets timer delegate stop flag
-     * @return Delegate stop flag
-     */
-    bool stop_flag() const;
-
-    /**
-     * @brief Sets timer delegate finalized flag
-     * @param finalized_flag Bool flag to be set
-     */
-    void set_finalized_flag(const bool finalized_flag);
-
-    /**
-     * @brief Gets timer delegate finalized flag
-     * @return Delegate finalized flag
-     */
-    bool finalized_flag() const;
-
-    void threadMain() OVERRIDE;
-    void exitThreadMain() OVERRIDE;
+    void OnExpired() OVERRIDE;
 
    private:
     Timer* timer_;
-    Milliseconds timeout_;
-
-    /**
-     * @brief Stop flag shows if timer should be stopped
-     * after next iteration
-     */
-    bool stop_flag_;
 
-    /**
-     * @brief Finalized flag shows if timer is finalized
-     * and cannot be restarted until actual thread stopping
-     */
-    bool finalized_flag_;
-
-    sync_primitives::Lock& state_lock_ref_;
-    sync_primitives::ConditionalVariable state_condition_;
-
-    DISALLOW_COPY_AND_ASSIGN(TimerDelegate);
+    DISALLOW_COPY_AND_ASSIGN(TimerEntry);
   };
 
   /**
-   * @brief Sets up timer delegate to start state.
+   * @brief Removes timer from the wheel waiting for
+   * currently running callback if any.
    * Not thread-safe
-   * @param timeout Timer timeout
    */
-  void StartDelegate(const Milliseconds timeout);
-
-  /**
-   * @brief Sets up timer delegate to stop state.
-   * Not thread-safe
-   */
-  void StopDelegate();
-
-  /**
-   * @brief Starts timer thread.
-   * Not thread-safe
-   */
-  void StartThread();
-
-  /**
-   * @brief Stops timer thread.
-   * Not thread-safe
-   */
-  void StopThread();
+  void CancelEntry();
 
   /**
    * @brief Callback called on timeout.
@@ -220,8 +152,14 @@ class Timer {
 
   mutable sync_primitives::Lock state_lock_;
 
-  std::unique_ptr<TimerDelegate> delegate_;
-  threads::Thread* thread_;
+  TimerEntry entry_;
+
+  Milliseconds timeout_;
+
+  /**
+   * @brief Stop flag shows if timer is not scheduled
+   */
+  bool stop_flag_;
 
   /**
    * @brief Single shot flag shows if timer should be fired once
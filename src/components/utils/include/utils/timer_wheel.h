@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SRC_COMPONENTS_UTILS_INCLUDE_UTILS_TIMER_WHEEL_H_
+#define SRC_COMPONENTS_UTILS_INCLUDE_UTILS_TIMER_WHEEL_H_
+
+#include <stdint.h>
+
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+#include "utils/macro.h"
+#include "utils/threads/thread.h"
+#include "utils/threads/thread_delegate.h"
+
+namespace timer {
+
+class TimerWheel;
+
+/**
+ * @brief Intrusive list link used by TimerWheel slots
+ */
+struct TimerWheelLink {
+  TimerWheelLink() : prev_(this), next_(this) {}
+
+  bool linked() const {
+    return next_ != this;
+  }
+
+  TimerWheelLink* prev_;
+  TimerWheelLink* next_;
+};
+
+/**
+ * @brief Entry which may be scheduled in TimerWheel.
+ * Entry is owned by client, wheel only links it into its slots.
+ * All fields are protected by the wheel lock.
+ */
+class TimerWheelEntry : private TimerWheelLink {
+ public:
+  TimerWheelEntry()
+      : expires_(0)
+      , period_(0)
+      , bucket_(kNoBucket)
+      , dispatching_(false)
+      , detached_(false)
+      , dispatcher_() {}
+  virtual ~TimerWheelEntry() {}
+
+  /**
+   * @brief Called from one of wheel dispatch threads once entry deadline
+   * has been reached. Wheel lock is not taken during the call, so it is
+   * allowed to schedule or cancel any entry (including this one) from the
+   * callback. Callbacks of the same entry never run concurrently, callbacks
+   * of different entries may. Long callback occupies one of kDispatchThreads
+   * threads, so other entries are delayed only if all of them are busy.
+   */
+  virtual void OnExpired() = 0;
+
+ private:
+  friend class TimerWheel;
+
+  enum { kNoBucket = -1, kDueBucket = -2 };
+
+  /**
+   * @brief Absolute expiration time in wheel ticks
+   */
+  uint64_t expires_;
+
+  /**
+   * @brief Reschedule period in ticks, 0 for single shot entries
+   */
+  uint32_t period_;
+
+  /**
+   * @brief Index of wheel slot entry is linked to
+   */
+  int32_t bucket_;
+
+  /**
+   * @brief Set while entry callback is running
+   */
+  bool dispatching_;
+
+  /**
+   * @brief Set if entry has been cancelled or rescheduled during its
+   * callback, so it should not be touched after callback returns
+   */
+  bool detached_;
+
+  /**
+   * @brief Thread running entry callback
+   */
+  threads::PlatformThreadHandle dispatcher_;
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheelEntry);
+};
+
+/**
+ * @brief Hierarchical timer wheel shared by all timers of the process.
+ * Time is counted in 1 ms ticks. Wheel consists of kLevels levels of kSlots
+ * slots each, level N slot covers kSlots^N ticks, so start/stop operations
+ * are O(1) independently on amount of scheduled timers.
+ * Wheel thread sleeps on timerfd armed to the nearest non-empty slot and
+ * moves expired entries to the due list, their callbacks are called from
+ * small pool of dispatch threads.
+ * Thread-safe class
+ */
+class TimerWheel {
+ public:
+  /**
+   * @brief Gets process-wide wheel instance.
+   * Wheel thread is started on first call and lives until process exit.
+   */
+  static TimerWheel& instance();
+
+  /**
+   * @brief Schedules entry to expire after specified timeout.
+   * Reschedules entry if it has been scheduled already.
+   * @param entry Entry to schedule
+   * @param timeout Timeout in milliseconds
+   * @param periodic True if entry should be rescheduled with the same timeout
+   * after each expiration. Periodic entry with zero timeout is rescheduled
+   * for the next tick
+   */
+  void Schedule(TimerWheelEntry* entry,
+                const uint32_t timeout,
+                const bool periodic);
+
+  /**
+   * @brief Removes entry from the wheel.
+   * If entry callback is running at the moment and method is called
+   * not from the callback itself it waits for callback completion,
+   * so entry can be safely destroyed after method returns.
+   * @param entry Entry to cancel
+   * @param lock Lock to release while waiting for callback completion,
+   * may be NULL
+   */
+  void Cancel(TimerWheelEntry* entry, sync_primitives::BaseLock* lock);
+
+  /**
+   * @brief Amount of threads callbacks are called from
+   */
+  static const uint32_t kDispatchThreads = 4u;
+
+ private:
+  enum { kSlotBits = 6, kSlots = 1 << kSlotBits, kLevels = 5 };
+
+  class WheelDelegate : public threads::ThreadDelegate {
+   public:
+    explicit WheelDelegate(TimerWheel* wheel);
+    void threadMain() OVERRIDE;
+
+   private:
+    TimerWheel* wheel_;
+  };
+
+  class DispatchDelegate : public threads::ThreadDelegate {
+   public:
+    explicit DispatchDelegate(TimerWheel* wheel);
+    void threadMain() OVERRIDE;
+
+   private:
+    TimerWheel* wheel_;
+  };
+
+  TimerWheel();
+
+  /**
+   * @brief Current time in ticks since wheel creation
+   */
+  uint64_t Now() const;
+
+  /**
+   * @brief Links entry into corresponding slot or due list,
+   * wakes up dispatch thread for due entry.
+   * Not thread-safe
+   */
+  void Insert(TimerWheelEntry* entry);
+
+  /**
+   * @brief Unlinks entry from any list it is linked to
+   * and updates slot occupation mask.
+   * Not thread-safe
+   */
+  void Unlink(TimerWheelEntry* entry);
+
+  /**
+   * @brief Moves all entries of level slot to lower levels or due list.
+   * Not thread-safe
+   */
+  void Cascade(const uint32_t level, const uint32_t slot);
+
+  /**
+   * @brief Advances wheel time processing all non-empty slots on the way.
+   * Not thread-safe
+   */
+  void Advance(const uint64_t now);
+
+  /**
+   * @brief Gets nearest tick when some non-empty slot should be processed
+   * @return Tick value or UINT64_MAX if wheel is empty.
+   * Not thread-safe
+   */
+  uint64_t NextEventTick() const;
+
+  /**
+   * @brief Gets first due entry which callback is not running at the moment
+   * @return Entry or NULL if there is no such entry.
+   * Not thread-safe
+   */
+  TimerWheelEntry* NextDueEntry() const;
+
+  /**
+   * @brief Arms wakeup source to specified tick if it is earlier than
+   * currently armed one.
+   * Not thread-safe
+   */
+  void ArmWakeup(const uint64_t tick);
+
+  /**
+   * @brief Blocks wheel thread until armed tick has been reached
+   */
+  void WaitForWakeup(sync_primitives::AutoLock& auto_lock);
+
+  /**
+   * @brief Wheel thread loop.
+   */
+  void Run();
+
+  /**
+   * @brief Dispatch thread loop.
+   */
+  void Dispatch();
+
+  mutable sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable due_ready_;
+  sync_primitives::ConditionalVariable dispatch_done_;
+
+  TimerWheelLink slots_[kLevels][kSlots];
+  uint64_t occupied_[kLevels];
+  TimerWheelLink due_;
+
+  uint64_t current_tick_;
+  uint64_t armed_tick_;
+  uint64_t start_time_ms_;
+
+#if defined(OS_LINUX)
+  int epoll_fd_;
+  int timer_fd_;
+#else
+  sync_primitives::ConditionalVariable wakeup_;
+#endif
+
+  WheelDelegate* delegate_;
+  threads::Thread* thread_;
+  DispatchDelegate* dispatch_delegates_[kDispatchThreads];
+  threads::Thread* dispatch_threads_[kDispatchThreads];
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+};
+
+}  // namespace timer
+
+#endif  // SRC_COMPONENTS_UTILS_INCLUDE_UTILS_TIMER_WHEEL_H_
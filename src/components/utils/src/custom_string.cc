@@ -33,18 +33,24 @@
 #include "utils/custom_string.h"
 #include <string.h>
 #include <algorithm>
-#include <clocale>
-#include <cstdlib>
-#include <cwchar>
-#include <cwctype>
-#include <new>
-#include <vector>
 #include "utils/logger.h"
 #include "utils/macro.h"
 
 namespace {
 namespace custom_str = utils::custom_string;
 
+/**
+ * @brief Code point used for invalid UTF8 sequences when string
+ * is converted to unicode string
+ */
+const wchar_t kReplacementCharacter = 0xFFFD;
+
+/**
+ * @brief Flag marking undecodable byte, so it does not coincide
+ * with any valid code point
+ */
+const uint32_t kInvalidByte = 0x80000000;
+
 // Calculates amount of characters in UTF string
 size_t CalculateLengthOfString(const char* str) {
   size_t length_of_string = 0;
@@ -57,24 +63,203 @@ size_t CalculateLengthOfString(const char* str) {
   return length_of_string;
 }
 
-// Converts string to unicode string.
-std::wstring ConvertUTFToWString(const char* str) {
-  size_t size = CalculateLengthOfString(str);
-  std::vector<wchar_t> wchar_array(size + 1, L'\0');
+// Decodes code point at the position and moves position past it.
+// Invalid byte is returned with kInvalidByte flag and skipped alone.
+uint32_t DecodeCodePoint(const char*& position, const char* end) {
+  const uint8_t lead = static_cast<uint8_t>(*position++);
+  if (lead < custom_str::kByteOfUTF8) {
+    return lead;
+  }
+  size_t continuation_count = 0;
+  uint32_t code_point = 0;
+  if ((lead & custom_str::kHigestByteOfUTF8Byte3) ==
+      custom_str::kHigestByteOfUTF8Byte2) {
+    continuation_count = 1;
+    code_point = lead & 0x1F;
+  } else if ((lead & custom_str::kHigestByteOfUTF8Byte4) ==
+             custom_str::kHigestByteOfUTF8Byte3) {
+    continuation_count = 2;
+    code_point = lead & 0x0F;
+  } else if ((lead & 0xF8) == custom_str::kHigestByteOfUTF8Byte4) {
+    continuation_count = 3;
+    code_point = lead & 0x07;
+  } else {
+    return kInvalidByte | lead;
+  }
+  if (static_cast<size_t>(end - position) < continuation_count) {
+    return kInvalidByte | lead;
+  }
+  for (size_t i = 0; i < continuation_count; ++i) {
+    const uint8_t byte = static_cast<uint8_t>(position[i]);
+    if ((byte & custom_str::kHigestByteOfUTF8Byte2) !=
+        custom_str::kByteOfUTF8) {
+      return kInvalidByte | lead;
+    }
+    code_point = (code_point << 6) | (byte & 0x3F);
+  }
+  position += continuation_count;
+  return code_point;
+}
 
-  std::string current_locale = setlocale(LC_ALL, NULL);
-  setlocale(LC_ALL, "");  // system locale
-  mbstowcs(&(wchar_array.front()), str, size);
-  setlocale(LC_ALL, current_locale.c_str());
-  return std::wstring(&(wchar_array.front()));
+/**
+ * @brief Upper case letters of Latin Extended-B and Greek which do not
+ * follow the simple patterns of their blocks, sorted by upper case letter
+ */
+const struct CaseMapping {
+  uint16_t upper;
+  uint16_t lower;
+} kIrregularLowerCase[] = {
+    {0x181, 0x253}, {0x182, 0x183}, {0x184, 0x185}, {0x186, 0x254},
+    {0x187, 0x188}, {0x189, 0x256}, {0x18A, 0x257}, {0x18B, 0x18C},
+    {0x18E, 0x1DD}, {0x18F, 0x259}, {0x190, 0x25B}, {0x191, 0x192},
+    {0x193, 0x260}, {0x194, 0x263}, {0x196, 0x269}, {0x197, 0x268},
+    {0x198, 0x199}, {0x19C, 0x26F}, {0x19D, 0x272}, {0x19F, 0x275},
+    {0x1A0, 0x1A1}, {0x1A2, 0x1A3}, {0x1A4, 0x1A5}, {0x1A6, 0x280},
+    {0x1A7, 0x1A8}, {0x1A9, 0x283}, {0x1AC, 0x1AD}, {0x1AE, 0x288},
+    {0x1AF, 0x1B0}, {0x1B1, 0x28A}, {0x1B2, 0x28B}, {0x1B3, 0x1B4},
+    {0x1B5, 0x1B6}, {0x1B7, 0x292}, {0x1B8, 0x1B9}, {0x1BC, 0x1BD},
+    {0x1C4, 0x1C6}, {0x1C5, 0x1C6}, {0x1C7, 0x1C9}, {0x1C8, 0x1C9},
+    {0x1CA, 0x1CC}, {0x1CB, 0x1CC}, {0x1F1, 0x1F3}, {0x1F2, 0x1F3},
+    {0x1F4, 0x1F5}, {0x1F6, 0x195}, {0x1F7, 0x1BF}, {0x220, 0x19E},
+    {0x23A, 0x2C65}, {0x23B, 0x23C}, {0x23D, 0x19A}, {0x23E, 0x2C66},
+    {0x241, 0x242}, {0x243, 0x180}, {0x244, 0x289}, {0x245, 0x28C},
+    {0x370, 0x371}, {0x372, 0x373}, {0x376, 0x377}, {0x37F, 0x3F3},
+    {0x3CF, 0x3D7}, {0x3F4, 0x3B8}, {0x3F7, 0x3F8}, {0x3F9, 0x3F2},
+    {0x3FA, 0x3FB}, {0x3FD, 0x37B}, {0x3FE, 0x37C}, {0x3FF, 0x37D}
+};
+
+// Looks code point up in kIrregularLowerCase, returns it as is if not found
+uint32_t IrregularToLowerCase(const uint32_t code_point) {
+  const CaseMapping* end = kIrregularLowerCase + ARRAYSIZE(kIrregularLowerCase);
+  const CaseMapping* it =
+      std::lower_bound(kIrregularLowerCase,
+                       end,
+                       code_point,
+                       [](const CaseMapping& item, const uint32_t value) {
+                         return item.upper < value;
+                       });
+  return (end != it && it->upper == code_point) ? it->lower : code_point;
 }
 
-// Converts string to lower case unicode string.
-void ConvertWStringToLowerCase(std::wstring& str) {
-  const std::string current_locale = setlocale(LC_ALL, NULL);
-  setlocale(LC_ALL, "");
-  std::transform(str.begin(), str.end(), str.begin(), towlower);
-  setlocale(LC_ALL, current_locale.c_str());
+// Converts upper case letter to lower case one, other code points are
+// returned as is. Covers Latin, Greek, Cyrillic and Armenian letters,
+// which is the same as towlower gives for them in UTF8 locales.
+uint32_t ToLowerCase(const uint32_t code_point) {
+  const uint32_t c = code_point;
+  if (c < 0x80) {
+    return (c - 'A' < 26u) ? c + 32 : c;
+  }
+  if (c < 0x100) {
+    return (c >= 0xC0 && c <= 0xDE && c != 0xD7) ? c + 32 : c;
+  }
+  if (c < 0x180) {
+    // Latin Extended-A consists of upper/lower pairs
+    if (0x130 == c) {
+      return 'i';
+    }
+    if (0x178 == c) {
+      return 0xFF;
+    }
+    if (c < 0x138 || (c >= 0x14A && c < 0x178)) {
+      return c | 1;
+    }
+    if ((c >= 0x139 && c < 0x149) || (c >= 0x179 && c < 0x17F)) {
+      return (c & 1) ? c + 1 : c;
+    }
+    return c;
+  }
+  if (c < 0x250) {
+    // Latin Extended-B has pairs in its second half only
+    if (c >= 0x1CD && c < 0x1DD) {
+      return (c & 1) ? c + 1 : c;
+    }
+    if ((c >= 0x1DE && c < 0x1F0) || (c >= 0x1F8 && c < 0x220) ||
+        (c >= 0x222 && c < 0x234) || (c >= 0x246)) {
+      return c | 1;
+    }
+    return IrregularToLowerCase(c);
+  }
+  if (c >= 0x370 && c < 0x400) {
+    if (c >= 0x391 && c <= 0x3AB && c != 0x3A2) {
+      return c + 32;
+    }
+    if (0x386 == c) {
+      return 0x3AC;
+    }
+    if (c >= 0x388 && c <= 0x38A) {
+      return c + 37;
+    }
+    if (0x38C == c) {
+      return 0x3CC;
+    }
+    if (0x38E == c || 0x38F == c) {
+      return c + 63;
+    }
+    if (c >= 0x3D8 && c < 0x3F0) {
+      return c | 1;
+    }
+    return IrregularToLowerCase(c);
+  }
+  if (c >= 0x400 && c < 0x530) {
+    if (c < 0x410) {
+      return c + 80;
+    }
+    if (c < 0x430) {
+      return c + 32;
+    }
+    if ((c >= 0x460 && c < 0x482) || (c >= 0x48A && c < 0x4C0) ||
+        (c >= 0x4D0 && c < 0x530)) {
+      return c | 1;
+    }
+    if (0x4C0 == c) {
+      return 0x4CF;
+    }
+    if (c >= 0x4C1 && c < 0x4CF) {
+      return (c & 1) ? c + 1 : c;
+    }
+    return c;
+  }
+  if (c >= 0x531 && c <= 0x556) {
+    return c + 48;
+  }
+  if ((c >= 0x1E00 && c < 0x1E96) || (c >= 0x1EA0 && c < 0x1F00)) {
+    return c | 1;
+  }
+  if (0x1E9E == c) {
+    // Capital sharp s
+    return 0xDF;
+  }
+  if (c >= 0xFF21 && c <= 0xFF3A) {
+    return c + 32;
+  }
+  return c;
+}
+
+// Converts string to unicode string, optionally in lower case.
+std::wstring ConvertUTFToWString(const std::string& str,
+                                 const bool lower_case) {
+  std::wstring result;
+  result.reserve(str.size());
+  const char* position = str.data();
+  const char* end = position + str.size();
+  while (position != end) {
+    uint32_t code_point = DecodeCodePoint(position, end);
+    if (code_point & kInvalidByte) {
+      code_point = kReplacementCharacter;
+    } else if (lower_case) {
+      code_point = ToLowerCase(code_point);
+    }
+    result.push_back(static_cast<wchar_t>(code_point));
+  }
+  return result;
+}
+
+// Adds code point to faq6 hash
+inline uint32_t HashStep(uint32_t hash, const uint32_t code_point) {
+  hash += code_point;
+  hash += (hash << 10);
+  hash ^= (hash >> 6);
+  return hash;
 }
 }  // namespace
 
@@ -161,15 +346,17 @@ bool CustomString::CompareIgnoreCase(const CustomString& str) const {
   if (is_ascii_string() && str.is_ascii_string()) {
     return !strcasecmp(c_str(), str.c_str());
   }
-  std::wstring wstr_first(ConvertUTFToWString(mb_string_.c_str()));
-  std::wstring wstr_second(ConvertUTFToWString(str.c_str()));
-  ConvertWStringToLowerCase(wstr_first);
-  ConvertWStringToLowerCase(wstr_second);
-  return wstr_first == wstr_second;
+  return EqualIgnoreCase(
+      mb_string_.data(), mb_string_.size(), str.c_str(), str.length_bytes());
 }
 
 bool CustomString::CompareIgnoreCase(const char* str) const {
-  return CompareIgnoreCase(CustomString(str));
+  return EqualIgnoreCase(
+      mb_string_.data(), mb_string_.size(), str, strlen(str));
+}
+
+uint32_t CustomString::HashIgnoreCase() const {
+  return custom_string::HashIgnoreCase(mb_string_.data(), mb_string_.size());
 }
 
 const char* CustomString::c_str() const {
@@ -177,7 +364,7 @@ const char* CustomString::c_str() const {
 }
 
 std::wstring CustomString::ToWString() const {
-  return ConvertUTFToWString(mb_string_.c_str());
+  return ConvertUTFToWString(mb_string_, false);
 }
 
 std::string CustomString::AsMBString() const {
@@ -185,9 +372,7 @@ std::string CustomString::AsMBString() const {
 }
 
 std::wstring CustomString::ToWStringLowerCase() const {
-  std::wstring wstr(ConvertUTFToWString(mb_string_.c_str()));
-  ConvertWStringToLowerCase(wstr);
-  return wstr;
+  return ConvertUTFToWString(mb_string_, true);
 }
 
 void CustomString::InitData() {
@@ -198,5 +383,35 @@ void CustomString::InitData() {
   is_ascii_string_ = amount_characters_ == mb_string_.size();
 }
 
+bool EqualIgnoreCase(const char* lhs,
+                     const size_t lhs_length,
+                     const char* rhs,
+                     const size_t rhs_length) {
+  if (lhs_length == rhs_length && 0 == memcmp(lhs, rhs, lhs_length)) {
+    return true;
+  }
+  const char* lhs_end = lhs + lhs_length;
+  const char* rhs_end = rhs + rhs_length;
+  while (lhs != lhs_end && rhs != rhs_end) {
+    if (ToLowerCase(DecodeCodePoint(lhs, lhs_end)) !=
+        ToLowerCase(DecodeCodePoint(rhs, rhs_end))) {
+      return false;
+    }
+  }
+  return lhs == lhs_end && rhs == rhs_end;
+}
+
+uint32_t HashIgnoreCase(const char* str, const size_t length) {
+  uint32_t hash = 0;
+  const char* end = str + length;
+  while (str != end) {
+    hash = HashStep(hash, ToLowerCase(DecodeCodePoint(str, end)));
+  }
+  hash += (hash << 3);
+  hash ^= (hash >> 11);
+  hash += (hash << 15);
+  return hash;
+}
+
 }  // namespace custom_string
 }  // namespace utils
@@ -86,22 +86,7 @@ uint32_t CaseInsensitiveFaq6HashFromString(const char* cstr) {
 
 uint32_t CaseInsensitiveFaq6HashFromString(
     const custom_string::CustomString& str_to_hash) {
-  uint32_t hash = 0;
-  if (str_to_hash.is_ascii_string()) {
-    hash = CaseInsensitiveFaq6HashFromString(str_to_hash.c_str());
-  } else {
-    const std::wstring& wstr = str_to_hash.ToWStringLowerCase();
-    size_t size = wstr.size();
-    for (size_t i = 0; i < size; ++i) {
-      hash += static_cast<uint32_t>(wstr[i]);
-      hash += (hash << 10);
-      hash ^= (hash >> 6);
-    }
-    hash += (hash << 3);
-    hash ^= (hash >> 11);
-    hash += (hash << 15);
-  }
-  return hash;
+  return str_to_hash.HashIgnoreCase();
 }
 
 }  // namespace utils
@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "utils/timer_wheel.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(OS_LINUX)
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif
+
+#include "utils/logger.h"
+
+SDL_CREATE_LOG_VARIABLE("Utils")
+
+namespace {
+
+const uint64_t kNoEvent = UINT64_MAX;
+
+uint64_t MonotonicMs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000u + ts.tv_nsec / 1000000u;
+}
+
+uint64_t RotateRight(const uint64_t value, const uint32_t shift) {
+  return shift ? (value >> shift) | (value << (64u - shift)) : value;
+}
+
+void LinkBefore(timer::TimerWheelLink* head, timer::TimerWheelLink* link) {
+  link->next_ = head;
+  link->prev_ = head->prev_;
+  head->prev_->next_ = link;
+  head->prev_ = link;
+}
+
+void UnlinkSelf(timer::TimerWheelLink* link) {
+  link->prev_->next_ = link->next_;
+  link->next_->prev_ = link->prev_;
+  link->prev_ = link;
+  link->next_ = link;
+}
+
+}  // namespace
+
+namespace timer {
+
+TimerWheel& TimerWheel::instance() {
+  // Wheel is intentionally never destroyed: timers owned by static objects
+  // may be stopped during static deinitialization
+  static TimerWheel* wheel = new TimerWheel();
+  return *wheel;
+}
+
+TimerWheel::TimerWheel()
+    : current_tick_(0)
+    , armed_tick_(kNoEvent)
+    , start_time_ms_(MonotonicMs())
+#if defined(OS_LINUX)
+    , epoll_fd_(epoll_create1(EPOLL_CLOEXEC))
+    , timer_fd_(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC))
+#endif
+    , delegate_(new WheelDelegate(this))
+    , thread_(threads::CreateThread("TimerWheel", delegate_)) {
+  for (uint32_t level = 0; level < kLevels; ++level) {
+    occupied_[level] = 0;
+  }
+#if defined(OS_LINUX)
+  DCHECK(-1 != epoll_fd_);
+  DCHECK(-1 != timer_fd_);
+  struct epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = timer_fd_;
+  if (-1 == epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &event)) {
+    SDL_LOG_ERROR_WITH_ERRNO("Failed to add timerfd to epoll");
+  }
+#endif
+  thread_->Start();
+  for (uint32_t i = 0; i < kDispatchThreads; ++i) {
+    dispatch_delegates_[i] = new DispatchDelegate(this);
+    dispatch_threads_[i] =
+        threads::CreateThread("TimerDispatch", dispatch_delegates_[i]);
+    dispatch_threads_[i]->Start();
+  }
+}
+
+void TimerWheel::Schedule(TimerWheelEntry* entry,
+                          const uint32_t timeout,
+                          const bool periodic) {
+  DCHECK_OR_RETURN_VOID(entry);
+  sync_primitives::AutoLock auto_lock(lock_);
+  Unlink(entry);
+  if (entry->dispatching_) {
+    entry->detached_ = true;
+  }
+  Advance(Now());
+  entry->expires_ = current_tick_ + timeout;
+  // Zero period would mean single shot, so periodic entry with zero
+  // timeout is repeated every tick instead
+  entry->period_ = periodic ? std::max<uint32_t>(timeout, 1u) : 0;
+  Insert(entry);
+  ArmWakeup(NextEventTick());
+}
+
+void TimerWheel::Cancel(TimerWheelEntry* entry,
+                        sync_primitives::BaseLock* lock) {
+  DCHECK_OR_RETURN_VOID(entry);
+  {
+    sync_primitives::AutoLock auto_lock(lock_);
+    Unlink(entry);
+    if (!entry->dispatching_) {
+      return;
+    }
+    entry->detached_ = true;
+    if (pthread_equal(entry->dispatcher_, threads::Thread::CurrentId())) {
+      return;
+    }
+  }
+
+  // Callback is running in dispatch thread and may require client lock,
+  // so it should be released while waiting for callback completion.
+  // Wheel lock is always taken after the client one.
+  if (lock) {
+    lock->Release();
+  }
+  {
+    sync_primitives::AutoLock auto_lock(lock_);
+    while (entry->dispatching_) {
+      dispatch_done_.Wait(auto_lock);
+    }
+  }
+  if (lock) {
+    lock->Acquire();
+  }
+}
+
+uint64_t TimerWheel::Now() const {
+  return MonotonicMs() - start_time_ms_;
+}
+
+void TimerWheel::Insert(TimerWheelEntry* entry) {
+  if (entry->expires_ <= current_tick_) {
+    entry->bucket_ = TimerWheelEntry::kDueBucket;
+    LinkBefore(&due_, entry);
+    due_ready_.NotifyOne();
+    return;
+  }
+
+  const uint64_t max_delta = (1ull << (kSlotBits * kLevels)) - 1;
+  const uint64_t delta = entry->expires_ - current_tick_;
+
+  uint32_t level = 0;
+  while (level < kLevels - 1 && delta >> (kSlotBits * (level + 1))) {
+    ++level;
+  }
+
+  // Entries which are too far away are parked in the farthest top level slot
+  // and get reinserted once it is cascaded
+  const uint64_t expires =
+      delta > max_delta ? current_tick_ + max_delta : entry->expires_;
+  const uint32_t slot = (expires >> (kSlotBits * level)) & (kSlots - 1);
+
+  entry->bucket_ = level * kSlots + slot;
+  occupied_[level] |= 1ull << slot;
+  LinkBefore(&slots_[level][slot], entry);
+}
+
+void TimerWheel::Unlink(TimerWheelEntry* entry) {
+  if (TimerWheelEntry::kNoBucket == entry->bucket_) {
+    return;
+  }
+
+  UnlinkSelf(entry);
+  if (entry->bucket_ >= 0) {
+    const uint32_t level = entry->bucket_ / kSlots;
+    const uint32_t slot = entry->bucket_ % kSlots;
+    if (!slots_[level][slot].linked()) {
+      occupied_[level] &= ~(1ull << slot);
+    }
+  }
+  entry->bucket_ = TimerWheelEntry::kNoBucket;
+}
+
+void TimerWheel::Cascade(const uint32_t level, const uint32_t slot) {
+  TimerWheelLink pending;
+  TimerWheelLink& head = slots_[level][slot];
+  if (!head.linked()) {
+    return;
+  }
+
+  // Move whole slot list to the local head at once
+  pending.next_ = head.next_;
+  pending.prev_ = head.prev_;
+  pending.next_->prev_ = &pending;
+  pending.prev_->next_ = &pending;
+  head.next_ = &head;
+  head.prev_ = &head;
+  occupied_[level] &= ~(1ull << slot);
+
+  while (pending.linked()) {
+    TimerWheelEntry* entry = static_cast<TimerWheelEntry*>(pending.next_);
+    UnlinkSelf(entry);
+    Insert(entry);
+  }
+}
+
+void TimerWheel::Advance(const uint64_t now) {
+  while (current_tick_ < now) {
+    const uint64_t next = NextEventTick();
+    if (next > now) {
+      current_tick_ = now;
+      return;
+    }
+
+    current_tick_ = next;
+    for (uint32_t level = kLevels - 1; level > 0; --level) {
+      const uint32_t shift = kSlotBits * level;
+      if (0 == (current_tick_ & ((1ull << shift) - 1))) {
+        Cascade(level, (current_tick_ >> shift) & (kSlots - 1));
+      }
+    }
+    Cascade(0, current_tick_ & (kSlots - 1));
+  }
+}
+
+TimerWheelEntry* TimerWheel::NextDueEntry() const {
+  for (TimerWheelLink* link = due_.next_; link != &due_; link = link->next_) {
+    TimerWheelEntry* entry = static_cast<TimerWheelEntry*>(link);
+    // Entry rescheduled from its own callback waits for the callback
+    if (!entry->dispatching_) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+uint64_t TimerWheel::NextEventTick() const {
+  uint64_t next = kNoEvent;
+  for (uint32_t level = 0; level < kLevels; ++level) {
+    if (!occupied_[level]) {
+      continue;
+    }
+    const uint32_t shift = kSlotBits * level;
+    const uint64_t first_index = (current_tick_ >> shift) + 1;
+    const uint32_t rotation = first_index & (kSlots - 1);
+    const uint64_t distance =
+        __builtin_ctzll(RotateRight(occupied_[level], rotation));
+    const uint64_t tick = (first_index + distance) << shift;
+    if (tick < next) {
+      next = tick;
+    }
+  }
+  return next;
+}
+
+void TimerWheel::ArmWakeup(const uint64_t tick) {
+  if (tick >= armed_tick_) {
+    return;
+  }
+  armed_tick_ = tick;
+
+#if defined(OS_LINUX)
+  // Zero value disarms timerfd, so it is never armed to current moment
+  const uint64_t wakeup_ms = start_time_ms_ + tick;
+  struct itimerspec spec = {};
+  spec.it_value.tv_sec = wakeup_ms / 1000u;
+  spec.it_value.tv_nsec = (wakeup_ms % 1000u) * 1000000u + 1;
+  if (-1 == timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, NULL)) {
+    SDL_LOG_ERROR_WITH_ERRNO("Failed to arm timerfd");
+  }
+#else
+  wakeup_.NotifyOne();
+#endif
+}
+
+void TimerWheel::WaitForWakeup(sync_primitives::AutoLock& auto_lock) {
+#if defined(OS_LINUX)
+  struct epoll_event event;
+  {
+    sync_primitives::AutoUnlock auto_unlock(auto_lock);
+    const int result = epoll_wait(epoll_fd_, &event, 1, -1);
+    if (-1 == result && EINTR != errno) {
+      SDL_LOG_ERROR_WITH_ERRNO("epoll_wait failed");
+    }
+    uint64_t expirations = 0;
+    if (-1 == read(timer_fd_, &expirations, sizeof(expirations)) &&
+        EAGAIN != errno) {
+      SDL_LOG_ERROR_WITH_ERRNO("Failed to read timerfd");
+    }
+  }
+#else
+  if (kNoEvent == armed_tick_) {
+    wakeup_.Wait(auto_lock);
+    return;
+  }
+  const uint64_t now = Now();
+  if (armed_tick_ > now) {
+    wakeup_.WaitFor(auto_lock, static_cast<uint32_t>(armed_tick_ - now));
+  }
+#endif
+}
+
+void TimerWheel::Run() {
+  sync_primitives::AutoLock auto_lock(lock_);
+  for (;;) {
+    Advance(Now());
+    armed_tick_ = kNoEvent;
+    ArmWakeup(NextEventTick());
+    WaitForWakeup(auto_lock);
+  }
+}
+
+void TimerWheel::Dispatch() {
+  sync_primitives::AutoLock auto_lock(lock_);
+  for (;;) {
+    TimerWheelEntry* entry = NextDueEntry();
+    if (!entry) {
+      due_ready_.Wait(auto_lock);
+      continue;
+    }
+
+    Unlink(entry);
+    entry->dispatching_ = true;
+    entry->detached_ = false;
+    entry->dispatcher_ = threads::Thread::CurrentId();
+    {
+      sync_primitives::AutoUnlock auto_unlock(auto_lock);
+      entry->OnExpired();
+    }
+    entry->dispatching_ = false;
+    if (!entry->detached_ && entry->period_) {
+      Advance(Now());
+      entry->expires_ = current_tick_ + entry->period_;
+      Insert(entry);
+      ArmWakeup(NextEventTick());
+    }
+    dispatch_done_.Broadcast();
+    // Entry skipped by other threads while its callback was running
+    // may be due already
+    if (due_.linked()) {
+      due_ready_.NotifyOne();
+    }
+  }
+}
+
+TimerWheel::WheelDelegate::WheelDelegate(TimerWheel* wheel) : wheel_(wheel) {
+  DCHECK(wheel_);
+}
+
+void TimerWheel::WheelDelegate::threadMain() {
+  wheel_->Run();
+}
+
+TimerWheel::DispatchDelegate::DispatchDelegate(TimerWheel* wheel)
+    : wheel_(wheel) {
+  DCHECK(wheel_);
+}
+
+void TimerWheel::DispatchDelegate::threadMain() {
+  wheel_->Dispatch();
+}
+
+}  // namespace timer
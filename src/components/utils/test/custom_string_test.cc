@@ -314,6 +314,94 @@ TEST_F(
   EXPECT_TRUE(obj.CompareIgnoreCase(mbstring.c_str()));
 }
 
+TEST_F(CustomStringTest,
+       AddSameMultiByteStringsToCustomString_ExpectEqualCaseInsensitiveHash) {
+  const std::string lower_case = "\xD1\x82\xD0\xB5\xD1\x81\xD1\x82";
+  custom_str::CustomString obj(CustomStringTest::mbstring1_);
+  custom_str::CustomString obj1(lower_case);
+  EXPECT_EQ(obj.HashIgnoreCase(), obj1.HashIgnoreCase());
+  EXPECT_EQ(obj.HashIgnoreCase(),
+            custom_str::CustomString("\xD0\xA2\xD0\x95\xD0\xA1\xD0\xA2")
+                .HashIgnoreCase());
+  EXPECT_NE(obj.HashIgnoreCase(),
+            custom_str::CustomString(CustomStringTest::mbstring2_)
+                .HashIgnoreCase());
+}
+
+TEST_F(CustomStringTest,
+       AddASCIIStringsToCustomString_ExpectEqualCaseInsensitiveHash) {
+  EXPECT_EQ(custom_str::CustomString("Navigation").HashIgnoreCase(),
+            custom_str::CustomString("NAVIGATION").HashIgnoreCase());
+  EXPECT_NE(custom_str::CustomString("Navigation").HashIgnoreCase(),
+            custom_str::CustomString("Navigator").HashIgnoreCase());
+}
+
+TEST_F(CustomStringTest, CompareLatinAndGreekLetters_ExpectCaseIgnored) {
+  // "ÄÖÜ straße" and "äöü STRASSE" differ in sharp s only
+  custom_str::CustomString latin("\xC3\x84\xC3\x96\xC3\x9C stra\xC3\x9F"
+                                 "e");
+  EXPECT_TRUE(
+      latin.CompareIgnoreCase("\xC3\xA4\xC3\xB6\xC3\xBC STRA\xC3\x9F"
+                              "E"));
+  EXPECT_FALSE(
+      latin.CompareIgnoreCase("\xC3\xA4\xC3\xB6\xC3\xBC STRASSE"));
+  // "ΣΟΦΙΑ" and "σοφια"
+  custom_str::CustomString greek("\xCE\xA3\xCE\x9F\xCE\xA6\xCE\x99\xCE\x91");
+  EXPECT_TRUE(
+      greek.CompareIgnoreCase("\xCF\x83\xCE\xBF\xCF\x86\xCE\xB9\xCE\xB1"));
+  EXPECT_EQ(
+      greek.HashIgnoreCase(),
+      custom_str::CustomString("\xCF\x83\xCE\xBF\xCF\x86\xCE\xB9\xCE\xB1")
+          .HashIgnoreCase());
+}
+
+TEST_F(CustomStringTest, CompareLatinExtendedLetters_ExpectCaseIgnored) {
+  // Romanian "ȘȚ", Vietnamese "ƠƯ" and capital sharp s "ẞ"
+  custom_str::CustomString upper(
+      "\xC8\x98\xC8\x9A\xC6\xA0\xC6\xAF\xE1\xBA\x9E");
+  const std::string lower = "\xC8\x99\xC8\x9B\xC6\xA1\xC6\xB0\xC3\x9F";
+  EXPECT_TRUE(upper.CompareIgnoreCase(lower.c_str()));
+  EXPECT_EQ(upper.HashIgnoreCase(),
+            custom_str::CustomString(lower).HashIgnoreCase());
+  EXPECT_EQ(std::wstring(L"\x0219\x021B\x01A1\x01B0\x00DF"),
+            upper.ToWStringLowerCase());
+}
+
+TEST_F(CustomStringTest, CompareInvalidUTF8_ExpectBytesCompared) {
+  const std::string invalid = "ab\xD0";
+  custom_str::CustomString obj(invalid);
+  EXPECT_TRUE(obj.CompareIgnoreCase("AB\xD0"));
+  EXPECT_FALSE(obj.CompareIgnoreCase("AB\xD1"));
+  EXPECT_FALSE(obj.CompareIgnoreCase("AB"));
+  EXPECT_EQ(std::wstring(L"ab\xFFFD"), obj.ToWString());
+}
+
+TEST_F(CustomStringTest,
+       AddMultiByteStringToCustomString_ExpectCorrectConvertingToLowerCase) {
+  custom_str::CustomString obj(CustomStringTest::mbstring2_);
+  EXPECT_EQ(std::wstring(L"\x0442\x0435\x0441\x0442"
+                         L"abc"),
+            obj.ToWStringLowerCase());
+}
+
+TEST_F(CustomStringTest, StringSetIgnoreCase_ExpectDuplicatesFound) {
+  const std::string synonyms[] = {
+      "Play", "Pause", "\xD0\xA2\xD0\xB5\xD1\x81\xD1\x82"};
+  custom_str::StringSetIgnoreCase index;
+  for (size_t i = 0; i < sizeof(synonyms) / sizeof(synonyms[0]); ++i) {
+    EXPECT_TRUE(
+        index.insert(custom_str::StringRefIgnoreCase(synonyms[i].c_str(),
+                                                     synonyms[i].size()))
+            .second);
+  }
+  const custom_str::CustomString duplicate("PLAY");
+  EXPECT_EQ(1u, index.count(custom_str::StringRefIgnoreCase(duplicate)));
+  const custom_str::CustomString russian("\xD1\x82\xD0\x95\xD0\xA1\xD0\xA2");
+  EXPECT_EQ(1u, index.count(custom_str::StringRefIgnoreCase(russian)));
+  const custom_str::CustomString unique("Stop");
+  EXPECT_EQ(0u, index.count(custom_str::StringRefIgnoreCase(unique)));
+}
+
 }  // namespace utils_test
 }  // namespace components
 }  // namespace test
@@ -30,7 +30,11 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <unistd.h>
+#include <vector>
+
 #include "gtest/gtest.h"
+#include "utils/lock.h"
 #include "utils/test_handler.h"
 
 namespace test {
@@ -47,6 +51,66 @@ TEST(MessageLoopThreadTest, GetMessageQueueSize_AddValueToQueue_CorrectSize) {
   ASSERT_EQ(1u, message_loop_thread.GetMessageQueueSize());
 }
 
+namespace {
+typedef threads::MessageLoopThread<std::queue<int> > IntLoopThread;
+
+class BatchHandler : public IntLoopThread::Handler {
+ public:
+  BatchHandler() : batches_count_(0) {}
+
+  void Handle(const int message) OVERRIDE {
+    sync_primitives::AutoLock auto_lock(lock_);
+    handled_.push_back(message);
+  }
+
+  void HandleBatch(const std::vector<int>& messages) OVERRIDE {
+    {
+      sync_primitives::AutoLock auto_lock(lock_);
+      ++batches_count_;
+    }
+    IntLoopThread::Handler::HandleBatch(messages);
+  }
+
+  std::vector<int> handled() const {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return handled_;
+  }
+
+  size_t batches_count() const {
+    sync_primitives::AutoLock auto_lock(lock_);
+    return batches_count_;
+  }
+
+ private:
+  mutable sync_primitives::Lock lock_;
+  std::vector<int> handled_;
+  size_t batches_count_;
+};
+}  // namespace
+
+TEST(MessageLoopThreadTest, HandleBatch_PostMessages_AllHandledInOrder) {
+  const int kMessagesCount = 1000;
+  BatchHandler handler;
+  {
+    IntLoopThread message_loop_thread("test", &handler);
+    for (int i = 0; i < kMessagesCount; ++i) {
+      message_loop_thread.PostMessage(i);
+    }
+    message_loop_thread.WaitDumpQueue();
+    while (handler.handled().size() < static_cast<size_t>(kMessagesCount)) {
+      usleep(1000);
+    }
+  }
+
+  const std::vector<int> handled = handler.handled();
+  ASSERT_EQ(static_cast<size_t>(kMessagesCount), handled.size());
+  for (int i = 0; i < kMessagesCount; ++i) {
+    EXPECT_EQ(i, handled[i]);
+  }
+  EXPECT_GE(handler.batches_count(), 1u);
+  EXPECT_LE(handler.batches_count(), static_cast<size_t>(kMessagesCount));
+}
+
 }  // namespace utils_test
 }  // namespace components
 }  // namespace test
@@ -174,6 +174,26 @@ TEST_F(MessageQueueTest,
   pthread_join(thread1, NULL);
 }
 
+TEST_F(MessageQueueTest,
+       MessageQueuePopBatchTest_ExpectElementsRemovedInOrderUpToMaxCount) {
+  test_queue.push(test_val_1);
+  test_queue.push(test_val_2);
+  test_queue.push(test_val_3);
+
+  std::vector<std::string> batch;
+  EXPECT_EQ(2u, test_queue.pop_batch(batch, 2u));
+  ASSERT_EQ(2u, batch.size());
+  EXPECT_EQ(test_val_1, batch[0]);
+  EXPECT_EQ(test_val_2, batch[1]);
+
+  EXPECT_EQ(1u, test_queue.pop_batch(batch, 2u));
+  ASSERT_EQ(3u, batch.size());
+  EXPECT_EQ(test_val_3, batch[2]);
+
+  EXPECT_EQ(0u, test_queue.pop_batch(batch, 2u));
+  EXPECT_TRUE(test_queue.empty());
+}
+
 }  // namespace utils_test
 }  // namespace components
 }  // namespace test
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/mpsc_ring_queue.h"
+
+#include <pthread.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+#include "utils/threads/message_loop_thread.h"
+
+namespace test {
+namespace components {
+namespace utils_test {
+
+namespace {
+
+const size_t kProducersCount = 4u;
+const size_t kMessagesPerProducer = 10000u;
+// Small ring makes producers to use overflow queue as well
+const size_t kSmallCapacity = 8u;
+
+typedef std::pair<size_t, size_t> ProducerMessage;
+typedef utils::MpscRingQueue<ProducerMessage, kSmallCapacity> SmallRingQueue;
+typedef utils::MessageQueue<ProducerMessage, SmallRingQueue> RingMessageQueue;
+
+/**
+ * Counts how many times value was copied on its way through the queue
+ */
+struct CopyCounted {
+  CopyCounted() : copies(0u) {}
+  CopyCounted(const CopyCounted& other) : copies(other.copies + 1) {}
+  CopyCounted(CopyCounted&& other) : copies(other.copies) {}
+  CopyCounted& operator=(const CopyCounted& other) {
+    copies = other.copies + 1;
+    return *this;
+  }
+  CopyCounted& operator=(CopyCounted&& other) {
+    copies = other.copies;
+    return *this;
+  }
+  size_t copies;
+};
+
+struct ProducerContext {
+  RingMessageQueue* queue;
+  size_t producer_id;
+};
+
+void* Produce(void* data) {
+  ProducerContext* context = static_cast<ProducerContext*>(data);
+  for (size_t i = 0; i < kMessagesPerProducer; ++i) {
+    context->queue->push(std::make_pair(context->producer_id, i));
+  }
+  return NULL;
+}
+
+typedef threads::MessageLoopThread<SmallRingQueue> RingLoopThread;
+
+struct PosterContext {
+  RingLoopThread* loop_thread;
+  size_t producer_id;
+};
+
+void* Post(void* data) {
+  PosterContext* context = static_cast<PosterContext*>(data);
+  for (size_t i = 0; i < kMessagesPerProducer; ++i) {
+    context->loop_thread->PostMessage(std::make_pair(context->producer_id, i));
+  }
+  return NULL;
+}
+
+class CountingHandler : public RingLoopThread::Handler {
+ public:
+  CountingHandler() : handled_count_(0u), order_violated_(false) {
+    for (size_t i = 0; i < kProducersCount; ++i) {
+      next_expected_.push_back(0u);
+    }
+  }
+
+  void Handle(const ProducerMessage message) OVERRIDE {
+    sync_primitives::AutoLock auto_lock(lock_);
+    if (next_expected_[message.first] != message.second) {
+      order_violated_ = true;
+    }
+    next_expected_[message.first] = message.second + 1;
+    ++handled_count_;
+    if (kProducersCount * kMessagesPerProducer == handled_count_) {
+      all_handled_.NotifyOne();
+    }
+  }
+
+  bool WaitAllHandled() {
+    sync_primitives::AutoLock auto_lock(lock_);
+    while (kProducersCount * kMessagesPerProducer != handled_count_) {
+      if (sync_primitives::ConditionalVariable::kTimeout ==
+          all_handled_.WaitFor(auto_lock, 10000u)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool order_violated() const {
+    return order_violated_;
+  }
+
+ private:
+  sync_primitives::Lock lock_;
+  sync_primitives::ConditionalVariable all_handled_;
+  std::vector<size_t> next_expected_;
+  size_t handled_count_;
+  bool order_violated_;
+};
+
+}  // namespace
+
+TEST(MpscRingQueueTest, TryPushTryPop_FullQueue_PushFailsAndOrderKept) {
+  utils::MpscRingQueue<int, 4u> queue;
+  EXPECT_TRUE(queue.empty());
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.TryPush(i));
+  }
+  EXPECT_FALSE(queue.TryPush(4));
+  EXPECT_EQ(4u, queue.size());
+
+  int value = -1;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_FALSE(queue.TryPop(value));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpscRingQueueTest,
+     MessageQueue_PushOverCapacity_AllElementsPoppedInOrder) {
+  RingMessageQueue queue;
+  const size_t count = kSmallCapacity * 3;
+  for (size_t i = 0; i < count; ++i) {
+    queue.push(std::make_pair(0u, i));
+  }
+  EXPECT_EQ(count, queue.size());
+
+  std::vector<ProducerMessage> batch;
+  EXPECT_EQ(kSmallCapacity, queue.pop_batch(batch, kSmallCapacity));
+
+  ProducerMessage message;
+  while (queue.pop(message)) {
+    batch.push_back(message);
+  }
+  ASSERT_EQ(count, batch.size());
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(i, batch[i].second);
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpscRingQueueTest, MessageQueue_PopBatch_ElementsMovedOut) {
+  utils::MessageQueue<CopyCounted,
+                      utils::MpscRingQueue<CopyCounted, kSmallCapacity> >
+      queue;
+  const size_t count = kSmallCapacity * 2;
+  for (size_t i = 0; i < count; ++i) {
+    queue.push(CopyCounted());
+  }
+
+  std::vector<CopyCounted> batch;
+  batch.reserve(count);
+  EXPECT_EQ(count, queue.pop_batch(batch, count));
+  ASSERT_EQ(count, batch.size());
+  for (size_t i = 0; i < count; ++i) {
+    // The only copy is made by push()
+    EXPECT_EQ(1u, batch[i].copies);
+  }
+}
+
+TEST(MpscRingQueueTest, MessageQueue_Shutdown_PopReturnsFalse) {
+  RingMessageQueue queue;
+  queue.push(std::make_pair(0u, 0u));
+  queue.Shutdown();
+  EXPECT_TRUE(queue.IsShuttingDown());
+
+  // Waiting on the queue being shut down should not block
+  queue.wait();
+  ProducerMessage message;
+  EXPECT_FALSE(queue.pop(message));
+  EXPECT_TRUE(queue.empty());
+
+  queue.push(std::make_pair(0u, 1u));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpscRingQueueTest,
+     MessageLoopThread_SeveralProducers_PerProducerOrderKept) {
+  CountingHandler handler;
+  RingLoopThread loop_thread("RingLoop", &handler);
+
+  pthread_t producers[kProducersCount];
+  PosterContext contexts[kProducersCount];
+  for (size_t i = 0; i < kProducersCount; ++i) {
+    contexts[i].loop_thread = &loop_thread;
+    contexts[i].producer_id = i;
+    ASSERT_EQ(0, pthread_create(&producers[i], NULL, &Post, &contexts[i]));
+  }
+  for (size_t i = 0; i < kProducersCount; ++i) {
+    pthread_join(producers[i], NULL);
+  }
+
+  EXPECT_TRUE(handler.WaitAllHandled());
+  EXPECT_FALSE(handler.order_violated());
+}
+
+TEST(MpscRingQueueTest, MessageQueue_SeveralProducers_AllElementsPopped) {
+  RingMessageQueue queue;
+  pthread_t producers[kProducersCount];
+  ProducerContext contexts[kProducersCount];
+  for (size_t i = 0; i < kProducersCount; ++i) {
+    contexts[i].queue = &queue;
+    contexts[i].producer_id = i;
+    ASSERT_EQ(0, pthread_create(&producers[i], NULL, &Produce, &contexts[i]));
+  }
+
+  std::vector<size_t> next_expected(kProducersCount, 0u);
+  size_t popped = 0u;
+  ProducerMessage message;
+  while (popped < kProducersCount * kMessagesPerProducer) {
+    queue.wait();
+    while (queue.pop(message)) {
+      ASSERT_EQ(next_expected[message.first], message.second);
+      next_expected[message.first] = message.second + 1;
+      ++popped;
+    }
+  }
+
+  for (size_t i = 0; i < kProducersCount; ++i) {
+    pthread_join(producers[i], NULL);
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+}  // namespace utils_test
+}  // namespace components
+}  // namespace test
@@ -37,6 +37,7 @@ namespace test {
 namespace components {
 namespace utils_test {
 
+using ::utils::FixedPrioritizedQueue;
 using ::utils::PrioritizedQueue;
 
 class TestMessage {
@@ -207,6 +208,77 @@ TEST_F(PrioritizedQueueTest,
   EXPECT_EQ(message3, test_queue.front());
 }
 
+class FixedPrioritizedQueueTest : public testing::Test {
+ protected:
+  FixedPrioritizedQueue<TestMessage> test_queue;
+};
+
+TEST_F(FixedPrioritizedQueueTest, DefaultCtorTest_ExpectEmptyQueueCreated) {
+  EXPECT_TRUE(test_queue.empty());
+  EXPECT_EQ(0u, test_queue.size());
+}
+
+TEST_F(FixedPrioritizedQueueTest,
+       PopAll_MessagesWithDifferentPriorities_ExpectPriorityThenFifoOrder) {
+  TestMessage message1("Ford", 2);
+  TestMessage message2("Hello", 1);
+  TestMessage message3("Luxoft", 255);
+  TestMessage message4("from", 2);
+  TestMessage message5("SDL", 64);
+  test_queue.push(message1);
+  test_queue.push(message2);
+  test_queue.push(message3);
+  test_queue.push(message4);
+  test_queue.push(message5);
+  EXPECT_EQ(5u, test_queue.size());
+
+  const TestMessage expected[] = {
+      message3, message5, message1, message4, message2};
+  for (size_t i = 0; i < ARRAYSIZE(expected); ++i) {
+    ASSERT_FALSE(test_queue.empty());
+    EXPECT_EQ(expected[i], test_queue.front());
+    test_queue.pop();
+  }
+  EXPECT_TRUE(test_queue.empty());
+}
+
+TEST_F(FixedPrioritizedQueueTest,
+       PushPop_MoreMessagesThanLevelCapacity_ExpectFifoOrderKept) {
+  const size_t messages_count = 100u;
+  for (size_t round = 0; round < 2; ++round) {
+    for (size_t i = 0; i < messages_count; ++i) {
+      test_queue.push(TestMessage(std::to_string(i), 7));
+      // Interleave pops to make level ring buffer wrap around
+      if (i % 3 == 0) {
+        test_queue.pop();
+      }
+    }
+    while (!test_queue.empty()) {
+      test_queue.pop();
+    }
+  }
+
+  for (size_t i = 0; i < messages_count; ++i) {
+    test_queue.push(TestMessage(std::to_string(i), 7));
+  }
+  for (size_t i = 0; i < messages_count; ++i) {
+    EXPECT_EQ(std::to_string(i), test_queue.front().msg());
+    test_queue.pop();
+  }
+  EXPECT_TRUE(test_queue.empty());
+}
+
+TEST_F(FixedPrioritizedQueueTest, Swap_ExpectContentExchanged) {
+  FixedPrioritizedQueue<TestMessage> other_queue;
+  TestMessage message("Hello", 3);
+  test_queue.push(message);
+
+  test_queue.swap(other_queue);
+  EXPECT_TRUE(test_queue.empty());
+  ASSERT_EQ(1u, other_queue.size());
+  EXPECT_EQ(message, other_queue.front());
+}
+
 }  // namespace utils_test
 }  // namespace components
 }  // namespace test
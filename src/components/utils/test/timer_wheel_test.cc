@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/timer_wheel.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/conditional_variable.h"
+#include "utils/lock.h"
+
+namespace test {
+namespace components {
+namespace timer_wheel_test {
+namespace {
+
+sync_primitives::Lock expire_lock;
+sync_primitives::ConditionalVariable expire_condition;
+
+const uint32_t kWaitTimeoutMs = 5000u;
+
+class TestEntry : public timer::TimerWheelEntry {
+ public:
+  TestEntry(const uint32_t id, std::vector<uint32_t>* order)
+      : id_(id), order_(order), calls_count_(0u) {}
+
+  void OnExpired() OVERRIDE {
+    sync_primitives::AutoLock auto_lock(expire_lock);
+    ++calls_count_;
+    if (order_) {
+      order_->push_back(id_);
+    }
+    expire_condition.Broadcast();
+  }
+
+  size_t calls_count() const {
+    return calls_count_;
+  }
+
+ private:
+  uint32_t id_;
+  std::vector<uint32_t>* order_;
+  size_t calls_count_;
+};
+
+class SelfCancelEntry : public timer::TimerWheelEntry {
+ public:
+  SelfCancelEntry() : calls_count_(0u) {}
+
+  void OnExpired() OVERRIDE {
+    timer::TimerWheel::instance().Cancel(this, NULL);
+    sync_primitives::AutoLock auto_lock(expire_lock);
+    ++calls_count_;
+    expire_condition.Broadcast();
+  }
+
+  size_t calls_count() const {
+    return calls_count_;
+  }
+
+ private:
+  size_t calls_count_;
+};
+
+/**
+ * Entry which callback does not return until it is released
+ */
+class BlockingEntry : public timer::TimerWheelEntry {
+ public:
+  BlockingEntry() : started_(false), released_(false), finished_(false) {}
+
+  void OnExpired() OVERRIDE {
+    sync_primitives::AutoLock auto_lock(expire_lock);
+    started_ = true;
+    expire_condition.Broadcast();
+    while (!released_) {
+      expire_condition.Wait(auto_lock);
+    }
+    finished_ = true;
+  }
+
+  /**
+   * Should be called with expire_lock taken
+   */
+  void Release() {
+    released_ = true;
+    expire_condition.Broadcast();
+  }
+
+  bool started() const {
+    return started_;
+  }
+
+  bool finished() const {
+    return finished_;
+  }
+
+ private:
+  bool started_;
+  bool released_;
+  bool finished_;
+};
+
+bool WaitForCalls(const std::vector<TestEntry*>& entries,
+                  sync_primitives::AutoLock& auto_lock) {
+  for (size_t i = 0; i < entries.size(); ++i) {
+    while (0u == entries[i]->calls_count()) {
+      if (sync_primitives::ConditionalVariable::kTimeout ==
+          expire_condition.WaitFor(auto_lock, kWaitTimeoutMs)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(TimerWheelTest, Schedule_EntriesWithDifferentLevels_ExpireInOrder) {
+  // Timeouts are chosen to be placed at level 0 and level 1 of the wheel
+  const uint32_t timeouts[] = {150u, 10u, 70u, 40u};
+  const uint32_t expected_order[] = {1u, 3u, 2u, 0u};
+
+  std::vector<uint32_t> order;
+  std::vector<TestEntry*> entries;
+  sync_primitives::AutoLock auto_lock(expire_lock);
+  for (uint32_t i = 0; i < ARRAYSIZE(timeouts); ++i) {
+    entries.push_back(new TestEntry(i, &order));
+    timer::TimerWheel::instance().Schedule(entries.back(), timeouts[i], false);
+  }
+
+  EXPECT_TRUE(WaitForCalls(entries, auto_lock));
+  ASSERT_EQ(ARRAYSIZE(expected_order), order.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    EXPECT_EQ(expected_order[i], order[i]);
+  }
+
+  for (size_t i = 0; i < entries.size(); ++i) {
+    EXPECT_EQ(1u, entries[i]->calls_count());
+    timer::TimerWheel::instance().Cancel(entries[i], &expire_lock);
+    delete entries[i];
+  }
+}
+
+TEST(TimerWheelTest, Cancel_ScheduledEntry_NoCall) {
+  TestEntry entry(0u, NULL);
+  TestEntry control_entry(1u, NULL);
+  std::vector<TestEntry*> entries(1u, &control_entry);
+
+  timer::TimerWheel::instance().Schedule(&entry, 20u, false);
+  timer::TimerWheel::instance().Cancel(&entry, NULL);
+
+  sync_primitives::AutoLock auto_lock(expire_lock);
+  timer::TimerWheel::instance().Schedule(&control_entry, 40u, false);
+  EXPECT_TRUE(WaitForCalls(entries, auto_lock));
+  EXPECT_EQ(0u, entry.calls_count());
+  timer::TimerWheel::instance().Cancel(&control_entry, &expire_lock);
+}
+
+TEST(TimerWheelTest, Schedule_Periodic_ExpiresSeveralTimes) {
+  const size_t loops_count = 3u;
+  TestEntry entry(0u, NULL);
+
+  sync_primitives::AutoLock auto_lock(expire_lock);
+  timer::TimerWheel::instance().Schedule(&entry, 10u, true);
+  while (entry.calls_count() < loops_count) {
+    ASSERT_EQ(sync_primitives::ConditionalVariable::kNoTimeout,
+              expire_condition.WaitFor(auto_lock, kWaitTimeoutMs));
+  }
+  timer::TimerWheel::instance().Cancel(&entry, &expire_lock);
+  EXPECT_LE(loops_count, entry.calls_count());
+}
+
+TEST(TimerWheelTest, Schedule_PeriodicWithZeroTimeout_ExpiresSeveralTimes) {
+  const size_t loops_count = 3u;
+  TestEntry entry(0u, NULL);
+
+  sync_primitives::AutoLock auto_lock(expire_lock);
+  timer::TimerWheel::instance().Schedule(&entry, 0u, true);
+  while (entry.calls_count() < loops_count) {
+    ASSERT_EQ(sync_primitives::ConditionalVariable::kNoTimeout,
+              expire_condition.WaitFor(auto_lock, kWaitTimeoutMs));
+  }
+  timer::TimerWheel::instance().Cancel(&entry, &expire_lock);
+  EXPECT_LE(loops_count, entry.calls_count());
+}
+
+TEST(TimerWheelTest, Cancel_FromOwnCallback_ExpiresOnce) {
+  SelfCancelEntry entry;
+
+  sync_primitives::AutoLock auto_lock(expire_lock);
+  timer::TimerWheel::instance().Schedule(&entry, 10u, true);
+  while (0u == entry.calls_count()) {
+    ASSERT_EQ(sync_primitives::ConditionalVariable::kNoTimeout,
+              expire_condition.WaitFor(auto_lock, kWaitTimeoutMs));
+  }
+  // Give wheel a chance to fire once more if it would reschedule the entry
+  expire_condition.WaitFor(auto_lock, 50u);
+  EXPECT_EQ(1u, entry.calls_count());
+  timer::TimerWheel::instance().Cancel(&entry, &expire_lock);
+}
+
+TEST(TimerWheelTest, Schedule_LongCallback_OtherEntryNotDelayed) {
+  BlockingEntry blocking_entry;
+  TestEntry entry(0u, NULL);
+  std::vector<TestEntry*> entries(1u, &entry);
+
+  sync_primitives::AutoLock auto_lock(expire_lock);
+  timer::TimerWheel::instance().Schedule(&blocking_entry, 0u, false);
+  while (!blocking_entry.started()) {
+    ASSERT_EQ(sync_primitives::ConditionalVariable::kNoTimeout,
+              expire_condition.WaitFor(auto_lock, kWaitTimeoutMs));
+  }
+
+  // Entry expires while callback of the blocking one is still running
+  timer::TimerWheel::instance().Schedule(&entry, 10u, false);
+  EXPECT_TRUE(WaitForCalls(entries, auto_lock));
+  EXPECT_FALSE(blocking_entry.finished());
+
+  blocking_entry.Release();
+  timer::TimerWheel::instance().Cancel(&blocking_entry, &expire_lock);
+  EXPECT_TRUE(blocking_entry.finished());
+  timer::TimerWheel::instance().Cancel(&entry, &expire_lock);
+}
+
+}  // namespace timer_wheel_test
+}  // namespace components
+}  // namespace test
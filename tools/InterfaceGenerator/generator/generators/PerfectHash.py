@@ -0,0 +1,163 @@
+"""Perfect hash tables for generated enum conversions.
+
+Builds two level (hash and displace) perfect hash tables for enum names
+and values. Hash functions must stay in sync with
+src/components/include/utils/perfect_hash.h.
+
+"""
+
+_UINT32_MASK = 0xFFFFFFFF
+_FNV_OFFSET_BASIS = 2166136261
+_FNV_PRIME = 16777619
+_SEED_STEP = 0x9E3779B9
+_MAX_SEED_ATTEMPTS = 64
+_MAX_DISPLACEMENT = 1 << 16
+
+
+class PerfectHashError(Exception):
+
+    """Perfect hash error.
+
+    This exception is raised when perfect hash tables can not be built
+    for given keys.
+
+    """
+
+    pass
+
+
+def mix(value):
+    """Finalization mix of MurmurHash3."""
+    value ^= value >> 16
+    value = (value * 0x85EBCA6B) & _UINT32_MASK
+    value ^= value >> 13
+    value = (value * 0xC2B2AE35) & _UINT32_MASK
+    value ^= value >> 16
+    return value
+
+
+def hash_string(string, seed):
+    """Seeded FNV-1a hash of UTF-8 representation of string."""
+    value = seed
+    for byte in bytearray(string.encode("utf-8")):
+        value ^= byte
+        value = (value * _FNV_PRIME) & _UINT32_MASK
+    return value
+
+
+def hash_value(value, seed):
+    """Seeded hash of 32 bit integer value."""
+    return mix((value & _UINT32_MASK) ^ seed)
+
+
+def _next_power_of_two(value):
+    result = 1
+    while result < value:
+        result <<= 1
+    return result
+
+
+def _place(hashes, bucket_mask, slot_mask):
+    """Search displacements placing every hash into its own slot.
+
+    Keyword arguments:
+    hashes -- dictionary of key hash to slot content.
+    bucket_mask -- displacements table size minus one.
+    slot_mask -- slots table size minus one.
+
+    Returns:
+    Tuple of displacements and slots tables or None if some hashes
+    can not be separated.
+
+    """
+
+    buckets = [[] for _ in range(bucket_mask + 1)]
+    for key_hash in hashes:
+        buckets[key_hash & bucket_mask].append(key_hash)
+    displacements = [0] * (bucket_mask + 1)
+    slots = [-1] * (slot_mask + 1)
+    order = sorted(range(len(buckets)), key=lambda x: (-len(buckets[x]), x))
+    for bucket in order:
+        items = buckets[bucket]
+        if not items:
+            break
+        for displacement in range(_MAX_DISPLACEMENT):
+            taken = [mix(x ^ displacement) & slot_mask for x in items]
+            if len(set(taken)) == len(taken) and \
+                    all(slots[x] < 0 for x in taken):
+                break
+        else:
+            return None
+        displacements[bucket] = displacement
+        for key_hash, slot in zip(items, taken):
+            slots[slot] = hashes[key_hash]
+    return displacements, slots
+
+
+def build(names, values=None):
+    """Build perfect hash tables for enum.
+
+    Slots contain index of element in names/values lists or -1 for
+    empty slot. Equal values are mapped to the last of elements having
+    that value.
+
+    Keyword arguments:
+    names -- list of unique string names of enum elements.
+    values -- list of integer values of enum elements or None if only
+              string lookup is required.
+
+    Returns:
+    Dictionary with seed, bucket_mask, slot_mask, string_displacements,
+    string_slots and optional value_displacements, value_slots.
+
+    """
+
+    slot_count = _next_power_of_two(max(2, 2 * len(names)))
+    bucket_count = max(1, slot_count // 4)
+    seed = _FNV_OFFSET_BASIS
+    for _ in range(_MAX_SEED_ATTEMPTS):
+        strings = dict()
+        for index, name in enumerate(names):
+            strings[hash_string(name, seed)] = index
+        result = None
+        if len(strings) == len(names):
+            result = _place(strings, bucket_count - 1, slot_count - 1)
+        if result is not None and values is not None:
+            value_indexes = dict()
+            for index, value in enumerate(values):
+                value_indexes[value] = index
+            hashes = dict()
+            for value, index in value_indexes.items():
+                hashes[hash_value(value, seed)] = index
+            value_result = None
+            if len(hashes) == len(value_indexes):
+                value_result = _place(
+                    hashes, bucket_count - 1, slot_count - 1)
+            if value_result is None:
+                result = None
+        if result is not None:
+            tables = dict(seed=seed,
+                          bucket_mask=bucket_count - 1,
+                          slot_mask=slot_count - 1,
+                          string_displacements=result[0],
+                          string_slots=result[1])
+            if values is not None:
+                tables["value_displacements"] = value_result[0]
+                tables["value_slots"] = value_result[1]
+            return tables
+        seed = (seed + _SEED_STEP) & _UINT32_MASK
+    raise PerfectHashError("Unable to build perfect hash for " +
+                           ", ".join(names))
+
+
+def format_array(items, indent=u"  ", width=80):
+    """Format list of integers as body of C++ array initializer."""
+    lines = []
+    line = indent
+    for item in [str(x) for x in items]:
+        if len(line) + len(item) + 1 > width and line != indent:
+            lines.append(line.rstrip())
+            line = indent
+        line += item + u", "
+    lines.append(line.rstrip().rstrip(u","))
+    return u"\n".join(lines)
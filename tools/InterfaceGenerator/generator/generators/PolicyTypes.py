@@ -12,6 +12,7 @@ import string
 import uuid
 import re
 
+from generator.generators import PerfectHash
 from model.enum import Enum
 from model.enum_element import EnumElement
 from model.function import Function
@@ -237,7 +238,7 @@ class CodeGenerator(object):
             f_cc.write(self._cc_file_template.substitute(
                 class_name=class_name,
                 header_file=header_file_name,
-                includes="",
+                includes=u'''#include "utils/perfect_hash.h"\n''',
                 namespace_open=namespace_open,
                 enums_content=self.gen_enums_processing(required_enum_values
                     ),
@@ -391,20 +392,26 @@ class CodeGenerator(object):
 
     def _gen_enum_from_json(self, enum):
         name = self.enum_naming_conversion_[enum.name]
-        enum_items = "\n".join([self._gen_enum_item_from_json(enum_item.name, enum.name) for enum_item in enum.elements.values()])
+        item_names = [enum_item.name for enum_item in enum.elements.values()]
         if (enum.name in self.required_empty_value):
-            enum_items += "\n" + self._gen_enum_item_from_json("EMPTY", enum.name)
+            item_names.append("EMPTY")
+        string_names = [self.enum_items_string_naming_conversion_[enum.name](x)
+                        for x in item_names]
+        if not string_names:
+            return self._empty_enum_from_json_template.substitute(name = name)
+        tables = PerfectHash.build(string_names)
         return self._enum_from_json_template.substitute(
             name = name,
-            enum_items = enum_items
+            string_names = ",\n".join(["    \"{}\"".format(x) for x in string_names]),
+            enum_items = ",\n".join(["    " + self.enum_items_naming_conversion_[enum.name](x)
+                                     for x in item_names]),
+            displacements = PerfectHash.format_array(tables["string_displacements"], indent=u"    "),
+            slots = PerfectHash.format_array(tables["string_slots"], indent=u"    "),
+            seed = tables["seed"],
+            bucket_mask = tables["bucket_mask"],
+            slot_mask = tables["slot_mask"]
         )
 
-    def _gen_enum_item_from_json(self, item_name, enum_name):
-        return self._enum_from_json_item_template.substitute(
-            name = self.enum_items_naming_conversion_[enum_name](item_name),
-            string_name = self.enum_items_string_naming_conversion_[enum_name](item_name)
-            )
-
     def _gen_comment(self, interface_item_base, use_doxygen=True):
         """Generate doxygen comment for iterface_item_base for header file.
 
@@ -641,15 +648,29 @@ class CodeGenerator(object):
 
     _enum_from_json_template = string.Template(
         u'''bool EnumFromJsonString(const std::string& literal, $name* result) {\n'''
-        u'''$enum_items'''
-        u'''  return false;\n'''
+        u'''  static const char* const kStrings[] = {\n'''
+        u'''$string_names};\n'''
+        u'''  static const $name kValues[] = {\n'''
+        u'''$enum_items};\n'''
+        u'''  static const uint32_t kDisplacements[] = {\n'''
+        u'''$displacements};\n'''
+        u'''  static const int16_t kSlots[] = {\n'''
+        u'''$slots};\n'''
+        u'''  namespace ph = utils::perfect_hash;\n'''
+        u'''  const int16_t index = ph::Lookup(\n'''
+        u'''      ph::HashString(literal.data(), literal.size(), ${seed}u),\n'''
+        u'''      kDisplacements, ${bucket_mask}u, kSlots, ${slot_mask}u);\n'''
+        u'''  if (index < 0 || literal != kStrings[index]) {\n'''
+        u'''    return false;\n'''
+        u'''  }\n'''
+        u'''  *result = kValues[index];\n'''
+        u'''  return true;\n'''
         u'''};\n''')
 
-    _enum_from_json_item_template = string.Template(
-        u'''  if ("$string_name" == literal) {\n'''
-        u'''    *result = $name;\n'''
-        u'''    return true;\n'''
-        u'''  }\n''')
+    _empty_enum_from_json_template = string.Template(
+        u'''bool EnumFromJsonString(const std::string& literal, $name* result) {\n'''
+        u'''  return false;\n'''
+        u'''};\n''')
 
     _enum_element_with_value_template = string.Template(
         u'''$comment\n'''
@@ -12,6 +12,7 @@ import os
 import string
 import uuid
 
+from generator.generators import PerfectHash
 from model.array import Array
 from model.boolean import Boolean
 from model.float import Float
@@ -215,7 +216,8 @@ class CodeGenerator(object):
             namespace=namespace,
             enum=x.name,
             cstringvalues=self._indent_code(self._gen_enum_cstring_values(x), 2),
-            enumvalues=self._indent_code(self._gen_enum_enum_values(x, namespace), 2))
+            enumvalues=self._indent_code(self._gen_enum_enum_values(x, namespace), 2),
+            hash_tables=self._gen_enum_hash_tables(x))
             for x in enums])
 
     def _gen_enum_cstring_values(self, enum):
@@ -227,6 +229,46 @@ class CodeGenerator(object):
         """
         return u",\n".join(['"' + x.name + '"' for x in enum.elements.values()])
 
+    def _gen_enum_int_values(self, enum):
+        """Calculate integer values of enum elements.
+        Keyword arguments:
+        enum -- enum to calculate values.
+        Returns:
+        List of values in the same order as enum elements.
+        """
+        result = []
+        # INVALID_ENUM = -1 is always the first element of generated enum
+        previous = -1
+        for element in enum.elements.values():
+            if element.value is not None:
+                previous = int(str(element.value), 0)
+            else:
+                previous += 1
+            result.append(previous)
+        return result
+
+    def _gen_enum_hash_tables(self, enum):
+        """Generate perfect hash tables for enum conversions.
+        Keyword arguments:
+        enum -- enum to generate tables.
+        Returns:
+        String value with tables definition.
+        """
+        tables = PerfectHash.build(
+            [x.name for x in enum.elements.values()],
+            self._gen_enum_int_values(enum))
+        return self._enum_hash_tables_template.substitute(
+            enum=enum.name,
+            seed=tables["seed"],
+            bucket_mask=tables["bucket_mask"],
+            slot_mask=tables["slot_mask"],
+            string_displacements=PerfectHash.format_array(
+                tables["string_displacements"]),
+            string_slots=PerfectHash.format_array(tables["string_slots"]),
+            value_displacements=PerfectHash.format_array(
+                tables["value_displacements"]),
+            value_slots=PerfectHash.format_array(tables["value_slots"]))
+
     def _gen_enum_enum_values(self, enum, namespace):
         """Generate list of all enum values.
         Keyword arguments:
@@ -1774,12 +1816,14 @@ class CodeGenerator(object):
         u'''  }\n'''
         u'''\n'''
         u'''  msg_params_schema_item->mSchemaItem->AddMemberSchemaItem(member_key, member);\n'''
+        u'''  ResetResolvedSchemes(function_id, message_type);\n'''
         u'''  return true;\n'''
         u'''}\n'''
         u'''\n'''
         u'''void $namespace::$class_name::ResetFunctionSchema(FunctionID::eType function_id,\n'''
         u'''                         messageType::eType message_type) {\n'''
         u'''  InitFunctionSchema(function_id, message_type);\n'''
+        u'''  ResetResolvedSchemes(function_id, message_type);\n'''
         u'''}\n'''
         u'''\n'''
         u'''void $namespace::$class_name::InitStructSchemes() {'''
@@ -1853,8 +1897,35 @@ class CodeGenerator(object):
         u'''enum_values_[] = {\n'''
         u'''${enumvalues}'''
         u'''};\n'''
+        u'''\n'''
+        u'''${hash_tables}'''
+        u'''\n'''
+        u'''template<>\n'''
+        u'''const EnumHashTables*\n'''
+        u'''EnumConversionHelper<${namespace}::${enum}::eType>::'''
+        u'''hash_tables_ = &k${enum}HashTables;\n'''
         u'''\n''')
 
+    _enum_hash_tables_template = string.Template(
+        u'''namespace {\n'''
+        u'''constexpr uint32_t k${enum}StringDisplacements[] = {\n'''
+        u'''${string_displacements}};\n'''
+        u'''\n'''
+        u'''constexpr int16_t k${enum}StringSlots[] = {\n'''
+        u'''${string_slots}};\n'''
+        u'''\n'''
+        u'''constexpr uint32_t k${enum}ValueDisplacements[] = {\n'''
+        u'''${value_displacements}};\n'''
+        u'''\n'''
+        u'''constexpr int16_t k${enum}ValueSlots[] = {\n'''
+        u'''${value_slots}};\n'''
+        u'''\n'''
+        u'''constexpr EnumHashTables k${enum}HashTables = {\n'''
+        u'''  ${seed}u, ${bucket_mask}u, ${slot_mask}u,\n'''
+        u'''  k${enum}StringDisplacements, k${enum}StringSlots,\n'''
+        u'''  k${enum}ValueDisplacements, k${enum}ValueSlots};\n'''
+        u'''}  // namespace\n''')
+
     _function_switch_template = string.Template(
         u'''switch(${switchable}) {\n'''
         u'''${cases}'''
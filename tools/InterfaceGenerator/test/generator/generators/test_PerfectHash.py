@@ -0,0 +1,63 @@
+"""Test for perfect hash tables builder.
+
+Verifies that built tables place every enum element into its own slot.
+
+"""
+import unittest
+from pathlib import Path
+
+import sys
+
+sys.path.append(Path(__file__).absolute().parents[3].as_posix())
+from generator.generators import PerfectHash
+
+
+def lookup(tables, key_hash, kind):
+    displacement = tables[kind + "_displacements"][
+        key_hash & tables["bucket_mask"]]
+    return tables[kind + "_slots"][
+        PerfectHash.mix(key_hash ^ displacement) & tables["slot_mask"]]
+
+
+class Test(unittest.TestCase):
+
+    """Test for perfect hash tables builder."""
+
+    def test_hash_functions(self):
+        """Test hash values are the same as in utils/perfect_hash.h."""
+        self.assertEqual(2723254922, PerfectHash.hash_string(
+            u"RegisterAppInterface", 2166136261))
+        self.assertEqual(3529584960, PerfectHash.hash_value(-5, 12345))
+
+    def test_build(self):
+        """Test every name and value is found in its own slot."""
+        names = [u"Name{}".format(x) for x in range(300)]
+        values = list(range(150)) + list(range(32768, 32918))
+        tables = PerfectHash.build(names, values)
+
+        self.assertEqual(1023, tables["slot_mask"])
+        for index, name in enumerate(names):
+            self.assertEqual(index, lookup(
+                tables, PerfectHash.hash_string(name, tables["seed"]),
+                "string"))
+        for index, value in enumerate(values):
+            self.assertEqual(index, lookup(
+                tables, PerfectHash.hash_value(value, tables["seed"]),
+                "value"))
+
+    def test_build_duplicated_values(self):
+        """Test equal values are mapped to the last element."""
+        tables = PerfectHash.build([u"A", u"B", u"C"], [0, 1, 1])
+        self.assertEqual(2, lookup(
+            tables, PerfectHash.hash_value(1, tables["seed"]), "value"))
+        self.assertNotIn("value_slots", PerfectHash.build([u"A"]))
+
+    def test_format_array(self):
+        """Test array initializer formatting."""
+        self.assertEqual(u"  1, -1, 2", PerfectHash.format_array([1, -1, 2]))
+        lines = PerfectHash.format_array(list(range(100))).split(u"\n")
+        self.assertTrue(all(len(x) <= 80 for x in lines))
+
+
+if __name__ == '__main__':
+    unittest.main()
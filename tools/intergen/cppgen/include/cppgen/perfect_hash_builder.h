@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PERFECT_HASH_BUILDER_H_
+#define PERFECT_HASH_BUILDER_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace codegen {
+
+/*
+ * Two level perfect hash tables for set of unique strings.
+ * Lookup scheme is implemented in src/components/include/utils/perfect_hash.h
+ * of generated code, so hash functions below must stay in sync with it
+ * and with tools/InterfaceGenerator PerfectHash module.
+ */
+struct PerfectHashTables {
+  uint32_t seed;
+  uint32_t bucket_mask;
+  uint32_t slot_mask;
+  std::vector<uint32_t> displacements;
+  // Index of string in source list or -1 for empty slot
+  std::vector<int16_t> slots;
+};
+
+// Seeded FNV-1a hash of |str|
+uint32_t PerfectHashString(const std::string& str, uint32_t seed);
+
+// Searches seed and displacements placing every string of |strings|
+// into its own slot. Returns false if there is no such placement.
+bool BuildPerfectHash(const std::vector<std::string>& strings,
+                      PerfectHashTables* tables);
+
+}  // namespace codegen
+
+#endif /* PERFECT_HASH_BUILDER_H_ */
@@ -33,9 +33,12 @@
 #include "cppgen/enum_from_json_value_function.h"
 
 #include <ostream>
+#include <string>
+#include <vector>
 
 #include "cppgen/generator_preferences.h"
 #include "cppgen/literal_generator.h"
+#include "cppgen/perfect_hash_builder.h"
 #include "model/composite_type.h"
 #include "utils/safeformat.h"
 
@@ -44,6 +47,21 @@ using typesafe_format::strmfmt;
 
 namespace codegen {
 
+namespace {
+// Writes comma separated |numbers| several per line
+template <typename T>
+void WriteNumbers(std::ostream* os, const std::vector<T>& numbers) {
+  const size_t kNumbersPerLine = 12;
+  Indent indent(*os);
+  for (size_t i = 0; i < numbers.size(); ++i) {
+    *os << static_cast<int64_t>(numbers[i]) << ",";
+    const bool line_end =
+        (i + 1) % kNumbersPerLine == 0 || i + 1 == numbers.size();
+    *os << (line_end ? '\n' : ' ');
+  }
+}
+}  // namespace
+
 EnumFromJsonStringFunction::EnumFromJsonStringFunction(
     const Enum* enm)
     : CppFunction("", "EnumFromJsonString", "bool"),
@@ -57,27 +75,54 @@ EnumFromJsonStringFunction::~EnumFromJsonStringFunction() {
 
 void EnumFromJsonStringFunction::DefineBody(std::ostream* os) const {
   const Enum::ConstantsList& consts = enm_->constants();
-  if (!consts.empty()) {
-    const char* if_statement = "if (\"{0}\" == {1}) {";
+  std::vector<std::string> names;
+  for (Enum::ConstantsList::const_iterator i = consts.begin();
+      i != consts.end(); ++i) {
+    names.push_back(i->name());
+  }
+  PerfectHashTables tables;
+  if (names.empty() || !BuildPerfectHash(names, &tables)) {
+    *os << "return false;" << endl;
+    return;
+  }
+  *os << "static const char* const kStrings[] = {" << endl;
+  {
+    Indent indent(*os);
+    for (size_t i = 0; i < names.size(); ++i) {
+      *os << "\"" << names[i] << "\"," << endl;
+    }
+  }
+  *os << "};" << endl;
+  strmfmt(*os, "static const {0} kValues[] = {", enm_->name()) << endl;
+  {
+    Indent indent(*os);
     for (Enum::ConstantsList::const_iterator i = consts.begin();
         i != consts.end(); ++i) {
-      const Enum::Constant& c = *i;
-      strmfmt(*os, if_statement, c.name(), parameters_[0].name) << endl;
-      {
-        Indent indent(*os);
-        strmfmt(*os, "{0} = {1};", parameters_[1].name,
-                LiteralGenerator(c).result()) << '\n';
-        *os << "return true;" << '\n';
-      }
-      if_statement = "} else if (\"{0}\" == {1}) {";
+      *os << LiteralGenerator(*i).result() << "," << endl;
     }
   }
-  *os << "} else {" << endl;
+  *os << "};" << endl;
+  *os << "static const uint32_t kDisplacements[] = {" << endl;
+  WriteNumbers(os, tables.displacements);
+  *os << "};" << endl;
+  *os << "static const int16_t kSlots[] = {" << endl;
+  WriteNumbers(os, tables.slots);
+  *os << "};" << endl;
+  *os << "namespace ph = utils::perfect_hash;" << endl;
+  strmfmt(*os, "const int16_t index = ph::Lookup("
+          "ph::HashString({0}.data(), {0}.size(), {1}u), "
+          "kDisplacements, {2}u, kSlots, {3}u);",
+          parameters_[0].name, tables.seed, tables.bucket_mask,
+          tables.slot_mask) << endl;
+  strmfmt(*os, "if (index < 0 || {0} != kStrings[index]) {",
+          parameters_[0].name) << endl;
   {
     Indent indent(*os);
-    *os << "return false;" << '\n';
+    *os << "return false;" << endl;
   }
   *os << "}" << endl;
+  strmfmt(*os, "{0} = kValues[index];", parameters_[1].name) << endl;
+  *os << "return true;" << endl;
 }
 
 }  // namespace codegen
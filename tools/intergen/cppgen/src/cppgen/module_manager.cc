@@ -87,6 +87,7 @@ ModuleManager::ModuleManager(const std::string& name,
   interface_header_.Include(CppFile::Header(enums_header_.file_name(), true));
   enums_header_.Include(CppFile::Header("string", false));
   enums_source_.Include(CppFile::Header(enums_header_.file_name(), true));
+  enums_source_.Include(CppFile::Header("utils/perfect_hash.h", true));
   structs_source_.Include(CppFile::Header(structs_header_.file_name(), true));
   functions_source_.Include(CppFile::Header(functions_header_.file_name(),
                                             true));
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2021, Ford Motor Company
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following
+ * disclaimer in the documentation and/or other materials provided with the
+ * distribution.
+ *
+ * Neither the name of the Ford Motor Company nor the names of its contributors
+ * may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cppgen/perfect_hash_builder.h"
+
+#include <algorithm>
+#include <map>
+
+namespace codegen {
+
+namespace {
+const uint32_t kFnvOffsetBasis = 2166136261u;
+const uint32_t kFnvPrime = 16777619u;
+const uint32_t kSeedStep = 0x9E3779B9u;
+const size_t kMaxSeedAttempts = 64;
+const uint32_t kMaxDisplacement = 1u << 16;
+
+uint32_t Mix(uint32_t hash) {
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+typedef std::vector<uint32_t> Bucket;
+
+bool BucketGreater(const std::pair<Bucket, uint32_t>& a,
+                   const std::pair<Bucket, uint32_t>& b) {
+  if (a.first.size() != b.first.size()) {
+    return a.first.size() > b.first.size();
+  }
+  return a.second < b.second;
+}
+
+// Places all |hashes| into slots, |hashes| maps hash to slot content
+bool Place(const std::map<uint32_t, int16_t>& hashes,
+           PerfectHashTables* tables) {
+  std::vector<std::pair<Bucket, uint32_t> > buckets(tables->bucket_mask + 1);
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    buckets[i].second = i;
+  }
+  for (std::map<uint32_t, int16_t>::const_iterator i = hashes.begin();
+       i != hashes.end(); ++i) {
+    buckets[i->first & tables->bucket_mask].first.push_back(i->first);
+  }
+  // Largest buckets are placed first while table is mostly empty
+  std::sort(buckets.begin(), buckets.end(), BucketGreater);
+  tables->displacements.assign(tables->bucket_mask + 1, 0);
+  tables->slots.assign(tables->slot_mask + 1, -1);
+  for (size_t b = 0; b < buckets.size() && !buckets[b].first.empty(); ++b) {
+    const Bucket& items = buckets[b].first;
+    std::vector<uint32_t> taken(items.size());
+    uint32_t displacement = 0;
+    for (; displacement < kMaxDisplacement; ++displacement) {
+      bool placed = true;
+      for (size_t i = 0; i < items.size() && placed; ++i) {
+        taken[i] = Mix(items[i] ^ displacement) & tables->slot_mask;
+        placed = tables->slots[taken[i]] < 0 &&
+                 std::find(taken.begin(), taken.begin() + i, taken[i]) ==
+                     taken.begin() + i;
+      }
+      if (placed) {
+        break;
+      }
+    }
+    if (displacement == kMaxDisplacement) {
+      return false;
+    }
+    tables->displacements[buckets[b].second] = displacement;
+    for (size_t i = 0; i < items.size(); ++i) {
+      tables->slots[taken[i]] = hashes.find(items[i])->second;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+uint32_t PerfectHashString(const std::string& str, uint32_t seed) {
+  uint32_t hash = seed;
+  for (size_t i = 0; i < str.size(); ++i) {
+    hash ^= static_cast<uint8_t>(str[i]);
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+bool BuildPerfectHash(const std::vector<std::string>& strings,
+                      PerfectHashTables* tables) {
+  uint32_t slot_count = 2;
+  while (slot_count < 2 * strings.size()) {
+    slot_count <<= 1;
+  }
+  tables->slot_mask = slot_count - 1;
+  tables->bucket_mask = std::max(1u, slot_count / 4) - 1;
+  tables->seed = kFnvOffsetBasis;
+  for (size_t attempt = 0; attempt < kMaxSeedAttempts; ++attempt) {
+    std::map<uint32_t, int16_t> hashes;
+    for (size_t i = 0; i < strings.size(); ++i) {
+      hashes[PerfectHashString(strings[i], tables->seed)] = i;
+    }
+    if (hashes.size() == strings.size() && Place(hashes, tables)) {
+      return true;
+    }
+    tables->seed += kSeedStep;
+  }
+  return false;
+}
+
+}  // namespace codegen